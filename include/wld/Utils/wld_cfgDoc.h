@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#ifndef INCLUDE_WLD_UTILS_WLD_CFGDOC_H_
+#define INCLUDE_WLD_UTILS_WLD_CFGDOC_H_
+
+#include "swl/swl_common.h"
+
+/*
+ * In-memory model of a daemon "key=value" config file (hostapd, wpa_supplicant).
+ * Line offsets of keys are indexed, so that value updates are applied as in-place
+ * patches of the file content, then flushed with one atomic write on commit.
+ *
+ * The file is split into sections, opened by section keys:
+ * - the section is named with the opener value (ie. interface=wlan0, bss=wlan1)
+ * - block sections (ie. network={ ... }) are named with the opener key;
+ *   lines after the block closer belong back to the enclosing section.
+ * Lines before the first section opener make the header section (NULL name).
+ *
+ * Documents are cached per file path, and reloaded when the file was
+ * changed on disk by another writer (ie. full config regeneration).
+ */
+typedef struct wld_cfgDoc wld_cfgDoc_t;
+
+wld_cfgDoc_t* wld_cfgDoc_get(const char* path, const char* const* sectionKeys, uint32_t nSectionKeys);
+const char* wld_cfgDoc_getValue(wld_cfgDoc_t* pDoc, const char* section, const char* key, size_t* pLen);
+swl_rc_ne wld_cfgDoc_set(wld_cfgDoc_t* pDoc, const char* section, const char* key, const char* value);
+bool wld_cfgDoc_isDirty(wld_cfgDoc_t* pDoc);
+swl_rc_ne wld_cfgDoc_commit(wld_cfgDoc_t* pDoc);
+void wld_cfgDoc_drop(const char* path);
+
+#endif /* INCLUDE_WLD_UTILS_WLD_CFGDOC_H_ */
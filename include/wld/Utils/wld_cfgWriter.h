@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+
+#ifndef INCLUDE_WLD_UTILS_WLD_CFGWRITER_H_
+#define INCLUDE_WLD_UTILS_WLD_CFGWRITER_H_
+
+#include "swl/swl_common.h"
+#include "swl/swl_maps.h"
+
+/*
+ * Streaming writer of daemon config files (hostapd, wpa_supplicant).
+ * The whole file content is rendered into a growable buffer, reused over writes,
+ * then flushed with a single write() into a temporary file, renamed over the target path.
+ */
+typedef struct wld_cfgWriter wld_cfgWriter_t;
+
+/* flags of file commit */
+#define M_WLD_CFG_WRITER_FSYNC  SWL_BIT_SHIFT(0) /* sync file content to storage before renaming */
+#define M_WLD_CFG_WRITER_DIRECT SWL_BIT_SHIFT(1) /* write target path in place, without tmp file (ie. tmpfs/memfd paths) */
+
+typedef struct {
+    uint32_t nWrites;       /* number of files written */
+    uint32_t nErrors;       /* number of failed file writes */
+    size_t lastSize;        /* size of last written content */
+    uint32_t lastRenderUs;  /* duration of last content rendering */
+    uint32_t lastWriteUs;   /* duration of last file write (write/sync/rename) */
+    uint32_t maxRenderUs;   /* max content rendering duration */
+    uint32_t maxWriteUs;    /* max file write duration */
+} wld_cfgWriter_stats_t;
+
+wld_cfgWriter_t* wld_cfgWriter_start(void);
+bool wld_cfgWriter_addStr(wld_cfgWriter_t* pWriter, const char* str);
+bool wld_cfgWriter_addFormat(wld_cfgWriter_t* pWriter, const char* format, ...) __attribute__((format(printf, 2, 3)));
+bool wld_cfgWriter_addMapEsc(wld_cfgWriter_t* pWriter, swl_mapChar_t* pMap, const char* escChars, char escChar);
+const char* wld_cfgWriter_getContent(wld_cfgWriter_t* pWriter, size_t* pLen);
+swl_rc_ne wld_cfgWriter_commit(wld_cfgWriter_t* pWriter, const char* path, uint32_t flags);
+swl_rc_ne wld_cfgWriter_writeFile(const char* path, const char* buf, size_t len, uint32_t flags);
+void wld_cfgWriter_setDefaultFlags(uint32_t flags);
+uint32_t wld_cfgWriter_getDefaultFlags(void);
+const wld_cfgWriter_stats_t* wld_cfgWriter_getStats(void);
+
+#endif /* INCLUDE_WLD_UTILS_WLD_CFGWRITER_H_ */
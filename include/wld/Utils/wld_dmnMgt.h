@@ -75,6 +75,7 @@ typedef struct {
 
 typedef struct {
     swl_trl_e useGlobalInstance;              //use global daemon: 0:Off, 1:On, 2:auto ie enabled when required
+    bool warmStandby;                         //pre-start global daemon without interfaces, then add/remove them at runtime
 } wld_dmnMgt_dmnExecSettings_t;
 
 typedef struct {
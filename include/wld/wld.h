@@ -101,6 +101,7 @@
 #include "wld_fsm.h"
 #include "wld_sensing.h"
 #include "wld_mld.h"
+#include "wld_ap_staDcLog.h"
 #include "Utils/wld_autoCommitRadData.h"
 #include "Utils/wld_dmnMgt.h"
 #include "swla/swla_radioStandards.h"
@@ -779,6 +780,94 @@ typedef struct {
     T_AccessPoint* ap;
 } wld_wds_intf_t;
 
+/* Signal strength range (dBm) covered by the far station buckets. Values outside are clamped. */
+#define WLD_AD_RSSI_BUCKET_MIN -127
+#define WLD_AD_RSSI_BUCKET_MAX 0
+#define WLD_AD_NR_RSSI_BUCKETS (WLD_AD_RSSI_BUCKET_MAX - WLD_AD_RSSI_BUCKET_MIN + 1)
+
+/*
+ * Aggregate station counters, kept per accesspoint and per radio.
+ * They are updated incrementally on each station state change, so that
+ * readers do not have to scan the station list.
+ */
+typedef struct {
+    uint32_t nrActive;                                  /* number of active stations */
+    uint32_t nrAuthenticated;                           /* number of authenticated stations */
+    uint32_t nrActiveVideo;                             /* number of active stations with video device type */
+    uint32_t nrActivePerStd[SWL_RADSTD_MAX];            /* number of active stations per operating standard */
+    uint32_t nrActivePerBand[SWL_FREQ_BAND_EXT_MAX];    /* number of active stations supporting each frequency band */
+    uint16_t nrActivePerRssi[WLD_AD_NR_RSSI_BUCKETS];   /* number of active stations per 1dBm signal strength bucket */
+} wld_ad_staCounters_t;
+
+/*
+ * Contribution of a single station to the aggregate counters,
+ * as it was last accounted.
+ */
+typedef struct {
+    T_AccessPoint* pAP;             /* accesspoint where station is accounted, NULL if not accounted */
+    T_Radio* pRad;                  /* radio where station is accounted */
+    bool active;
+    bool authenticated;
+    bool video;
+    swl_radStd_e operatingStandard;
+    swl_freqBandExt_m freqCapabilities;
+    uint8_t rssiBucket;
+} wld_ad_staCountKey_t;
+
+/* Version of the wld_ad_statsRecord_t layout. Increment on any layout change. */
+#define WLD_AD_STATS_RECORD_VERSION 1
+
+#define WLD_AD_STATS_RECORD_FLAG_ACTIVE        0x01
+#define WLD_AD_STATS_RECORD_FLAG_AUTHENTICATED 0x02
+#define WLD_AD_STATS_RECORD_FLAG_POWERSAVE     0x04
+
+/*
+ * Fixed layout statistics record of a single station, for bulk export.
+ * Fields are ordered by size, so the layout has no implicit padding.
+ */
+typedef struct {
+    uint64_t generation;             /* stats generation at which the record content last changed */
+    uint64_t txBytes;
+    uint64_t rxBytes;
+    uint64_t rxFailures;
+    uint64_t lastSampleTimeMs;       /* mono time of last stats sample, in milliseconds */
+    uint32_t apIndex;                /* ref_index of the accesspoint of the station */
+    uint32_t txPacketCount;
+    uint32_t rxPacketCount;
+    uint32_t txFailures;
+    uint32_t retransmissions;
+    uint32_t lastDataDownlinkRate;   /* kbps */
+    uint32_t lastDataUplinkRate;     /* kbps */
+    uint32_t maxDownlinkRateReached; /* kbps */
+    uint32_t maxUplinkRateReached;   /* kbps */
+    uint32_t inactive;               /* seconds */
+    uint32_t connectionDuration;     /* seconds */
+    uint32_t associationTime;        /* mono time of last association, in seconds */
+    int32_t signalStrength;          /* dBm */
+    int32_t noise;                   /* dBm */
+    int32_t signalNoiseRatio;        /* dB */
+    uint8_t macAddress[ETHER_ADDR_LEN];
+    uint8_t downlinkMcs;
+    uint8_t uplinkMcs;
+    uint8_t downlinkNss;
+    uint8_t uplinkNss;
+    uint8_t operatingStandard;       /* swl_radStd_e */
+    uint8_t flags;                   /* WLD_AD_STATS_RECORD_FLAG_* */
+} wld_ad_statsRecord_t;
+
+/*
+ * Header of a bulk station statistics export.
+ */
+typedef struct {
+    uint32_t version;     /* WLD_AD_STATS_RECORD_VERSION */
+    uint32_t recordSize;  /* sizeof(wld_ad_statsRecord_t) */
+    uint32_t nrStations;  /* number of stations currently known */
+    uint32_t nrChanged;   /* number of stations changed since the requested generation */
+    uint32_t nrRecords;   /* number of records filled, lower than nrChanged if the record array is too small */
+    uint32_t reserved;
+    uint64_t generation;  /* current stats generation, to pass as sinceGeneration in the next export */
+} wld_ad_statsSnapshot_t;
+
 typedef struct {
     char Name[32];                            /* Name tag.*/
     unsigned char MACAddress[ETHER_ADDR_LEN]; /* MAC address of station */
@@ -885,6 +974,9 @@ typedef struct {
     wld_wds_intf_t* wdsIntf;                /* wds interface info */
     amxp_timer_t* delayDisassocNotif;
     swl_mlo_mode_e mloMode;                 /* the Mlo mode */
+    wld_ad_staCountKey_t staCountKey;       /* last accounted contribution to aggregate station counters */
+    wld_ad_statsRecord_t statsRecord;       /* last exported stats record, used to track stats generation */
+    uint32_t pendingBatchChange;            /* 1 + index of the pending coalesced change of this station, 0 if none */
 } T_AssociatedDevice;
 
 
@@ -1594,6 +1686,7 @@ struct WLD_RADIO {
     T_CONST_WPS* wpsConst;                                                  /* WPS constant strings (Build defined) */
     int currentStations;                                                    /* Stat the current # of stations connected to this radio */
     uint32_t currentVideoStations;                                          /* Stat the current # of video endpoints connected to to this radio */
+    wld_ad_staCounters_t staCounters;                                       /* Aggregate counters of stations of all accesspoints of this radio */
     int maxStations;                                                        /* config the MAX # of stations this radio can handle */
     uint32_t maxNrHwBss;                                                    /* The max nr of Bss that radio can create (determined by hardware) */
     uint32_t maxNrHwSta;                                                    /* The max nr of stations that radio can create (determined by hardware) */
@@ -1660,6 +1753,7 @@ struct WLD_RADIO {
     wld_autoCommitRadData_t autoCommitData;             /* struct for managing auto commiting */
     wld_nl80211_listener_t* nl80211Listener;            /* nl80211 events listener */
     wld_secDmn_t* hostapd;                              /* hostapd daemon context. */
+    wld_hostapd_cfgSnapshot_t* hapdCfgSnapshot;         /* sections fingerprints of the last written hostapd config */
     uint32_t wiphy;                                     /* nl80211 wireless physical device id */
     char wiphyName[IFNAMSIZ];                           /* nl80211 wireless physical device name */
     wld_nl80211_channelSurveyInfo_t* pLastSurvey;       /* last active chan survey result (cached) */
@@ -1920,11 +2014,12 @@ struct S_ACCESSPOINT {
     wld_fcallState_t stationsStatsState;  /* Station stats state */
     wld_vapConfigDriver_t driverCfg;      /* Detailed driver config options */
 
-    /* Table of recent station disconnections.
+    /* Bounded log of recent station disconnections, indexed by mac address.
      * Only for stations that were authenticated. Stations that did not get authenticated
-     * will not be added to this list */
-    swl_unLiTable_t staDcList;
+     * will not be added to this log */
+    wld_apDcLog_t staDcLog;
     int32_t historyCnt;
+    wld_ad_staCounters_t staCounters;         /* Aggregate counters of stations of this accesspoint */
 
     wld_nl80211_listener_t* nl80211Listener;  /* nl80211 events listener */
     wld_wpaCtrlInterface_t* wpaCtrlInterface; /* wpaCtrlInterface to hostapd interface */
@@ -2007,6 +2102,26 @@ typedef struct {
     void* data;
 } wld_ad_changeEvent_t;
 
+/*
+ * Coalesced lifecycle changes of a single station, since the previous batch delivery.
+ */
+typedef struct {
+    T_AccessPoint* vap;
+    T_AssociatedDevice* ad;              /* NULL if the station was destroyed in the meantime */
+    swl_macBin_t macAddress;
+    uint32_t changeMask;                 /* bitmask of wld_ad_changeEvent_e seen */
+    wld_ad_changeEvent_e lastChangeType; /* latest change seen */
+    uint32_t nrEvents;                   /* number of change events merged */
+} wld_ad_batchChange_t;
+
+/*
+ * Event delivered on gWld_queue_sta_onBatchChangeEvent: one entry per changed station.
+ */
+typedef struct {
+    uint32_t nrChanges;
+    const wld_ad_batchChange_t* changes;
+} wld_ad_batchChangeEvent_t;
+
 
 typedef enum bs_uplink_type {
     UPLINK_TYPE_UNKNOWN,
@@ -0,0 +1,133 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#ifndef SRC_INCLUDE_WLD_WLD_AP_STADCLOG_H_
+#define SRC_INCLUDE_WLD_WLD_AP_STADCLOG_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <amxc/amxc.h>
+#include <swl/swl_common.h>
+#include <swl/swl_returnCode.h>
+#include <swla/swla_mac.h>
+#include <swla/swla_time_spec.h>
+
+#define WLD_AP_DCLOG_DEFAULT_SIZE 64
+#define WLD_AP_DCLOG_NR_REASON_BUCKETS 16
+#define WLD_AP_DCLOG_NO_IDX (-1)
+
+/**
+ * Single entry of the station disconnection log.
+ * macAddress and dcTime must remain the first fields, as the entry is passed
+ * as data of the disassociation change event.
+ */
+typedef struct {
+    swl_macBin_t macAddress;   /* Mac address of the disconnected station */
+    swl_timeSpecMono_t dcTime; /* Monotonic time of the latest disconnection */
+    uint16_t reason;           /* Deauthentication reason of the latest disconnection */
+    int32_t hashNext;          /* Next entry in the same mac hash bucket */
+    int32_t older;             /* Previous entry in recency order */
+    int32_t newer;             /* Next entry in recency order */
+    int32_t reasonPrev;        /* Previous (newer) entry in the same reason bucket */
+    int32_t reasonNext;        /* Next (older) entry in the same reason bucket */
+} wld_apDcLog_entry_t;
+
+/**
+ * Bounded log of recent station disconnections of an accesspoint.
+ * Entries live in a fixed array of capacity slots, indexed by a mac hash table.
+ * They are chained in recency order, so that the least recently disconnected
+ * station is evicted when the log is full, and per reason bucket, so reason
+ * queries do not need to scan the full log.
+ */
+typedef struct {
+    wld_apDcLog_entry_t* entries;
+    int32_t* hashHeads;
+    uint32_t capacity;
+    uint32_t hashMask;
+    uint32_t count;
+    int32_t oldest;
+    int32_t newest;
+    int32_t reasonHeads[WLD_AP_DCLOG_NR_REASON_BUCKETS];
+} wld_apDcLog_t;
+
+/**
+ * Filter for recent disconnection queries.
+ * maxAgeMs: only return entries that disconnected at most maxAgeMs ago, 0 for no limit.
+ * filterReason: if true, only return entries whose latest reason matches reason.
+ */
+typedef struct {
+    uint32_t maxAgeMs;
+    bool filterReason;
+    uint16_t reason;
+} wld_apDcLog_filter_t;
+
+swl_rc_ne wld_apDcLog_init(wld_apDcLog_t* pLog, uint32_t capacity);
+void wld_apDcLog_destroy(wld_apDcLog_t* pLog);
+swl_rc_ne wld_apDcLog_setCapacity(wld_apDcLog_t* pLog, uint32_t capacity);
+uint32_t wld_apDcLog_getCount(wld_apDcLog_t* pLog);
+
+wld_apDcLog_entry_t* wld_apDcLog_find(wld_apDcLog_t* pLog, const swl_macBin_t* macAddress);
+wld_apDcLog_entry_t* wld_apDcLog_add(wld_apDcLog_t* pLog, const swl_macBin_t* macAddress, uint16_t reason);
+uint32_t wld_apDcLog_getRecent(wld_apDcLog_t* pLog, const wld_apDcLog_filter_t* filter, wld_apDcLog_entry_t** results, uint32_t maxResults);
+void wld_apDcLog_toListOfMaps(wld_apDcLog_t* pLog, amxc_var_t* variant);
+
+#endif /* SRC_INCLUDE_WLD_WLD_AP_STADCLOG_H_ */
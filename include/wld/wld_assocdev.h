@@ -130,6 +130,19 @@ void wld_ad_syncStats(T_AssociatedDevice* pAD);
 bool wld_ad_has_active_video_stations(T_AccessPoint* pAP);
 bool wld_rad_has_active_stations(T_Radio* pRad);
 bool wld_rad_has_active_video_stations(T_Radio* pRad);
+
+void wld_ad_refreshStaCounters(T_AccessPoint* pAP, T_AssociatedDevice* pAD);
+bool wld_ad_checkStaCounters(T_AccessPoint* pAP);
+const wld_ad_staCounters_t* wld_ad_getStaCounters(T_AccessPoint* pAP);
+const wld_ad_staCounters_t* wld_rad_getStaCounters(T_Radio* pRad);
+uint32_t wld_ad_getFarStaCountFromCounters(const wld_ad_staCounters_t* counters, int threshold);
+void wld_ad_setBatchChangeWindow(uint32_t windowMs);
+uint32_t wld_ad_getBatchChangeWindow();
+void wld_ad_flushBatchChanges();
+swl_rc_ne wld_ad_exportStaStats(T_AccessPoint* pAP, uint64_t sinceGeneration, wld_ad_statsSnapshot_t* pSnapshot,
+                                wld_ad_statsRecord_t* records, uint32_t maxRecords);
+swl_rc_ne wld_rad_exportStaStats(T_Radio* pRad, uint64_t sinceGeneration, wld_ad_statsSnapshot_t* pSnapshot,
+                                 wld_ad_statsRecord_t* records, uint32_t maxRecords);
 int32_t wld_ad_getAvgSignalStrengthByChain(T_AssociatedDevice* pAD);
 void wld_ad_printSignalStrengthHistory(T_AssociatedDevice* pAD, char* buf, uint32_t bufSize);
 void wld_ad_printSignalStrengthByChain(T_AssociatedDevice* pAD, char* buf, uint32_t bufSize);
@@ -67,6 +67,7 @@
 #include <stdint.h>
 #include <time.h>
 #include <signal.h>
+#include <swla/swla_time_spec.h>
 
 /* Daemon running state. */
 typedef enum {
@@ -144,6 +145,23 @@ typedef struct {
     wld_dmn_stopHandler stop;         // optional handler to terminate process
 } wld_deamonEvtHandlers;
 
+/*
+ * Number of time-to-ready histogram buckets:
+ * bucket i counts startups ready in less than wld_dmn_readyHistBoundsMs[i],
+ * and the last one counts the slower ones
+ */
+#define WLD_DMN_READY_HIST_SIZE 8
+extern const uint32_t wld_dmn_readyHistBoundsMs[WLD_DMN_READY_HIST_SIZE - 1];
+
+/* Daemon startup readiness statistics. */
+typedef struct {
+    uint32_t nReady;                         /* number of startups confirmed ready */
+    uint32_t nStartupFails;                  /* number of startups ended before being ready */
+    uint32_t lastMs;                         /* time to ready of last startup */
+    uint32_t maxMs;                          /* max time to ready */
+    uint32_t hist[WLD_DMN_READY_HIST_SIZE];  /* time to ready histogram */
+} wld_dmn_readyStats_t;
+
 /* wld daemon context. */
 struct wld_process {
     char* cmd;                         /* Command to run */
@@ -159,6 +177,11 @@ struct wld_process {
     uint32_t totalRestarts;            /* Total amount of restarts since first time daemon is set to enabled */
     time_t failDate;                   /* Indicates the last time daemon has been started */
     bool forceKill;                    /* Force -9 option when terminating, as done by some ref software */
+    swl_timeSpecMono_t startTime;      /* Mono time of last process start */
+    bool isReady;                      /* Indicates if started process is confirmed usable (ie. ctrl iface answering) */
+    uint32_t startupFails;             /* Amount of consecutive startups failed before being ready */
+    bool crashLoop;                    /* Indicates that startups keep failing: daemon not usable */
+    wld_dmn_readyStats_t readyStats;   /* Startup readiness statistics */
 
     amxp_proc_ctrl_t* process;         /* Process information struct */
     amxp_timer_t* restart_timer;       /* used when a daemon need to be restarted */
@@ -174,9 +197,15 @@ typedef struct {
     bool enableParam;
     int32_t instantRestartLimit;
     uint32_t minRestartInterval;
+    bool supervise;                    /* supervisor mode: restart is successful only once process is set ready (crashes once ready keep the instant restart limit) */
+    uint32_t backoffInitMs;            /* supervisor mode: restart delay after a first failed startup */
+    uint32_t backoffMaxMs;             /* supervisor mode: max restart delay, for consecutive failed startups */
+    uint32_t crashLoopLimit;           /* supervisor mode: consecutive failed startups to flag crash loop */
 } wld_daemonMonitorConf_t;
 
 void wld_dmn_setMonitorConf(wld_daemonMonitorConf_t* pDmnMoniConf);
+uint32_t wld_dmn_getStartupBackoffMs(const wld_daemonMonitorConf_t* pDmnMoniConf, uint32_t nStartupFails);
+uint32_t wld_dmn_getCrashRestartDelayMs(const wld_daemonMonitorConf_t* pDmnMoniConf, uint32_t nCrashes, double elapsedSec);
 
 /**
  * Create and initialize a daemonMonitor object.
@@ -210,6 +239,13 @@ bool wld_dmn_isRunning(wld_process_t* process);
 bool wld_dmn_isEnabled(wld_process_t* process);
 bool wld_dmn_isRestarting(wld_process_t* process);
 
+/* Startup readiness supervision. */
+void wld_dmn_setReady(wld_process_t* process);
+bool wld_dmn_isReady(wld_process_t* process);
+bool wld_dmn_isCrashLooping(wld_process_t* process);
+const wld_dmn_readyStats_t* wld_dmn_getReadyStats(wld_process_t* process);
+void wld_dmn_debug(wld_process_t* process, amxc_var_t* retMap);
+
 /* init or reinit the daemon arg list , before starting/restarting it. */
 void wld_dmn_setArgList(wld_process_t* process, char* args);
 
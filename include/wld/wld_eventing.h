@@ -66,6 +66,7 @@
 
 
 
+#include <stdbool.h>
 #include <amxc/amxc.h>
 #include <amxp/amxp.h>
 #include <amxd/amxd_parameter.h>
@@ -113,6 +114,7 @@ extern wld_event_queue_t* gWld_queue_rad_onChangeEvent;
 extern wld_event_queue_t* gWld_queue_rad_onFrameEvent;
 
 extern wld_event_queue_t* gWld_queue_sta_onChangeEvent;
+extern wld_event_queue_t* gWld_queue_sta_onBatchChangeEvent;
 
 extern wld_event_queue_t* gWld_queue_lifecycleEvent;
 extern wld_event_queue_t* gWld_queue_wdsInterface;
@@ -123,6 +125,7 @@ extern wld_event_queue_t* gWld_queue_mld_onChangeEvent;
 void wld_event_add_callback(wld_event_queue_t* queue, wld_event_callback_t* callback);
 void wld_event_remove_callback(wld_event_queue_t* queue, wld_event_callback_t* callback);
 void wld_event_trigger_callback(wld_event_queue_t* queue, const void* data);
+bool wld_event_hasSubscribers(wld_event_queue_t* queue);
 
 
 void wld_event_init();
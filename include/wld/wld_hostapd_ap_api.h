@@ -77,11 +77,27 @@ typedef enum {
     SECDMN_ACTION_OK_NEED_RESTART
 } wld_secDmn_action_rc_ne;
 
+/*
+ * minimal action plan applying a config params delta
+ */
+typedef struct {
+    wld_secDmn_action_rc_ne action;                                  /* cheapest action applying all changes */
+    uint32_t nChanged;                                               /* number of added/modified/removed params */
+    uint32_t nParamsByAction[SECDMN_ACTION_OK_NEED_RESTART + 1];     /* number of changed params per required action */
+} wld_ap_hostapd_cfgDeltaPlan_t;
+
 bool wld_ap_hostapd_setParamValue(T_AccessPoint* pAP, const char* field, const char* value, const char* reason);
 bool wld_ap_hostapd_sendCommand(T_AccessPoint* pAP, char* cmd, const char* reason);
+void wld_ap_hostapd_queueCommand(T_AccessPoint* pAP, char* cmd, const char* reason);
+bool wld_ap_hostapd_queueParamValue(T_AccessPoint* pAP, const char* field, const char* value, const char* reason);
 swl_rc_ne wld_ap_hostapd_getParamAction(wld_secDmn_action_rc_ne* pOutMappedAction, const char* paramName);
 swl_rc_ne wld_ap_hostapd_setParamAction(const char* paramName, wld_secDmn_action_rc_ne inMappedAction);
+wld_secDmn_action_rc_ne wld_ap_hostapd_classifyParamChange(const char* paramName, const char* oldValue, const char* newValue);
+wld_secDmn_action_rc_ne wld_ap_hostapd_classifyParamsDelta(swl_mapChar_t* pCurrParams, swl_mapChar_t* pNewParams, wld_ap_hostapd_cfgDeltaPlan_t* pPlan);
+bool wld_ap_hostapd_isNoSecSyncParam(const char* paramName);
+wld_secDmn_action_rc_ne wld_ap_hostapd_classifyNoSecParamsDelta(swl_mapChar_t* pCurrParams, swl_mapChar_t* pNewParams, wld_ap_hostapd_cfgDeltaPlan_t* pPlan);
 bool wld_ap_hostapd_updateBeacon(T_AccessPoint* pAP, const char* reason);
+void wld_ap_hostapd_queueUpdateBeacon(T_AccessPoint* pAP, const char* reason);
 bool wld_ap_hostapd_reloadSecKey(T_AccessPoint* pAP, const char* reason);
 swl_rc_ne wld_ap_hostapd_setNeighbor(T_AccessPoint* pAP, T_ApNeighbour* pApNeighbor);
 swl_rc_ne wld_ap_hostapd_removeNeighbor(T_AccessPoint* pAP, T_ApNeighbour* pApNeighbor);
@@ -145,8 +161,8 @@ swl_rc_ne wld_ap_hostapd_requestRRMReport(T_AccessPoint* pAP, const swl_macChar_
                                           uint16_t randomInterval, uint16_t measurementDuration, uint8_t measurementMode, const swl_macChar_t* bssid, const char* ssid);
 swl_rc_ne wld_ap_hostapd_requestRRMReport_ext(T_AccessPoint* pAP, const swl_macChar_t* sta, wld_rrmReq_t* req);
 
-swl_trl_e wld_hostapd_ap_getCfgParamSupp(T_AccessPoint* pAP, const char* param);
-swl_rc_ne wld_hostapd_ap_sendCfgParam(T_AccessPoint* pAP, const char* param, const char* value);
+swl_trl_e wld_hostapd_ap_getCfgParamSupp(T_AccessPoint* pAP, wld_secDmn_cfgParamId_t paramId);
+swl_rc_ne wld_hostapd_ap_sendCfgParam(T_AccessPoint* pAP, wld_secDmn_cfgParamId_t paramId, const char* value);
 bool wld_hostapd_ap_needWpaCtrlIface(T_AccessPoint* pAP);
 
 const char* wld_hostapd_ap_selectApLinkIface(T_AccessPoint* pAP);
@@ -68,6 +68,10 @@
 void wld_hostapd_cfgFile_create(T_Radio* pRad, char* cfgFileName);
 void wld_hostapd_cfgFile_createExt(T_Radio* pRad);
 bool wld_hostapd_cfgFile_update(char* configPath, const char* interface, const char* key, const char* value);
+bool wld_hostapd_cfgFile_stageUpdate(char* configPath, const char* interface, const char* key, const char* value);
+bool wld_hostapd_cfgFile_commitUpdates(char* configPath);
+bool wld_hostapd_cfgFile_stageRadUpdate(T_Radio* pRad, const char* interface, const char* key, const char* value);
+bool wld_hostapd_cfgFile_commitRadUpdates(T_Radio* pRad);
 void wld_hostapd_cfgFile_setRadioConfig(T_Radio* pRad, swl_mapChar_t* radConfigMap);
 void wld_hostapd_cfgFile_setVapConfig(T_AccessPoint* pAP, swl_mapChar_t* vapConfigMap, swl_mapChar_t* multiAPConfig);
 swl_rc_ne wld_hostapd_cfgFile_genConfigHash(char** pHashStr, swl_mapChar_t* configMap);
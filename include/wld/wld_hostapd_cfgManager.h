@@ -71,6 +71,15 @@ typedef struct wld_hostapdVapInfo wld_hostapdVapInfo_t;
 struct wld_hostapd_config;
 typedef struct wld_hostapd_config wld_hostapd_config_t;
 
+/*
+ * scope of config changes, ordered from the least to the most impacting
+ */
+typedef enum {
+    WLD_HOSTAPD_CFG_CHANGE_NONE,    /* config unchanged */
+    WLD_HOSTAPD_CFG_CHANGE_BSS,     /* only some interface/bss sections changed */
+    WLD_HOSTAPD_CFG_CHANGE_FULL,    /* general section, or the list of bss changed */
+} wld_hostapd_cfgChange_e;
+
 bool wld_hostapd_loadConfig(wld_hostapd_config_t** conf, char* path);
 bool wld_hostapd_createConfig(wld_hostapd_config_t** conf, T_Radio* pRad);
 bool wld_hostapd_deleteConfig(wld_hostapd_config_t* conf);
@@ -81,5 +90,16 @@ swl_mapChar_t* wld_hostapd_getConfigMap(wld_hostapd_config_t* conf, char* bssNam
 const char* wld_hostapd_getConfigParamValStr(wld_hostapd_config_t* conf, char* bssName, const char* key);
 swl_mapChar_t* wld_hostapd_getConfigMapByBssid(wld_hostapd_config_t* conf, swl_macBin_t* bssid);
 const char* wld_hostapd_getConfigParamByBssidValStr(wld_hostapd_config_t* conf, swl_macBin_t* bssid, const char* key);
+uint64_t wld_hostapd_getMapFingerprint(swl_mapChar_t* configMap);
+uint64_t wld_hostapd_getConfigFingerprint(wld_hostapd_config_t* conf, const char* bssName);
+wld_hostapd_cfgChange_e wld_hostapd_diffConfigSnapshot(const wld_hostapd_cfgSnapshot_t* pSnapshot, wld_hostapd_config_t* conf, const char* path);
+bool wld_hostapd_isConfigSectionChanged(wld_hostapd_config_t* conf, const char* bssName);
+bool wld_hostapd_saveConfigSnapshot(wld_hostapd_cfgSnapshot_t** ppSnapshot, wld_hostapd_config_t* conf, wld_hostapd_cfgChange_e change, const char* path);
+bool wld_hostapd_updateConfigSnapshotParam(wld_hostapd_cfgSnapshot_t* pSnapshot, const char* bssName, const char* key, const char* oldValue, const char* newValue);
+void wld_hostapd_updateConfigSnapshotFileStat(wld_hostapd_cfgSnapshot_t* pSnapshot, const char* path);
+void wld_hostapd_deleteConfigSnapshot(wld_hostapd_cfgSnapshot_t** ppSnapshot);
+wld_hostapd_cfgChange_e wld_hostapd_getConfigSnapshotPendingChange(const wld_hostapd_cfgSnapshot_t* pSnapshot);
+bool wld_hostapd_isConfigSnapshotBssPending(const wld_hostapd_cfgSnapshot_t* pSnapshot, const char* bssName);
+void wld_hostapd_setConfigSnapshotPendingChange(wld_hostapd_cfgSnapshot_t* pSnapshot, wld_hostapd_cfgChange_e change);
 
 #endif /* __WLD_HOSTAPD_CFG_MANAGER_H__ */
@@ -72,6 +72,7 @@
 #include "wld_nl80211_compat.h"
 #include "swl/swl_common.h"
 #include "swl/swl_common_chanspec.h"
+#include "swl/swl_common_mcs.h"
 
 /*
  * @brief macro to get nl attribute typed value, when it is found
@@ -148,6 +149,35 @@ int32_t wld_nl80211_bwSwlToNl(swl_bandwidth_e swlBw);
  */
 uint32_t wld_nl80211_bwNlToVal(uint32_t nl80211Bw);
 
+/*
+ * station rate info bandwidth flags
+ */
+#define WLD_NL80211_RATE_BW_F_5   (1 << 0) /* NL80211_RATE_INFO_5_MHZ_WIDTH */
+#define WLD_NL80211_RATE_BW_F_10  (1 << 1) /* NL80211_RATE_INFO_10_MHZ_WIDTH */
+#define WLD_NL80211_RATE_BW_F_40  (1 << 2) /* NL80211_RATE_INFO_40_MHZ_WIDTH */
+#define WLD_NL80211_RATE_BW_F_80  (1 << 3) /* NL80211_RATE_INFO_80_MHZ_WIDTH */
+#define WLD_NL80211_RATE_BW_F_160 (1 << 4) /* NL80211_RATE_INFO_160_MHZ_WIDTH or NL80211_RATE_INFO_80P80_MHZ_WIDTH */
+#define WLD_NL80211_RATE_BW_F_ALL ((1 << 5) - 1)
+
+/*
+ * @brief convert mask of rate info bandwidth flags into swl bandwidth enum ID
+ *
+ * @param bwFlags mask of WLD_NL80211_RATE_BW_F_xxx
+ *
+ * @return swl bandwidth of the widest flag, SWL_BW_20MHZ if none
+ */
+swl_bandwidth_e wld_nl80211_rateBwFlagsToSwl(uint32_t bwFlags);
+
+/*
+ * @brief convert HE/EHT rate info guard interval into swl guard interval enum ID
+ *
+ * @param nlGi NL80211_RATE_INFO_HE_GI_xxx or NL80211_RATE_INFO_EHT_GI_xxx value
+ * @param defaultGi value returned when nlGi is unknown
+ *
+ * @return swl guard interval
+ */
+swl_guardinterval_e wld_nl80211_rateHeGiToSwl(uint8_t nlGi, swl_guardinterval_e defaultGi);
+
 /*
  * @brief convert channel bandwidth value in MHz into NL80211_CHAN_WIDTH_xxx
  *
@@ -74,10 +74,11 @@ swl_rc_ne wld_rad_hostapd_reload(T_Radio* pR);
 swl_rc_ne wld_rad_hostapd_reconfigure(T_Radio* pR);
 swl_rc_ne wld_rad_hostapd_enable(T_Radio* pR);
 swl_rc_ne wld_rad_hostapd_disable(T_Radio* pR);
-swl_trl_e wld_rad_hostapd_getCfgParamSupp(T_Radio* pRad, const char* param);
+swl_trl_e wld_rad_hostapd_getCfgParamSupp(T_Radio* pRad, wld_secDmn_cfgParamId_t paramId);
 T_AccessPoint* wld_rad_hostapd_getFirstConnectedVap(T_Radio* pRad);
 T_AccessPoint* wld_rad_hostapd_getCfgMainVap(T_Radio* pRad);
 T_AccessPoint* wld_rad_hostapd_getRunMainVap(T_Radio* pRad);
+swl_rc_ne wld_rad_hostapd_getCachedCmdReplyParamStr(T_Radio* pRad, const char* cmd, const char* key, uint32_t maxAgeMs, char* valStr, size_t valStrSize);
 swl_rc_ne wld_rad_hostapd_getCmdReplyParamStr(T_Radio* pRad, const char* cmd, const char* key, char* valStr, size_t valStrSize);
 int32_t wld_rad_hostapd_getCmdReplyParam32Def(T_Radio* pRad, const char* cmd, const char* key, int32_t defVal);
 swl_rc_ne wld_rad_hostapd_getCfgParamStr(T_Radio* pRad, const char* key, char* valStr, size_t valStrSize);
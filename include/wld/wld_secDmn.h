@@ -75,30 +75,65 @@ typedef void (* wld_secDmn_onStartHandler)(wld_secDmn_t* pSecDmn, void* userdata
 typedef char* (* wld_secDmn_getArgsHandler)(wld_secDmn_t* pSecDmn, void* userdata);
 typedef bool (* wld_secDmn_stopHandler)(wld_secDmn_t* pSecDmn, void* userdata);
 typedef void (* wld_secDmn_writeCfgHandler)(wld_secDmn_t* pSecDmn, void* userdata);
+typedef void (* wld_secDmn_cfgParamSuppHandler)(wld_secDmn_t* pSecDmn, void* userdata);
+
+typedef struct wld_secDmn_cfgParamProbe wld_secDmn_cfgParamProbe_t;
+
+/*
+ * config param names are interned into compact ids, shared by all secDmns,
+ * so that param support checks are done with bit tests
+ */
+#define WLD_SECDMN_CFG_PARAM_ID_MAX 64
+#define WLD_SECDMN_CFG_PARAM_ID_INVALID -1
+typedef int32_t wld_secDmn_cfgParamId_t;
+
+/*
+ * config params checked when generating config:
+ * interned first, so that their ids are static
+ */
+typedef enum {
+    WLD_SECDMN_CFG_PARAM_RNR,
+    WLD_SECDMN_CFG_PARAM_CONFIG_ID,
+    WLD_SECDMN_CFG_PARAM_KNOWN_MAX
+} wld_secDmn_cfgParamKnown_e;
+
+/*
+ * config params support as two bit-planes, indexed by param id:
+ * a param that is in none of them has unknown support
+ */
+typedef struct {
+    uint64_t supp;   /* params known as supported */
+    uint64_t unsupp; /* params known as not supported */
+} wld_secDmn_cfgParamSuppMap_t;
 
 typedef struct {
-    wld_secDmn_restartHandler restartCb;   // optional handler to manage security daemon restarting
-    wld_secDmn_onStopHandler stopCb;       // optional handler to get notification for security daemon process end
-    wld_secDmn_onStartHandler startCb;     // optional handler post-startup
-    wld_secDmn_getArgsHandler getArgs;     // optional handler to provide security daemon arguments on startup
-    wld_secDmn_stopHandler stop;           // optional handler to terminate security daemon
-    wld_secDmn_writeCfgHandler writeCfgCb; // optional handler to write the config file of the security daemon
+    wld_secDmn_restartHandler restartCb;           // optional handler to manage security daemon restarting
+    wld_secDmn_onStopHandler stopCb;               // optional handler to get notification for security daemon process end
+    wld_secDmn_onStartHandler startCb;             // optional handler post-startup
+    wld_secDmn_getArgsHandler getArgs;             // optional handler to provide security daemon arguments on startup
+    wld_secDmn_stopHandler stop;                   // optional handler to terminate security daemon
+    wld_secDmn_writeCfgHandler writeCfgCb;         // optional handler to write the config file of the security daemon
+    wld_secDmn_cfgParamSuppHandler cfgParamSuppCb; // optional handler notified when config params support got learned
 } wld_secDmnEvtHandlers;
 
 struct wld_secDmn {
-    wld_wpaCtrlMngr_t* wpaCtrlMngr; /* wpaCtrlMngr */
-    wld_process_t* dmnProcess;      /* daemon process context: pointing to either self proc or group proc */
-    char* cfgFile;                  /* config file path*/
-    char* ctrlIfaceDir;             /* ctrl_interface directory: /var/run/xxx/*/
-    wld_secDmnEvtHandlers handlers; /* optional handlers of secDmn events*/
-    void* userData;                 /* optional user data available in restart handler. */
-    swl_mapCharInt32_t cfgParamSup; /* list of dynamically checked config parameters support */
-    swl_mapCharInt32_t cmdSup;      /* list of dynamically checked command support */
+    wld_wpaCtrlMngr_t* wpaCtrlMngr;               /* wpaCtrlMngr */
+    wld_process_t* dmnProcess;                    /* daemon process context: pointing to either self proc or group proc */
+    char* cfgFile;                                /* config file path*/
+    char* ctrlIfaceDir;                           /* ctrl_interface directory: /var/run/xxx/*/
+    wld_secDmnEvtHandlers handlers;               /* optional handlers of secDmn events*/
+    void* userData;                               /* optional user data available in restart handler. */
+    swl_mapCharInt32_t cfgParamSup;               /* list of dynamically checked config parameters support */
+    wld_secDmn_cfgParamSuppMap_t cfgParamSuppMap; /* bitmap of config parameters support, indexed by interned param id */
+    swl_mapCharInt32_t cmdSup;                    /* list of dynamically checked command support */
+    swl_mapCharInt32_t cfgParamProbed;            /* config parameters found supported by probing the daemon binary */
+    swl_mapChar_t cfgParamRejected;               /* config parameters values found rejected by probing the daemon binary */
 
     /* private: self//group process management */
-    wld_process_t* selfDmnProcess;  /* self daemon process context. */
-    wld_secDmnGrp_t* secDmnGroup;   /* grouped (/global) secDmn using one daemon process for multiple wpaCtrl mngrs */
-    bool needRestart;               /* flag indicating whether dmn process need a forced restart */
+    wld_process_t* selfDmnProcess;                /* self daemon process context. */
+    wld_secDmnGrp_t* secDmnGroup;                 /* grouped (/global) secDmn using one daemon process for multiple wpaCtrl mngrs */
+    bool needRestart;                             /* flag indicating whether dmn process need a forced restart */
+    wld_secDmn_cfgParamProbe_t* cfgParamProbe;    /* pending asynchronous probing of config params support */
 };
 
 swl_rc_ne wld_secDmn_init(wld_secDmn_t** ppSecDmn, char* cmd, char* startArgs, char* cfgFile, char* ctrlIfaceDir);
@@ -116,13 +151,25 @@ bool wld_secDmn_isRestarting(wld_secDmn_t* pSecDmn);
 bool wld_secDmn_isRunning(wld_secDmn_t* pSecDmn);
 bool wld_secDmn_isEnabled(wld_secDmn_t* pSecDmn);
 bool wld_secDmn_isAlive(wld_secDmn_t* pSecDmn);
+bool wld_secDmn_isCrashLooping(wld_secDmn_t* pSecDmn);
+swl_rc_ne wld_secDmn_checkReady(wld_secDmn_t* pSecDmn);
 bool wld_secDmn_hasAvailableCtrlIface(wld_secDmn_t* pSecDmn);
 wld_wpaCtrlMngr_t* wld_secDmn_getWpaCtrlMgr(wld_secDmn_t* pSecDmn);
 bool wld_secDmn_setCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param, swl_trl_e supp);
 swl_trl_e wld_secDmn_getCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param);
+wld_secDmn_cfgParamId_t wld_secDmn_getCfgParamId(const char* param);
+const char* wld_secDmn_getCfgParamName(wld_secDmn_cfgParamId_t paramId);
+swl_trl_e wld_secDmn_getCfgParamSuppById(wld_secDmn_t* pSecDmn, wld_secDmn_cfgParamId_t paramId);
+bool wld_secDmn_setCfgParamSuppById(wld_secDmn_t* pSecDmn, wld_secDmn_cfgParamId_t paramId, swl_trl_e supp);
 uint32_t wld_secDmn_countCfgParamSuppAll(wld_secDmn_t* pSecDmn);
 uint32_t wld_secDmn_countCfgParamSuppChecked(wld_secDmn_t* pSecDmn);
 uint32_t wld_secDmn_countCfgParamSuppByVal(wld_secDmn_t* pSecDmn, swl_trl_e supp);
+swl_rc_ne wld_secDmn_probeCfgParamSupp(wld_secDmn_t* pSecDmn, wld_wpaCtrlInterface_t* pIface, const char* param, const char* valStr);
+bool wld_secDmn_isProbingCfgParamSupp(wld_secDmn_t* pSecDmn);
+swl_rc_ne wld_secDmn_loadCfgParamSuppProfile(wld_secDmn_t* pSecDmn);
+swl_rc_ne wld_secDmn_saveCfgParamSuppProfile(wld_secDmn_t* pSecDmn);
+swl_rc_ne wld_secDmn_setCfgParamProfileDir(const char* dirPath);
+const char* wld_secDmn_getCfgParamProfileDir();
 const char* wld_secDmn_getCtrlIfaceDirPath(wld_secDmn_t* pSecDmn);
 bool wld_secDmn_setCmdSupp(wld_secDmn_t* pSecDmn, const char* cmd, swl_trl_e supp);
 swl_trl_e wld_secDmn_getCmdSupp(wld_secDmn_t* pSecDmn, const char* cmd);
@@ -94,18 +94,44 @@ typedef bool (* wld_secDmnGrp_isMemberStartable)(wld_secDmnGrp_t* pSecDmnGrp, vo
  */
 typedef bool (* wld_secDmnGrp_hasMemberRtmAction)(wld_secDmnGrp_t* pSecDmnGrp, void* userData, wld_secDmn_t* pMember);
 
+/*
+ * @brief handler to attach/detach a member to/from the running group process,
+ * without restarting it (eg. through the daemon global control interface)
+ * @param pSecDmnGrp pointer to group context
+ * @param userData user data provided at initialization
+ * @param pMember group member (pointer to sec deamon context)
+ * @return SWL_RC_OK when member is attached/detached, error code otherwise
+ */
+typedef swl_rc_ne (* wld_secDmnGrp_memberCtrlHandler)(wld_secDmnGrp_t* pSecDmnGrp, void* userData, wld_secDmn_t* pMember);
+
 typedef struct {
     wld_secDmnGrp_getArgsHandler getArgsCb;               /* handler to build dynamically arguments before starting daemon */
     wld_secDmnGrp_isMemberStartable isMemberStartableCb;  /* handler to pre-check starting conditions of group member */
     wld_secDmnGrp_hasMemberRtmAction hasSchedRestartCb;   /* handler to check whether member is pending for restart. */
+    wld_secDmnGrp_memberCtrlHandler addMemberCb;          /* handler to attach member to running process (warm standby mode) */
+    wld_secDmnGrp_memberCtrlHandler removeMemberCb;       /* handler to detach member from running process (warm standby mode) */
 } wld_secDmnGrp_EvtHandlers_t;
 
+/*
+ * @brief statistics of runtime actions (reload/restart) requested by a group member,
+ * and applied once for all the group members
+ */
+typedef struct {
+    uint32_t nApplied;                                    /* number of member requests satisfied by an applied action */
+    uint32_t nMerged;                                     /* number of member requests merged into an already pending one */
+    uint32_t lastLatencyMs;                               /* delay between member request and action apply, for last request */
+    uint32_t maxLatencyMs;                                /* max request-to-apply delay */
+    uint64_t totalLatencyMs;                              /* cumulated request-to-apply delay (to compute average) */
+} wld_secDmnGrp_rtmActionStats_t;
+
 swl_rc_ne wld_secDmnGrp_init(wld_secDmnGrp_t** ppSecDmnGrp, char* cmd, char* startArgs, const char* groupName);
 swl_rc_ne wld_secDmnGrp_cleanup(wld_secDmnGrp_t** ppSecDmn);
 swl_rc_ne wld_secDmnGrp_setEvtHandlers(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_EvtHandlers_t* pHandlers, void* userData);
 bool wld_secDmnGrp_isEnabled(wld_secDmnGrp_t* pSecDmnGrp);
 bool wld_secDmnGrp_isRunning(wld_secDmnGrp_t* pSecDmnGrp);
 wld_process_t* wld_secDmnGrp_getProc(wld_secDmnGrp_t* pSecDmnGrp);
+swl_rc_ne wld_secDmnGrp_setWarmStandby(wld_secDmnGrp_t* pSecDmnGrp, bool enable);
+bool wld_secDmnGrp_isWarmStandby(wld_secDmnGrp_t* pSecDmnGrp);
 
 /*
  * In order to add/del members to group, secDmn APIs must be used
@@ -116,7 +142,11 @@ uint32_t wld_secDmnGrp_getActiveMembersCount(wld_secDmnGrp_t* pSecDmnGrp);
 const wld_secDmn_t* wld_secDmnGrp_getMemberByPos(wld_secDmnGrp_t* pSecDmnGrp, int32_t pos);
 const wld_secDmn_t* wld_secDmnGrp_getMemberByName(wld_secDmnGrp_t* pSecDmnGrp, const char* name);
 bool wld_secDmnGrp_hasMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
+bool wld_secDmnGrp_isMemberStarted(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
+bool wld_secDmnGrp_isMemberAttached(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
 swl_rc_ne wld_secDmnGrp_setMemberStartable(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn, bool isStartable);
 swl_rc_ne wld_secDmnGrp_dropMembers(wld_secDmnGrp_t* pSecDmnGrp);
+swl_rc_ne wld_secDmnGrp_getMemberRtmActionStats(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn, wld_secDmnGrp_rtmActionStats_t* pStats);
+uint32_t wld_secDmnGrp_getRtmActionExecCount(wld_secDmnGrp_t* pSecDmnGrp);
 
 #endif /* INCLUDE_WLD_WLD_SECDMNGRP_H_ */
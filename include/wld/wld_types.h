@@ -78,6 +78,7 @@ typedef struct vendor vendor_t;
 typedef struct wld_tinyRoam wld_tinyRoam_t;
 typedef struct wld_mldMgr wld_mldMgr_t;
 typedef struct wld_mldLink wld_mldLink_t;
+typedef struct wld_hostapd_cfgSnapshot wld_hostapd_cfgSnapshot_t;
 
 /*
  * Deprecated types with old syntax T_xxx , only defined for backward compatibility with legacy code
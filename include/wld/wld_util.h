@@ -412,6 +412,29 @@ wld_spectrumChannelInfoEntry_t* wld_util_getSpectrumEntryByChannel(amxc_llist_t*
  */
 wld_spectrumChannelInfoEntry_t* wld_util_addorUpdateSpectrumEntry(amxc_llist_t* llSpectrumChannelInfo, wld_spectrumChannelInfoEntry_t* pData);
 
+#define WLD_UTIL_FNV32_OFFSET_BASIS 2166136261U
+#define WLD_UTIL_FNV64_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+/**
+ * @brief update a 32-bit FNV-1a hash with a chunk of data
+ *
+ * @param hash the current hash, WLD_UTIL_FNV32_OFFSET_BASIS to start a new one
+ * @param pData the data to hash
+ * @param len the data length
+ * @return the updated hash
+ */
+uint32_t wld_util_fnv32Update(uint32_t hash, const void* pData, size_t len);
+
+/**
+ * @brief update a 64-bit FNV-1a hash with a chunk of data
+ *
+ * @param hash the current hash, WLD_UTIL_FNV64_OFFSET_BASIS to start a new one
+ * @param pData the data to hash
+ * @param len the data length
+ * @return the updated hash
+ */
+uint64_t wld_util_fnv64Update(uint64_t hash, const void* pData, size_t len);
+
 #ifdef __cplusplus
 }/* extern "C" */
 #endif
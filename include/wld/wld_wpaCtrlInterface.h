@@ -65,6 +65,8 @@
 
 #include "wld_wpaCtrl_types.h"
 #include "wld_wpaCtrl_events.h"
+#include "wld_wpaCtrl_api.h"
+#include "wld_wpaCtrl_evtPolicy.h"
 
 bool wld_wpaCtrlInterface_init(wld_wpaCtrlInterface_t** ppIface, char* interfaceName, char* serverPath);
 bool wld_wpaCtrlInterface_initWithSockName(wld_wpaCtrlInterface_t** ppIface, char* interfaceName, const char* serverPath, const char* sockName);
@@ -84,6 +86,8 @@ bool wld_wpaCtrlInterface_isEnabled(const wld_wpaCtrlInterface_t* pIface);
 const char* wld_wpaCtrlInterface_getConnectionDirPath(const wld_wpaCtrlInterface_t* pIface);
 bool wld_wpaCtrlInterface_checkConnectionPath(const wld_wpaCtrlInterface_t* pIface);
 const char* wld_wpaCtrlInterface_getConnectionSockName(const wld_wpaCtrlInterface_t* pIface);
+bool wld_wpaCtrlInterface_getEvtRxStats(const wld_wpaCtrlInterface_t* pIface, wld_wpaCtrl_rxStats_t* pStats);
+bool wld_wpaCtrlInterface_getEvtClassStats(const wld_wpaCtrlInterface_t* pIface, wld_wpaCtrl_evtClass_e evtClass, wld_wpaCtrl_evtClassStats_t* pStats);
 
 #define CALL_INTF_EXT(pIntf, fName, ...) \
     { \
@@ -66,17 +66,72 @@
 #include "wld_wpaCtrl_types.h"
 #include "swl/swl_common.h"
 
+/*
+ * @brief handler called when an asynchronous wpa_ctrl command is completed
+ *
+ * @param userData user data provided when sending the command
+ * @param cmd the sent command
+ * @param rc SWL_RC_OK when the command is answered,
+ *           SWL_RC_NOT_AVAILABLE when the reply was not received in time,
+ *           SWL_RC_INVALID_STATE when the connection was closed before getting the reply,
+ *           SWL_RC_ERROR when the command could not be sent
+ * @param reply the received reply (without trailing new line), NULL when rc is not SWL_RC_OK
+ */
+typedef void (* wld_wpaCtrl_cmdDoneCb_f)(void* userData, const char* cmd, swl_rc_ne rc, const char* reply);
+
+/*
+ * @brief handler called once all commands of a batch are answered, failed or timed out
+ *
+ * @param userData user data given when ending the batch
+ * @param ifName name of the wpa_ctrl interface where the batch was sent
+ * @param nrCmds number of commands sent in the batch
+ * @param nrFailed number of commands failed, timed out, or not answered as expected
+ *                 (commands dropped because the connection was closed are not counted)
+ */
+typedef void (* wld_wpaCtrl_cmdBatchDoneCb_f)(void* userData, const char* ifName, uint32_t nrCmds, uint32_t nrFailed);
+
+/*
+ * max age value accepting a cached reply, as long as not made stale by an event
+ */
+#define WLD_WPACTRL_MAX_AGE_UNLIMITED UINT32_MAX
+
+/*
+ * wpa_ctrl socket reception counters
+ */
+typedef struct {
+    uint32_t nrWakeups;         // number of socket read wakeups
+    uint64_t nrMsgs;            // number of received messages
+    uint32_t lastMsgsPerWakeup; // number of messages read at last wakeup
+    uint32_t maxMsgsPerWakeup;  // max number of messages read in one wakeup (max backlog)
+    uint32_t nrBudgetExhausted; // number of wakeups leaving messages pending after reading the max per wakeup
+} wld_wpaCtrl_rxStats_t;
+
 bool wld_wpaCtrl_sendCmd(wld_wpaCtrlInterface_t* pIface, const char* cmd);
+swl_rc_ne wld_wpaCtrl_sendCmdAsync(wld_wpaCtrlInterface_t* pIface, const char* cmd, uint32_t tmOutMSec, wld_wpaCtrl_cmdDoneCb_f fDoneCb, void* userData);
 bool wld_wpaCtrl_sendCmdSynced(wld_wpaCtrlInterface_t* pIface, const char* cmd, char* reply, size_t replyLen);
+swl_rc_ne wld_wpaCtrl_startCmdBatch(wld_wpaCtrlInterface_t* pIface);
+bool wld_wpaCtrl_isCmdBatchOpen(const wld_wpaCtrlInterface_t* pIface);
+swl_rc_ne wld_wpaCtrl_batchCmdCheckResponse(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* expectedResponse);
+swl_rc_ne wld_wpaCtrl_endCmdBatch(wld_wpaCtrlInterface_t* pIface, wld_wpaCtrl_cmdBatchDoneCb_f fDoneCb, void* userData);
+swl_rc_ne wld_wpaCtrl_waitPendingCmds(wld_wpaCtrlInterface_t* pIface);
 bool wld_wpaCtrl_sendCmdCheckResponse(wld_wpaCtrlInterface_t* pIface, char* cmd, char* expectedResponse);
 bool wld_wpaCtrl_sendCmdCheckResponseExt(wld_wpaCtrlInterface_t* pIface, char* cmd, char* expectedResponse, uint32_t tmOutMSec);
 swl_rc_ne wld_wpaCtrl_sendCmdFmtCheckResponse(wld_wpaCtrlInterface_t* pIface, char* expectedResponse, const char* cmdFormat, ...);
 swl_rc_ne wld_wpaCtrl_getSyncCmdParamVal(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, char* valStr, size_t valStrSize);
 swl_rc_ne wld_wpaCtrl_getSyncCmdParamValInt32Def(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, int32_t* pRetVal, int32_t defVal);
+swl_rc_ne wld_wpaCtrl_getCachedCmdParamVal(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, uint32_t maxAgeMs, char* valStr, size_t valStrSize);
+swl_rc_ne wld_wpaCtrl_getCachedCmdParamValInt32Def(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, uint32_t maxAgeMs, int32_t* pRetVal, int32_t defVal);
+swl_rc_ne wld_wpaCtrl_refreshCmdSnapshot(wld_wpaCtrlInterface_t* pIface, const char* cmd);
+void wld_wpaCtrl_invalidateCmdSnapshots(wld_wpaCtrlInterface_t* pIface);
 void wld_wpaCtrl_processMsg(wld_wpaCtrlInterface_t* pInterface, char* msgData, size_t len);
 bool wld_wpaCtrl_checkSockPath(const char* sockPath);
 swl_rc_ne wld_wpaCtrl_queryToSock(const char* serverPath, const char* sockName, const char* cmd, char* reply, size_t replyLen);
+void wld_wpaCtrl_flushConnPool(const char* serverPath);
+uint32_t wld_wpaCtrl_getConnPoolSize(const char* serverPath);
+swl_rc_ne wld_wpaCtrl_setConnPoolIdleTmout(uint32_t idleTmoutMs);
 size_t wld_wpaCtrl_getMaxMsgLen();
 swl_rc_ne wld_wpaCtrl_setMaxMsgLen(size_t msgLen);
+const char* wld_wpaCtrl_getClientDir();
+swl_rc_ne wld_wpaCtrl_setClientDir(const char* dirPath);
 
 #endif /* __WLD_WPA_CTRL_API_H__ */
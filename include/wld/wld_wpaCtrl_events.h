@@ -273,6 +273,40 @@ int wld_wpaCtrl_getValueStr(const char* pData, const char* pKey, char* pValue, i
 int wld_wpaCtrl_getValueInt(const char* pData, const char* pKey);
 bool wld_wpaCtrl_getValueIntExt(const char* pData, const char* pKey, int32_t* pVal);
 
+#define WLD_WPACTRL_REPLY_MAX_PAIRS 256
+#define WLD_WPACTRL_REPLY_NR_BUCKETS 64
+#define WLD_WPACTRL_REPLY_NO_IDX UINT16_MAX
+
+/*
+ * key=value pair located in the tokenized reply (offsets relative to reply start)
+ */
+typedef struct {
+    uint16_t keyOffset;
+    uint16_t keyLen;
+    uint16_t valOffset;
+    uint16_t valLen;
+    uint16_t hashNext; // index of next pair in the same hash bucket
+} wld_wpaCtrl_replyPair_t;
+
+/*
+ * wpactrl reply (or event arguments) split once into key=value pairs,
+ * referring to (and not copying) the tokenized string, which must outlive it.
+ * Value may include spaces: it ends at the last space before the next key.
+ */
+typedef struct {
+    const char* pData;
+    uint16_t nrPairs;
+    bool truncated; // more pairs than table capacity: missing keys are looked up in the string
+    uint16_t buckets[WLD_WPACTRL_REPLY_NR_BUCKETS];
+    wld_wpaCtrl_replyPair_t pairs[WLD_WPACTRL_REPLY_MAX_PAIRS];
+} wld_wpaCtrl_reply_t;
+
+swl_rc_ne wld_wpaCtrl_reply_parse(wld_wpaCtrl_reply_t* pReply, const char* pData);
+const char* wld_wpaCtrl_reply_getValueRef(const wld_wpaCtrl_reply_t* pReply, const char* pKey, size_t* pLen);
+int wld_wpaCtrl_reply_getValueStr(const wld_wpaCtrl_reply_t* pReply, const char* pKey, char* pValue, int length);
+bool wld_wpaCtrl_reply_getValueIntExt(const wld_wpaCtrl_reply_t* pReply, const char* pKey, int32_t* pVal);
+int wld_wpaCtrl_reply_getValueInt(const wld_wpaCtrl_reply_t* pReply, const char* pKey);
+
 
 /*
  * @brief parse a wpactrl msg and fetch the event name from a provided list
@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#ifndef INCLUDE_WLD_WLD_WPACTRL_EVTPOLICY_H_
+#define INCLUDE_WLD_WLD_WPACTRL_EVTPOLICY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "swl/swl_returnCode.h"
+
+/*
+ * Event classes used to shed unsolicited wpa_ctrl messages under overload.
+ * Critical events (station association, DFS, interface state, ...) are never dropped.
+ */
+typedef enum {
+    WLD_WPACTRL_EVT_CLASS_CRITICAL,
+    WLD_WPACTRL_EVT_CLASS_NORMAL,
+    WLD_WPACTRL_EVT_CLASS_LOW,
+    WLD_WPACTRL_EVT_CLASS_MAX
+} wld_wpaCtrl_evtClass_e;
+
+extern const char* wld_wpaCtrl_evtClass_str[WLD_WPACTRL_EVT_CLASS_MAX];
+
+/*
+ * Shedding policy of one event class.
+ */
+typedef struct {
+    uint32_t maxRate;        // sustained accepted events per second, 0 for unlimited
+    uint32_t burst;          // max events accepted back-to-back above the sustained rate
+    uint32_t sampleWindowMs; // under pressure, repeats of the same event key within this window are dropped
+} wld_wpaCtrl_evtClassPolicy_t;
+
+typedef struct {
+    uint32_t nrPassed;      // events handed to the parsers
+    uint32_t nrRateDropped; // events dropped because the class rate was exceeded
+    uint32_t nrSampledOut;  // events dropped as repeats while under pressure
+} wld_wpaCtrl_evtClassStats_t;
+
+#define WLD_WPACTRL_EVT_SAMPLE_SLOTS 32
+
+typedef struct {
+    uint32_t key;
+    int64_t lastMs;
+} wld_wpaCtrl_evtSample_t;
+
+/*
+ * Per interface shaping state: one token bucket per class,
+ * and a small direct mapped table of recently accepted event keys.
+ */
+typedef struct {
+    bool initialized;
+    int64_t tokens[WLD_WPACTRL_EVT_CLASS_MAX];       // milli-events
+    int64_t lastRefillMs[WLD_WPACTRL_EVT_CLASS_MAX];
+    wld_wpaCtrl_evtClassStats_t stats[WLD_WPACTRL_EVT_CLASS_MAX];
+    wld_wpaCtrl_evtSample_t samples[WLD_WPACTRL_EVT_SAMPLE_SLOTS];
+} wld_wpaCtrl_evtShaper_t;
+
+wld_wpaCtrl_evtClass_e wld_wpaCtrl_getEvtClass(const char* msgData);
+swl_rc_ne wld_wpaCtrl_setEvtClassPolicy(wld_wpaCtrl_evtClass_e evtClass, const wld_wpaCtrl_evtClassPolicy_t* pPolicy);
+swl_rc_ne wld_wpaCtrl_getEvtClassPolicy(wld_wpaCtrl_evtClass_e evtClass, wld_wpaCtrl_evtClassPolicy_t* pPolicy);
+
+void wld_wpaCtrl_evtShaper_reset(wld_wpaCtrl_evtShaper_t* pShaper);
+bool wld_wpaCtrl_evtShaper_acceptAt(wld_wpaCtrl_evtShaper_t* pShaper, const char* msgData, int64_t nowMs);
+bool wld_wpaCtrl_evtShaper_accept(wld_wpaCtrl_evtShaper_t* pShaper, const char* msgData);
+swl_rc_ne wld_wpaCtrl_evtShaper_getStats(const wld_wpaCtrl_evtShaper_t* pShaper, wld_wpaCtrl_evtClass_e evtClass, wld_wpaCtrl_evtClassStats_t* pStats);
+
+#endif /* INCLUDE_WLD_WLD_WPACTRL_EVTPOLICY_H_ */
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#ifndef INCLUDE_WLD_WLD_WPACTRL_TRACE_H_
+#define INCLUDE_WLD_WLD_WPACTRL_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "swl/swl_returnCode.h"
+
+/*
+ * Capture of the wpa_ctrl datagram stream, for offline replay.
+ *
+ * File format (host byte order):
+ * - header: magic "WPCTRLT" + format version (1 byte)
+ * - records: delay since previous record in usec (uint32), direction (uint8),
+ *   socket name length (uint8), data length (uint16), socket name, data
+ */
+#define WLD_WPACTRL_TRACE_MAGIC "WPCTRLT"
+#define WLD_WPACTRL_TRACE_VERSION 1
+#define WLD_WPACTRL_TRACE_SOCK_NAME_MAX 64
+#define WLD_WPACTRL_TRACE_ENV_VAR "WLD_WPACTRL_RECORD_FILE"
+#define WLD_WPACTRL_TRACE_REDACTED "<redacted>" // written in place of secret values
+
+typedef enum {
+    WLD_WPACTRL_TRACE_DIR_CMD,   // command sent to the server
+    WLD_WPACTRL_TRACE_DIR_REPLY, // reply received from the server
+    WLD_WPACTRL_TRACE_DIR_EVT,   // unsolicited message received from the server
+    WLD_WPACTRL_TRACE_DIR_MAX
+} wld_wpaCtrl_traceDir_e;
+
+extern const char* wld_wpaCtrl_traceDir_str[WLD_WPACTRL_TRACE_DIR_MAX];
+
+typedef struct {
+    uint64_t tsUs;                                     // time since start of record
+    wld_wpaCtrl_traceDir_e dir;
+    char sockName[WLD_WPACTRL_TRACE_SOCK_NAME_MAX];
+    const char* data;                                  // nul terminated, valid until next read
+    size_t len;
+} wld_wpaCtrl_traceRecord_t;
+
+swl_rc_ne wld_wpaCtrl_startRecord(const char* path);
+void wld_wpaCtrl_stopRecord();
+bool wld_wpaCtrl_isRecording();
+void wld_wpaCtrl_recordMsg(wld_wpaCtrl_traceDir_e dir, const char* sockName, const char* data, size_t len);
+size_t wld_wpaCtrl_traceRedact(const char* data, size_t len, char* buf, size_t bufSize);
+
+typedef struct wld_wpaCtrl_traceReader wld_wpaCtrl_traceReader_t;
+
+swl_rc_ne wld_wpaCtrl_traceReader_open(wld_wpaCtrl_traceReader_t** ppReader, const char* path);
+swl_rc_ne wld_wpaCtrl_traceReader_next(wld_wpaCtrl_traceReader_t* pReader, wld_wpaCtrl_traceRecord_t* pRecord);
+void wld_wpaCtrl_traceReader_close(wld_wpaCtrl_traceReader_t** ppReader);
+
+#endif /* INCLUDE_WLD_WLD_WPACTRL_TRACE_H_ */
@@ -64,6 +64,7 @@
 #define __WLD_WPA_SUPPLICANT_API_H__
 
 #include "wld_wps.h"
+#include "wld_wpaCtrl_events.h"
 
 swl_rc_ne wld_wpaSupp_ep_disconnect(T_EndPoint* pEP);
 swl_rc_ne wld_wpaSupp_ep_getBssid(T_EndPoint* pEP, swl_macChar_t* bssid);
@@ -72,6 +73,7 @@ swl_rc_ne wld_wpaSupp_ep_startWpsPbc(T_EndPoint* pEP, swl_macChar_t* bssid);
 swl_rc_ne wld_wpaSupp_ep_startWpsPin(T_EndPoint* pEP, char* pin, swl_macChar_t* bssid);
 swl_rc_ne wld_wpaSupp_ep_cancelWps(T_EndPoint* pEP);
 swl_rc_ne wld_wpaSupp_ep_getAllStatusDetails(T_EndPoint* pEP, char* reply, size_t replySize);
+swl_rc_ne wld_wpaSupp_ep_getStatusDetails(T_EndPoint* pEP, char* reply, size_t replySize, wld_wpaCtrl_reply_t* pStatus);
 swl_rc_ne wld_wpaSupp_ep_getOneStatusDetail(T_EndPoint* pEP, const char* key, char* valStr, size_t valStrSize);
 swl_rc_ne wld_wpaSupp_ep_getSsid(T_EndPoint* pEP, char* ssid, size_t ssidSize);
 swl_rc_ne wld_wpaSupp_ep_getConnState(T_EndPoint* pEP, wld_epConnectionStatus_e* pEPConnState);
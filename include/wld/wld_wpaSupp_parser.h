@@ -63,6 +63,39 @@
 #ifndef __WLD_WPA_SUPPLICANT_PARSER_H__
 #define __WLD_WPA_SUPPLICANT_PARSER_H__
 
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Streaming reader of WPS attributes (big endian 16bit type, 16bit length, value),
+ * iterating in place over a binary buffer
+ */
+typedef struct {
+    const uint8_t* pos;
+    const uint8_t* end;
+} wld_wpsTlvReader_t;
+
+/*
+ * Streaming writer of WPS attributes into a caller provided buffer
+ */
+typedef struct {
+    uint8_t* buf;
+    size_t size;
+    size_t len;
+    bool overflow; // set when an attribute did not fit in the buffer
+} wld_wpsTlvWriter_t;
+
+void wld_wpsTlv_initReader(wld_wpsTlvReader_t* pReader, const uint8_t* data, size_t dataLen);
+swl_rc_ne wld_wpsTlv_next(wld_wpsTlvReader_t* pReader, uint16_t* pAttr, uint16_t* pLen, const uint8_t** ppVal);
+void wld_wpsTlv_initWriter(wld_wpsTlvWriter_t* pWriter, uint8_t* buf, size_t bufSize);
+void wld_wpsTlv_put(wld_wpsTlvWriter_t* pWriter, uint16_t attr, uint16_t len, const void* val);
+void wld_wpsTlv_putU8(wld_wpsTlvWriter_t* pWriter, uint16_t attr, uint8_t val);
+void wld_wpsTlv_putBe16(wld_wpsTlvWriter_t* pWriter, uint16_t attr, uint16_t val);
+size_t wld_wpsTlv_openContainer(wld_wpsTlvWriter_t* pWriter, uint16_t attr);
+void wld_wpsTlv_closeContainer(wld_wpsTlvWriter_t* pWriter, size_t containerOffset);
+
+swl_rc_ne wpaSup_parseWpsCredentials(T_WPSCredentials* creds, const uint8_t* data, size_t dataLen);
 swl_rc_ne wpaSup_parseWpsReceiveCredentialsEvt(T_WPSCredentials* creds, char* data, size_t dataLen);
 swl_rc_ne wpaSupp_buildWpsCredentials(T_AccessPoint* pAP, char* data, size_t* dataLen);
 
@@ -74,6 +74,10 @@ swl_rc_ne wifiGen_hapd_startDaemon(T_Radio* pRad);
 swl_rc_ne wifiGen_hapd_stopDaemon(T_Radio* pRad);
 swl_rc_ne wifiGen_hapd_reloadDaemon(T_Radio* pRad);
 void wifiGen_hapd_writeConfig(T_Radio* pRad);
+void wifiGen_hapd_probeDynCfgParams(T_Radio* pRad);
+void wifiGen_hapd_forceConfigReload(T_Radio* pRad);
+void wifiGen_hapd_ackConfigReload(T_Radio* pRad);
+swl_rc_ne wifiGen_hapd_applyConfig(T_Radio* pRad);
 bool wifiGen_hapd_isRunning(T_Radio* pRad);
 bool wifiGen_hapd_isAlive(T_Radio* pRad);
 swl_rc_ne wifiGen_hapd_getRadState(T_Radio* pRad, chanmgt_rad_state* pDetailedState);
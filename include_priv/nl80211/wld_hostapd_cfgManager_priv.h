@@ -63,18 +63,42 @@
 #ifndef __WLD_HOSTAPD_CFG_MANAGER_PRIV_H__
 #define __WLD_HOSTAPD_CFG_MANAGER_PRIV_H__
 
+#include <sys/stat.h>
 #include "swl/swl_map.h"
 struct wld_hostapdVapInfo {
     amxc_llist_it_t it;
     bool isInterface;
     char* bssName;
     swl_macBin_t bssid;
+    amxc_htable_it_t nameIt;   /* entry in config index by bss name */
+    amxc_htable_it_t bssidIt;  /* entry in config index by bssid (when set) */
     swl_mapChar_t vapParams;
+    uint64_t fingerprint;      /* sum of params fingerprints, maintained when adding/deleting params */
+    bool fingerprintStale;     /* params map was handed out, fingerprint must be recomputed */
+    bool changed;              /* section changed vs last saved snapshot */
 };
 
 struct wld_hostapd_config {
     swl_mapChar_t header;
-    amxc_llist_t vaps;
+    amxc_llist_t vaps;             /* sections, in config file order */
+    amxc_htable_t vapsByName;      /* index of vaps by bss name */
+    amxc_htable_t vapsByBssid;     /* index of vaps by bssid string */
+    uint64_t headerFingerprint;
+    bool headerFingerprintStale;
+};
+
+typedef struct {
+    char* bssName;
+    uint64_t fingerprint;
+    bool pendingChange; /* section changed since daemon last applied the config */
+} wld_hostapd_cfgSnapshotBss_t;
+
+struct wld_hostapd_cfgSnapshot {
+    uint64_t headerFingerprint;
+    uint32_t nBss;
+    wld_hostapd_cfgSnapshotBss_t* bss;     /* in config file order */
+    wld_hostapd_cfgChange_e pendingChange; /* changes written but not yet applied by daemon */
+    struct stat fileStat;                  /* config file status, when written */
 };
 
 #endif /* __WLD_HOSTAPD_CFG_MANAGER_PRIV_H__ */
@@ -70,8 +70,10 @@ swl_rc_ne wld_secDmnGrp_setMemberEvtHdlrs(wld_secDmnGrp_t* pSecDmnGrp, wld_secDm
 swl_rc_ne wld_secDmnGrp_delMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
 swl_rc_ne wld_secDmnGrp_startMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
 swl_rc_ne wld_secDmnGrp_stopMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
-bool wld_secDmnGrp_isMemberStarted(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
 bool wld_secDmnGrp_isMemberRestarting(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
 swl_rc_ne wld_secDmnGrp_restartMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
+swl_rc_ne wld_secDmnGrp_reloadMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn);
+void wld_secDmnGrp_updateCfgParamSupp(wld_secDmnGrp_t* pSecDmnGrp);
+const wld_secDmn_cfgParamSuppMap_t* wld_secDmnGrp_getCfgParamSuppMap(wld_secDmnGrp_t* pSecDmnGrp);
 
 #endif /* INCLUDE_PRIV_NL80211_WLD_SECDMNGRP_PRIV_H_ */
@@ -64,11 +64,15 @@
 #define INCLUDE_PRIV_NL80211_WLD_WPACTRLCONNECTION_PRIV_H_
 
 #include <sys/un.h>
+#include <amxc/amxc.h>
+#include <amxp/amxp.h>
 #include "swl/swl_common.h"
+#include "wld_wpaCtrl_api.h"
 
 #define CTRL_IFACE_CLIENT_DIR "/var/lib/wld"
-#define CTRL_IFACE_CLIENT CTRL_IFACE_CLIENT_DIR "/wpactrl-"
+#define CTRL_IFACE_CLIENT_PREFIX "wpactrl-"
 #define DFLT_SYNC_CMD_TMOUT_MS 1000
+#define DFLT_MAX_IN_FLIGHT_CMDS 4
 
 typedef void (* wld_wpaCtrlConnection_readDataCb_f)(void* userData, char* msgData, size_t msgLen);
 
@@ -80,15 +84,34 @@ typedef struct wpaCtrlConnection {
     struct sockaddr_un clientAddr;
     struct sockaddr_un serverAddr;
     int wpaPeer;
+    uint32_t connId;
+    uint32_t nrResyncs;         // number of times the client socket was renewed, after a lost reply
+    bool isAttached;            // registered to unsolicited messages (ATTACH)
     void* userData;
     wld_wpaCtrlConnection_evtHandlers_cb evtHdlrs;
     char* srvDirPath;
+    amxc_llist_t cmdQueue;      // queued commands (FIFO): the first nrInFlightCmds ones are already sent
+    uint32_t nrInFlightCmds;    // number of sent commands waiting for their reply
+    uint32_t maxInFlightCmds;   // max number of sent commands waiting for their reply
+    uint32_t syncWaitDepth;     // > 0 while blocked waiting for a synchronous command reply
+    amxc_llist_t deferredMsgs;  // unsolicited messages and async cmd completions received while blocked waiting for a sync reply
+    amxp_timer_t* deferredMsgsTimer;
+    char* rxBuf;                // receive buffer, sized to max msg length
+    size_t rxBufSize;
+    bool rxBufBusy;             // rx buffer holding the message being processed
+    uint32_t rxBurstBudget;     // max number of messages read per socket wakeup
+    wld_wpaCtrl_rxStats_t rxStats;
 } wpaCtrlConnection_t;
 
 swl_rc_ne wld_wpaCtrlConnection_init(wpaCtrlConnection_t** ppConn, uint32_t connId, const char* serverPath, const char* sockName);
 swl_rc_ne wld_wpaCtrlConnection_setEvtHandlers(wpaCtrlConnection_t* pConn, void* userData, wld_wpaCtrlConnection_evtHandlers_cb* pEvtHdlrs);
 swl_rc_ne wld_wpaCtrlConnection_open(wpaCtrlConnection_t* pConn);
 swl_rc_ne wld_wpaCtrlConnection_sendCmd(wpaCtrlConnection_t* pConn, const char* cmd);
+swl_rc_ne wld_wpaCtrlConnection_sendCmdAsync(wpaCtrlConnection_t* pConn, const char* cmd, uint32_t tmOutMSec, wld_wpaCtrl_cmdDoneCb_f fDoneCb, void* userData);
+swl_rc_ne wld_wpaCtrlConnection_setMaxInFlightCmds(wpaCtrlConnection_t* pConn, uint32_t maxInFlightCmds);
+uint32_t wld_wpaCtrlConnection_getNrPendingCmds(wpaCtrlConnection_t* pConn);
+swl_rc_ne wld_wpaCtrlConnection_setRxBurstBudget(wpaCtrlConnection_t* pConn, uint32_t rxBurstBudget);
+swl_rc_ne wld_wpaCtrlConnection_getRxStats(wpaCtrlConnection_t* pConn, wld_wpaCtrl_rxStats_t* pStats);
 swl_rc_ne wld_wpaCtrlConnection_sendCmdSyncedExt(wpaCtrlConnection_t* pConn, const char* cmd, char* reply, size_t replyLen, uint32_t tmOutMSec);
 swl_rc_ne wld_wpaCtrlConnection_sendCmdSynced(wpaCtrlConnection_t* pConn, const char* cmd, char* reply, size_t replyLen);
 swl_rc_ne wld_wpaCtrlConnection_sendCmdCheckResponseExt(wpaCtrlConnection_t* pConn, char* cmd, char* expectedResponse, uint32_t tmOutMSec);
@@ -66,6 +66,29 @@
 #include "wld_wpaCtrlInterface.h"
 #include "wld_wpaCtrlMngr.h"
 #include "wld_wpaCtrlConnection_priv.h"
+#include "wld_wpaCtrl_evtPolicy.h"
+#include "swla/swla_time_spec.h"
+
+typedef struct wld_wpaCtrl_cmdBatch wld_wpaCtrl_cmdBatch_t;
+
+/*
+ * commands whose reply is kept in memory, to serve parameter reads
+ */
+typedef enum {
+    WLD_WPACTRL_SNAPSHOT_STATUS,
+    WLD_WPACTRL_SNAPSHOT_GET_CONFIG,
+    WLD_WPACTRL_SNAPSHOT_MAX
+} wld_wpaCtrl_snapshotId_e;
+
+typedef struct {
+    char* reply;                   // last reply of the snapshot command
+    wld_wpaCtrl_reply_t* pPairs;   // last reply split into key=value pairs, referring to reply
+    swl_timeSpecMono_t updateTime; // time of last reply update
+    bool valid;                    // false when made stale by an event, until next update
+    uint32_t gen;                  // incremented on each update/invalidation, to discard outdated async replies
+    uint32_t refreshGen;           // generation when async refresh was sent
+    bool refreshing;               // async refresh pending
+} wld_wpaCtrl_cmdSnapshot_t;
 
 struct wld_wpaCtrlInterface {
     char* name;  //interface name
@@ -78,8 +101,13 @@ struct wld_wpaCtrlInterface {
     void* userData;
     wld_wpaCtrlMngr_t* pMgr;
     wld_wpaCtrl_evtHandlers_cb handlers;
+    wld_wpaCtrl_cmdBatch_t* cmdBatch;  // open batch of pipelined commands
+    wld_wpaCtrl_evtShaper_t evtShaper; // overload shedding state of unsolicited messages
+    wld_wpaCtrl_cmdSnapshot_t snapshots[WLD_WPACTRL_SNAPSHOT_MAX];
 };
 
+void wld_wpaCtrlInterface_checkSnapshotEvt(wld_wpaCtrlInterface_t* pIface, const char* msgData);
+
 // Call interface handler protected against null interface and null handler
 #define CALL_INTF(pIntf, fName, ...) \
     if(pIntf != NULL) { \
@@ -66,6 +66,8 @@
 #define MAX_CONNECTION_ATTEMPTS 20
 #define FIRST_DELAY_MS 500
 #define RETRY_DELAY_MS 500
+#define DIR_WATCH_RETRY_DELAY_MS 2000 // safety net polling period, while ctrl iface dir is watched
+#define DIR_WATCH_NEW_SOCK_DELAY_MS 100 // delay to connect a socket created in the watched dir, for the daemon to serve it
 
 #include "swl/swl_unLiList.h"
 #include "wld_wpaCtrl_events.h"
@@ -78,6 +80,8 @@ struct wld_wpaCtrlMngr {
     void* userData;
     swl_unLiList_t ifaces; //list of wpa_ctrl interfaces, handled by the manager
     wld_wpaCtrl_radioEvtHandlers_cb handlers;
+    int dirWatchFd;       // inotify fd watching socket creation/removal in ctrl iface dir
+    char* watchedDirPath; // ctrl iface dir being watched
 };
 
 #define CALL_MGR(pMgr, ifName, fName, ...) \
@@ -0,0 +1,354 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <debug/sahtrace.h>
+
+#include "wld_ap_staDcLog.h"
+#include "swl/swl_assert.h"
+#include "wld.h"
+#include "wld_util.h"
+
+#define ME "apDcLog"
+
+#define NO_IDX WLD_AP_DCLOG_NO_IDX
+
+static uint32_t s_hashMac(const swl_macBin_t* macAddress) {
+    return wld_util_fnv32Update(WLD_UTIL_FNV32_OFFSET_BASIS, macAddress->bMac, SWL_MAC_BIN_LEN);
+}
+
+static uint32_t s_getHashSize(uint32_t capacity) {
+    uint32_t size = 1;
+    while(size < 2 * capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+static uint32_t s_getReasonBucket(uint16_t reason) {
+    return reason % WLD_AP_DCLOG_NR_REASON_BUCKETS;
+}
+
+static int32_t* s_getHashHead(wld_apDcLog_t* pLog, const swl_macBin_t* macAddress) {
+    return &pLog->hashHeads[s_hashMac(macAddress) & pLog->hashMask];
+}
+
+static int32_t s_findIdx(wld_apDcLog_t* pLog, const swl_macBin_t* macAddress) {
+    int32_t idx = *s_getHashHead(pLog, macAddress);
+    while(idx != NO_IDX) {
+        wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+        if(swl_mac_binMatches(&entry->macAddress, macAddress)) {
+            return idx;
+        }
+        idx = entry->hashNext;
+    }
+    return NO_IDX;
+}
+
+static void s_hashLink(wld_apDcLog_t* pLog, int32_t idx) {
+    wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+    int32_t* pHead = s_getHashHead(pLog, &entry->macAddress);
+    entry->hashNext = *pHead;
+    *pHead = idx;
+}
+
+static void s_hashUnlink(wld_apDcLog_t* pLog, int32_t idx) {
+    wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+    int32_t* pIdx = s_getHashHead(pLog, &entry->macAddress);
+    while(*pIdx != NO_IDX) {
+        if(*pIdx == idx) {
+            *pIdx = entry->hashNext;
+            entry->hashNext = NO_IDX;
+            return;
+        }
+        pIdx = &pLog->entries[*pIdx].hashNext;
+    }
+}
+
+static void s_recencyAppend(wld_apDcLog_t* pLog, int32_t idx) {
+    wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+    entry->older = pLog->newest;
+    entry->newer = NO_IDX;
+    if(pLog->newest != NO_IDX) {
+        pLog->entries[pLog->newest].newer = idx;
+    } else {
+        pLog->oldest = idx;
+    }
+    pLog->newest = idx;
+}
+
+static void s_recencyUnlink(wld_apDcLog_t* pLog, int32_t idx) {
+    wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+    if(entry->older != NO_IDX) {
+        pLog->entries[entry->older].newer = entry->newer;
+    } else {
+        pLog->oldest = entry->newer;
+    }
+    if(entry->newer != NO_IDX) {
+        pLog->entries[entry->newer].older = entry->older;
+    } else {
+        pLog->newest = entry->older;
+    }
+    entry->older = NO_IDX;
+    entry->newer = NO_IDX;
+}
+
+static void s_reasonPush(wld_apDcLog_t* pLog, int32_t idx) {
+    wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+    int32_t* pHead = &pLog->reasonHeads[s_getReasonBucket(entry->reason)];
+    entry->reasonPrev = NO_IDX;
+    entry->reasonNext = *pHead;
+    if(*pHead != NO_IDX) {
+        pLog->entries[*pHead].reasonPrev = idx;
+    }
+    *pHead = idx;
+}
+
+static void s_reasonUnlink(wld_apDcLog_t* pLog, int32_t idx) {
+    wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+    if(entry->reasonPrev != NO_IDX) {
+        pLog->entries[entry->reasonPrev].reasonNext = entry->reasonNext;
+    } else {
+        pLog->reasonHeads[s_getReasonBucket(entry->reason)] = entry->reasonNext;
+    }
+    if(entry->reasonNext != NO_IDX) {
+        pLog->entries[entry->reasonNext].reasonPrev = entry->reasonPrev;
+    }
+    entry->reasonPrev = NO_IDX;
+    entry->reasonNext = NO_IDX;
+}
+
+/*
+ * Store a disconnection, reusing the entry of the station if already logged,
+ * a free slot if any, or the least recently disconnected station otherwise.
+ * The stored entry becomes the most recent one.
+ */
+static wld_apDcLog_entry_t* s_store(wld_apDcLog_t* pLog, const swl_macBin_t* macAddress, uint16_t reason, const swl_timeSpecMono_t* dcTime) {
+    int32_t idx = s_findIdx(pLog, macAddress);
+    if(idx != NO_IDX) {
+        s_recencyUnlink(pLog, idx);
+        s_reasonUnlink(pLog, idx);
+    } else {
+        if(pLog->count < pLog->capacity) {
+            idx = pLog->count;
+            pLog->count++;
+        } else {
+            idx = pLog->oldest;
+            s_recencyUnlink(pLog, idx);
+            s_reasonUnlink(pLog, idx);
+            s_hashUnlink(pLog, idx);
+        }
+        memcpy(&pLog->entries[idx].macAddress, macAddress, sizeof(swl_macBin_t));
+        s_hashLink(pLog, idx);
+    }
+    wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+    entry->dcTime = *dcTime;
+    entry->reason = reason;
+    s_recencyAppend(pLog, idx);
+    s_reasonPush(pLog, idx);
+    return entry;
+}
+
+swl_rc_ne wld_apDcLog_init(wld_apDcLog_t* pLog, uint32_t capacity) {
+    ASSERT_NOT_NULL(pLog, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_EQUALS(capacity, 0, SWL_RC_INVALID_PARAM, ME, "null capacity");
+    memset(pLog, 0, sizeof(*pLog));
+    uint32_t hashSize = s_getHashSize(capacity);
+    pLog->entries = calloc(capacity, sizeof(wld_apDcLog_entry_t));
+    pLog->hashHeads = calloc(hashSize, sizeof(int32_t));
+    if((pLog->entries == NULL) || (pLog->hashHeads == NULL)) {
+        SAH_TRACEZ_ERROR(ME, "fail to alloc log of %u entries", capacity);
+        wld_apDcLog_destroy(pLog);
+        return SWL_RC_ERROR;
+    }
+    pLog->capacity = capacity;
+    pLog->hashMask = hashSize - 1;
+    for(uint32_t i = 0; i < hashSize; i++) {
+        pLog->hashHeads[i] = NO_IDX;
+    }
+    for(uint32_t i = 0; i < WLD_AP_DCLOG_NR_REASON_BUCKETS; i++) {
+        pLog->reasonHeads[i] = NO_IDX;
+    }
+    pLog->oldest = NO_IDX;
+    pLog->newest = NO_IDX;
+    return SWL_RC_OK;
+}
+
+void wld_apDcLog_destroy(wld_apDcLog_t* pLog) {
+    ASSERT_NOT_NULL(pLog, , ME, "NULL");
+    free(pLog->entries);
+    free(pLog->hashHeads);
+    memset(pLog, 0, sizeof(*pLog));
+    pLog->oldest = NO_IDX;
+    pLog->newest = NO_IDX;
+}
+
+/**
+ * Change the number of disconnections that can be logged.
+ * When shrinking, only the most recent disconnections are kept.
+ */
+swl_rc_ne wld_apDcLog_setCapacity(wld_apDcLog_t* pLog, uint32_t capacity) {
+    ASSERT_NOT_NULL(pLog, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_EQUALS(capacity, 0, SWL_RC_INVALID_PARAM, ME, "null capacity");
+    ASSERTS_NOT_EQUALS(capacity, pLog->capacity, SWL_RC_OK, ME, "same capacity");
+    if(pLog->entries == NULL) {
+        return wld_apDcLog_init(pLog, capacity);
+    }
+
+    wld_apDcLog_t newLog;
+    swl_rc_ne rc = wld_apDcLog_init(&newLog, capacity);
+    ASSERT_TRUE(swl_rc_isOk(rc), rc, ME, "fail to resize log to %u entries", capacity);
+
+    uint32_t nrSkip = (pLog->count > capacity) ? pLog->count - capacity : 0;
+    for(int32_t idx = pLog->oldest; idx != NO_IDX; idx = pLog->entries[idx].newer) {
+        if(nrSkip > 0) {
+            nrSkip--;
+            continue;
+        }
+        wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+        s_store(&newLog, &entry->macAddress, entry->reason, &entry->dcTime);
+    }
+    wld_apDcLog_destroy(pLog);
+    *pLog = newLog;
+    return SWL_RC_OK;
+}
+
+uint32_t wld_apDcLog_getCount(wld_apDcLog_t* pLog) {
+    ASSERT_NOT_NULL(pLog, 0, ME, "NULL");
+    return pLog->count;
+}
+
+/**
+ * Return the logged disconnection of the station with the given mac address,
+ * or NULL if it is not logged.
+ */
+wld_apDcLog_entry_t* wld_apDcLog_find(wld_apDcLog_t* pLog, const swl_macBin_t* macAddress) {
+    ASSERT_NOT_NULL(pLog, NULL, ME, "NULL");
+    ASSERT_NOT_NULL(macAddress, NULL, ME, "NULL");
+    ASSERTS_NOT_EQUALS(pLog->count, 0, NULL, ME, "empty log");
+    int32_t idx = s_findIdx(pLog, macAddress);
+    ASSERTS_NOT_EQUALS(idx, NO_IDX, NULL, ME, "not found");
+    return &pLog->entries[idx];
+}
+
+/**
+ * Log a disconnection of the station with the given mac address, at the current time.
+ * If the log is full, the least recently disconnected station is dropped.
+ */
+wld_apDcLog_entry_t* wld_apDcLog_add(wld_apDcLog_t* pLog, const swl_macBin_t* macAddress, uint16_t reason) {
+    ASSERT_NOT_NULL(pLog, NULL, ME, "NULL");
+    ASSERT_NOT_NULL(macAddress, NULL, ME, "NULL");
+    ASSERT_NOT_NULL(pLog->entries, NULL, ME, "log not initialized");
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    return s_store(pLog, macAddress, reason, &now);
+}
+
+/**
+ * Fill results with up to maxResults logged disconnections matching filter, most recent first.
+ * Both the recency and the reason chains are sorted by time, so the walk stops at the first
+ * entry older than the filter time window.
+ *
+ * @return the number of entries written in results
+ */
+uint32_t wld_apDcLog_getRecent(wld_apDcLog_t* pLog, const wld_apDcLog_filter_t* filter, wld_apDcLog_entry_t** results, uint32_t maxResults) {
+    ASSERT_NOT_NULL(pLog, 0, ME, "NULL");
+    ASSERT_NOT_NULL(results, 0, ME, "NULL");
+    ASSERTS_NOT_EQUALS(pLog->count, 0, 0, ME, "empty log");
+
+    bool byReason = ((filter != NULL) && filter->filterReason);
+    uint32_t maxAgeMs = (filter != NULL) ? filter->maxAgeMs : 0;
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+
+    uint32_t nrResults = 0;
+    int32_t idx = byReason ? pLog->reasonHeads[s_getReasonBucket(filter->reason)] : pLog->newest;
+    while((idx != NO_IDX) && (nrResults < maxResults)) {
+        wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+        if((maxAgeMs != 0) && (swl_timespec_diffToMillisec(&entry->dcTime, &now) > maxAgeMs)) {
+            break;
+        }
+        if(!byReason || (entry->reason == filter->reason)) {
+            results[nrResults] = entry;
+            nrResults++;
+        }
+        idx = byReason ? entry->reasonNext : entry->older;
+    }
+    return nrResults;
+}
+
+/**
+ * Write all logged disconnections to variant as a list of maps, oldest first.
+ */
+void wld_apDcLog_toListOfMaps(wld_apDcLog_t* pLog, amxc_var_t* variant) {
+    ASSERT_NOT_NULL(pLog, , ME, "NULL");
+    ASSERT_NOT_NULL(variant, , ME, "NULL");
+    amxc_var_set_type(variant, AMXC_VAR_ID_LIST);
+    for(int32_t idx = pLog->oldest; idx != NO_IDX; idx = pLog->entries[idx].newer) {
+        wld_apDcLog_entry_t* entry = &pLog->entries[idx];
+        amxc_var_t* map = amxc_var_add(amxc_htable_t, variant, NULL);
+        amxc_var_add_key(cstring_t, map, "macAddress", swl_typeMacBin_toBuf32(entry->macAddress).buf);
+        amxc_var_add_key(cstring_t, map, "dcTime", swl_typeTimeSpecMono_toBuf32(entry->dcTime).buf);
+        amxc_var_add_key(uint32_t, map, "reason", entry->reason);
+    }
+}
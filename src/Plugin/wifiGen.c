@@ -95,6 +95,10 @@ bool wifiGen_init() {
         .enableParam = true,
         .instantRestartLimit = 3,
         .minRestartInterval = 5,
+        .supervise = true,
+        .backoffInitMs = 500,
+        .backoffMaxMs = 60000,
+        .crashLoopLimit = 5,
     };
     wld_dmn_setMonitorConf(&dmnMoniConf);
 
@@ -988,6 +988,7 @@ static void s_handleAssocMsgAffiliatedSta(T_AccessPoint* pAP, T_AssociatedDevice
 
     /* force 802.11BE */
     pAD->operatingStandard = SWL_RADSTD_BE;
+    wld_ad_refreshStaCounters(pAP, pAD);
 
     wld_affiliatedSta_t* afSta = wld_ad_getOrAddAffiliatedSta(pAD, pAP);
     ASSERT_NOT_NULL(afSta, , ME, "%s: create affiliatedSta (linkId:%u,mac:%s) failed for sta(%s)!", pAP->alias,
@@ -1293,15 +1294,22 @@ static void s_stationConnectedEvt(void* pRef, char* ifName, swl_macBin_t* bBssid
     T_Radio* pRad = pEP->pRadio;
     ASSERT_NOT_NULL(pRad, , ME, "%s: no radio mapped", pEP->Name);
 
+    /* query status once for all needed details */
+    char statusBuf[1024] = {0};
+    wld_wpaCtrl_reply_t status;
+    bool hasStatus = (wld_wpaSupp_ep_getStatusDetails(pEP, statusBuf, sizeof(statusBuf), &status) >= SWL_RC_OK);
+
     swl_macChar_t tmpBssidStr = SWL_MAC_CHAR_NEW();
     if((bBssidMac != NULL) && (!swl_mac_binIsNull(bBssidMac))) {
         memcpy(pEP->pSSID->BSSID, bBssidMac->bMac, SWL_MAC_BIN_LEN);
         swl_mac_binToChar(&tmpBssidStr, bBssidMac);
-    } else if(wld_wpaSupp_ep_getBssid(pEP, &tmpBssidStr) >= SWL_RC_OK) {
+    } else if(hasStatus &&
+              (wld_wpaCtrl_reply_getValueStr(&status, "bssid", tmpBssidStr.cMac, sizeof(tmpBssidStr.cMac)) > 0) &&
+              (swl_mac_charIsValidStaMac(&tmpBssidStr))) {
         swl_mac_charToBin((swl_macBin_t*) pEP->pSSID->BSSID, &tmpBssidStr);
     }
     char tmpSsid[128] = {0};
-    if(wld_wpaSupp_ep_getSsid(pEP, tmpSsid, sizeof(tmpSsid)) >= SWL_RC_OK) {
+    if(hasStatus && (wld_wpaCtrl_reply_getValueStr(&status, "ssid", tmpSsid, sizeof(tmpSsid)) > 0)) {
         swl_str_copy(pEP->pSSID->SSID, sizeof(pEP->pSSID->SSID), tmpSsid);
     }
 
@@ -67,6 +67,7 @@
 #include "wld/wld_hostapd_ap_api.h"
 #include "wld/wld_hostapd_cfgFile.h"
 #include "wld/wld_wpaSupp_ep_api.h"
+#include "wld/wld_wpaCtrl_api.h"
 #include "wld/wld_rad_nl80211.h"
 #include "wld/wld_ap_nl80211.h"
 #include "wld/wld_chanmgt.h"
@@ -472,8 +473,21 @@ static bool s_doUpdateHostapd(T_Radio* pRad) {
     ASSERTI_TRUE(wifiGen_hapd_isStarted(pRad), true, ME, "%s: hostapd instance not started", pRad->Name);
 
     wifiGen_hapd_restoreMainIface(pRad);
+    /*
+     * hostapd main iface toggling is implied by config reload:
+     * so fully reload the config, even if unchanged
+     */
+    if(isBitSetLongArray(pRad->fsmRad.FSM_AC_BitActionArray, FSM_BW, GEN_FSM_DISABLE_HOSTAPD)) {
+        wifiGen_hapd_forceConfigReload(pRad);
+    }
     SAH_TRACEZ_INFO(ME, "%s: reload hostapd", pRad->Name);
-    wifiGen_hapd_reloadDaemon(pRad);
+    swl_rc_ne rc = wifiGen_hapd_applyConfig(pRad);
+    ASSERTS_FALSE(rc == SWL_RC_DONE, true, ME, "%s: no hostapd config change to apply", pRad->Name);
+    /*
+     * reload merged into a pending restart of the shared hostapd:
+     * warm params will be restored on restart, when all params are re-synced
+     */
+    ASSERTI_FALSE(rc == SWL_RC_CONTINUE, true, ME, "%s: hostapd reload merged into pending restart", pRad->Name);
     wld_wpaCtrlMngr_connect(wld_secDmn_getWpaCtrlMgr(pRad->hostapd));
     //delay before restore warm applicable params after reloading conf file with sighup
     pRad->fsmRad.timeout_msec = 500;
@@ -513,13 +527,11 @@ static void s_syncOnRadUp(void* userData, char* ifName, bool state) {
         return;
     }
 
-    // check and apply dyn detected cfg params
+    // check dyn detected cfg params
+    // learned params are applied later, by cfgParamSuppCb
     if(wld_secDmn_countCfgParamSuppByVal(pRad->hostapd, SWL_TRL_UNKNOWN) > 0) {
-        SAH_TRACEZ_INFO(ME, "%s: try to detect and apply dyn cfg params", pRad->Name);
-        wifiGen_hapd_writeConfig(pRad);
-        if(wld_secDmn_countCfgParamSuppByVal(pRad->hostapd, SWL_TRL_TRUE) > 0) {
-            wld_ap_hostapd_sendCommand(pAP, "RELOAD", "refreshConfig");
-        }
+        SAH_TRACEZ_INFO(ME, "%s: try to detect dyn cfg params", pRad->Name);
+        wifiGen_hapd_probeDynCfgParams(pRad);
     }
 
     if(!pRad->autoChannelEnable
@@ -578,7 +590,11 @@ static bool s_doStartHostapd(T_Radio* pRad) {
         //update hostapd conf to consider changed configs while it was disabled
         //+reconnect wpactrlMgr to update wpactrl connections (of added/removed BSSs)
         wld_wpaCtrlMngr_disconnect(wld_secDmn_getWpaCtrlMgr(pRad->hostapd));
+        wifiGen_hapd_forceConfigReload(pRad);
         setBitLongArray(pRad->fsmRad.FSM_AC_BitActionArray, FSM_BW, GEN_FSM_UPDATE_HOSTAPD);
+    } else if(rc == SWL_RC_OK) {
+        //new hostapd instance loads the last written config
+        wifiGen_hapd_ackConfigReload(pRad);
     }
 
     s_registerHadpRadEvtHandlers(pRad->hostapd);
@@ -637,13 +653,44 @@ static bool s_doSetBssid(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
     return true;
 }
 
+/*
+ * runtime commands of the AP (SETs included, as their applying action does not depend
+ * on their result) are pipelined to hostapd, the batches of all APs being in flight together:
+ * if any of them is rejected, then reload the whole saved conf
+ */
+static void s_onApCmdBatchDone(void* userData _UNUSED, const char* ifName, uint32_t nrCmds, uint32_t nrFailed) {
+    ASSERTI_NOT_EQUALS(nrFailed, 0, , ME, "%s: %u runtime cmds applied", ifName, nrCmds);
+    T_AccessPoint* pAP = wld_vap_get_vap(ifName);
+    ASSERT_NOT_NULL(pAP, , ME, "%s: no ap ctx", ifName);
+    T_Radio* pRad = pAP->pRadio;
+    ASSERT_NOT_NULL(pRad, , ME, "%s: no rad ctx", ifName);
+    SAH_TRACEZ_WARNING(ME, "%s: %u/%u runtime cmds failed => reload hostapd conf", ifName, nrFailed, nrCmds);
+    bool needCommit = (pRad->fsmRad.FSM_State != FSM_RUN);
+    unsigned long* actionArray = (needCommit ? pRad->fsmRad.FSM_BitActionArray : pRad->fsmRad.FSM_AC_BitActionArray);
+    wifiGen_hapd_forceConfigReload(pRad);
+    setBitLongArray(actionArray, FSM_BW, GEN_FSM_UPDATE_HOSTAPD);
+    if(needCommit) {
+        wld_rad_doCommitIfUnblocked(pRad);
+    }
+}
+
+static void s_startApCmdBatch(T_AccessPoint* pAP) {
+    wld_wpaCtrl_startCmdBatch(pAP->wpaCtrlInterface);
+}
+
+static void s_endApCmdBatch(T_AccessPoint* pAP) {
+    wld_wpaCtrl_endCmdBatch(pAP->wpaCtrlInterface, s_onApCmdBatchDone, NULL);
+}
+
 static bool s_doSetSsid(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
     ASSERTS_NOT_NULL(pAP, true, ME, "NULL");
     ASSERTI_TRUE(wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface), true, ME, "%s: wpaCtrl disconnected", pAP->alias);
     T_SSID* pSSID = pAP->pSSID;
     ASSERTS_NOT_NULL(pSSID, true, ME, "%s: no ssid ctx", pAP->alias);
     SAH_TRACEZ_INFO(ME, "%s: set ssid (%s)", pSSID->Name, pSSID->SSID);
+    s_startApCmdBatch(pAP);
     wld_secDmn_action_rc_ne rc = wld_ap_hostapd_setSsid(pAP, pSSID->SSID);
+    s_endApCmdBatch(pAP);
     ASSERT_FALSE(rc < SECDMN_ACTION_OK_DONE, true, ME, "%s: fail to set ssid", pSSID->Name);
     s_schedNextAction(rc, pAP, pRad);
     return true;
@@ -660,8 +707,10 @@ static bool s_doSetMfList(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
 static bool s_doSetApSec(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
     ASSERTS_NOT_NULL(pAP, true, ME, "NULL");
     ASSERTI_TRUE(wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface), true, ME, "%s: wpaCtrl disconnected", pAP->alias);
-    wld_ap_hostapd_sendCommand(pAP, "PMKSA_FLUSH", "refreshConfig");
+    s_startApCmdBatch(pAP);
+    wld_ap_hostapd_queueCommand(pAP, "PMKSA_FLUSH", "refreshConfig");
     wld_secDmn_action_rc_ne rc = wld_ap_hostapd_setSecParams(pAP);
+    s_endApCmdBatch(pAP);
     ASSERT_FALSE(rc < SECDMN_ACTION_OK_DONE, true, ME, "%s: fail to set secret key", pAP->alias);
 
     s_schedNextAction(rc, pAP, pRad);
@@ -674,7 +723,9 @@ static bool s_doSetApMld(T_AccessPoint* pAP, T_Radio* pRad) {
     ASSERTI_TRUE(wld_secDmn_hasAvailableCtrlIface(pRad->hostapd), true, ME, "%s: hapd has no available socket", pRad->Name);
     ASSERTI_TRUE(wld_rad_isMloCapable(pRad), true, ME, "%s: not mlo capable", pRad->Name);
     SAH_TRACEZ_INFO(ME, "%s: checking mld conf changes", pAP->alias);
+    s_startApCmdBatch(pAP);
     wld_secDmn_action_rc_ne rc = wld_ap_hostapd_setMldParams(pAP);
+    s_endApCmdBatch(pAP);
     ASSERT_FALSE(rc < SECDMN_ACTION_OK_DONE, true, ME, "%s: fail to set common params", pAP->alias);
     s_schedNextAction(rc, pAP, pRad);
     return true;
@@ -683,8 +734,10 @@ static bool s_doSetApMld(T_AccessPoint* pAP, T_Radio* pRad) {
 static bool s_doSyncAp(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
     ASSERTS_NOT_NULL(pAP, true, ME, "NULL");
     ASSERTI_TRUE(wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface), true, ME, "%s: wpaCtrl disconnected", pAP->alias);
+    s_startApCmdBatch(pAP);
     wld_ap_hostapd_updateMaxNbrSta(pAP);
     wld_secDmn_action_rc_ne rc = wld_ap_hostapd_setNoSecParams(pAP);
+    s_endApCmdBatch(pAP);
     ASSERT_FALSE(rc < SECDMN_ACTION_OK_DONE, true, ME, "%s: fail to set common params", pAP->alias);
     s_schedNextAction(rc, pAP, pRad);
     return true;
@@ -693,7 +746,9 @@ static bool s_doSyncAp(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
 static bool s_doReloadApSecKey(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
     ASSERTS_NOT_NULL(pAP, true, ME, "NULL");
     ASSERTI_TRUE(wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface), true, ME, "%s: wpaCtrl disconnected", pAP->alias);
-    wld_ap_hostapd_reloadSecKey(pAP, "reloadSecKey");
+    s_startApCmdBatch(pAP);
+    wld_ap_hostapd_queueCommand(pAP, "RELOAD_WPA_PSK", "reloadSecKey");
+    s_endApCmdBatch(pAP);
     return true;
 }
 
@@ -706,7 +761,9 @@ static bool s_doUpdateBeacon(T_AccessPoint* pAP, T_Radio* pRad _UNUSED) {
         return true;
     }
     SAH_TRACEZ_INFO(ME, "%s: start/update beaconing", pAP->alias);
-    wld_ap_hostapd_updateBeacon(pAP, "updateBeacon");
+    s_startApCmdBatch(pAP);
+    wld_ap_hostapd_queueUpdateBeacon(pAP, "updateBeacon");
+    s_endApCmdBatch(pAP);
     return true;
 }
 
@@ -1038,12 +1095,26 @@ static void s_writeHapdConfFileCb(wld_secDmn_t* pSecDmn _UNUSED, void* userdata)
     wifiGen_hapd_writeConfig(pRad);
 }
 
+static void s_onHapdCfgParamSuppCb(wld_secDmn_t* pSecDmn, void* userdata) {
+    T_Radio* pRad = (T_Radio*) userdata;
+    ASSERT_NOT_NULL(pRad, , ME, "NULL");
+    ASSERTS_TRUE(wifiGen_hapd_isAlive(pRad), , ME, "%s: hostapd not alive", pRad->Name);
+    SAH_TRACEZ_INFO(ME, "%s: apply learned dyn cfg params", pRad->Name);
+    wifiGen_hapd_writeConfig(pRad);
+    wld_wpaCtrlInterface_t* pIface = wld_wpaCtrlMngr_getFirstReadyInterface(wld_secDmn_getWpaCtrlMgr(pSecDmn));
+    ASSERTI_NOT_NULL(pIface, , ME, "%s: no ready iface to reload hostapd", pRad->Name);
+    wld_wpaCtrl_sendCmdCheckResponse(pIface, "RELOAD", "OK");
+}
+
 static void s_updateHapdDmnEvtHandlers(T_Radio* pRad) {
     ASSERTS_NOT_NULL(pRad, , ME, "NULL");
     ASSERTS_NOT_NULL(pRad->hostapd, , ME, "NULL");
     if(pRad->hostapd->handlers.writeCfgCb == NULL) {
         pRad->hostapd->handlers.writeCfgCb = s_writeHapdConfFileCb;
     }
+    if(pRad->hostapd->handlers.cfgParamSuppCb == NULL) {
+        pRad->hostapd->handlers.cfgParamSuppCb = s_onHapdCfgParamSuppCb;
+    }
 }
 
 static void s_radioChange(wld_rad_changeEvent_t* event) {
@@ -1109,6 +1180,7 @@ static void s_apChange(wld_vap_changeEvent_t* event) {
     SAH_TRACEZ_INFO(ME, "%s: receiving event %d", pAP->alias, event->changeType);
     if((event->changeType == WLD_VAP_CHANGE_EVENT_DEINIT) &&
        (wld_wpaCtrlInterface_isEnabled(pAP->wpaCtrlInterface))) {
+        wifiGen_hapd_forceConfigReload(pRad);
         setBitLongArray(pRad->fsmRad.FSM_BitActionArray, FSM_BW, GEN_FSM_UPDATE_HOSTAPD);
     }
 }
@@ -67,6 +67,7 @@
 #include "wld/wld_linuxIfUtils.h"
 #include "wld/wld_rad_nl80211.h"
 #include "wld/wld_hostapd_cfgFile.h"
+#include "wld/wld_hostapd_cfgManager.h"
 #include "wld/wld_rad_hostapd_api.h"
 #include "wld/wld_wpaCtrl_api.h"
 #include "wld/wld_wpaCtrl_events.h"
@@ -79,6 +80,11 @@
 #define ME "genHapd"
 #define HOSTAPD_CONF_FILE_PATH_FORMAT "/tmp/%s_hapd.conf"
 #define HOSTAPD_ARGS_FORMAT "-ddt"
+/*
+ * global ctrl iface socket (hostapd -g option) of global hostapd in warm standby mode,
+ * used to add/remove radio interfaces at runtime
+ */
+#define HOSTAPD_GLOBAL_CTRL_SOCK_NAME "global"
 
 #define HOSTAPD_EXIT_REASON_SUCCESS 0
 /*
@@ -95,6 +101,12 @@
  */
 #define HOSTAPD_EXIT_REASON_LOAD_FAIL 1
 
+/*
+ * hostapd state changes are notified by events, or follow commands sent by wld,
+ * which both make the kept STATUS reply stale: the max age only bounds silent transitions
+ */
+#define HOSTAPD_STATE_MAX_AGE_MS 1000
+
 /*
  * MLD Link wpa socket name format "<IFACEX>_link<Y>"
  */
@@ -137,14 +149,16 @@ T_AccessPoint* wifiGen_hapd_fetchSockApLink(T_AccessPoint* pAPMld, const char* s
     char valStr[128] = {0};
     char ssidStr[64] = {0};
     swl_macBin_t macBin = SWL_MAC_BIN_NEW();
-    if((wld_wpaCtrl_getValueStr(reply, "bssid", valStr, sizeof(valStr)) > 0) &&
+    wld_wpaCtrl_reply_t config;
+    wld_wpaCtrl_reply_parse(&config, reply);
+    if((wld_wpaCtrl_reply_getValueStr(&config, "bssid", valStr, sizeof(valStr)) > 0) &&
        (swl_typeMacBin_fromChar(&macBin, valStr)) && (!swl_mac_binIsNull(&macBin)) &&
        ((pLinkSSID = wld_ssid_getSsidByMacAddress(&macBin)) != NULL)) {
         SAH_TRACEZ_INFO(ME, "sock(%s): GET_CONFIG linkMac(%s) => pSSID(%s)",
                         sockName, swl_typeMacBin_toBuf32(macBin).buf, pLinkSSID->Name);
         return pLinkSSID->AP_HOOK;
     }
-    wld_wpaCtrl_getValueStr(reply, "ssid", ssidStr, sizeof(ssidStr));
+    wld_wpaCtrl_reply_getValueStr(&config, "ssid", ssidStr, sizeof(ssidStr));
     rc = wld_wpaCtrl_queryToSock(serverPath, sockName, "STATUS", reply, sizeof(reply));
     ASSERTI_TRUE(swl_rc_isOk(rc), NULL, ME, "%s: fail to get hostapd status over %s/%s", pAPMld->alias, serverPath, sockName);
     swl_chanspec_t chspec = SWL_CHANSPEC_EMPTY;
@@ -318,8 +332,10 @@ void wifiGen_hapd_initDynCfgParamSupp(T_Radio* pRad) {
      * wld_secDmn_setCfgParamSupp(pRad->hostapd, "custom_param", SWL_TRL_UNKNOWN);
      */
     bool hasRnr = (swl_bit32_getHighest(pRad->supportedStandards) >= SWL_RADSTD_AX);
-    wld_secDmn_setCfgParamSupp(pRad->hostapd, "rnr", hasRnr ? SWL_TRL_TRUE : SWL_TRL_UNKNOWN);
-    wld_secDmn_setCfgParamSupp(pRad->hostapd, "config_id", SWL_TRL_TRUE);
+    wld_secDmn_setCfgParamSuppById(pRad->hostapd, WLD_SECDMN_CFG_PARAM_RNR, hasRnr ? SWL_TRL_TRUE : SWL_TRL_UNKNOWN);
+    wld_secDmn_setCfgParamSuppById(pRad->hostapd, WLD_SECDMN_CFG_PARAM_CONFIG_ID, SWL_TRL_TRUE);
+    /* restore support learned by previous runs of the same hostapd binary */
+    wld_secDmn_loadCfgParamSuppProfile(pRad->hostapd);
 }
 
 swl_rc_ne wifiGen_hapd_init(T_Radio* pRad) {
@@ -415,6 +431,80 @@ void wifiGen_hapd_writeConfig(T_Radio* pRad) {
     wld_hostapd_cfgFile_createExt(pRad);
 }
 
+/*
+ * @brief probe support of dyn cfg params, without rewriting the config file
+ * (params of unknown support can not be written, until their probe pass is done)
+ */
+void wifiGen_hapd_probeDynCfgParams(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, , ME, "NULL");
+    wld_hostapd_config_t* config = NULL;
+    ASSERTS_TRUE(wld_hostapd_createConfig(&config, pRad), , ME, "%s: fail to generate config", pRad->Name);
+    wld_hostapd_deleteConfig(config);
+}
+
+/*
+ * @brief force next config apply to fully reload hostapd
+ * (ie. runtime state diverged from the written config)
+ */
+void wifiGen_hapd_forceConfigReload(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, , ME, "NULL");
+    wld_hostapd_setConfigSnapshotPendingChange(pRad->hapdCfgSnapshot, WLD_HOSTAPD_CFG_CHANGE_FULL);
+}
+
+/*
+ * @brief acknowledge that hostapd has loaded the last written config
+ */
+void wifiGen_hapd_ackConfigReload(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, , ME, "NULL");
+    wld_hostapd_setConfigSnapshotPendingChange(pRad->hapdCfgSnapshot, WLD_HOSTAPD_CFG_CHANGE_NONE);
+}
+
+static bool s_reloadPendingBss(T_Radio* pRad) {
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        if(!wld_hostapd_isConfigSnapshotBssPending(pRad->hapdCfgSnapshot, pAP->alias)) {
+            continue;
+        }
+        SAH_TRACEZ_INFO(ME, "%s: reload bss config", pAP->alias);
+        if(!wld_ap_hostapd_sendCommand(pAP, "RELOAD_BSS", "applyConfig")) {
+            SAH_TRACEZ_WARNING(ME, "%s: fail to reload bss config", pAP->alias);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * @brief apply written config changes with the least impacting method:
+ * - nothing when config was not changed since last applied
+ * - bss reload of the changed bss sections, when general section is unchanged
+ * - full daemon reload otherwise
+ *
+ * @param pRad radio context
+ *
+ * @return SWL_RC_DONE if nothing to apply, SWL_RC_OK on success,
+ *         SWL_RC_CONTINUE when reload of the shared hostapd is delayed to be merged with other members
+ *         requests, or merged into a pending restart (written config is then loaded later), error code otherwise
+ */
+swl_rc_ne wifiGen_hapd_applyConfig(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+    wld_hostapd_cfgChange_e change = wld_hostapd_getConfigSnapshotPendingChange(pRad->hapdCfgSnapshot);
+    swl_rc_ne rc = SWL_RC_DONE;
+    if(change == WLD_HOSTAPD_CFG_CHANGE_NONE) {
+        SAH_TRACEZ_INFO(ME, "%s: hostapd config unchanged: skip reload", pRad->Name);
+        return rc;
+    }
+    if((change == WLD_HOSTAPD_CFG_CHANGE_BSS) && s_reloadPendingBss(pRad)) {
+        rc = SWL_RC_OK;
+    } else {
+        rc = wifiGen_hapd_reloadDaemon(pRad);
+    }
+    if(swl_rc_isOk(rc)) {
+        wifiGen_hapd_ackConfigReload(pRad);
+    }
+    return rc;
+}
+
 static wld_wpaCtrlInterface_t* s_mainInterface(T_Radio* pRad) {
     ASSERTS_NOT_NULL(pRad, NULL, ME, "NULL");
     ASSERTS_NOT_NULL(pRad->hostapd, NULL, ME, "NULL");
@@ -447,10 +537,8 @@ swl_rc_ne wifiGen_hapd_getRadState(T_Radio* pRad, chanmgt_rad_state* pDetailedSt
     ASSERTS_NOT_NULL(mainIface, SWL_RC_ERROR, ME, "%s: No main hapd wpactrl iface", pRad->Name);
     ASSERTI_TRUE(wld_wpaCtrlInterface_isReady(mainIface), SWL_RC_ERROR,
                  ME, "%s: main wpactrl iface is not ready", pRad->Name);
-    char reply[1024] = {0};
     char state[64] = {0};
-    if((!wld_wpaCtrl_sendCmdSynced(mainIface, "STATUS", reply, sizeof(reply) - 1)) ||
-       (wld_wpaCtrl_getValueStr(reply, "state", state, sizeof(state)) <= 0)) {
+    if(!swl_rc_isOk(wld_wpaCtrl_getCachedCmdParamVal(mainIface, "STATUS", "state", HOSTAPD_STATE_MAX_AGE_MS, state, sizeof(state)))) {
         SAH_TRACEZ_INFO(ME, "%s: status not yet available", pRad->Name);
         return SWL_RC_ERROR;
     }
@@ -545,11 +633,20 @@ static char* s_getGlobHapdArgsCb(wld_secDmnGrp_t* pSecDmnGrp, void* userData _UN
     char startArgs[256] = {0};
     //set default start args
     swl_str_copy(startArgs, sizeof(startArgs), HOSTAPD_ARGS_FORMAT);
+    bool warmStandby = wld_secDmnGrp_isWarmStandby(pSecDmnGrp);
+    if(warmStandby) {
+        //open global ctrl iface, to add other radio ifaces at runtime
+        swl_str_catFormat(startArgs, sizeof(startArgs), " -g %s/%s", HOSTAPD_CTRL_IFACE_DIR, HOSTAPD_GLOBAL_CTRL_SOCK_NAME);
+    }
     wld_secDmn_t* grpMembers[wld_secDmnGrp_getMembersCount(pSecDmnGrp) + 1];
     uint32_t nGrpMembers = 0;
     for(uint32_t i = 0; i < wld_secDmnGrp_getMembersCount(pSecDmnGrp); i++) {
         wld_secDmn_t* pSecDmn = (wld_secDmn_t*) wld_secDmnGrp_getMemberByPos(pSecDmnGrp, i);
-        if((pSecDmn != NULL) && (!swl_str_isEmpty(pSecDmn->cfgFile))) {
+        if((pSecDmn == NULL) || (swl_str_isEmpty(pSecDmn->cfgFile))) {
+            continue;
+        }
+        //in warm standby, only load started radios, others are added later
+        if((!warmStandby) || (wld_secDmnGrp_isMemberStarted(pSecDmnGrp, pSecDmn))) {
             grpMembers[nGrpMembers++] = pSecDmn;
         }
     }
@@ -595,10 +692,44 @@ static bool s_hasHapdSchedRestart(wld_secDmnGrp_t* pSecDmnGrp _UNUSED, void* use
     return s_hasRtmSchedState(pRad, GEN_FSM_START_HOSTAPD);
 }
 
+static swl_rc_ne s_queryGlobHapd(const char* cmd) {
+    char reply[128] = {0};
+    swl_rc_ne rc = wld_wpaCtrl_queryToSock(HOSTAPD_CTRL_IFACE_DIR, HOSTAPD_GLOBAL_CTRL_SOCK_NAME, cmd, reply, sizeof(reply));
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "fail to send (%s) to glob hapd", cmd);
+    ASSERT_TRUE(swl_str_startsWith(reply, "OK"), SWL_RC_ERROR, ME, "glob hapd rejected (%s): (%s)", cmd, reply);
+    return SWL_RC_OK;
+}
+
+static swl_rc_ne s_addHapdIfaceCb(wld_secDmnGrp_t* pSecDmnGrp _UNUSED, void* userData _UNUSED, wld_secDmn_t* pSecDmn) {
+    ASSERT_NOT_NULL(pSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    T_Radio* pRad = (T_Radio*) pSecDmn->userData;
+    ASSERT_TRUE(debugIsRadPointer(pRad), SWL_RC_INVALID_PARAM, ME, "INVALID");
+    ASSERT_STR(pSecDmn->cfgFile, SWL_RC_INVALID_STATE, ME, "%s: no hostapd config file", pRad->Name);
+    const char* mainIface = s_getMainIface(pRad);
+    SAH_TRACEZ_WARNING(ME, "%s: add iface %s to glob hostapd", pRad->Name, mainIface);
+    char cmd[256] = {0};
+    swl_str_catFormat(cmd, sizeof(cmd), "ADD %s config=%s", mainIface, pSecDmn->cfgFile);
+    return s_queryGlobHapd(cmd);
+}
+
+static swl_rc_ne s_removeHapdIfaceCb(wld_secDmnGrp_t* pSecDmnGrp _UNUSED, void* userData _UNUSED, wld_secDmn_t* pSecDmn) {
+    ASSERT_NOT_NULL(pSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    T_Radio* pRad = (T_Radio*) pSecDmn->userData;
+    ASSERT_TRUE(debugIsRadPointer(pRad), SWL_RC_INVALID_PARAM, ME, "INVALID");
+    const char* mainIface = s_getMainIface(pRad);
+    SAH_TRACEZ_WARNING(ME, "%s: remove iface %s from glob hostapd", pRad->Name, mainIface);
+    wld_wpaCtrlMngr_disconnect(wld_secDmn_getWpaCtrlMgr(pSecDmn));
+    char cmd[128] = {0};
+    swl_str_catFormat(cmd, sizeof(cmd), "REMOVE %s", mainIface);
+    return s_queryGlobHapd(cmd);
+}
+
 static wld_secDmnGrp_EvtHandlers_t sGHapdEvtCbs = {
     .getArgsCb = s_getGlobHapdArgsCb,
     .isMemberStartableCb = s_isHapdIfaceStartable,
     .hasSchedRestartCb = s_hasHapdSchedRestart,
+    .addMemberCb = s_addHapdIfaceCb,
+    .removeMemberCb = s_removeHapdIfaceCb,
 };
 
 static swl_rc_ne s_initGlobalHapdGrp(vendor_t* pVdr, bool forceGlob) {
@@ -632,6 +763,9 @@ swl_rc_ne wifiGen_hapd_setGlobDmnSettings(vendor_t* pVdr, wld_dmnMgt_dmnExecSett
     }
     bool enableGlobHapd = ((pCfg->useGlobalInstance == SWL_TRL_TRUE) ||
                            ((pCfg->useGlobalInstance == SWL_TRL_AUTO) && gHapd->globalDmnRequired));
+    if((!enableGlobHapd) && (gHapd->pGlobalDmnGrp != NULL)) {
+        wld_secDmnGrp_setWarmStandby(gHapd->pGlobalDmnGrp, false);
+    }
     if(wld_secDmnGrp_isEnabled(gHapd->pGlobalDmnGrp) != enableGlobHapd) {
         if(!enableGlobHapd) {
             SAH_TRACEZ_INFO(ME, "drop all members of gHapd %s", pVdr->name);
@@ -653,6 +787,10 @@ swl_rc_ne wifiGen_hapd_setGlobDmnSettings(vendor_t* pVdr, wld_dmnMgt_dmnExecSett
             }
         }
     }
+    if(enableGlobHapd) {
+        //pre-start global hostapd when warm standby is enabled, to cut radio ifaces bring-up time
+        wld_secDmnGrp_setWarmStandby(gHapd->pGlobalDmnGrp, pCfg->warmStandby);
+    }
     return SWL_RC_OK;
 }
 
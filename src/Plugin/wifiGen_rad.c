@@ -637,6 +637,9 @@ int wifiGen_rad_status(T_Radio* pRad) {
     if(!wld_rad_hasEnabledIface(pRad)) {
         SAH_TRACEZ_INFO(ME, "%s: has no enabled interface", pRad->Name);
         pRad->detailedState = CM_RAD_DOWN;
+    } else if(wld_secDmn_isCrashLooping(pRad->hostapd)) {
+        SAH_TRACEZ_ERROR(ME, "%s: hostapd keeps failing to start", pRad->Name);
+        pRad->detailedState = CM_RAD_ERROR;
     } else if(wld_bgdfs_isRunning(pRad)) {
         // In this situation, there is a background dfs running.
         SAH_TRACEZ_INFO(ME, "%s: background dfs is running", pRad->Name);
@@ -751,6 +754,7 @@ int wifiGen_rad_refresh(T_Radio* pRad, int set) {
     ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERT_TRUE(set & SET, SWL_RC_INVALID_PARAM, ME, "Set Only");
     SAH_TRACEZ_INFO(ME, "%s : set rad_refresh", pRad->Name);
+    wifiGen_hapd_forceConfigReload(pRad);
     setBitLongArray(pRad->fsmRad.FSM_BitActionArray, FSM_BW, GEN_FSM_UPDATE_HOSTAPD);
     wld_rad_doCommitIfUnblocked(pRad);
     return SWL_RC_OK;
@@ -0,0 +1,491 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <amxc/amxc.h>
+
+#include "swl/swl_common.h"
+#include "swl/swl_string.h"
+#include "swl/swl_maps.h"
+#include "Utils/wld_cfgDoc.h"
+#include "Utils/wld_cfgWriter.h"
+
+#define ME "cfgDoc"
+
+#define CFG_DOC_MAX_INDENT 8
+#define CFG_DOC_BLOCK_OPENER "{"
+#define CFG_DOC_BLOCK_CLOSER "}"
+
+typedef struct {
+    uint32_t section;                   /* index of the owner section */
+    size_t lineStart;                   /* offset of the line start */
+    size_t valStart;                    /* offset of the value start */
+    size_t valEnd;                      /* offset of the value end (line feed excluded) */
+} wld_cfgDoc_entry_t;
+
+typedef struct {
+    char* name;                         /* section name, NULL for the header */
+    size_t insertPos;                   /* offset where new keys of the section are inserted */
+    char indent[CFG_DOC_MAX_INDENT + 1]; /* indentation of the section keys */
+} wld_cfgDoc_section_t;
+
+struct wld_cfgDoc {
+    amxc_llist_it_t it;
+    char* path;                         /* config file path */
+    char* buf;                          /* file content */
+    size_t len;                         /* content length */
+    size_t cap;                         /* content buffer size */
+    wld_cfgDoc_entry_t* entries;        /* key lines, in parsing/insertion order */
+    uint32_t nEntries;
+    uint32_t maxEntries;
+    wld_cfgDoc_section_t* sections;     /* sections, in file order, header first */
+    uint32_t nSections;
+    swl_mapCharInt32_t index;           /* "<section>:<key>" => entry position */
+    struct stat fileStat;               /* file status when last loaded or written */
+    bool dirty;                         /* content has uncommitted patches */
+};
+
+static amxc_llist_t sDocs = {NULL, NULL};
+
+static bool s_buildIndexKey(char* idxKey, size_t idxKeySize, uint32_t section, const char* key, size_t keyLen) {
+    int ret = snprintf(idxKey, idxKeySize, "%u:%.*s", section, (int) keyLen, key);
+    return ((ret > 0) && (ret < (int) idxKeySize));
+}
+
+static void s_clearContent(wld_cfgDoc_t* pDoc) {
+    for(uint32_t i = 0; i < pDoc->nSections; i++) {
+        free(pDoc->sections[i].name);
+    }
+    W_SWL_FREE(pDoc->sections);
+    pDoc->nSections = 0;
+    W_SWL_FREE(pDoc->entries);
+    pDoc->nEntries = 0;
+    pDoc->maxEntries = 0;
+    W_SWL_FREE(pDoc->buf);
+    pDoc->len = 0;
+    pDoc->cap = 0;
+    swl_mapCharInt32_cleanup(&pDoc->index);
+    pDoc->dirty = false;
+}
+
+static void s_freeDoc(wld_cfgDoc_t* pDoc) {
+    amxc_llist_it_take(&pDoc->it);
+    s_clearContent(pDoc);
+    free(pDoc->path);
+    free(pDoc);
+}
+
+static bool s_reserve(wld_cfgDoc_t* pDoc, size_t len) {
+    ASSERTS_TRUE(len >= pDoc->cap, true, ME, "enough room");
+    size_t cap = SWL_MAX(pDoc->cap * 2, len + 1);
+    char* buf = realloc(pDoc->buf, cap);
+    ASSERT_NOT_NULL(buf, false, ME, "fail to grow %s content to %zu", pDoc->path, cap);
+    pDoc->buf = buf;
+    pDoc->cap = cap;
+    return true;
+}
+
+static int32_t s_addSection(wld_cfgDoc_t* pDoc, const char* name, size_t nameLen, size_t insertPos) {
+    wld_cfgDoc_section_t* sections = realloc(pDoc->sections, (pDoc->nSections + 1) * sizeof(*sections));
+    ASSERT_NOT_NULL(sections, -1, ME, "fail to alloc section");
+    pDoc->sections = sections;
+    wld_cfgDoc_section_t* pSection = &sections[pDoc->nSections];
+    memset(pSection, 0, sizeof(*pSection));
+    if(name != NULL) {
+        pSection->name = strndup(name, nameLen);
+    }
+    pSection->insertPos = insertPos;
+    return pDoc->nSections++;
+}
+
+static bool s_addEntry(wld_cfgDoc_t* pDoc, uint32_t section, size_t lineStart, size_t keyStart, size_t valStart, size_t valEnd) {
+    if(pDoc->nEntries >= pDoc->maxEntries) {
+        uint32_t maxEntries = SWL_MAX(pDoc->maxEntries * 2, (uint32_t) 64);
+        wld_cfgDoc_entry_t* entries = realloc(pDoc->entries, maxEntries * sizeof(*entries));
+        ASSERT_NOT_NULL(entries, false, ME, "fail to alloc entries");
+        pDoc->entries = entries;
+        pDoc->maxEntries = maxEntries;
+    }
+    char idxKey[128];
+    ASSERT_TRUE(s_buildIndexKey(idxKey, sizeof(idxKey), section, &pDoc->buf[keyStart], valStart - 1 - keyStart),
+                false, ME, "key too long");
+    if(swl_map_get(&pDoc->index, idxKey) == NULL) {
+        // only first occurrence of a key is indexed
+        swl_mapCharInt32_addOrSet(&pDoc->index, idxKey, pDoc->nEntries);
+    }
+    wld_cfgDoc_entry_t* pEntry = &pDoc->entries[pDoc->nEntries++];
+    pEntry->section = section;
+    pEntry->lineStart = lineStart;
+    pEntry->valStart = valStart;
+    pEntry->valEnd = valEnd;
+    return true;
+}
+
+static bool s_isSectionKey(const char* key, size_t keyLen, const char* const* sectionKeys, uint32_t nSectionKeys) {
+    for(uint32_t i = 0; i < nSectionKeys; i++) {
+        if((strlen(sectionKeys[i]) == keyLen) && (strncmp(sectionKeys[i], key, keyLen) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @brief index the sections and key lines of the loaded content
+ */
+static bool s_parse(wld_cfgDoc_t* pDoc, const char* const* sectionKeys, uint32_t nSectionKeys) {
+    swl_mapCharInt32_init(&pDoc->index);
+    ASSERT_EQUALS(s_addSection(pDoc, NULL, 0, 0), 0, false, ME, "fail to add header");
+    uint32_t curSection = 0;
+    // section enclosing the current block section, restored when the block is closed
+    uint32_t outerSection = 0;
+    size_t lineStart = 0;
+    while(lineStart < pDoc->len) {
+        char* line = &pDoc->buf[lineStart];
+        char* lineEnd = strchr(line, '\n');
+        size_t nextLine = (lineEnd - pDoc->buf) + 1;
+        char* key = line;
+        while((*key == ' ') || (*key == '\t')) {
+            key++;
+        }
+        char* eq = memchr(key, '=', lineEnd - key);
+        if((*key == '#') || (key == lineEnd)) {
+            lineStart = nextLine;
+            continue;
+        }
+        if(eq == NULL) {
+            if(strncmp(key, CFG_DOC_BLOCK_CLOSER, strlen(CFG_DOC_BLOCK_CLOSER)) == 0) {
+                curSection = outerSection;
+            }
+            lineStart = nextLine;
+            continue;
+        }
+        size_t keyLen = eq - key;
+        char* val = eq + 1;
+        size_t valLen = lineEnd - val;
+        if(s_isSectionKey(key, keyLen, sectionKeys, nSectionKeys)) {
+            bool isBlock = ((valLen == strlen(CFG_DOC_BLOCK_OPENER)) && (strncmp(val, CFG_DOC_BLOCK_OPENER, valLen) == 0));
+            int32_t section = isBlock ? s_addSection(pDoc, key, keyLen, nextLine) : s_addSection(pDoc, val, valLen, nextLine);
+            ASSERT_FALSE(section < 0, false, ME, "fail to add section");
+            if(isBlock) {
+                outerSection = curSection;
+                curSection = section;
+                lineStart = nextLine;
+                continue;
+            }
+            curSection = section;
+        }
+        wld_cfgDoc_section_t* pSection = &pDoc->sections[curSection];
+        if((size_t) (key - line) <= CFG_DOC_MAX_INDENT) {
+            memcpy(pSection->indent, line, key - line);
+            pSection->indent[key - line] = 0;
+        }
+        ASSERT_TRUE(s_addEntry(pDoc, curSection, lineStart, key - pDoc->buf, val - pDoc->buf, lineEnd - pDoc->buf),
+                    false, ME, "fail to add entry");
+        pSection->insertPos = nextLine;
+        lineStart = nextLine;
+    }
+    return true;
+}
+
+static bool s_statFile(const char* path, struct stat* pSt) {
+    return (stat(path, pSt) == 0);
+}
+
+static bool s_isFileChanged(wld_cfgDoc_t* pDoc, const struct stat* pSt) {
+    return ((pDoc->fileStat.st_ino != pSt->st_ino) ||
+            (pDoc->fileStat.st_size != pSt->st_size) ||
+            (pDoc->fileStat.st_mtim.tv_sec != pSt->st_mtim.tv_sec) ||
+            (pDoc->fileStat.st_mtim.tv_nsec != pSt->st_mtim.tv_nsec));
+}
+
+static bool s_load(wld_cfgDoc_t* pDoc, const struct stat* pSt, const char* const* sectionKeys, uint32_t nSectionKeys) {
+    s_clearContent(pDoc);
+    FILE* fp = fopen(pDoc->path, "r");
+    ASSERT_NOT_NULL(fp, false, ME, "fail to open %s (%d:%s)", pDoc->path, errno, strerror(errno));
+    size_t len = pSt->st_size;
+    bool ok = s_reserve(pDoc, len + 1);
+    if(ok) {
+        pDoc->len = fread(pDoc->buf, 1, len, fp);
+        ok = (pDoc->len == len);
+    }
+    fclose(fp);
+    ASSERT_TRUE(ok, false, ME, "fail to read %s", pDoc->path);
+    // content is NUL free text, where each line ends with a line feed
+    pDoc->len = strnlen(pDoc->buf, pDoc->len);
+    if((pDoc->len > 0) && (pDoc->buf[pDoc->len - 1] != '\n')) {
+        pDoc->buf[pDoc->len++] = '\n';
+    }
+    pDoc->buf[pDoc->len] = 0;
+    pDoc->fileStat = *pSt;
+    ASSERT_TRUE(s_parse(pDoc, sectionKeys, nSectionKeys), false, ME, "fail to parse %s", pDoc->path);
+    SAH_TRACEZ_INFO(ME, "%s: loaded %u keys in %u sections", pDoc->path, pDoc->nEntries, pDoc->nSections);
+    return true;
+}
+
+static wld_cfgDoc_t* s_findDoc(const char* path) {
+    amxc_llist_for_each(it, &sDocs) {
+        wld_cfgDoc_t* pDoc = amxc_container_of(it, wld_cfgDoc_t, it);
+        if(swl_str_matches(pDoc->path, path)) {
+            return pDoc;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * @brief get the in-memory document of a config file, loading it when not yet cached,
+ * or when the file was changed on disk since last load/commit.
+ * When reloaded, uncommitted patches are dropped.
+ *
+ * @param path config file path
+ * @param sectionKeys keys opening config sections
+ * @param nSectionKeys number of section keys
+ *
+ * @return pointer to the document, or NULL if the file can not be loaded
+ */
+wld_cfgDoc_t* wld_cfgDoc_get(const char* path, const char* const* sectionKeys, uint32_t nSectionKeys) {
+    ASSERT_STR(path, NULL, ME, "Empty path");
+    wld_cfgDoc_t* pDoc = s_findDoc(path);
+    struct stat st;
+    if(!s_statFile(path, &st)) {
+        SAH_TRACEZ_INFO(ME, "%s: missing file (%d:%s)", path, errno, strerror(errno));
+        if(pDoc != NULL) {
+            s_freeDoc(pDoc);
+        }
+        return NULL;
+    }
+    if((pDoc != NULL) && (!s_isFileChanged(pDoc, &st))) {
+        return pDoc;
+    }
+    if(pDoc == NULL) {
+        pDoc = calloc(1, sizeof(*pDoc));
+        ASSERT_NOT_NULL(pDoc, NULL, ME, "fail to alloc doc");
+        swl_str_copyMalloc(&pDoc->path, path);
+        amxc_llist_append(&sDocs, &pDoc->it);
+    } else if(pDoc->dirty) {
+        SAH_TRACEZ_WARNING(ME, "%s: changed on disk, drop uncommitted patches", path);
+    }
+    if(!s_load(pDoc, &st, sectionKeys, nSectionKeys)) {
+        s_freeDoc(pDoc);
+        return NULL;
+    }
+    return pDoc;
+}
+
+static int32_t s_findSection(wld_cfgDoc_t* pDoc, const char* section) {
+    for(uint32_t i = 0; i < pDoc->nSections; i++) {
+        if(swl_str_matches(pDoc->sections[i].name, section) || ((section == NULL) && (pDoc->sections[i].name == NULL))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static wld_cfgDoc_entry_t* s_findEntry(wld_cfgDoc_t* pDoc, uint32_t section, const char* key) {
+    char idxKey[128];
+    ASSERTS_TRUE(s_buildIndexKey(idxKey, sizeof(idxKey), section, key, strlen(key)), NULL, ME, "key too long");
+    int32_t* pPos = swl_map_get(&pDoc->index, idxKey);
+    ASSERTS_NOT_NULL(pPos, NULL, ME, "key %s not found", key);
+    return &pDoc->entries[*pPos];
+}
+
+/*
+ * @brief get value of a key, as written in the file
+ *
+ * @param pDoc pointer to document
+ * @param section section name, NULL for the header
+ * @param key the key to look for
+ * @param pLen output value length (the returned value is not NUL terminated)
+ *
+ * @return pointer to value in the document content, NULL if the key is not found
+ */
+const char* wld_cfgDoc_getValue(wld_cfgDoc_t* pDoc, const char* section, const char* key, size_t* pLen) {
+    ASSERT_NOT_NULL(pDoc, NULL, ME, "NULL");
+    ASSERT_STR(key, NULL, ME, "Empty key");
+    int32_t sectionIdx = s_findSection(pDoc, section);
+    ASSERTS_FALSE(sectionIdx < 0, NULL, ME, "%s: section %s not found", pDoc->path, section);
+    wld_cfgDoc_entry_t* pEntry = s_findEntry(pDoc, sectionIdx, key);
+    ASSERTS_NOT_NULL(pEntry, NULL, ME, "%s: key %s not found", pDoc->path, key);
+    if(pLen != NULL) {
+        *pLen = pEntry->valEnd - pEntry->valStart;
+    }
+    return &pDoc->buf[pEntry->valStart];
+}
+
+/*
+ * @brief replace content range [pos, pos+oldLen[ with newStr, and shift all following offsets
+ */
+static bool s_splice(wld_cfgDoc_t* pDoc, size_t pos, size_t oldLen, const char* newStr, size_t newLen) {
+    ASSERT_TRUE(s_reserve(pDoc, pDoc->len - oldLen + newLen + 1), false, ME, "fail to patch %s", pDoc->path);
+    memmove(&pDoc->buf[pos + newLen], &pDoc->buf[pos + oldLen], pDoc->len - pos - oldLen + 1);
+    memcpy(&pDoc->buf[pos], newStr, newLen);
+    pDoc->len = pDoc->len - oldLen + newLen;
+    size_t from = pos + oldLen;
+#define M_SHIFT(off) if((off) >= from) { (off) = (off) - oldLen + newLen; }
+    for(uint32_t i = 0; i < pDoc->nEntries; i++) {
+        wld_cfgDoc_entry_t* pEntry = &pDoc->entries[i];
+        M_SHIFT(pEntry->lineStart);
+        M_SHIFT(pEntry->valStart);
+        M_SHIFT(pEntry->valEnd);
+    }
+    for(uint32_t i = 0; i < pDoc->nSections; i++) {
+        M_SHIFT(pDoc->sections[i].insertPos);
+    }
+#undef M_SHIFT
+    pDoc->dirty = true;
+    return true;
+}
+
+/*
+ * @brief set the value of a key, by patching in place the line of the key,
+ * or by inserting a new line at the end of the section.
+ * Value is escaped, as done when writing the full config.
+ *
+ * @param pDoc pointer to document
+ * @param section section name, NULL for the header
+ * @param key the key to add/update
+ * @param value the new key value
+ *
+ * @return SWL_RC_OK if the key is patched, SWL_RC_DONE if the value is unchanged, error code otherwise
+ */
+swl_rc_ne wld_cfgDoc_set(wld_cfgDoc_t* pDoc, const char* section, const char* key, const char* value) {
+    ASSERT_NOT_NULL(pDoc, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_STR(key, SWL_RC_INVALID_PARAM, ME, "Empty key");
+    ASSERT_NOT_NULL(value, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NULL(strpbrk(value, "\n"), SWL_RC_INVALID_PARAM, ME, "multi-line value of %s", key);
+    int32_t sectionIdx = s_findSection(pDoc, section);
+    ASSERT_FALSE(sectionIdx < 0, SWL_RC_INVALID_PARAM, ME, "%s: section %s not found", pDoc->path, section);
+
+    size_t rawLen = strlen(value);
+    char escVal[(rawLen * 2) + 1];
+    size_t escLen = 0;
+    for(size_t i = 0; i < rawLen; i++) {
+        if(value[i] == '\\') {
+            escVal[escLen++] = '\\';
+        }
+        escVal[escLen++] = value[i];
+    }
+    escVal[escLen] = 0;
+
+    wld_cfgDoc_entry_t* pEntry = s_findEntry(pDoc, sectionIdx, key);
+    if(pEntry != NULL) {
+        size_t curLen = pEntry->valEnd - pEntry->valStart;
+        ASSERTS_FALSE((curLen == escLen) && (memcmp(&pDoc->buf[pEntry->valStart], escVal, escLen) == 0),
+                      SWL_RC_DONE, ME, "%s: %s unchanged", pDoc->path, key);
+        size_t valStart = pEntry->valStart;
+        ASSERT_TRUE(s_splice(pDoc, valStart, curLen, escVal, escLen), SWL_RC_ERROR, ME, "fail to patch %s", key);
+        // an empty value starts where it ends, so it was shifted too
+        pEntry->valStart = valStart;
+        return SWL_RC_OK;
+    }
+
+    wld_cfgDoc_section_t* pSection = &pDoc->sections[sectionIdx];
+    size_t indentLen = strlen(pSection->indent);
+    size_t keyLen = strlen(key);
+    size_t lineLen = indentLen + keyLen + 1 + escLen + 1;
+    char line[lineLen + 1];
+    snprintf(line, sizeof(line), "%s%s=%s\n", pSection->indent, key, escVal);
+    size_t pos = pSection->insertPos;
+    ASSERT_TRUE(s_splice(pDoc, pos, 0, line, lineLen), SWL_RC_ERROR, ME, "fail to insert %s", key);
+    ASSERT_TRUE(s_addEntry(pDoc, sectionIdx, pos, pos + indentLen, pos + indentLen + keyLen + 1, pos + lineLen - 1),
+                SWL_RC_ERROR, ME, "fail to index %s", key);
+    return SWL_RC_OK;
+}
+
+bool wld_cfgDoc_isDirty(wld_cfgDoc_t* pDoc) {
+    ASSERTS_NOT_NULL(pDoc, false, ME, "NULL");
+    return pDoc->dirty;
+}
+
+/*
+ * @brief flush all patches applied since last commit, with one atomic file write
+ *
+ * @param pDoc pointer to document
+ *
+ * @return SWL_RC_OK if written, SWL_RC_DONE if nothing to write, error code otherwise
+ */
+swl_rc_ne wld_cfgDoc_commit(wld_cfgDoc_t* pDoc) {
+    ASSERT_NOT_NULL(pDoc, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTS_TRUE(pDoc->dirty, SWL_RC_DONE, ME, "%s: nothing to commit", pDoc->path);
+    swl_rc_ne rc = wld_cfgWriter_writeFile(pDoc->path, pDoc->buf, pDoc->len, wld_cfgWriter_getDefaultFlags());
+    ASSERT_TRUE(swl_rc_isOk(rc), rc, ME, "fail to write %s", pDoc->path);
+    pDoc->dirty = false;
+    if(!s_statFile(pDoc->path, &pDoc->fileStat)) {
+        // force reload on next access
+        memset(&pDoc->fileStat, 0, sizeof(pDoc->fileStat));
+    }
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief release the cached document of a config file
+ */
+void wld_cfgDoc_drop(const char* path) {
+    wld_cfgDoc_t* pDoc = s_findDoc(path);
+    ASSERTS_NOT_NULL(pDoc, , ME, "%s: not cached", path);
+    s_freeDoc(pDoc);
+}
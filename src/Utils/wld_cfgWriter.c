@@ -0,0 +1,308 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "swl/swl_common.h"
+#include "swl/swl_string.h"
+#include "swl/swl_maps.h"
+#include "Utils/wld_cfgWriter.h"
+
+#define ME "cfgWrtr"
+
+#define CFG_WRITER_INIT_SIZE 4096
+
+struct wld_cfgWriter {
+    char* buf;                          /* rendered content, kept allocated between writes */
+    size_t len;                         /* content length */
+    size_t cap;                         /* content buffer size */
+    bool failed;                        /* rendering failed: content is incomplete */
+    uint64_t renderStartUs;             /* mono time of rendering start */
+};
+
+static wld_cfgWriter_t sWriter;
+static wld_cfgWriter_stats_t sStats;
+static uint32_t sDefaultFlags = 0;
+
+static uint64_t s_nowUs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000ULL) + ((uint64_t) ts.tv_nsec / 1000);
+}
+
+static uint32_t s_elapsedUs(uint64_t startUs) {
+    uint64_t elapsed = s_nowUs() - startUs;
+    return (elapsed > UINT32_MAX) ? UINT32_MAX : (uint32_t) elapsed;
+}
+
+static bool s_reserve(wld_cfgWriter_t* pWriter, size_t addLen) {
+    ASSERTS_FALSE(pWriter->failed, false, ME, "rendering already failed");
+    size_t len = pWriter->len + addLen;
+    ASSERTS_TRUE(len >= pWriter->cap, true, ME, "enough room");
+    size_t cap = SWL_MAX(SWL_MAX(pWriter->cap * 2, len + 1), (size_t) CFG_WRITER_INIT_SIZE);
+    char* buf = realloc(pWriter->buf, cap);
+    if(buf == NULL) {
+        SAH_TRACEZ_ERROR(ME, "fail to grow content buffer to %zu", cap);
+        pWriter->failed = true;
+        return false;
+    }
+    pWriter->buf = buf;
+    pWriter->cap = cap;
+    return true;
+}
+
+/*
+ * @brief start rendering a new config file content
+ * The returned writer is shared and reused: content must be committed
+ * before starting another one.
+ *
+ * @return pointer to the writer, with empty content
+ */
+wld_cfgWriter_t* wld_cfgWriter_start(void) {
+    wld_cfgWriter_t* pWriter = &sWriter;
+    pWriter->len = 0;
+    pWriter->failed = false;
+    if(pWriter->buf != NULL) {
+        pWriter->buf[0] = '\0';
+    }
+    pWriter->renderStartUs = s_nowUs();
+    return pWriter;
+}
+
+bool wld_cfgWriter_addStr(wld_cfgWriter_t* pWriter, const char* str) {
+    ASSERT_NOT_NULL(pWriter, false, ME, "NULL");
+    size_t len = swl_str_len(str);
+    ASSERTS_TRUE(len > 0, true, ME, "empty");
+    ASSERTS_TRUE(s_reserve(pWriter, len), false, ME, "no room");
+    memcpy(&pWriter->buf[pWriter->len], str, len);
+    pWriter->len += len;
+    pWriter->buf[pWriter->len] = '\0';
+    return true;
+}
+
+bool wld_cfgWriter_addFormat(wld_cfgWriter_t* pWriter, const char* format, ...) {
+    ASSERT_NOT_NULL(pWriter, false, ME, "NULL");
+    ASSERT_NOT_NULL(format, false, ME, "NULL");
+    ASSERTS_FALSE(pWriter->failed, false, ME, "rendering already failed");
+    va_list args;
+    va_start(args, format);
+    size_t room = pWriter->cap - pWriter->len;
+    int ret = vsnprintf((room > 0) ? &pWriter->buf[pWriter->len] : NULL, room, format, args);
+    va_end(args);
+    if(ret < 0) {
+        SAH_TRACEZ_ERROR(ME, "fail to format %s", format);
+        pWriter->failed = true;
+        return false;
+    }
+    if((size_t) ret >= room) {
+        ASSERTS_TRUE(s_reserve(pWriter, ret), false, ME, "no room");
+        va_start(args, format);
+        vsnprintf(&pWriter->buf[pWriter->len], pWriter->cap - pWriter->len, format, args);
+        va_end(args);
+    }
+    pWriter->len += ret;
+    return true;
+}
+
+static bool s_addEsc(wld_cfgWriter_t* pWriter, const char* str, const char* escChars, char escChar) {
+    size_t len = swl_str_len(str);
+    // worst case: all chars escaped
+    ASSERTS_TRUE(s_reserve(pWriter, 2 * len), false, ME, "no room");
+    for(size_t i = 0; i < len; i++) {
+        if((escChars != NULL) && (strchr(escChars, str[i]) != NULL)) {
+            pWriter->buf[pWriter->len++] = escChar;
+        }
+        pWriter->buf[pWriter->len++] = str[i];
+    }
+    pWriter->buf[pWriter->len] = '\0';
+    return true;
+}
+
+/*
+ * @brief render all map entries as "key=value" lines,
+ * prefixing with escChar any char of escChars
+ */
+bool wld_cfgWriter_addMapEsc(wld_cfgWriter_t* pWriter, swl_mapChar_t* pMap, const char* escChars, char escChar) {
+    ASSERT_NOT_NULL(pWriter, false, ME, "NULL");
+    ASSERT_NOT_NULL(pMap, false, ME, "NULL");
+    swl_mapIt_t it;
+    swl_map_for_each(it, pMap) {
+        if((!s_addEsc(pWriter, (const char*) swl_map_itKey(&it), escChars, escChar)) ||
+           (!wld_cfgWriter_addStr(pWriter, "=")) ||
+           (!s_addEsc(pWriter, (const char*) swl_map_itValue(&it), escChars, escChar)) ||
+           (!wld_cfgWriter_addStr(pWriter, "\n"))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* wld_cfgWriter_getContent(wld_cfgWriter_t* pWriter, size_t* pLen) {
+    ASSERT_NOT_NULL(pWriter, NULL, ME, "NULL");
+    W_SWL_SETPTR(pLen, pWriter->len);
+    return (pWriter->buf != NULL) ? pWriter->buf : "";
+}
+
+/*
+ * @brief write a content buffer into a file, with a single write
+ *
+ * @param path target file path
+ * @param buf content to write
+ * @param len content length
+ * @param flags M_WLD_CFG_WRITER_xxx flags:
+ *              - FSYNC: content is synced to storage before being renamed over the target
+ *              - DIRECT: target is truncated and written in place (no tmp file/rename)
+ *
+ * @return SWL_RC_OK on success, error code otherwise
+ */
+swl_rc_ne wld_cfgWriter_writeFile(const char* path, const char* buf, size_t len, uint32_t flags) {
+    ASSERT_STR(path, SWL_RC_INVALID_PARAM, ME, "Empty path");
+    ASSERT_TRUE((buf != NULL) || (len == 0), SWL_RC_INVALID_PARAM, ME, "NULL");
+    bool direct = ((flags & M_WLD_CFG_WRITER_DIRECT) != 0);
+    char tmpName[strlen(path) + 16];
+    snprintf(tmpName, sizeof(tmpName), "%s.tmp.txt", path);
+    const char* target = direct ? path : tmpName;
+    int fd = open(target, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    ASSERT_TRUE(fd >= 0, SWL_RC_ERROR, ME, "fail to open %s (%d:%s)", target, errno, strerror(errno));
+    size_t done = 0;
+    bool ok = true;
+    while(ok && (done < len)) {
+        ssize_t ret = write(fd, &buf[done], len - done);
+        if(ret > 0) {
+            done += ret;
+        } else if((ret < 0) && (errno == EINTR)) {
+            continue;
+        } else {
+            ok = false;
+        }
+    }
+    if(ok && ((flags & M_WLD_CFG_WRITER_FSYNC) != 0)) {
+        ok = (fsync(fd) == 0);
+    }
+    ok &= (close(fd) == 0);
+    if(ok && (!direct)) {
+        ok = (rename(tmpName, path) == 0);
+    }
+    if(!ok) {
+        SAH_TRACEZ_ERROR(ME, "fail to write %s (%d:%s)", path, errno, strerror(errno));
+        if(!direct) {
+            unlink(tmpName);
+        }
+        return SWL_RC_ERROR;
+    }
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief write rendered content into the target file, and account render/write durations
+ *
+ * @param pWriter pointer to writer
+ * @param path target file path
+ * @param flags M_WLD_CFG_WRITER_xxx flags
+ *
+ * @return SWL_RC_OK on success, error code otherwise
+ */
+swl_rc_ne wld_cfgWriter_commit(wld_cfgWriter_t* pWriter, const char* path, uint32_t flags) {
+    ASSERT_NOT_NULL(pWriter, SWL_RC_INVALID_PARAM, ME, "NULL");
+    uint32_t renderUs = s_elapsedUs(pWriter->renderStartUs);
+    if(pWriter->failed) {
+        SAH_TRACEZ_ERROR(ME, "%s: content rendering failed", path);
+        sStats.nErrors++;
+        return SWL_RC_ERROR;
+    }
+    uint64_t writeStartUs = s_nowUs();
+    swl_rc_ne rc = wld_cfgWriter_writeFile(path, pWriter->buf, pWriter->len, flags);
+    uint32_t writeUs = s_elapsedUs(writeStartUs);
+    if(rc < SWL_RC_OK) {
+        sStats.nErrors++;
+        return rc;
+    }
+    sStats.nWrites++;
+    sStats.lastSize = pWriter->len;
+    sStats.lastRenderUs = renderUs;
+    sStats.lastWriteUs = writeUs;
+    sStats.maxRenderUs = SWL_MAX(sStats.maxRenderUs, renderUs);
+    sStats.maxWriteUs = SWL_MAX(sStats.maxWriteUs, writeUs);
+    SAH_TRACEZ_INFO(ME, "%s: written %zu bytes (render:%u us, write:%u us)", path, pWriter->len, renderUs, writeUs);
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief set flags used by default when writing daemons config files
+ * (ie. FSYNC on platforms where config must survive power loss)
+ */
+void wld_cfgWriter_setDefaultFlags(uint32_t flags) {
+    sDefaultFlags = flags;
+}
+
+uint32_t wld_cfgWriter_getDefaultFlags(void) {
+    return sDefaultFlags;
+}
+
+const wld_cfgWriter_stats_t* wld_cfgWriter_getStats(void) {
+    return &sStats;
+}
@@ -65,6 +65,7 @@
 #include "swla/swla_dm.h"
 
 #include "Utils/wld_config.h"
+#include "Utils/wld_cfgWriter.h"
 
 #define ME "wldCfg"
 
@@ -115,8 +116,24 @@ static void s_setEnableSyncMode_pwf(void* priv _UNUSED, amxd_object_t* object _U
     s_curSyncMode = newMode;
 }
 
+/* same order as M_WLD_CFG_WRITER_xxx flags */
+static const char* s_cfgWriterFlags_str[] = {"Fsync", "Direct"};
+
+static void s_setConfigFileWriteFlags_pwf(void* priv _UNUSED, amxd_object_t* object _UNUSED,
+                                          amxd_param_t* param _UNUSED,
+                                          const amxc_var_t* const newValue) {
+    char* newFlagsStr = amxc_var_get_cstring_t(newValue);
+    uint32_t newFlags = swl_conv_charToMask(newFlagsStr, s_cfgWriterFlags_str, SWL_ARRAY_SIZE(s_cfgWriterFlags_str));
+    free(newFlagsStr);
+
+    ASSERTI_NOT_EQUALS(newFlags, wld_cfgWriter_getDefaultFlags(), , ME, "EQUAL");
+    SAH_TRACEZ_INFO(ME, "update config file write flags 0x%x to 0x%x", wld_cfgWriter_getDefaultFlags(), newFlags);
+    wld_cfgWriter_setDefaultFlags(newFlags);
+}
+
 SWLA_DM_HDLRS(sWldConfigParamChangeHandlers,
-              ARR(SWLA_DM_PARAM_HDLR("EnableSyncMode", s_setEnableSyncMode_pwf)));
+              ARR(SWLA_DM_PARAM_HDLR("EnableSyncMode", s_setEnableSyncMode_pwf),
+                  SWLA_DM_PARAM_HDLR("ConfigFileWriteFlags", s_setConfigFileWriteFlags_pwf)));
 
 void _wld_config_setConf_ocf(const char* const sig_name,
                              const amxc_var_t* const data,
@@ -61,6 +61,7 @@
 ****************************************************************************/
 
 #include <stdlib.h>
+#include <unistd.h>
 #include "wld.h"
 #include "wld_daemon.h"
 #include "swl/swl_common.h"
@@ -68,12 +69,20 @@
 
 #define ME "wldDmn"
 
+#define RESTART_DELAY_MS 100
+
 const char* g_str_wld_dmn_state[] = {"Init", "Up", "Down", "Error", "Error", "Destroyed", "Restarting", };
 
+const uint32_t wld_dmn_readyHistBoundsMs[WLD_DMN_READY_HIST_SIZE - 1] = {100, 250, 500, 1000, 2000, 5000, 10000};
+
 static wld_daemonMonitorConf_t s_dmnMoniConf = {
     .enableParam = false,
     .instantRestartLimit = 3,
     .minRestartInterval = 1800,
+    .supervise = false,
+    .backoffInitMs = 500,
+    .backoffMaxMs = 60000,
+    .crashLoopLimit = 5,
 };
 
 void wld_dmn_setMonitorConf(wld_daemonMonitorConf_t* pDmnMoniConf) {
@@ -81,6 +90,68 @@ void wld_dmn_setMonitorConf(wld_daemonMonitorConf_t* pDmnMoniConf) {
     s_dmnMoniConf.enableParam = pDmnMoniConf->enableParam;
     s_dmnMoniConf.instantRestartLimit = pDmnMoniConf->instantRestartLimit;
     s_dmnMoniConf.minRestartInterval = pDmnMoniConf->minRestartInterval;
+    s_dmnMoniConf.supervise = pDmnMoniConf->supervise;
+    if(pDmnMoniConf->backoffInitMs > 0) {
+        s_dmnMoniConf.backoffInitMs = pDmnMoniConf->backoffInitMs;
+    }
+    if(pDmnMoniConf->backoffMaxMs > 0) {
+        s_dmnMoniConf.backoffMaxMs = pDmnMoniConf->backoffMaxMs;
+    }
+    if(pDmnMoniConf->crashLoopLimit > 0) {
+        s_dmnMoniConf.crashLoopLimit = pDmnMoniConf->crashLoopLimit;
+    }
+}
+
+/*
+ * @brief get restart delay after consecutive failed startups:
+ * doubled on each failure, from backoffInitMs up to backoffMaxMs,
+ * with +/-20% jitter, to avoid restarting multiple daemons in lockstep
+ *
+ * @param pDmnMoniConf monitor configuration
+ * @param nStartupFails number of consecutive failed startups (>= 1)
+ *
+ * @return restart delay in ms
+ */
+uint32_t wld_dmn_getStartupBackoffMs(const wld_daemonMonitorConf_t* pDmnMoniConf, uint32_t nStartupFails) {
+    ASSERTS_NOT_NULL(pDmnMoniConf, RESTART_DELAY_MS, ME, "NULL");
+    static bool seeded = false;
+    if(!seeded) {
+        /* jitter must differ between processes restarted in lockstep */
+        srand((unsigned int) (time(NULL) ^ getpid()));
+        seeded = true;
+    }
+    uint64_t delay = pDmnMoniConf->backoffInitMs;
+    uint32_t shift = SWL_MIN(SWL_MAX(nStartupFails, 1U) - 1, 31U);
+    delay <<= shift;
+    delay = SWL_MIN(delay, (uint64_t) pDmnMoniConf->backoffMaxMs);
+    uint64_t jitterRange = delay / 5;
+    delay = delay - jitterRange + ((uint64_t) rand() % (2 * jitterRange + 1));
+    delay = SWL_MIN(delay, (uint64_t) pDmnMoniConf->backoffMaxMs);
+    return SWL_MAX((uint32_t) delay, (uint32_t) RESTART_DELAY_MS);
+}
+
+/*
+ * @brief get restart delay after a crash of a running process (ready process in supervisor mode):
+ * immediate, unless more than instantRestartLimit crashes occurred,
+ * and the previous one less than minRestartInterval seconds ago
+ *
+ * @param pDmnMoniConf monitor configuration
+ * @param nCrashes number of crashes, including the last one
+ * @param elapsedSec seconds since the previous crash
+ *
+ * @return restart delay in ms
+ */
+uint32_t wld_dmn_getCrashRestartDelayMs(const wld_daemonMonitorConf_t* pDmnMoniConf, uint32_t nCrashes, double elapsedSec) {
+    ASSERTS_NOT_NULL(pDmnMoniConf, RESTART_DELAY_MS, ME, "NULL");
+    if((pDmnMoniConf->instantRestartLimit >= 0) &&
+       (nCrashes > (uint32_t) pDmnMoniConf->instantRestartLimit) &&
+       (pDmnMoniConf->minRestartInterval > (uint32_t) elapsedSec)) {
+        uint32_t restartInterval = (nCrashes == (uint32_t) pDmnMoniConf->instantRestartLimit + 1) ?
+            pDmnMoniConf->minRestartInterval :
+            (uint32_t) (pDmnMoniConf->minRestartInterval - elapsedSec);
+        return restartInterval * 1000;
+    }
+    return RESTART_DELAY_MS;
 }
 
 static void s_deamonStarter(amxp_timer_t* timer _UNUSED, void* userdata) {
@@ -303,6 +374,8 @@ bool wld_dmn_startDeamon(wld_process_t* dmn_process) {
 
     dmn_process->status = WLD_DAEMON_STATE_UP;
     dmn_process->enabled = true;
+    dmn_process->isReady = false;
+    swl_timespec_getMono(&dmn_process->startTime);
 
     char curArgs[dmn_process->argLen + 1];
     s_getCurArgs(dmn_process, curArgs, sizeof(curArgs));
@@ -334,6 +407,9 @@ bool wld_dmn_stopDeamon(wld_process_t* dmn_process) {
 
     dmn_process->status = WLD_DAEMON_STATE_DOWN;
     dmn_process->enabled = false;
+    dmn_process->isReady = false;
+    dmn_process->startupFails = 0;
+    dmn_process->crashLoop = false;
 
     memset(&dmn_process->lastExitInfo, 0, sizeof(wld_deamonExitInfo_t));
     dmn_process->lastExitInfo.isStopped = true;
@@ -396,9 +472,12 @@ bool wld_dmn_stopCb(wld_process_t* end_process) {
         pExitInfo->termSignal = amxp_subproc_get_termsig(end_process->process->proc);
     }
 
+    bool wasReady = end_process->isReady;
+    end_process->isReady = false;
+
     if(end_process->status == WLD_DAEMON_STATE_RESTARTING) {
         SWL_CALL(end_process->handlers.stopCb, end_process, end_process->userData);
-        amxp_timer_start(end_process->restart_timer, 100 /* ms */);
+        amxp_timer_start(end_process->restart_timer, RESTART_DELAY_MS);
         SAH_TRACEZ_WARNING(ME, "User requested Process %s restart now.", end_process->cmd);
         return true;
     }
@@ -415,27 +494,39 @@ bool wld_dmn_stopCb(wld_process_t* end_process) {
     end_process->totalFails++;
     SAH_TRACEZ_INFO(ME, "%s->fails updated to %d And %s->totalFails to %d.", end_process->cmd,
                     end_process->fails, end_process->cmd, end_process->totalFails);
-    SWL_CALL(end_process->handlers.stopCb, end_process, end_process->userData);
 
     time_t lastFailDate = end_process->failDate;
     end_process->failDate = time(NULL);
-    if(s_dmnMoniConf.enableParam && end_process->cmd) {
-        double elapsedTime = difftime(end_process->failDate, lastFailDate);
+    double elapsedTime = difftime(end_process->failDate, lastFailDate);
+    uint32_t restartInterval = RESTART_DELAY_MS;
+    bool doRestart = (s_dmnMoniConf.enableParam && end_process->cmd);
+    if(doRestart && s_dmnMoniConf.supervise && !wasReady) {
+        end_process->startupFails++;
+        end_process->readyStats.nStartupFails++;
+        restartInterval = wld_dmn_getStartupBackoffMs(&s_dmnMoniConf, end_process->startupFails);
+        if((end_process->startupFails >= s_dmnMoniConf.crashLoopLimit) && (!end_process->crashLoop)) {
+            end_process->crashLoop = true;
+            SAH_TRACEZ_ERROR(ME, "Process %s crash looping: %d startups failed before being ready: not usable",
+                             end_process->cmd, end_process->startupFails);
+        }
+    } else if(doRestart) {
         SAH_TRACEZ_ERROR(ME, "Last daemon crash occured %.2f seconds before.", elapsedTime);
+        /* in supervisor mode, failed startups are already limited by backoff */
+        uint32_t nCrashes = end_process->totalFails;
+        if(s_dmnMoniConf.supervise) {
+            end_process->startupFails = 0;
+            nCrashes -= SWL_MIN(end_process->readyStats.nStartupFails, nCrashes);
+        }
+        restartInterval = wld_dmn_getCrashRestartDelayMs(&s_dmnMoniConf, nCrashes, elapsedTime);
+    }
+    /* restart scheduling is accounted before notifying, to let handler check crash loop state */
+    SWL_CALL(end_process->handlers.stopCb, end_process, end_process->userData);
 
+    if(doRestart) {
         amxp_timer_stop(end_process->restart_timer);
-        if((s_dmnMoniConf.instantRestartLimit >= 0) &&
-           (end_process->totalFails > (uint32_t) s_dmnMoniConf.instantRestartLimit) &&
-           (s_dmnMoniConf.minRestartInterval > (uint32_t) elapsedTime)) {
-            uint32_t restartInterval = (end_process->totalFails == (uint32_t) s_dmnMoniConf.instantRestartLimit + 1) ?
-                s_dmnMoniConf.minRestartInterval :
-                (s_dmnMoniConf.minRestartInterval - elapsedTime);
-            amxp_timer_start(end_process->restart_timer, restartInterval * 1000);
-            SAH_TRACEZ_ERROR(ME, "Dead Process %s restart in %d s.", end_process->cmd, restartInterval);
-        } else {
-            amxp_timer_start(end_process->restart_timer, 100 /* ms */);
-            SAH_TRACEZ_ERROR(ME, "Dead Process %s restart now.", end_process->cmd);
-        }
+        amxp_timer_start(end_process->restart_timer, restartInterval);
+        SAH_TRACEZ_ERROR(ME, "Dead Process %s (ready:%d, startupFails:%d) restart in %d ms.",
+                         end_process->cmd, wasReady, end_process->startupFails, restartInterval);
     }
 
     return true;
@@ -464,6 +555,85 @@ bool wld_dmn_isRestarting(wld_process_t* process) {
     return false;
 }
 
+/*
+ * @brief confirm that the started process is usable (eg. its ctrl iface answers)
+ * In supervisor mode, this ends the startup: failure backoff and crash loop flag are cleared.
+ * The time to ready, since process start, is accounted in readiness stats.
+ */
+void wld_dmn_setReady(wld_process_t* process) {
+    ASSERT_NOT_NULL(process, , ME, "NULL");
+    ASSERTS_EQUALS(process->status, WLD_DAEMON_STATE_UP, , ME, "%s not running", process->cmd);
+    ASSERTS_FALSE(process->isReady, , ME, "%s already ready", process->cmd);
+    process->isReady = true;
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    int64_t readyMs = swl_timespec_diffToMillisec(&process->startTime, &now);
+    wld_dmn_readyStats_t* pStats = &process->readyStats;
+    pStats->nReady++;
+    pStats->lastMs = (uint32_t) SWL_MIN(SWL_MAX(readyMs, (int64_t) 0), (int64_t) UINT32_MAX);
+    pStats->maxMs = SWL_MAX(pStats->maxMs, pStats->lastMs);
+    uint32_t bucket = 0;
+    while((bucket < SWL_ARRAY_SIZE(wld_dmn_readyHistBoundsMs)) && (pStats->lastMs >= wld_dmn_readyHistBoundsMs[bucket])) {
+        bucket++;
+    }
+    pStats->hist[bucket]++;
+    if(process->crashLoop) {
+        SAH_TRACEZ_WARNING(ME, "Process %s recovered from crash loop, after %d failed startups", process->cmd, process->startupFails);
+    }
+    process->startupFails = 0;
+    process->crashLoop = false;
+    SAH_TRACEZ_INFO(ME, "Process %s ready after %d ms", process->cmd, pStats->lastMs);
+}
+
+bool wld_dmn_isReady(wld_process_t* process) {
+    ASSERTS_NOT_NULL(process, false, ME, "NULL");
+    return ((process->status == WLD_DAEMON_STATE_UP) && (process->isReady));
+}
+
+bool wld_dmn_isCrashLooping(wld_process_t* process) {
+    ASSERTS_NOT_NULL(process, false, ME, "NULL");
+    return process->crashLoop;
+}
+
+const wld_dmn_readyStats_t* wld_dmn_getReadyStats(wld_process_t* process) {
+    ASSERTS_NOT_NULL(process, NULL, ME, "NULL");
+    return &process->readyStats;
+}
+
+/*
+ * @brief dump process supervision state and readiness stats into a htable variant
+ */
+void wld_dmn_debug(wld_process_t* process, amxc_var_t* retMap) {
+    ASSERTS_NOT_NULL(retMap, , ME, "NULL");
+    if(process == NULL) {
+        amxc_var_add_key(cstring_t, retMap, "Error", "No daemon process");
+        return;
+    }
+    amxc_var_add_key(cstring_t, retMap, "Cmd", process->cmd);
+    amxc_var_add_key(cstring_t, retMap, "Status", g_str_wld_dmn_state[process->status]);
+    amxc_var_add_key(bool, retMap, "Ready", wld_dmn_isReady(process));
+    amxc_var_add_key(bool, retMap, "CrashLoop", process->crashLoop);
+    amxc_var_add_key(uint32_t, retMap, "StartupFails", process->startupFails);
+    amxc_var_add_key(uint32_t, retMap, "TotalFails", process->totalFails);
+    amxc_var_add_key(uint32_t, retMap, "TotalRestarts", process->totalRestarts);
+    const wld_dmn_readyStats_t* pStats = &process->readyStats;
+    amxc_var_t* pStatsMap = amxc_var_add_key(amxc_htable_t, retMap, "ReadyStats", NULL);
+    amxc_var_add_key(uint32_t, pStatsMap, "NrReady", pStats->nReady);
+    amxc_var_add_key(uint32_t, pStatsMap, "NrStartupFails", pStats->nStartupFails);
+    amxc_var_add_key(uint32_t, pStatsMap, "LastMs", pStats->lastMs);
+    amxc_var_add_key(uint32_t, pStatsMap, "MaxMs", pStats->maxMs);
+    amxc_var_t* pHistMap = amxc_var_add_key(amxc_htable_t, pStatsMap, "Histogram", NULL);
+    char key[32];
+    for(uint32_t i = 0; i < WLD_DMN_READY_HIST_SIZE; i++) {
+        if(i < WLD_DMN_READY_HIST_SIZE - 1) {
+            snprintf(key, sizeof(key), "Below%uMs", wld_dmn_readyHistBoundsMs[i]);
+        } else {
+            snprintf(key, sizeof(key), "Above%uMs", wld_dmn_readyHistBoundsMs[i - 1]);
+        }
+        amxc_var_add_key(uint32_t, pHistMap, key, pStats->hist[i]);
+    }
+}
+
 void wld_dmn_setArgList(wld_process_t* process, char* args) {
     uint32_t nrArgs = 0;
     uint32_t i = 0;
@@ -137,6 +137,12 @@ static void s_setDmnExecSettings_ocf(void* priv _UNUSED, amxd_object_t* object,
                 continue;
             }
             pDmnCtx->exec.useGlobalInstance = valTrl;
+        } else if(swl_str_matches(pname, "WarmStandby")) {
+            bool valBool = amxc_var_dyncast(bool, newValue);
+            if(pDmnCtx->exec.warmStandby == valBool) {
+                continue;
+            }
+            pDmnCtx->exec.warmStandby = valBool;
         } else {
             continue;
         }
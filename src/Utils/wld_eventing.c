@@ -92,6 +92,7 @@ static wld_event_queue_t rqueue_vap_onChange = {.name = "evApChange"};
 static wld_event_queue_t rqueue_vap_onAction = {.name = "evApAction"};
 static wld_event_queue_t rqueue_ep_onChange = {.name = "evEpChange"};
 static wld_event_queue_t rqueue_sta_onChange = {.name = "evStaChange"};
+static wld_event_queue_t rqueue_sta_onBatchChange = {.name = "evStaBatchChange"};
 static wld_event_queue_t rqueue_lifecycleEvent = {.name = "evLifecycle"};
 static wld_event_queue_t rqueue_wps_onStateChange = {.name = "evWpsStateChange"};
 static wld_event_queue_t rqueue_wdsInterfaceEv = {.name = "wdsInterfaceEv"};
@@ -108,7 +109,8 @@ wld_event_queue_t* gWld_queue_rad_onChangeEvent = NULL;
 wld_event_queue_t* gWld_queue_rad_onFrameEvent = NULL;
 wld_event_queue_t* gWld_queue_wps_onStateChange = NULL;
 
-wld_event_queue_t* gWld_queue_sta_onChangeEvent = NULL; // Called on station lifecycle changes. @type wld_ad_changeEvent_t.
+wld_event_queue_t* gWld_queue_sta_onChangeEvent = NULL;      // Called on station lifecycle changes. @type wld_ad_changeEvent_t.
+wld_event_queue_t* gWld_queue_sta_onBatchChangeEvent = NULL; // Called with coalesced station lifecycle changes. @type wld_ad_batchChangeEvent_t.
 
 wld_event_queue_t* gWld_queue_mld_onChangeEvent = NULL;
 
@@ -154,6 +156,9 @@ void wld_event_init() {
     gWld_queue_sta_onChangeEvent = &rqueue_sta_onChange;
     amxc_llist_init(&gWld_queue_sta_onChangeEvent->subscribers);
 
+    gWld_queue_sta_onBatchChangeEvent = &rqueue_sta_onBatchChange;
+    amxc_llist_init(&gWld_queue_sta_onBatchChangeEvent->subscribers);
+
     gWld_queue_wps_onStateChange = &rqueue_wps_onStateChange;
     amxc_llist_init(&gWld_queue_wps_onStateChange->subscribers);
 
@@ -192,6 +197,7 @@ void wld_event_destroy() {
     wld_event_cleanup_queue(gWld_queue_rad_onScan_change);
     wld_event_cleanup_queue(gWld_queue_lifecycleEvent);
     wld_event_cleanup_queue(gWld_queue_sta_onChangeEvent);
+    wld_event_cleanup_queue(gWld_queue_sta_onBatchChangeEvent);
     wld_event_cleanup_queue(gWld_queue_wps_onStateChange);
     wld_event_cleanup_queue(gWld_queue_wdsInterface);
     wld_event_cleanup_queue(gWld_queue_mld_onChangeEvent);
@@ -239,6 +245,14 @@ void wld_event_remove_callback(wld_event_queue_t* queue, wld_event_callback_t* c
     }
 }
 
+/**
+ * Return whether the given queue has any subscribed callback
+ */
+bool wld_event_hasSubscribers(wld_event_queue_t* queue) {
+    ASSERTS_NOT_NULL(queue, false, ME, "NULL");
+    return !amxc_llist_is_empty(&queue->subscribers);
+}
+
 /**
  * Notify all callbacks with the given data structure
  * @param queue
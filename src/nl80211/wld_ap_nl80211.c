@@ -64,6 +64,7 @@
  */
 
 #include "wld_ap_nl80211.h"
+#include "wld_assocdev.h"
 #include "wld_ssid_nl80211_priv.h"
 #include "swl/swl_common.h"
 
@@ -277,6 +278,9 @@ swl_rc_ne wld_ap_nl80211_copyStationInfoToAssocDev(T_AccessPoint* pAP, T_Associa
         pAD->mloMode = SWL_MLO_MODE_ACTIVE_UNKNOWN;
     }
 
+    /* signal strength and operating standard are accounted in the aggregate station counters */
+    wld_ad_refreshStaCounters(pAP, pAD);
+
     return SWL_RC_OK;
 }
 
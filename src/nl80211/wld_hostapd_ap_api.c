@@ -80,6 +80,7 @@
 
 
 #define HOSTAPD_CTRL_IFACE_RCV_BUFSIZE 4096
+#define MLD_STATUS_MAX_AGE_MS 1000 // mld link setup of a bss only changes with events
 
 static bool s_sendHostapdCommand(T_AccessPoint* pAP, char* cmd, const char* reason) {
     ASSERTS_NOT_NULL(pAP, false, ME, "NULL");
@@ -91,6 +92,40 @@ static bool s_sendHostapdCommand(T_AccessPoint* pAP, char* cmd, const char* reas
     return wld_wpaCtrl_sendCmdCheckResponse(pAP->wpaCtrlInterface, cmd, "OK");
 }
 
+/*
+ * @brief send a hostapd command whose result is not used by the caller
+ * Within an open command batch, it is pipelined, and its reply is only checked
+ * when the batch completes. Otherwise, it is sent synchronously.
+ *
+ * @return true when the command is queued, or sent and answered as expected
+ */
+static bool s_queueHostapdCommand(T_AccessPoint* pAP, char* cmd, const char* reason) {
+    ASSERTS_NOT_NULL(pAP, false, ME, "NULL");
+    if(!wld_wpaCtrl_isCmdBatchOpen(pAP->wpaCtrlInterface)) {
+        return s_sendHostapdCommand(pAP, cmd, reason);
+    }
+    ASSERTS_TRUE(wld_wpaCtrlInterface_isReady(pAP->wpaCtrlInterface), false, ME, "%s: wpactrl link not ready", pAP->alias);
+    SAH_TRACEZ_INFO(ME, "%s: queue hostapd cmd %s for %s",
+                    wld_wpaCtrlInterface_getName(pAP->wpaCtrlInterface), cmd, reason);
+    return (wld_wpaCtrl_batchCmdCheckResponse(pAP->wpaCtrlInterface, cmd, "OK") == SWL_RC_OK);
+}
+
+/*
+ * @brief get the bss whose beacon has to be updated:
+ * with MBSSID advertisement, beacon is rebuilt by the main bss
+ */
+static T_AccessPoint* s_getBeaconAp(T_AccessPoint* pAP) {
+    T_Radio* pRad = pAP->pRadio;
+    ASSERTS_TRUE(wld_rad_hasMbssidAds(pRad), pAP, ME, "no mbssid");
+    T_AccessPoint* pAPmain = wld_rad_hostapd_getCfgMainVap(pRad);
+    ASSERTS_TRUE(pAPmain && !wld_vap_isDummyVap(pAPmain), pAP, ME, "no main bss");
+    if(pAPmain != pAP) {
+        /* pipelined settings of this bss must be applied before */
+        wld_wpaCtrl_waitPendingCmds(pAP->wpaCtrlInterface);
+    }
+    return pAPmain;
+}
+
 /**
  * @brief update beacon frame
  *
@@ -100,14 +135,19 @@ static bool s_sendHostapdCommand(T_AccessPoint* pAP, char* cmd, const char* reas
  */
 bool wld_ap_hostapd_updateBeacon(T_AccessPoint* pAP, const char* reason) {
     ASSERTS_NOT_NULL(pAP, false, ME, "NULL");
-    T_Radio* pRad = pAP->pRadio;
-    if(wld_rad_hasMbssidAds(pRad)) {
-        T_AccessPoint* pAPmain = wld_rad_hostapd_getCfgMainVap(pRad);
-        if(pAPmain && !wld_vap_isDummyVap(pAPmain)) {
-            pAP = pAPmain;
-        }
-    }
-    return s_sendHostapdCommand(pAP, "UPDATE_BEACON", reason);
+    return s_sendHostapdCommand(s_getBeaconAp(pAP), "UPDATE_BEACON", reason);
+}
+
+/**
+ * @brief update beacon frame, without waiting for the result
+ * Within an open command batch, the command is pipelined.
+ *
+ * @param pAP accesspoint
+ * @param reason the command caller
+ */
+void wld_ap_hostapd_queueUpdateBeacon(T_AccessPoint* pAP, const char* reason) {
+    ASSERTS_NOT_NULL(pAP, , ME, "NULL");
+    s_queueHostapdCommand(s_getBeaconAp(pAP), "UPDATE_BEACON", reason);
 }
 
 /**
@@ -281,6 +321,24 @@ bool wld_ap_hostapd_setParamValue(T_AccessPoint* pAP, const char* field, const c
     return s_sendHostapdCommand(pAP, cmd, reason);
 }
 
+/**
+ * @brief set a parameter value in hostapd context, without waiting for the result
+ * Within an open command batch, the SET is pipelined, and its reply is checked
+ * when the batch completes. Otherwise, it is sent synchronously.
+ *
+ * @param pAP accesspoint
+ * @param reason the command caller
+ * @return true when the SET cmd is queued, or executed successfully. Otherwise false.
+ */
+bool wld_ap_hostapd_queueParamValue(T_AccessPoint* pAP, const char* field, const char* value, const char* reason) {
+    ASSERTS_NOT_NULL(pAP, false, ME, "NULL");
+    ASSERTS_STR(field, false, ME, "empty key");
+    ASSERTS_STR(value, false, ME, "empty value");
+    char cmd[256];
+    snprintf(cmd, sizeof(cmd), "SET %s %s", field, value);
+    return s_queueHostapdCommand(pAP, cmd, reason);
+}
+
 /**
  * @brief send hostapd command
  *
@@ -293,6 +351,19 @@ bool wld_ap_hostapd_sendCommand(T_AccessPoint* pAP, char* cmd, const char* reaso
     return s_sendHostapdCommand(pAP, cmd, reason);
 }
 
+/**
+ * @brief send hostapd command, without waiting for the result
+ * Within an open command batch, the command is pipelined,
+ * and its reply is checked when the batch completes.
+ *
+ * @param pAP accesspoint
+ * @param cmd the command to send
+ * @param reason the command caller
+ */
+void wld_ap_hostapd_queueCommand(T_AccessPoint* pAP, char* cmd, const char* reason) {
+    s_queueHostapdCommand(pAP, cmd, reason);
+}
+
 SWL_TABLE(sHapdCfgParamsActionMap,
           ARR(char* param; wld_secDmn_action_rc_ne action; ),
           ARR(swl_type_charPtr, swl_type_uint32, ),
@@ -352,6 +423,9 @@ SWL_TABLE(sHapdCfgParamsActionMap,
               {"multi_ap_profile", SECDMN_ACTION_OK_NEED_UPDATE_BEACON},
               {"multi_ap_vlanid", SECDMN_ACTION_OK_NEED_UPDATE_BEACON},
               //params set and applied without any action
+              {"config_id", SECDMN_ACTION_OK_DONE},
+              {"max_num_sta", SECDMN_ACTION_OK_DONE},
+              {"start_disabled", SECDMN_ACTION_OK_DONE},
               ));
 
 /**
@@ -380,21 +454,172 @@ swl_rc_ne wld_ap_hostapd_setParamAction(const char* paramName, wld_secDmn_action
     return SWL_RC_OK;
 }
 
+/**
+ * @brief classify the change of a hostapd parameter into the cheapest action applying it
+ *
+ * Params without mapped action are applied by reloading the saved conf.
+ * Removed params can not be unset at runtime, so they also need the saved conf reloading.
+ *
+ * @param paramName the parameter name
+ * @param oldValue the current param value (NULL if not set)
+ * @param newValue the new param value (NULL if removed)
+ * @return SECDMN_ACTION_OK_DONE if unchanged or applicable with runtime SET only,
+ *         the action required to apply the change otherwise
+ */
+wld_secDmn_action_rc_ne wld_ap_hostapd_classifyParamChange(const char* paramName, const char* oldValue, const char* newValue) {
+    ASSERTS_STR(paramName, SECDMN_ACTION_ERROR, ME, "Empty param");
+    if(swl_str_matches(oldValue, newValue)) {
+        return SECDMN_ACTION_OK_DONE;
+    }
+    wld_secDmn_action_rc_ne* pMappedAction = (wld_secDmn_action_rc_ne*) swl_table_getMatchingValue(&sHapdCfgParamsActionMap, 1, 0, paramName);
+    wld_secDmn_action_rc_ne action = (pMappedAction != NULL) ? *pMappedAction : SECDMN_ACTION_OK_NEED_SIGHUP;
+    if(newValue == NULL) {
+        action = SWL_MAX(action, SECDMN_ACTION_OK_NEED_SIGHUP);
+    }
+    return action;
+}
+
+/**
+ * @brief classify the delta between current and new params of a config section,
+ * into the minimal action plan applying it
+ *
+ * @param pCurrParams current section params (eg. saved conf)
+ * @param pNewParams new section params (eg. generated conf)
+ * @param pPlan optional output plan, counting changed params per action
+ * @return the cheapest action applying all changes (SECDMN_ACTION_OK_DONE if unchanged
+ * or only runtime SETs are needed), SECDMN_ACTION_ERROR on invalid args
+ */
+wld_secDmn_action_rc_ne wld_ap_hostapd_classifyParamsDelta(swl_mapChar_t* pCurrParams, swl_mapChar_t* pNewParams, wld_ap_hostapd_cfgDeltaPlan_t* pPlan) {
+    ASSERTS_NOT_NULL(pCurrParams, SECDMN_ACTION_ERROR, ME, "NULL");
+    ASSERTS_NOT_NULL(pNewParams, SECDMN_ACTION_ERROR, ME, "NULL");
+    wld_ap_hostapd_cfgDeltaPlan_t plan;
+    memset(&plan, 0, sizeof(plan));
+    swl_mapIt_t it;
+    swl_map_for_each(it, pNewParams) {
+        const char* key = (const char*) swl_map_itKey(&it);
+        const char* oldValue = swl_mapChar_get(pCurrParams, (char*) key);
+        const char* newValue = (const char*) swl_map_itValue(&it);
+        if(swl_str_matches(oldValue, newValue)) {
+            continue;
+        }
+        wld_secDmn_action_rc_ne action = wld_ap_hostapd_classifyParamChange(key, oldValue, newValue);
+        if(action < SECDMN_ACTION_OK_DONE) {
+            continue;
+        }
+        plan.nChanged++;
+        plan.nParamsByAction[action]++;
+        plan.action = SWL_MAX(plan.action, action);
+    }
+    swl_map_for_each(it, pCurrParams) {
+        const char* key = (const char*) swl_map_itKey(&it);
+        if(swl_mapChar_has(pNewParams, (char*) key)) {
+            continue;
+        }
+        wld_secDmn_action_rc_ne action = wld_ap_hostapd_classifyParamChange(key, (const char*) swl_map_itValue(&it), NULL);
+        if(action < SECDMN_ACTION_OK_DONE) {
+            continue;
+        }
+        plan.nChanged++;
+        plan.nParamsByAction[action]++;
+        plan.action = SWL_MAX(plan.action, action);
+    }
+    W_SWL_SETPTR(pPlan, plan);
+    return plan.action;
+}
+
+/*
+ * vap params not synced with common params:
+ * either set by dedicated paths (ssid, security, mld, enabling, max stations),
+ * or structural (only applied when creating the bss)
+ */
+static const char* sNoSecSyncExcludedParams[] = {
+    "interface", "bss", "bssid", "ctrl_interface", "bridge",
+    "ssid", "ssid2", "utf8_ssid",
+    "wpa", "rsn_pairwise", "ieee8021x", "auth_algs", "eap_server",
+    "own_ip_addr", "nas_identifier", "okc", "disable_pmksa_caching",
+    "mobility_domain", "transition_disable",
+    "start_disabled", "max_num_sta", "mld_ap", "disable_11be",
+};
+static const char* sNoSecSyncExcludedParamPrefixes[] = {
+    "wpa_", "sae_", "wep_", "owe_", "auth_server_", "acct_server_", "radius_",
+    "multi_ap_backhaul_", "mld_",
+};
+
+/**
+ * @brief check whether a vap param is synced with the AP common (non security) params
+ *
+ * @param paramName the parameter name
+ * @return false for security and structural params, which are handled by dedicated paths
+ */
+bool wld_ap_hostapd_isNoSecSyncParam(const char* paramName) {
+    ASSERTS_STR(paramName, false, ME, "Empty param");
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sNoSecSyncExcludedParams); i++) {
+        if(swl_str_matches(paramName, sNoSecSyncExcludedParams[i])) {
+            return false;
+        }
+    }
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sNoSecSyncExcludedParamPrefixes); i++) {
+        if(swl_str_startsWith(paramName, sNoSecSyncExcludedParamPrefixes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void s_copyNoSecSyncParams(swl_mapChar_t* pDst, swl_mapChar_t* pSrc) {
+    swl_mapIt_t it;
+    swl_map_for_each(it, pSrc) {
+        const char* key = (const char*) swl_map_itKey(&it);
+        if(wld_ap_hostapd_isNoSecSyncParam(key)) {
+            swl_mapChar_add(pDst, (char*) key, (char*) swl_map_itValue(&it));
+        }
+    }
+}
+
+/**
+ * @brief classify the delta of AP common (non security) params of a vap section,
+ * ignoring security and structural params
+ *
+ * @param pCurrParams current vap params (eg. saved conf)
+ * @param pNewParams new vap params (eg. generated conf)
+ * @param pPlan optional output plan, counting changed params per action
+ * @return the cheapest action applying the common params changes, SECDMN_ACTION_ERROR on invalid args
+ */
+wld_secDmn_action_rc_ne wld_ap_hostapd_classifyNoSecParamsDelta(swl_mapChar_t* pCurrParams, swl_mapChar_t* pNewParams, wld_ap_hostapd_cfgDeltaPlan_t* pPlan) {
+    ASSERTS_NOT_NULL(pCurrParams, SECDMN_ACTION_ERROR, ME, "NULL");
+    ASSERTS_NOT_NULL(pNewParams, SECDMN_ACTION_ERROR, ME, "NULL");
+    swl_mapChar_t currParams;
+    swl_mapChar_t newParams;
+    swl_mapChar_init(&currParams);
+    swl_mapChar_init(&newParams);
+    s_copyNoSecSyncParams(&currParams, pCurrParams);
+    s_copyNoSecSyncParams(&newParams, pNewParams);
+    wld_secDmn_action_rc_ne action = wld_ap_hostapd_classifyParamsDelta(&currParams, &newParams, pPlan);
+    swl_mapChar_cleanup(&currParams);
+    swl_mapChar_cleanup(&newParams);
+    return action;
+}
+
+/*
+ * The applying action only depends on the param, not on the SET reply:
+ * so SETs can be pipelined within the caller's command batch,
+ * whose failure is recovered by reloading the whole saved conf.
+ */
 static bool s_setParam(T_AccessPoint* pAP, const char* param, const char* value, wld_secDmn_action_rc_ne* pAction) {
     ASSERTS_NOT_NULL(param, false, ME, "NULL");
-    bool ret = wld_ap_hostapd_setParamValue(pAP, param, value, param);
+    bool ret = wld_ap_hostapd_queueParamValue(pAP, param, value, param);
     wld_secDmn_action_rc_ne* pMappedAction = (wld_secDmn_action_rc_ne*) swl_table_getMatchingValue(&sHapdCfgParamsActionMap, 1, 0, param);
     if((pAP->status == APSTI_DISABLED) && !pAP->enable) {
         W_SWL_SETPTR(pAction, SECDMN_ACTION_OK_DONE);
     } else if(pMappedAction != NULL) {
         //keep most critical action
         W_SWL_SETPTR(pAction, SWL_MAX(*pAction, *pMappedAction));
-    } else if(ret) {
+    } else {
         /*
-         * If param is successfully set but has no specific applying action,
+         * If param has no specific applying action,
          * then reload whole save hostapd conf
          */
-        W_SWL_SETPTR(pAction, SECDMN_ACTION_OK_NEED_SIGHUP);
+        W_SWL_SETPTR(pAction, SWL_MAX(*pAction, SECDMN_ACTION_OK_NEED_SIGHUP));
     }
     return ret;
 }
@@ -665,7 +890,7 @@ wld_secDmn_action_rc_ne wld_ap_hostapd_setMaxNbrSta(T_AccessPoint* pAP, uint32_t
     ASSERTS_NOT_NULL(pAP, SECDMN_ACTION_ERROR, ME, "NULL");
     char strVal[16] = {0};
     snprintf(strVal, sizeof(strVal), "%u", num);
-    bool ret = wld_ap_hostapd_setParamValue(pAP, "max_num_sta", strVal, "maxStation");
+    bool ret = wld_ap_hostapd_queueParamValue(pAP, "max_num_sta", strVal, "maxStation");
     ASSERTS_TRUE(ret, SECDMN_ACTION_ERROR, ME, "Error setting hostapd enable vap");
     return SECDMN_ACTION_OK_DONE;
 }
@@ -722,16 +947,26 @@ wld_secDmn_action_rc_ne wld_ap_hostapd_setNoSecParams(T_AccessPoint* pAP) {
     ASSERTI_TRUE(ret, SECDMN_ACTION_ERROR, ME, "no new config");
     swl_mapChar_t* pNewVapParams = wld_hostapd_getConfigMapByBssid(pNewCfg, (swl_macBin_t*) pAP->pSSID->BSSID);
     wld_secDmn_action_rc_ne action = SECDMN_ACTION_OK_DONE;
-    const char* params[] = {
-        "ap_isolate", "ignore_broadcast_ssid",
-        "ft_over_ds", "multi_ap", "qos_map_set",
-        "wps_state", "config_methods", "uuid", "ap_pin",
-        "rrm_neighbor_report", "rrm_beacon_report", "ieee80211w", "mbo",
-        "wmm_enabled", "uapsd_advertisement_enabled", "rnr", "ap_max_inactivity",
-        "multi_ap_profile", "multi_ap_vlanid",
-    };
-    s_setChangedMultiParams(pAP, pCurrVapParams, pNewVapParams,
-                            params, SWL_ARRAY_SIZE(params), &action);
+    /*
+     * set changed common params having a runtime applying action,
+     * and keep the cheapest action applying the whole common params delta
+     * (eg. changed vendor specific params are applied by reloading the saved conf)
+     */
+    wld_secDmn_action_rc_ne deltaAction = wld_ap_hostapd_classifyNoSecParamsDelta(pCurrVapParams, pNewVapParams, NULL);
+    if(deltaAction > SECDMN_ACTION_ERROR) {
+        swl_mapIt_t it;
+        swl_map_for_each(it, pNewVapParams) {
+            const char* key = (const char*) swl_map_itKey(&it);
+            if(!wld_ap_hostapd_isNoSecSyncParam(key) ||
+               (swl_table_getMatchingValue(&sHapdCfgParamsActionMap, 1, 0, key) == NULL)) {
+                continue;
+            }
+            s_setChangedParam(pAP, pCurrVapParams, key, (const char*) swl_map_itValue(&it), &action);
+        }
+        if((pAP->status != APSTI_DISABLED) || pAP->enable) {
+            action = SWL_MAX(action, deltaAction);
+        }
+    }
     wld_hostapd_deleteConfig(pNewCfg);
     wld_hostapd_deleteConfig(config);
     return action;
@@ -1185,9 +1420,11 @@ SWL_TABLE(sAkmSuiteSelectorMap,
 static void s_parseHostapdStaCmdResponse(T_AccessPoint* pAP, T_AssociatedDevice* pAD, char* buff) {
     char valStr[WLD_M_BUF] = {0};
     int32_t val = 0;
+    wld_wpaCtrl_reply_t reply;
+    wld_wpaCtrl_reply_parse(&reply, buff);
 
     //Eg: flags=[AUTH][ASSOC][AUTHORIZED][WMM][MFP][HT][HE]
-    if(wld_wpaCtrl_getValueStr(buff, "flags", valStr, sizeof(valStr)) > 0) {
+    if(wld_wpaCtrl_reply_getValueStr(&reply, "flags", valStr, sizeof(valStr)) > 0) {
         pAD->seen = (strstr(valStr, "[ASSOC]") != NULL);
         /*
          * when station is connected and authenticated, then initialize security with mode enabled on AP
@@ -1198,7 +1435,7 @@ static void s_parseHostapdStaCmdResponse(T_AccessPoint* pAP, T_AssociatedDevice*
         }
     }
 
-    if(wld_wpaCtrl_getValueIntExt(buff, "wpa", &val)) {
+    if(wld_wpaCtrl_reply_getValueIntExt(&reply, "wpa", &val)) {
         switch(val) {
         case 1: pAD->assocCaps.currentSecurity = SWL_SECURITY_APMODE_WPA_P; break;  // WPA_VERSION_WPA = 1: WPA / IEEE 802.11i/D3.0
         case 2: pAD->assocCaps.currentSecurity = SWL_SECURITY_APMODE_WPA2_P; break; // WPA_VERSION_WPA2 = 2: WPA2 / IEEE 802.11i
@@ -1208,7 +1445,7 @@ static void s_parseHostapdStaCmdResponse(T_AccessPoint* pAP, T_AssociatedDevice*
     // if WPA not used, then sec mode may be Open, WEP, EAP ...
     // even with wpa3, we need  refine secMode using the selected AuthenticationKeyManagement (AKM) suite
     // Eg: AKMSuiteSelector=00-0f-ac-8
-    if(wld_wpaCtrl_getValueStr(buff, "AKMSuiteSelector", valStr, sizeof(valStr)) > 0) {
+    if(wld_wpaCtrl_reply_getValueStr(&reply, "AKMSuiteSelector", valStr, sizeof(valStr)) > 0) {
         swl_security_apMode_e* pCurrSec = (swl_security_apMode_e*) swl_table_getMatchingValue(&sAkmSuiteSelectorMap, 1, 0, valStr);
         if(pCurrSec) {
             pAD->assocCaps.currentSecurity = *pCurrSec;
@@ -1258,16 +1495,18 @@ swl_rc_ne wld_ap_hostapd_getAllStaInfo(T_AccessPoint* pAP) {
 
 static bool s_checkMainStaMldLinkIndic(char* staInfoBuf) {
     char valStr[WLD_M_BUF] = {0};
+    wld_wpaCtrl_reply_t reply;
+    wld_wpaCtrl_reply_parse(&reply, staInfoBuf);
     //Eg: capability=0x1111 (=> mgmt->u.assoc_req.capab_info)
     //only set saved in sta context upon assoc/reassoc, which is only received over main STA mld link
-    if(wld_wpaCtrl_getValueStr(staInfoBuf, "capability", valStr, sizeof(valStr)) > 0) {
+    if(wld_wpaCtrl_reply_getValueStr(&reply, "capability", valStr, sizeof(valStr)) > 0) {
         uint16_t val = 0;
         if(swl_rc_isOk(wldu_convStrToNum(valStr, &val, sizeof(val), 16, false)) && (val > 0)) {
             return true;
         }
     }
     //Eg: vendor_oui=00:50:f2: only set saved in sta context upon assoc/reassoc, which is only received over main STA mld link
-    if(wld_wpaCtrl_getValueStr(staInfoBuf, "vendor_oui", valStr, sizeof(valStr)) > 0) {
+    if(wld_wpaCtrl_reply_getValueStr(&reply, "vendor_oui", valStr, sizeof(valStr)) > 0) {
         swl_oui_t oui;
         memset(&oui, 0, sizeof(oui));
         if(swl_typeOui_fromChar(&oui, valStr) && (SWL_OUI_GET(oui.ouiBytes) > 0)) {
@@ -1406,7 +1645,7 @@ swl_rc_ne wld_ap_hostapd_getNumMldLinks(T_AccessPoint* pAP, uint32_t* pNLinks) {
     int32_t val = 0;
     W_SWL_SETPTR(pNLinks, val);
     ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
-    swl_rc_ne rc = wld_wpaCtrl_getSyncCmdParamValInt32Def(pAP->wpaCtrlInterface, "STATUS", "num_links", &val, val);
+    swl_rc_ne rc = wld_wpaCtrl_getCachedCmdParamValInt32Def(pAP->wpaCtrlInterface, "STATUS", "num_links", MLD_STATUS_MAX_AGE_MS, &val, val);
     W_SWL_SETPTR(pNLinks, val);
     return rc;
 }
@@ -1415,19 +1654,21 @@ swl_rc_ne wld_ap_hostapd_getMldLinkId(T_AccessPoint* pAP, int32_t* pLinkId) {
     int32_t val = -1;
     W_SWL_SETPTR(pLinkId, val);
     ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
-    swl_rc_ne rc = wld_wpaCtrl_getSyncCmdParamValInt32Def(pAP->wpaCtrlInterface, "STATUS", "link_id", &val, val);
+    swl_rc_ne rc = wld_wpaCtrl_getCachedCmdParamValInt32Def(pAP->wpaCtrlInterface, "STATUS", "link_id", MLD_STATUS_MAX_AGE_MS, &val, val);
     W_SWL_SETPTR(pLinkId, val);
     return rc;
 }
 
-swl_trl_e wld_hostapd_ap_getCfgParamSupp(T_AccessPoint* pAP, const char* param) {
+swl_trl_e wld_hostapd_ap_getCfgParamSupp(T_AccessPoint* pAP, wld_secDmn_cfgParamId_t paramId) {
     ASSERT_NOT_NULL(pAP, SWL_TRL_UNKNOWN, ME, "NULL");
     wld_wpaCtrlMngr_t* pMgr = wld_wpaCtrlInterface_getMgr(pAP->wpaCtrlInterface);
     wld_secDmn_t* pSecDmn = wld_wpaCtrlMngr_getSecDmn(pMgr);
-    swl_trl_e trl = wld_secDmn_getCfgParamSupp(pSecDmn, param);
+    swl_trl_e trl = wld_secDmn_getCfgParamSuppById(pSecDmn, paramId);
     if(trl != SWL_TRL_UNKNOWN) {
         return trl;
     }
+    const char* param = wld_secDmn_getCfgParamName(paramId);
+    ASSERT_NOT_NULL(param, trl, ME, "invalid param id %d", paramId);
     T_Radio* pR = pAP->pRadio;
     ASSERTS_NOT_NULL(pR, trl, ME, "NULL");
     ASSERTS_NOT_NULL(pR->hostapd, trl, ME, "NULL");
@@ -1442,21 +1683,23 @@ swl_trl_e wld_hostapd_ap_getCfgParamSupp(T_AccessPoint* pAP, const char* param)
     return trl;
 }
 
-swl_rc_ne wld_hostapd_ap_sendCfgParam(T_AccessPoint* pAP, const char* param, const char* value) {
+swl_rc_ne wld_hostapd_ap_sendCfgParam(T_AccessPoint* pAP, wld_secDmn_cfgParamId_t paramId, const char* value) {
     ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
     wld_wpaCtrlMngr_t* pMgr = wld_wpaCtrlInterface_getMgr(pAP->wpaCtrlInterface);
     wld_secDmn_t* pSecDmn = wld_wpaCtrlMngr_getSecDmn(pMgr);
     ASSERT_NOT_NULL(pSecDmn, SWL_RC_INVALID_STATE, ME, "NULL");
-    swl_trl_e trl = wld_hostapd_ap_getCfgParamSupp(pAP, param);
+    const char* param = wld_secDmn_getCfgParamName(paramId);
+    ASSERT_NOT_NULL(param, SWL_RC_INVALID_PARAM, ME, "invalid param id %d", paramId);
+    swl_trl_e trl = wld_hostapd_ap_getCfgParamSupp(pAP, paramId);
     if(trl == SWL_TRL_FALSE) {
         return SWL_RC_ERROR;
     }
     swl_rc_ne rc = wld_wpaCtrl_sendCmdFmtCheckResponse(pAP->wpaCtrlInterface, "OK", "SET %s %s", (char*) param, (char*) value);
     if(trl == SWL_TRL_UNKNOWN) {
         if(rc == SWL_RC_OK) {
-            wld_secDmn_setCfgParamSupp(pSecDmn, param, SWL_TRL_TRUE);
+            wld_secDmn_setCfgParamSuppById(pSecDmn, paramId, SWL_TRL_TRUE);
         } else if(rc == SWL_RC_ERROR) {
-            wld_secDmn_setCfgParamSupp(pSecDmn, param, SWL_TRL_FALSE);
+            wld_secDmn_setCfgParamSuppById(pSecDmn, paramId, SWL_TRL_FALSE);
         }
     }
     return rc;
@@ -67,7 +67,6 @@
 #include "swl/swl_hex.h"
 #include "swl/map/swl_mapCharFmt.h"
 #include "swl/swl_common.h"
-#include "swl/swl_hash.h"
 #include "swl/fileOps/swl_mapWriterKVP.h"
 #include "wld_wpaSupp_parser.h"
 #include "wld_hostapd_cfgManager.h"
@@ -79,6 +78,7 @@
 #include "wld_wpaCtrlInterface.h"
 #include "wld_wpaCtrl_api.h"
 #include "wld_secDmn.h"
+#include "Utils/wld_cfgDoc.h"
 
 #define ME "hapdCfg"
 
@@ -148,25 +148,22 @@ SWL_TABLE(sChWidthIDsMaps,
               {2, 9, SWL_BW_320MHZ},
               ));
 
-static swl_rc_ne s_checkAndSetParamValueStr(wld_wpaCtrlInterface_t* pIface, swl_mapChar_t* mapChar, const char* param, const char* valStr) {
+static swl_rc_ne s_checkAndSetParamValueStr(wld_wpaCtrlInterface_t* pIface, swl_mapChar_t* mapChar, wld_secDmn_cfgParamId_t paramId, const char* valStr) {
     wld_secDmn_t* pSecDmn = wld_wpaCtrlMngr_getSecDmn(wld_wpaCtrlInterface_getMgr(pIface));
     ASSERTS_NOT_NULL(pSecDmn, SWL_RC_INVALID_STATE, ME, "no secDmn");
-    ASSERT_STR(param, SWL_RC_INVALID_PARAM, ME, "empty param");
+    const char* param = wld_secDmn_getCfgParamName(paramId);
+    ASSERT_STR(param, SWL_RC_INVALID_PARAM, ME, "invalid param id %d", paramId);
     ASSERT_STR(valStr, SWL_RC_INVALID_PARAM, ME, "empty value");
-    swl_trl_e trl = wld_secDmn_getCfgParamSupp(pSecDmn, param);
+    swl_trl_e trl = wld_secDmn_getCfgParamSuppById(pSecDmn, paramId);
     ASSERTS_NOT_EQUALS(trl, SWL_TRL_FALSE, SWL_RC_INVALID_PARAM, ME, "param %s not supported", param);
     int32_t ret = 0;
     swl_rc_ne rc = SWL_RC_INVALID_PARAM;
     if(trl == SWL_TRL_UNKNOWN) {
-        rc = wld_wpaCtrl_sendCmdFmtCheckResponse(pIface, "OK", "SET %s %s", param, valStr);
-        if(rc == SWL_RC_OK) {
-            trl = SWL_TRL_TRUE;
-        } else if(rc == SWL_RC_ERROR) {
-            trl = SWL_TRL_FALSE;
-        }
-        if(trl != SWL_TRL_UNKNOWN) {
-            wld_secDmn_setCfgParamSupp(pSecDmn, param, trl);
-        }
+        /*
+         * support is learned asynchronously (once per daemon binary, as saved in profile):
+         * param can not be written yet, config is rewritten once the probe pass is done
+         */
+        return wld_secDmn_probeCfgParamSupp(pSecDmn, pIface, param, valStr);
     }
     if(trl == SWL_TRL_TRUE) {
         ret = swl_mapChar_addOrSet(mapChar, (char*) param, (char*) valStr);
@@ -175,22 +172,22 @@ static swl_rc_ne s_checkAndSetParamValueStr(wld_wpaCtrlInterface_t* pIface, swl_
     return rc;
 }
 
-static swl_rc_ne s_checkAndSetParamValueFmt(wld_wpaCtrlInterface_t* pIface, swl_mapChar_t* mapChar, char* param, const char* valFormat, ...) {
+static swl_rc_ne s_checkAndSetParamValueFmt(wld_wpaCtrlInterface_t* pIface, swl_mapChar_t* mapChar, wld_secDmn_cfgParamId_t paramId, const char* valFormat, ...) {
     wld_secDmn_t* pSecDmn = wld_wpaCtrlMngr_getSecDmn(wld_wpaCtrlInterface_getMgr(pIface));
     ASSERTS_NOT_NULL(pSecDmn, SWL_RC_INVALID_STATE, ME, "no secDmn");
-    swl_trl_e trl = wld_secDmn_getCfgParamSupp(pSecDmn, param);
-    ASSERTS_NOT_EQUALS(trl, SWL_TRL_FALSE, SWL_RC_INVALID_PARAM, ME, "param %s not supported", param);
+    swl_trl_e trl = wld_secDmn_getCfgParamSuppById(pSecDmn, paramId);
+    ASSERTS_NOT_EQUALS(trl, SWL_TRL_FALSE, SWL_RC_INVALID_PARAM, ME, "param %d not supported", paramId);
     char valStr[512] = {0};
     va_list args;
     va_start(args, valFormat);
     int32_t ret = vsnprintf(valStr, sizeof(valStr), valFormat, args);
     va_end(args);
     ASSERT_FALSE(ret < 0, SWL_RC_ERROR, ME, "Fail to format value string");
-    return s_checkAndSetParamValueStr(pIface, mapChar, param, valStr);
+    return s_checkAndSetParamValueStr(pIface, mapChar, paramId, valStr);
 }
 
-static swl_rc_ne s_checkAndSetParamValueInt32(wld_wpaCtrlInterface_t* pIface, swl_mapChar_t* mapChar, char* param, int32_t value) {
-    return s_checkAndSetParamValueFmt(pIface, mapChar, param, "%d", value);
+static swl_rc_ne s_checkAndSetParamValueInt32(wld_wpaCtrlInterface_t* pIface, swl_mapChar_t* mapChar, wld_secDmn_cfgParamId_t paramId, int32_t value) {
+    return s_checkAndSetParamValueFmt(pIface, mapChar, paramId, "%d", value);
 }
 
 void s_filterEntries(swl_mapChar_t* configMap, const char* keys[], uint32_t nKeys) {
@@ -1001,7 +998,7 @@ static bool s_setVapCommonConfig(T_AccessPoint* pAP, swl_mapChar_t* vapConfigMap
     swl_mapCharFmt_addValInt32(vapConfigMap, "rrm_beacon_report", isIEEE80211k);
     // set rnr is supported by hostapd
     bool isRnrEnabled = isIEEE80211k && (wld_ap_getDiscoveryMethod(pAP) == M_AP_DM_RNR);
-    s_checkAndSetParamValueInt32(pAP->wpaCtrlInterface, vapConfigMap, "rnr", isRnrEnabled);
+    s_checkAndSetParamValueInt32(pAP->wpaCtrlInterface, vapConfigMap, WLD_SECDMN_CFG_PARAM_RNR, isRnrEnabled);
     // Multiband Operation (MBO)
     if(pAP->mboEnable) {
         swl_mapCharFmt_addValInt32(vapConfigMap, "mbo", pAP->mboEnable);
@@ -1088,7 +1085,8 @@ static void s_setVapWpsConfig(T_AccessPoint* pAP, swl_mapChar_t* vapConfigMap) {
 }
 
 /**
- * @brief generate md5 hash for a config map
+ * @brief generate hash for a config map
+ * Hash is the params order independent fingerprint of the map
  *
  * @param pHashStr Pointer output string (to be freed by caller)
  * @param configMap map char of config param/values
@@ -1097,21 +1095,8 @@ static void s_setVapWpsConfig(T_AccessPoint* pAP, swl_mapChar_t* vapConfigMap) {
  */
 swl_rc_ne wld_hostapd_cfgFile_genConfigHash(char** pHashStr, swl_mapChar_t* configMap) {
     ASSERTS_NOT_NULL(configMap, SWL_RC_INVALID_PARAM, ME, "NULL");
-
-    // Generate the BSS config text
-    char bssCfgStr[4096] = {0};
-    bool success = swl_mapWriterKVP_writeToStr(configMap, bssCfgStr, SWL_ARRAY_SIZE(bssCfgStr));
-
-    ASSERT_TRUE(success, SWL_RC_ERROR, ME, "fail to generate the config text");
-
-    // Encode an MD5 hash from the BSS config
-    swl_bit8_t bssCfgHash[MD5_DIGEST_LENGTH] = {'\0'};
-    swl_rc_ne ret = swl_hash_rawToMD5(bssCfgHash, sizeof(bssCfgHash), (swl_bit8_t*) bssCfgStr, strlen((char*) bssCfgStr));
-
-    ASSERT_FALSE(ret < SWL_RC_ERROR, ret, ME, "fail to encode an MD5 hash from config");
-
-    char vapCfgId[MD5_DIGEST_LENGTH * 2 + 1] = {'\0'};
-    swl_hex_fromBytes(vapCfgId, sizeof(vapCfgId), bssCfgHash, MD5_DIGEST_LENGTH, 0);
+    char vapCfgId[17] = {'\0'};
+    snprintf(vapCfgId, sizeof(vapCfgId), "%016llx", (unsigned long long) wld_hostapd_getMapFingerprint(configMap));
     ASSERT_TRUE(swl_str_copyMalloc(pHashStr, vapCfgId), SWL_RC_ERROR, ME, "Fail to copy Hash");
 
     return SWL_RC_OK;
@@ -1124,7 +1109,7 @@ static void s_saveVapConfigId(T_AccessPoint* pAP, swl_mapChar_t* vapConfigMap) {
     }
     char* newValue = NULL;
     if(wld_hostapd_cfgFile_genConfigHash(&newValue, vapConfigMap) == SWL_RC_OK) {
-        s_checkAndSetParamValueStr(pAP->wpaCtrlInterface, vapConfigMap, "config_id", newValue);
+        s_checkAndSetParamValueStr(pAP->wpaCtrlInterface, vapConfigMap, WLD_SECDMN_CFG_PARAM_CONFIG_ID, newValue);
     }
     free(newValue);
 }
@@ -1153,11 +1138,11 @@ void wld_hostapd_cfgFile_setVapConfig(T_AccessPoint* pAP, swl_mapChar_t* vapConf
     pAP->pFA->mfn_wvap_updateConfigMap(pAP, vapConfigMap);
 
     // if rnr conf has been changed by vdr, then prevent further overwriting by removing standard rnr conf setting
-    if(wld_secDmn_getCfgParamSupp(pAP->pRadio->hostapd, "rnr") != SWL_TRL_FALSE) {
+    if(wld_secDmn_getCfgParamSuppById(pAP->pRadio->hostapd, WLD_SECDMN_CFG_PARAM_RNR) != SWL_TRL_FALSE) {
         // get final rnr config (may be customized by vdr module)
         bool rnrCfgFinal = swl_str_matches(swl_mapChar_get(vapConfigMap, "rnr"), "1");
         if(rnrCfgStd != rnrCfgFinal) {
-            wld_secDmn_setCfgParamSupp(pAP->pRadio->hostapd, "rnr", SWL_TRL_FALSE);
+            wld_secDmn_setCfgParamSuppById(pAP->pRadio->hostapd, WLD_SECDMN_CFG_PARAM_RNR, SWL_TRL_FALSE);
         }
     }
 
@@ -1183,36 +1168,144 @@ void wld_hostapd_cfgFile_create(T_Radio* pRad, char* cfgFileName) {
     wld_hostapd_deleteConfig(config);
 }
 
+/**
+ * @brief create the radio hostapd configuration file, only when its content changes
+ *
+ * The generated config is compared, section by section, against the snapshot of the last written one.
+ * The file is rewritten only when some section changed, and the scope of change is accumulated
+ * in the snapshot, until applied by hostapd.
+ *
+ * @param pRad the radio
+ *
+ * @return void
+ */
 void wld_hostapd_cfgFile_createExt(T_Radio* pRad) {
     ASSERTS_NOT_NULL(pRad, , ME, "NULL");
     ASSERTS_NOT_NULL(pRad->hostapd, , ME, "NULL");
-    wld_hostapd_cfgFile_create(pRad, pRad->hostapd->cfgFile);
+    char* cfgFileName = pRad->hostapd->cfgFile;
+    ASSERT_STR(cfgFileName, , ME, "Empty path");
+    ASSERTS_FALSE(amxc_llist_is_empty(&pRad->llAP), , ME, "No vaps");
+    wld_hostapd_config_t* config = NULL;
+    bool ret = wld_hostapd_createConfig(&config, pRad);
+    ASSERT_TRUE(ret, , ME, "Bad config");
+    wld_hostapd_cfgChange_e change = wld_hostapd_diffConfigSnapshot(pRad->hapdCfgSnapshot, config, cfgFileName);
+    if(change == WLD_HOSTAPD_CFG_CHANGE_NONE) {
+        SAH_TRACEZ_INFO(ME, "%s: config unchanged, skip writing %s", pRad->Name, cfgFileName);
+    } else if(wld_hostapd_writeConfig(config, cfgFileName)) {
+        SAH_TRACEZ_INFO(ME, "%s: config changed (scope %d), written in %s", pRad->Name, change, cfgFileName);
+        wld_hostapd_saveConfigSnapshot(&pRad->hapdCfgSnapshot, config, change, cfgFileName);
+    } else {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to write config %s", pRad->Name, cfgFileName);
+        wld_hostapd_deleteConfigSnapshot(&pRad->hapdCfgSnapshot);
+    }
+    wld_hostapd_deleteConfig(config);
+}
+
+static const char* const sHapdCfgSectionKeys[] = {"interface", "bss"};
+
+/**
+ * @brief stage a key update in the in-memory hostapd config document
+ * The config file is patched on disk by wld_hostapd_cfgFile_commitUpdates
+ *
+ * @param configPath the path of the config file
+ * @param interface bss name, or NULL for the general (radio) configuration
+ * @param key the param to update
+ * @param value the key value to set
+ * @return true if the update is staged (or value is unchanged)
+ */
+bool wld_hostapd_cfgFile_stageUpdate(char* configPath, const char* interface, const char* key, const char* value) {
+    ASSERT_STR(configPath, false, ME, "Empty path");
+    ASSERT_FALSE((interface != NULL) && (interface[0] == 0), false, ME, "Empty interface");
+    ASSERT_STR(key, false, ME, "Empty key");
+    ASSERT_NOT_NULL(value, false, ME, "NULL");
+    wld_cfgDoc_t* pDoc = wld_cfgDoc_get(configPath, sHapdCfgSectionKeys, SWL_ARRAY_SIZE(sHapdCfgSectionKeys));
+    ASSERTS_NOT_NULL(pDoc, false, ME, "Bad config");
+    SAH_TRACEZ_INFO(ME, "%s: updateConfig interface:%s, key:%s, value:%s", configPath, (interface != NULL) ? interface : "(general)", key, value);
+    return swl_rc_isOk(wld_cfgDoc_set(pDoc, interface, key, value));
+}
+
+/**
+ * @brief write all staged updates of the hostapd config file, at once
+ *
+ * @param configPath the path of the config file
+ * @return true if the file is up to date
+ */
+bool wld_hostapd_cfgFile_commitUpdates(char* configPath) {
+    ASSERT_STR(configPath, false, ME, "Empty path");
+    wld_cfgDoc_t* pDoc = wld_cfgDoc_get(configPath, sHapdCfgSectionKeys, SWL_ARRAY_SIZE(sHapdCfgSectionKeys));
+    ASSERTS_NOT_NULL(pDoc, false, ME, "Bad config");
+    return swl_rc_isOk(wld_cfgDoc_commit(pDoc));
+}
+
+/**
+ * @brief stage an update of the radio hostapd config file, for a param already applied at runtime
+ *
+ * Unlike wld_hostapd_cfgFile_stageUpdate, the radio config snapshot is kept in sync with
+ * the patched value, so that next wld_hostapd_cfgFile_createExt does not rewrite nor reload the file.
+ *
+ * @param pRad the radio
+ * @param interface bss name, or NULL for the general (radio) configuration
+ * @param key the param to update
+ * @param value the key value to set
+ * @return true if the update is staged (or value is unchanged)
+ */
+bool wld_hostapd_cfgFile_stageRadUpdate(T_Radio* pRad, const char* interface, const char* key, const char* value) {
+    ASSERTS_NOT_NULL(pRad, false, ME, "NULL");
+    ASSERTS_NOT_NULL(pRad->hostapd, false, ME, "NULL");
+    char* configPath = pRad->hostapd->cfgFile;
+    ASSERT_STR(configPath, false, ME, "Empty path");
+    ASSERT_STR(key, false, ME, "Empty key");
+    ASSERT_NOT_NULL(value, false, ME, "NULL");
+    wld_cfgDoc_t* pDoc = wld_cfgDoc_get(configPath, sHapdCfgSectionKeys, SWL_ARRAY_SIZE(sHapdCfgSectionKeys));
+    ASSERTS_NOT_NULL(pDoc, false, ME, "Bad config");
+    size_t oldLen = 0;
+    const char* oldRef = wld_cfgDoc_getValue(pDoc, interface, key, &oldLen);
+    char* oldValue = (oldRef != NULL) ? strndup(oldRef, oldLen) : NULL;
+    bool ret = wld_hostapd_cfgFile_stageUpdate(configPath, interface, key, value);
+    if(ret && ((oldValue == NULL) || !swl_str_matches(oldValue, value)) &&
+       !wld_hostapd_updateConfigSnapshotParam(pRad->hapdCfgSnapshot, interface, key, oldValue, value)) {
+        // snapshot can not follow the file content: next config creation will be a full one
+        wld_hostapd_deleteConfigSnapshot(&pRad->hapdCfgSnapshot);
+    }
+    free(oldValue);
+    return ret;
+}
+
+/**
+ * @brief write all staged updates of the radio hostapd config file, at once,
+ * and save the new file status in the radio config snapshot
+ *
+ * @param pRad the radio
+ * @return true if the file is up to date
+ */
+bool wld_hostapd_cfgFile_commitRadUpdates(T_Radio* pRad) {
+    ASSERTS_NOT_NULL(pRad, false, ME, "NULL");
+    ASSERTS_NOT_NULL(pRad->hostapd, false, ME, "NULL");
+    char* configPath = pRad->hostapd->cfgFile;
+    bool ret = wld_hostapd_cfgFile_commitUpdates(configPath);
+    if(ret) {
+        wld_hostapd_updateConfigSnapshotFileStat(pRad->hapdCfgSnapshot, configPath);
+    } else {
+        wld_hostapd_deleteConfigSnapshot(&pRad->hapdCfgSnapshot);
+    }
+    return ret;
 }
 
 /**
  * @brief update a configuration file for the hostapd
  *
  * @param configPath the path of the config file
- * @param interface bss name
+ * @param interface bss name, or NULL for the general (radio) configuration
  * @param key the param to update
  * @param value the key value to set
  * @return void
  */
 bool wld_hostapd_cfgFile_update(char* configPath, const char* interface, const char* key, const char* value) {
     SAH_TRACEZ_IN(ME);
-    ASSERT_STR(configPath, false, ME, "Empty path");
-    ASSERT_STR(interface, false, ME, "Empty interface");
-    ASSERT_STR(key, false, ME, "Empty key");
-    ASSERT_NOT_NULL(value, false, ME, "NULL");
-    wld_hostapd_config_t* config;
-    bool ret = wld_hostapd_loadConfig(&config, configPath);
-    ASSERTS_TRUE(ret, false, ME, "Bad config");
-    SAH_TRACEZ_INFO(ME, "%s: updateConfig interface:%s, key:%s, value:%s", configPath, interface, key, value);
-    ret = wld_hostapd_addConfigParam(config, interface, key, value);
+    bool ret = wld_hostapd_cfgFile_stageUpdate(configPath, interface, key, value);
     if(ret) {
-        ret = wld_hostapd_writeConfig(config, configPath);
+        ret = wld_hostapd_cfgFile_commitUpdates(configPath);
     }
-    wld_hostapd_deleteConfig(config);
     SAH_TRACEZ_OUT(ME);
     return ret;
 }
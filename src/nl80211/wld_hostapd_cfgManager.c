@@ -61,43 +61,129 @@
 ****************************************************************************/
 #include <errno.h>
 #include <swl/fileOps/swl_fileUtils.h>
-#include <swl/fileOps/swl_mapWriterKVP.h>
 #include "wld.h"
 #include "wld_util.h"
 #include "wld_hostapd_cfgManager.h"
 #include "wld_hostapd_cfgManager_priv.h"
 #include "wld_hostapd_cfgFile.h"
+#include "Utils/wld_cfgWriter.h"
 #include "wld_radio.h"
 #include "wld_rad_hostapd_api.h"
 
 #define ME "fileMgr"
 
+/*
+ * @brief 64-bit fingerprint of one "key=value" param
+ * Section fingerprint is the sum of its params fingerprints: independent of params order,
+ * and updated in O(1) when a param is added, modified or removed.
+ */
+static uint64_t s_paramFingerprint(const char* key, const char* value) {
+    uint64_t h = WLD_UTIL_FNV64_OFFSET_BASIS;
+    h = wld_util_fnv64Update(h, key, swl_str_len(key));
+    h = wld_util_fnv64Update(h, "=", 1);
+    h = wld_util_fnv64Update(h, value, swl_str_len(value));
+    // final avalanche, to spread single bit changes before summing
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t wld_hostapd_getMapFingerprint(swl_mapChar_t* configMap) {
+    ASSERTS_NOT_NULL(configMap, 0, ME, "NULL");
+    uint64_t fingerprint = 0;
+    swl_mapIt_t it;
+    swl_map_for_each(it, configMap) {
+        fingerprint += s_paramFingerprint((const char*) swl_map_itKey(&it), (const char*) swl_map_itValue(&it));
+    }
+    return fingerprint;
+}
+
+static wld_hostapdVapInfo_t* s_getVapInfo(wld_hostapd_config_t* conf, const char* bssName) {
+    ASSERTS_STR(bssName, NULL, ME, "empty bss name");
+    amxc_htable_it_t* it = amxc_htable_get(&conf->vapsByName, bssName);
+    ASSERTS_NOT_NULL(it, NULL, ME, "bss %s not found", bssName);
+    return amxc_htable_it_get_data(it, wld_hostapdVapInfo_t, nameIt);
+}
+
+static wld_hostapdVapInfo_t* s_getVapInfoByBssid(wld_hostapd_config_t* conf, swl_macBin_t* bssid) {
+    swl_macChar_t macChar = SWL_MAC_CHAR_NEW();
+    SWL_MAC_BIN_TO_CHAR(&macChar, bssid);
+    amxc_htable_it_t* it = amxc_htable_get(&conf->vapsByBssid, macChar.cMac);
+    ASSERTS_NOT_NULL(it, NULL, ME, "bssid %s not found", macChar.cMac);
+    return amxc_htable_it_get_data(it, wld_hostapdVapInfo_t, bssidIt);
+}
+
+/*
+ * @brief set vap section bssid, and update the bssid index
+ */
+static void s_setVapInfoBssid(wld_hostapd_config_t* conf, wld_hostapdVapInfo_t* vapInfo, swl_macBin_t* bssid) {
+    amxc_htable_it_clean(&vapInfo->bssidIt, NULL);
+    memcpy(&vapInfo->bssid, bssid, sizeof(vapInfo->bssid));
+    ASSERTS_FALSE(swl_mac_binIsNull(&vapInfo->bssid), , ME, "%s: no bssid", vapInfo->bssName);
+    swl_macChar_t macChar = SWL_MAC_CHAR_NEW();
+    SWL_MAC_BIN_TO_CHAR(&macChar, &vapInfo->bssid);
+    amxc_htable_insert(&conf->vapsByBssid, macChar.cMac, &vapInfo->bssidIt);
+}
+
+static void s_initConfigIndexes(wld_hostapd_config_t* conf) {
+    amxc_llist_init(&conf->vaps);
+    amxc_htable_init(&conf->vapsByName, 8);
+    amxc_htable_init(&conf->vapsByBssid, 8);
+}
+
+/*
+ * @brief locate the params map of a section, with its fingerprint
+ * bssName NULL designates the general section
+ */
+static swl_mapChar_t* s_getSection(wld_hostapd_config_t* conf, const char* bssName, uint64_t** ppFingerprint, bool** ppStale) {
+    if(bssName == NULL) {
+        *ppFingerprint = &conf->headerFingerprint;
+        *ppStale = &conf->headerFingerprintStale;
+        return &conf->header;
+    }
+    wld_hostapdVapInfo_t* vapInfo = s_getVapInfo(conf, bssName);
+    ASSERTS_NOT_NULL(vapInfo, NULL, ME, "bss %s not found", bssName);
+    *ppFingerprint = &vapInfo->fingerprint;
+    *ppStale = &vapInfo->fingerprintStale;
+    return &vapInfo->vapParams;
+}
+
 /**
- * @brief create a vap map for interface/bss section
+ * @brief create a vap map for interface/bss section, indexed in the config by bss name
+ * The caller inserts it in the config vaps list, at the matching file position.
  *
+ * @param conf the structure mapping the content of hostapd configuration file
  * @param isInterface if the hostapdVapInfo is an interface or bss
  * @param bssName the interface/bss name
  *
  * @return a Non NULL pointer to a wld_hostapdVapInfo_t on success. Otherwise, NULL
  */
-static wld_hostapdVapInfo_t* s_createHostapdVapInfo(bool isInterface, char* bssName) {
+static wld_hostapdVapInfo_t* s_createHostapdVapInfo(wld_hostapd_config_t* conf, bool isInterface, char* bssName) {
     wld_hostapdVapInfo_t* vapInfo = calloc(1, sizeof(wld_hostapdVapInfo_t));
     ASSERTS_NOT_NULL(vapInfo, NULL, ME, "NULL");
     vapInfo->isInterface = isInterface;
     vapInfo->bssName = strdup(bssName);
     swl_mapChar_init(&(vapInfo->vapParams));
+    amxc_htable_it_init(&vapInfo->nameIt);
+    amxc_htable_it_init(&vapInfo->bssidIt);
+    amxc_htable_insert(&conf->vapsByName, vapInfo->bssName, &vapInfo->nameIt);
     return vapInfo;
 }
 
 /**
- * @brief delete a vap map for interface/bss section
+ * @brief delete a vap map for interface/bss section, and drop it from config list and indexes
  *
- * @param isInterface if the hostapdVapInfo is an interface or bss
+ * @param vapInfo the interface/bss section
  *
  * @return void
  */
 static void s_deleteHostapdVapInfo(wld_hostapdVapInfo_t* vapInfo) {
     ASSERTS_NOT_NULL(vapInfo, , ME, "NULL");
+    amxc_htable_it_clean(&vapInfo->nameIt, NULL);
+    amxc_htable_it_clean(&vapInfo->bssidIt, NULL);
     free(vapInfo->bssName);
     vapInfo->bssName = NULL;
     swl_mapChar_cleanup(&(vapInfo->vapParams));
@@ -122,16 +208,16 @@ static bool s_initConfig(wld_hostapd_config_t** pConf, amxc_llist_t* pllAP) {
     *pConf = config;
     // Init the header map
     swl_mapChar_init(&(config->header));
-    amxc_llist_init(&config->vaps);
+    s_initConfigIndexes(config);
     amxc_llist_for_each(ap_it, pllAP) {
         T_AccessPoint* pAp = amxc_llist_it_get_data(ap_it, T_AccessPoint, it);
         bool isInterface = (pAp == wld_rad_hostapd_getCfgMainVap(pAp->pRadio));
-        wld_hostapdVapInfo_t* vapInfo = s_createHostapdVapInfo(isInterface, pAp->alias);
+        wld_hostapdVapInfo_t* vapInfo = s_createHostapdVapInfo(config, isInterface, pAp->alias);
         if(vapInfo == NULL) {
             SAH_TRACEZ_ERROR(ME, "%s: fail to alloc vap conf section", pAp->alias);
             continue;
         }
-        memcpy(&vapInfo->bssid, pAp->pSSID->MACAddress, SWL_MAC_BIN_LEN);
+        s_setVapInfoBssid(config, vapInfo, (swl_macBin_t*) pAp->pSSID->MACAddress);
         if(isInterface) {
             amxc_llist_prepend(&config->vaps, &vapInfo->it);
         } else {
@@ -231,6 +317,7 @@ bool wld_hostapd_loadConfig(wld_hostapd_config_t** conf, char* path) {
 
     // Init the header map
     swl_mapChar_init(&(config->header));
+    s_initConfigIndexes(config);
 
     while(fgets(line, sizeof(line), fp) != NULL) {
         if(line[0] == '#') {
@@ -254,15 +341,14 @@ bool wld_hostapd_loadConfig(wld_hostapd_config_t** conf, char* path) {
 
         if(swl_str_matches(key, "interface")) {
             isHeaderParsing = false;
-            amxc_llist_init(&config->vaps);
-            lastVap = s_createHostapdVapInfo(true, value);
+            lastVap = s_createHostapdVapInfo(config, true, value);
             if(lastVap == NULL) {
                 ret = false;
                 break;
             }
             amxc_llist_append(&config->vaps, &lastVap->it);
         } else if(swl_str_matches(key, "bss")) {
-            lastVap = s_createHostapdVapInfo(false, value);
+            lastVap = s_createHostapdVapInfo(config, false, value);
             if(lastVap == NULL) {
                 ret = false;
                 break;
@@ -270,11 +356,17 @@ bool wld_hostapd_loadConfig(wld_hostapd_config_t** conf, char* path) {
             amxc_llist_append(&config->vaps, &lastVap->it);
         }
         if(isHeaderParsing) {
-            swl_mapChar_add(&(config->header), key, value);
+            if(swl_mapChar_add(&(config->header), key, value)) {
+                config->headerFingerprint += s_paramFingerprint(key, value);
+            }
         } else {
-            swl_mapChar_add(&(lastVap->vapParams), key, value);
+            if(swl_mapChar_add(&(lastVap->vapParams), key, value)) {
+                lastVap->fingerprint += s_paramFingerprint(key, value);
+            }
             if(swl_str_matches(key, "bssid")) {
-                swl_typeMacBin_fromChar(&lastVap->bssid, value);
+                swl_macBin_t bssid = SWL_MAC_BIN_NEW();
+                swl_typeMacBin_fromChar(&bssid, value);
+                s_setVapInfoBssid(config, lastVap, &bssid);
             }
         }
     }
@@ -308,6 +400,8 @@ bool wld_hostapd_deleteConfig(wld_hostapd_config_t* conf) {
         it = amxc_llist_it_get_next(it);
         s_deleteHostapdVapInfo(vapInfo);
     }
+    amxc_htable_clean(&conf->vapsByName, NULL);
+    amxc_htable_clean(&conf->vapsByBssid, NULL);
     free(conf);
     SAH_TRACEZ_OUT(ME);
     return true;
@@ -328,43 +422,25 @@ bool wld_hostapd_writeConfig(wld_hostapd_config_t* conf, char* path) {
     SAH_TRACEZ_IN(ME);
     ASSERTS_NOT_NULL(conf, false, ME, "NULL");
     ASSERT_STR(path, false, ME, "Empty path");
-    char tmpName[128];
-    bool ret;
-
-    // Write header into temporary file
-    snprintf(tmpName, sizeof(tmpName), "%s.tmp.txt", path);
-    FILE* fptr = fopen(tmpName, "w");
-    ASSERTS_NOT_NULL(fptr, false, ME, "NULL");
-    fprintf(fptr, "## General configurations\n");
-    ret = swl_mapWriterKVP_writeToFptrEsc(&(conf->header), fptr, "\\", '\\');
-    if(!ret) {
-        SAH_TRACEZ_ERROR(ME, "writing config header failed");
-        fclose(fptr);
-        unlink(tmpName);
-        return false;
-    }
 
-    // Write vaps list into into temporary file
+    // Render the whole config, then write it at once
+    wld_cfgWriter_t* pWriter = wld_cfgWriter_start();
+    wld_cfgWriter_addStr(pWriter, "## General configurations\n");
+    bool ret = wld_cfgWriter_addMapEsc(pWriter, &(conf->header), "\\", '\\');
+    ASSERT_TRUE(ret, false, ME, "writing config header failed");
+
     amxc_llist_for_each(it, &conf->vaps) {
         wld_hostapdVapInfo_t* vapInfo = amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it);
         if(vapInfo->isInterface) {
-            fprintf(fptr, "## Interface configurations\n");
+            wld_cfgWriter_addStr(pWriter, "## Interface configurations\n");
         } else {
-            fprintf(fptr, "## BSS configurations\n");
-        }
-        ret = swl_mapWriterKVP_writeToFptrEsc(&(vapInfo->vapParams), fptr, "\\", '\\');
-        if(!ret) {
-            SAH_TRACEZ_ERROR(ME, "writing config header failed");
-            break;
+            wld_cfgWriter_addStr(pWriter, "## BSS configurations\n");
         }
+        ret = wld_cfgWriter_addMapEsc(pWriter, &(vapInfo->vapParams), "\\", '\\');
+        ASSERT_TRUE(ret, false, ME, "writing config of %s failed", vapInfo->bssName);
     }
 
-    fclose(fptr);
-    // Rename the file
-    if(ret) {
-        ret = rename(tmpName, path) >= 0 ? true : false;
-    }
-    unlink(tmpName);
+    ret = swl_rc_isOk(wld_cfgWriter_commit(pWriter, path, wld_cfgWriter_getDefaultFlags()));
 
     SAH_TRACEZ_OUT(ME);
     return ret;
@@ -388,18 +464,18 @@ bool wld_hostapd_addConfigParam(wld_hostapd_config_t* conf, const char* bssName,
     ASSERTS_NOT_NULL(conf, false, ME, "NULL");
     ASSERTS_NOT_NULL(key, false, ME, "NULL");
     ASSERTS_NOT_NULL(value, false, ME, "NULL");
-    bool ret = false;
-
-    if(bssName == NULL) {
-        ret = swl_map_addOrSet(&conf->header, (char*) key, (char*) value);
-    } else {
-        amxc_llist_for_each(it, &conf->vaps) {
-            wld_hostapdVapInfo_t* vapInfo = amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it);
-            if(swl_str_matches(vapInfo->bssName, bssName)) {
-                ret = swl_map_addOrSet(&vapInfo->vapParams, (char*) key, (char*) value);
-                break;
-            }
-        }
+    uint64_t* pFingerprint = NULL;
+    bool* pStale = NULL;
+    swl_mapChar_t* configMap = s_getSection(conf, bssName, &pFingerprint, &pStale);
+    ASSERTS_NOT_NULL(configMap, false, ME, "no section %s", bssName);
+    uint64_t oldParamFp = 0;
+    const char* oldValue = swl_mapChar_get(configMap, (char*) key);
+    if(oldValue != NULL) {
+        oldParamFp = s_paramFingerprint(key, oldValue);
+    }
+    bool ret = swl_map_addOrSet(configMap, (char*) key, (char*) value);
+    if(ret) {
+        *pFingerprint += s_paramFingerprint(key, value) - oldParamFp;
     }
     SAH_TRACEZ_OUT(ME);
     return ret;
@@ -423,25 +499,16 @@ bool wld_hostapd_delConfigParam(wld_hostapd_config_t* conf, char* bssName, char*
     SAH_TRACEZ_IN(ME);
     ASSERTS_NOT_NULL(conf, false, ME, "NULL");
     ASSERTS_NOT_NULL(key, false, ME, "NULL");
-    bool ret = false;
-
-    if(bssName == NULL) {
-        ret = swl_map_has(&conf->header, key);
-        ASSERT_TRUE(ret, false, ME, "key %s doesn't exist", key);
-        swl_map_delete(&conf->header, key);
-    } else {
-        amxc_llist_for_each(it, &conf->vaps) {
-            wld_hostapdVapInfo_t* vapInfo = amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it);
-            if(swl_str_matches(vapInfo->bssName, bssName)) {
-                ret = swl_map_has(&vapInfo->vapParams, key);
-                ASSERT_TRUE(ret, false, ME, "key %s doesn't exist", key);
-                swl_map_delete(&vapInfo->vapParams, key);
-                break;
-            }
-        }
-    }
+    uint64_t* pFingerprint = NULL;
+    bool* pStale = NULL;
+    swl_mapChar_t* configMap = s_getSection(conf, bssName, &pFingerprint, &pStale);
+    ASSERTS_NOT_NULL(configMap, false, ME, "no section %s", bssName);
+    const char* oldValue = swl_mapChar_get(configMap, key);
+    ASSERT_NOT_NULL(oldValue, false, ME, "key %s doesn't exist", key);
+    *pFingerprint -= s_paramFingerprint(key, oldValue);
+    swl_map_delete(configMap, key);
     SAH_TRACEZ_OUT(ME);
-    return ret;
+    return true;
 }
 
 /**
@@ -455,22 +522,22 @@ bool wld_hostapd_delConfigParam(wld_hostapd_config_t* conf, char* bssName, char*
 swl_mapChar_t* wld_hostapd_getConfigMap(wld_hostapd_config_t* conf, char* bssName) {
     SAH_TRACEZ_IN(ME);
     ASSERTS_NOT_NULL(conf, NULL, ME, "NULL");
-    if(bssName == NULL) {
-        return &(conf->header);
-    } else {
-        amxc_llist_for_each(it, &conf->vaps) {
-            wld_hostapdVapInfo_t* vapInfo = amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it);
-            if(swl_str_matches(vapInfo->bssName, bssName)) {
-                return &(vapInfo->vapParams);
-            }
-        }
+    uint64_t* pFingerprint = NULL;
+    bool* pStale = NULL;
+    swl_mapChar_t* configMap = s_getSection(conf, bssName, &pFingerprint, &pStale);
+    if(configMap != NULL) {
+        // map may be modified directly by caller
+        *pStale = true;
     }
     SAH_TRACEZ_OUT(ME);
-    return NULL;
+    return configMap;
 }
 
 const char* wld_hostapd_getConfigParamValStr(wld_hostapd_config_t* conf, char* bssName, const char* key) {
-    swl_mapChar_t* configMap = wld_hostapd_getConfigMap(conf, bssName);
+    ASSERTS_NOT_NULL(conf, NULL, ME, "NULL");
+    uint64_t* pFingerprint = NULL;
+    bool* pStale = NULL;
+    swl_mapChar_t* configMap = s_getSection(conf, bssName, &pFingerprint, &pStale);
     ASSERTS_NOT_NULL(configMap, NULL, ME, "NULL");
     swl_mapEntry_t* entry = swl_mapChar_getEntry(configMap, (char*) key);
     ASSERTI_NOT_NULL(entry, NULL, ME, "key (%s) Not found", key);
@@ -481,24 +548,267 @@ swl_mapChar_t* wld_hostapd_getConfigMapByBssid(wld_hostapd_config_t* conf, swl_m
     SAH_TRACEZ_IN(ME);
     ASSERTS_NOT_NULL(conf, NULL, ME, "NULL");
     if(bssid == NULL) {
+        conf->headerFingerprintStale = true;
         return &(conf->header);
-    } else {
-        amxc_llist_for_each(it, &conf->vaps) {
-            wld_hostapdVapInfo_t* vapInfo = amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it);
-            if(swl_typeMacBin_equalsRef(&vapInfo->bssid, bssid)) {
-                return &(vapInfo->vapParams);
-            }
-        }
     }
+    wld_hostapdVapInfo_t* vapInfo = s_getVapInfoByBssid(conf, bssid);
+    ASSERTS_NOT_NULL(vapInfo, NULL, ME, "NULL");
+    // map may be modified directly by caller
+    vapInfo->fingerprintStale = true;
     SAH_TRACEZ_OUT(ME);
-    return NULL;
+    return &(vapInfo->vapParams);
 }
 
 const char* wld_hostapd_getConfigParamByBssidValStr(wld_hostapd_config_t* conf, swl_macBin_t* bssid, const char* key) {
-    swl_mapChar_t* configMap = wld_hostapd_getConfigMapByBssid(conf, bssid);
+    ASSERTS_NOT_NULL(conf, NULL, ME, "NULL");
+    swl_mapChar_t* configMap = NULL;
+    if(bssid == NULL) {
+        configMap = &conf->header;
+    } else {
+        wld_hostapdVapInfo_t* vapInfo = s_getVapInfoByBssid(conf, bssid);
+        ASSERTS_NOT_NULL(vapInfo, NULL, ME, "NULL");
+        configMap = &vapInfo->vapParams;
+    }
     ASSERTS_NOT_NULL(configMap, NULL, ME, "NULL");
     swl_mapEntry_t* entry = swl_mapChar_getEntry(configMap, (char*) key);
     ASSERTI_NOT_NULL(entry, NULL, ME, "key (%s) Not found", key);
     return swl_map_getEntryValueValue(configMap, entry);
 }
 
+/**
+ * @brief get the fingerprint of a config section
+ *
+ * The fingerprint is maintained when params are added/deleted through the config manager,
+ * and recomputed only when the section map was handed out to a caller.
+ *
+ * @param conf the structure mapping the content of hostapd configuration file
+ * @param bssName if NULL then the general section. Otherwise, the interface/bss section
+ *
+ * @return the section fingerprint, 0 if section is not found
+ */
+uint64_t wld_hostapd_getConfigFingerprint(wld_hostapd_config_t* conf, const char* bssName) {
+    ASSERTS_NOT_NULL(conf, 0, ME, "NULL");
+    uint64_t* pFingerprint = NULL;
+    bool* pStale = NULL;
+    swl_mapChar_t* configMap = s_getSection(conf, bssName, &pFingerprint, &pStale);
+    ASSERTS_NOT_NULL(configMap, 0, ME, "no section %s", bssName);
+    if(*pStale) {
+        *pFingerprint = wld_hostapd_getMapFingerprint(configMap);
+        *pStale = false;
+    }
+    return *pFingerprint;
+}
+
+static bool s_isFileStatChanged(const wld_hostapd_cfgSnapshot_t* pSnapshot, const char* path) {
+    struct stat st;
+    if(stat(path, &st) < 0) {
+        return true;
+    }
+    return ((st.st_ino != pSnapshot->fileStat.st_ino) ||
+            (st.st_size != pSnapshot->fileStat.st_size) ||
+            (st.st_mtim.tv_sec != pSnapshot->fileStat.st_mtim.tv_sec) ||
+            (st.st_mtim.tv_nsec != pSnapshot->fileStat.st_mtim.tv_nsec));
+}
+
+/**
+ * @brief compare config against the snapshot of the last written config
+ *
+ * Per-section result is available afterwards with wld_hostapd_isConfigSectionChanged.
+ *
+ * @param pSnapshot snapshot of the last written config (may be NULL)
+ * @param conf the structure mapping the content of hostapd configuration file
+ * @param path optional config file path: any change of the file since the snapshot was saved
+ * (ie. external edit, removal) implies full change
+ *
+ * @return scope of the changes:
+ *  - NONE: all sections fingerprints match
+ *  - BSS: general section and list of bss unchanged, but some interface/bss sections changed
+ *  - FULL: no snapshot, file modified, general section changed or bss added/removed/reordered
+ */
+wld_hostapd_cfgChange_e wld_hostapd_diffConfigSnapshot(const wld_hostapd_cfgSnapshot_t* pSnapshot, wld_hostapd_config_t* conf, const char* path) {
+    ASSERTS_NOT_NULL(conf, WLD_HOSTAPD_CFG_CHANGE_FULL, ME, "NULL");
+    bool full = ((pSnapshot == NULL) ||
+                 (!swl_str_isEmpty(path) && s_isFileStatChanged(pSnapshot, path)) ||
+                 (pSnapshot->headerFingerprint != wld_hostapd_getConfigFingerprint(conf, NULL)) ||
+                 (pSnapshot->nBss != amxc_llist_size(&conf->vaps)));
+    wld_hostapd_cfgChange_e change = full ? WLD_HOSTAPD_CFG_CHANGE_FULL : WLD_HOSTAPD_CFG_CHANGE_NONE;
+    uint32_t i = 0;
+    amxc_llist_for_each(it, &conf->vaps) {
+        wld_hostapdVapInfo_t* vapInfo = amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it);
+        uint64_t fingerprint = wld_hostapd_getConfigFingerprint(conf, vapInfo->bssName);
+        vapInfo->changed = full ||
+            !swl_str_matches(pSnapshot->bss[i].bssName, vapInfo->bssName) ||
+            (pSnapshot->bss[i].fingerprint != fingerprint);
+        if(!full && vapInfo->changed) {
+            if(!swl_str_matches(pSnapshot->bss[i].bssName, vapInfo->bssName)) {
+                change = WLD_HOSTAPD_CFG_CHANGE_FULL;
+            } else if(change == WLD_HOSTAPD_CFG_CHANGE_NONE) {
+                change = WLD_HOSTAPD_CFG_CHANGE_BSS;
+            }
+        }
+        i++;
+    }
+    if(change == WLD_HOSTAPD_CFG_CHANGE_FULL) {
+        amxc_llist_for_each(it, &conf->vaps) {
+            amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it)->changed = true;
+        }
+    }
+    return change;
+}
+
+/**
+ * @brief check whether interface/bss section was found changed by last wld_hostapd_diffConfigSnapshot
+ */
+bool wld_hostapd_isConfigSectionChanged(wld_hostapd_config_t* conf, const char* bssName) {
+    ASSERTS_NOT_NULL(conf, true, ME, "NULL");
+    wld_hostapdVapInfo_t* vapInfo = s_getVapInfo(conf, bssName);
+    ASSERTS_NOT_NULL(vapInfo, true, ME, "bss %s not found", bssName);
+    return vapInfo->changed;
+}
+
+static void s_clearSnapshotBss(wld_hostapd_cfgSnapshot_t* pSnapshot) {
+    for(uint32_t i = 0; i < pSnapshot->nBss; i++) {
+        free(pSnapshot->bss[i].bssName);
+    }
+    free(pSnapshot->bss);
+    pSnapshot->bss = NULL;
+    pSnapshot->nBss = 0;
+}
+
+/**
+ * @brief save the fingerprints of a config just written into file
+ *
+ * Pending change scope is accumulated with the one of the previous snapshot,
+ * until it is acknowledged with wld_hostapd_setConfigSnapshotPendingChange.
+ *
+ * @param ppSnapshot pointer to the snapshot to create/update
+ * @param conf the structure mapping the content of hostapd configuration file
+ * @param change scope of change returned by wld_hostapd_diffConfigSnapshot
+ * @param path the config file path, whose status is saved
+ *
+ * @return true on success, false otherwise (snapshot is then deleted)
+ */
+bool wld_hostapd_saveConfigSnapshot(wld_hostapd_cfgSnapshot_t** ppSnapshot, wld_hostapd_config_t* conf, wld_hostapd_cfgChange_e change, const char* path) {
+    ASSERTS_NOT_NULL(ppSnapshot, false, ME, "NULL");
+    ASSERTS_NOT_NULL(conf, false, ME, "NULL");
+    wld_hostapd_cfgSnapshot_t* pSnapshot = *ppSnapshot;
+    if(pSnapshot == NULL) {
+        pSnapshot = calloc(1, sizeof(*pSnapshot));
+        ASSERT_NOT_NULL(pSnapshot, false, ME, "fail to alloc config snapshot");
+        pSnapshot->pendingChange = WLD_HOSTAPD_CFG_CHANGE_FULL;
+        *ppSnapshot = pSnapshot;
+    }
+    uint32_t nBss = amxc_llist_size(&conf->vaps);
+    wld_hostapd_cfgSnapshotBss_t* bss = calloc(nBss ? nBss : 1, sizeof(*bss));
+    if(bss == NULL) {
+        SAH_TRACEZ_ERROR(ME, "fail to alloc config snapshot");
+        wld_hostapd_deleteConfigSnapshot(ppSnapshot);
+        return false;
+    }
+    bool samePendingBss = (change != WLD_HOSTAPD_CFG_CHANGE_FULL) && (pSnapshot->nBss == nBss);
+    uint32_t i = 0;
+    amxc_llist_for_each(it, &conf->vaps) {
+        wld_hostapdVapInfo_t* vapInfo = amxc_llist_it_get_data(it, wld_hostapdVapInfo_t, it);
+        bss[i].bssName = strdup(vapInfo->bssName);
+        bss[i].fingerprint = wld_hostapd_getConfigFingerprint(conf, vapInfo->bssName);
+        bss[i].pendingChange = !samePendingBss || vapInfo->changed || pSnapshot->bss[i].pendingChange;
+        i++;
+    }
+    s_clearSnapshotBss(pSnapshot);
+    pSnapshot->bss = bss;
+    pSnapshot->nBss = nBss;
+    pSnapshot->headerFingerprint = wld_hostapd_getConfigFingerprint(conf, NULL);
+    pSnapshot->pendingChange = SWL_MAX(pSnapshot->pendingChange, change);
+    if(swl_str_isEmpty(path) || (stat(path, &pSnapshot->fileStat) < 0)) {
+        memset(&pSnapshot->fileStat, 0, sizeof(pSnapshot->fileStat));
+    }
+    return true;
+}
+
+/**
+ * @brief account, in the snapshot, a param patched in place in the written config file
+ * (ie. applied at runtime), so that next diff does not see it as a change.
+ *
+ * @param pSnapshot snapshot of the last written config
+ * @param bssName if NULL then the general section. Otherwise, the interface/bss section
+ * @param key the patched param
+ * @param oldValue the value previously written in file (NULL if param was absent)
+ * @param newValue the new value written in file
+ *
+ * @return true if the section is found in snapshot, false otherwise
+ */
+bool wld_hostapd_updateConfigSnapshotParam(wld_hostapd_cfgSnapshot_t* pSnapshot, const char* bssName, const char* key, const char* oldValue, const char* newValue) {
+    ASSERTS_NOT_NULL(pSnapshot, false, ME, "NULL");
+    ASSERTS_STR(key, false, ME, "empty key");
+    uint64_t* pFingerprint = NULL;
+    if(bssName == NULL) {
+        pFingerprint = &pSnapshot->headerFingerprint;
+    } else {
+        for(uint32_t i = 0; (i < pSnapshot->nBss) && (pFingerprint == NULL); i++) {
+            if(swl_str_matches(pSnapshot->bss[i].bssName, bssName)) {
+                pFingerprint = &pSnapshot->bss[i].fingerprint;
+            }
+        }
+    }
+    ASSERTS_NOT_NULL(pFingerprint, false, ME, "bss %s not in snapshot", bssName);
+    if(oldValue != NULL) {
+        *pFingerprint -= s_paramFingerprint(key, oldValue);
+    }
+    *pFingerprint += s_paramFingerprint(key, newValue);
+    return true;
+}
+
+/**
+ * @brief save the status of the config file, after it was patched in place
+ */
+void wld_hostapd_updateConfigSnapshotFileStat(wld_hostapd_cfgSnapshot_t* pSnapshot, const char* path) {
+    ASSERTS_NOT_NULL(pSnapshot, , ME, "NULL");
+    if(swl_str_isEmpty(path) || (stat(path, &pSnapshot->fileStat) < 0)) {
+        memset(&pSnapshot->fileStat, 0, sizeof(pSnapshot->fileStat));
+    }
+}
+
+void wld_hostapd_deleteConfigSnapshot(wld_hostapd_cfgSnapshot_t** ppSnapshot) {
+    ASSERTS_NOT_NULL(ppSnapshot, , ME, "NULL");
+    ASSERTS_NOT_NULL(*ppSnapshot, , ME, "NULL");
+    s_clearSnapshotBss(*ppSnapshot);
+    free(*ppSnapshot);
+    *ppSnapshot = NULL;
+}
+
+/**
+ * @brief get the scope of config changes written but not yet applied by the daemon
+ * Without snapshot, config is assumed fully changed
+ */
+wld_hostapd_cfgChange_e wld_hostapd_getConfigSnapshotPendingChange(const wld_hostapd_cfgSnapshot_t* pSnapshot) {
+    ASSERTS_NOT_NULL(pSnapshot, WLD_HOSTAPD_CFG_CHANGE_FULL, ME, "NULL");
+    return pSnapshot->pendingChange;
+}
+
+bool wld_hostapd_isConfigSnapshotBssPending(const wld_hostapd_cfgSnapshot_t* pSnapshot, const char* bssName) {
+    ASSERTS_NOT_NULL(pSnapshot, true, ME, "NULL");
+    if(pSnapshot->pendingChange == WLD_HOSTAPD_CFG_CHANGE_FULL) {
+        return true;
+    }
+    for(uint32_t i = 0; i < pSnapshot->nBss; i++) {
+        if(swl_str_matches(pSnapshot->bss[i].bssName, bssName)) {
+            return pSnapshot->bss[i].pendingChange;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief force or acknowledge the scope of pending config changes
+ * NONE acknowledges all pending changes (ie. applied by daemon),
+ * FULL forces the next config apply to be a full reload
+ */
+void wld_hostapd_setConfigSnapshotPendingChange(wld_hostapd_cfgSnapshot_t* pSnapshot, wld_hostapd_cfgChange_e change) {
+    ASSERTS_NOT_NULL(pSnapshot, , ME, "NULL");
+    pSnapshot->pendingChange = change;
+    if(change == WLD_HOSTAPD_CFG_CHANGE_NONE) {
+        for(uint32_t i = 0; i < pSnapshot->nBss; i++) {
+            pSnapshot->bss[i].pendingChange = false;
+        }
+    }
+}
@@ -1160,22 +1160,10 @@ static swl_rc_ne s_parseRateInfo(struct nlattr* pBitrateAttributre, wld_nl80211_
     // Get guard interval
     if(pRinfo[NL80211_RATE_INFO_EHT_GI]) {
         uint8_t sgi = nla_get_u8(pRinfo[NL80211_RATE_INFO_EHT_GI]);
-        if(sgi == NL80211_RATE_INFO_EHT_GI_0_8) {
-            pRate->mcsInfo.guardInterval = SWL_SGI_800;
-        } else if(sgi == NL80211_RATE_INFO_EHT_GI_1_6) {
-            pRate->mcsInfo.guardInterval = SWL_SGI_1600;
-        } else if(sgi == NL80211_RATE_INFO_EHT_GI_3_2) {
-            pRate->mcsInfo.guardInterval = SWL_SGI_3200;
-        }
+        pRate->mcsInfo.guardInterval = wld_nl80211_rateHeGiToSwl(sgi, pRate->mcsInfo.guardInterval);
     } else if(pRinfo[NL80211_RATE_INFO_HE_GI]) {
         uint8_t sgi = nla_get_u8(pRinfo[NL80211_RATE_INFO_HE_GI]);
-        if(sgi == NL80211_RATE_INFO_HE_GI_0_8) {
-            pRate->mcsInfo.guardInterval = SWL_SGI_800;
-        } else if(sgi == NL80211_RATE_INFO_HE_GI_1_6) {
-            pRate->mcsInfo.guardInterval = SWL_SGI_1600;
-        } else if(sgi == NL80211_RATE_INFO_HE_GI_3_2) {
-            pRate->mcsInfo.guardInterval = SWL_SGI_3200;
-        }
+        pRate->mcsInfo.guardInterval = wld_nl80211_rateHeGiToSwl(sgi, pRate->mcsInfo.guardInterval);
     } else if(pRinfo[NL80211_RATE_INFO_SHORT_GI]) {
         pRate->mcsInfo.guardInterval = SWL_SGI_400;
     }
@@ -1192,19 +1180,13 @@ static swl_rc_ne s_parseRateInfo(struct nlattr* pBitrateAttributre, wld_nl80211_
     }
 
     // Get Bandwidth value
-    if((pRinfo[NL80211_RATE_INFO_80P80_MHZ_WIDTH]) || (pRinfo[NL80211_RATE_INFO_160_MHZ_WIDTH])) {
-        pRate->mcsInfo.bandwidth = SWL_BW_160MHZ;
-    } else if(pRinfo[NL80211_RATE_INFO_80_MHZ_WIDTH]) {
-        pRate->mcsInfo.bandwidth = SWL_BW_80MHZ;
-    } else if(pRinfo[NL80211_RATE_INFO_40_MHZ_WIDTH]) {
-        pRate->mcsInfo.bandwidth = SWL_BW_40MHZ;
-    } else if(pRinfo[NL80211_RATE_INFO_10_MHZ_WIDTH]) {
-        pRate->mcsInfo.bandwidth = SWL_BW_10MHZ;
-    } else if(pRinfo[NL80211_RATE_INFO_5_MHZ_WIDTH]) {
-        pRate->mcsInfo.bandwidth = SWL_BW_5MHZ;
-    } else {
-        pRate->mcsInfo.bandwidth = SWL_BW_20MHZ;
-    }
+    uint32_t bwFlags = 0;
+    bwFlags |= (pRinfo[NL80211_RATE_INFO_80P80_MHZ_WIDTH] || pRinfo[NL80211_RATE_INFO_160_MHZ_WIDTH]) ? WLD_NL80211_RATE_BW_F_160 : 0;
+    bwFlags |= pRinfo[NL80211_RATE_INFO_80_MHZ_WIDTH] ? WLD_NL80211_RATE_BW_F_80 : 0;
+    bwFlags |= pRinfo[NL80211_RATE_INFO_40_MHZ_WIDTH] ? WLD_NL80211_RATE_BW_F_40 : 0;
+    bwFlags |= pRinfo[NL80211_RATE_INFO_10_MHZ_WIDTH] ? WLD_NL80211_RATE_BW_F_10 : 0;
+    bwFlags |= pRinfo[NL80211_RATE_INFO_5_MHZ_WIDTH] ? WLD_NL80211_RATE_BW_F_5 : 0;
+    pRate->mcsInfo.bandwidth = wld_nl80211_rateBwFlagsToSwl(bwFlags);
 
     swl_mcs_checkMcsIndexes(&pRate->mcsInfo);
 
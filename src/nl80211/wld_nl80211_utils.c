@@ -88,6 +88,28 @@ SWL_TABLE(sChannelWidthMap,
               {NL80211_CHAN_WIDTH_80P80, 160, SWL_BW_AUTO},
               ));
 
+/*
+ * Same mapping as sChannelWidthMap, directly indexed by NL80211_CHAN_WIDTH_xxx,
+ * for conversions done on each parsed nl message.
+ * Entries with null bw are not matched.
+ */
+#define NR_NL_CHAN_WIDTHS (NL80211_CHAN_WIDTH_320 + 1)
+static const struct {
+    uint16_t bw;
+    swl_bandwidth_e swlBw;
+} sNlChannelWidthIdx[NR_NL_CHAN_WIDTHS] = {
+    [NL80211_CHAN_WIDTH_20_NOHT] = {20, SWL_BW_20MHZ},
+    [NL80211_CHAN_WIDTH_20] = {20, SWL_BW_20MHZ},
+    [NL80211_CHAN_WIDTH_40] = {40, SWL_BW_40MHZ},
+    [NL80211_CHAN_WIDTH_80] = {80, SWL_BW_80MHZ},
+    [NL80211_CHAN_WIDTH_80P80] = {160, SWL_BW_AUTO},
+    [NL80211_CHAN_WIDTH_160] = {160, SWL_BW_160MHZ},
+    [NL80211_CHAN_WIDTH_5] = {5, SWL_BW_5MHZ},
+    [NL80211_CHAN_WIDTH_10] = {10, SWL_BW_10MHZ},
+    [NL80211_CHAN_WIDTH_2] = {2, SWL_BW_2MHZ},
+    [NL80211_CHAN_WIDTH_320] = {320, SWL_BW_320MHZ},
+};
+
 /*
  * @brief convert NL80211_CHAN_WIDTH_xxx into swl bandwidth enum ID
  *
@@ -96,9 +118,9 @@ SWL_TABLE(sChannelWidthMap,
  * @return valid SWL_BW_ or SWL_BW_MAX if not match is found
  */
 swl_bandwidth_e wld_nl80211_bwNlToSwl(uint32_t nl80211Bw) {
-    uint32_t* pSwlBw = (uint32_t*) swl_table_getMatchingValue(&sChannelWidthMap, 2, 0, &nl80211Bw);
-    ASSERT_NOT_NULL(pSwlBw, SWL_BW_MAX, ME, "unmatch nl bw %d", nl80211Bw);
-    return (swl_bandwidth_e) (*pSwlBw);
+    ASSERT_TRUE((nl80211Bw < NR_NL_CHAN_WIDTHS) && (sNlChannelWidthIdx[nl80211Bw].bw != 0), SWL_BW_MAX,
+                ME, "unmatch nl bw %d", nl80211Bw);
+    return sNlChannelWidthIdx[nl80211Bw].swlBw;
 }
 
 /*
@@ -125,9 +147,9 @@ int32_t wld_nl80211_bwSwlToNl(swl_bandwidth_e swlBw) {
  * @return valid channel bandwidth value or 0 if not match is found
  */
 uint32_t wld_nl80211_bwNlToVal(uint32_t nl80211Bw) {
-    uint32_t* pBwVal = (uint32_t*) swl_table_getMatchingValue(&sChannelWidthMap, 1, 0, &nl80211Bw);
-    ASSERT_NOT_NULL(pBwVal, 0, ME, "unmatch nl bw %d", nl80211Bw);
-    return *pBwVal;
+    ASSERT_TRUE((nl80211Bw < NR_NL_CHAN_WIDTHS) && (sNlChannelWidthIdx[nl80211Bw].bw != 0), 0,
+                ME, "unmatch nl bw %d", nl80211Bw);
+    return sNlChannelWidthIdx[nl80211Bw].bw;
 }
 
 /*
@@ -179,3 +201,52 @@ swl_freqBand_e wld_nl80211_freqBandNlToSwl(uint32_t nl80211Fb) {
     return (swl_freqBand_e) (*pSwlFb);
 }
 
+/*
+ * Station rate bandwidth, indexed by the mask of WLD_NL80211_RATE_BW_F_xxx rate info flags:
+ * the widest flagged bandwidth applies, 20MHz when no flag is set.
+ */
+#define X2(bw) bw, bw
+#define X4(bw) X2(bw), X2(bw)
+#define X8(bw) X4(bw), X4(bw)
+#define X16(bw) X8(bw), X8(bw)
+static const swl_bandwidth_e sRateBwIdx[WLD_NL80211_RATE_BW_F_ALL + 1] = {
+    SWL_BW_20MHZ, SWL_BW_5MHZ, X2(SWL_BW_10MHZ), X4(SWL_BW_40MHZ), X8(SWL_BW_80MHZ), X16(SWL_BW_160MHZ),
+};
+#undef X16
+#undef X8
+#undef X4
+#undef X2
+
+/*
+ * @brief convert mask of rate info bandwidth flags into swl bandwidth enum ID
+ *
+ * @param bwFlags mask of WLD_NL80211_RATE_BW_F_xxx
+ *
+ * @return swl bandwidth of the rate
+ */
+swl_bandwidth_e wld_nl80211_rateBwFlagsToSwl(uint32_t bwFlags) {
+    return sRateBwIdx[bwFlags & WLD_NL80211_RATE_BW_F_ALL];
+}
+
+/*
+ * Guard interval indexed by NL80211_RATE_INFO_HE_GI_xxx, or NL80211_RATE_INFO_EHT_GI_xxx which use the same values.
+ */
+static const swl_guardinterval_e sRateHeGiIdx[] = {
+    [NL80211_RATE_INFO_HE_GI_0_8] = SWL_SGI_800,
+    [NL80211_RATE_INFO_HE_GI_1_6] = SWL_SGI_1600,
+    [NL80211_RATE_INFO_HE_GI_3_2] = SWL_SGI_3200,
+};
+
+/*
+ * @brief convert HE/EHT rate info guard interval into swl guard interval enum ID
+ *
+ * @param nlGi NL80211_RATE_INFO_HE_GI_xxx or NL80211_RATE_INFO_EHT_GI_xxx value
+ * @param defaultGi value returned when nlGi is unknown
+ *
+ * @return swl guard interval
+ */
+swl_guardinterval_e wld_nl80211_rateHeGiToSwl(uint8_t nlGi, swl_guardinterval_e defaultGi) {
+    ASSERTS_TRUE(nlGi < SWL_ARRAY_SIZE(sRateHeGiIdx), defaultGi, ME, "unknown gi %u", nlGi);
+    return sRateHeGiIdx[nlGi];
+}
+
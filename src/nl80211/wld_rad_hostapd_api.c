@@ -71,6 +71,8 @@
 
 #define ME "hapdRad"
 
+#define MAIN_BSSID_MAX_AGE_MS WLD_WPACTRL_MAX_AGE_UNLIMITED // main bss only changes with restart or reconfiguration
+
 static wld_wpaCtrlInterface_t* s_getFirstReadyIface(T_Radio* pRad) {
     ASSERT_NOT_NULL(pRad, NULL, ME, "NULL");
     wld_wpaCtrlMngr_t* pMgr = wld_secDmn_getWpaCtrlMgr(pRad->hostapd);
@@ -320,6 +322,36 @@ swl_rc_ne wld_rad_hostapd_reconfigure(T_Radio* pR) {
     return rc;
 }
 
+/*
+ * @brief stage, in the hostapd config file, the params that are applied at runtime,
+ * so that they are kept by next config reload.
+ * Staged params are written at once by wld_hostapd_cfgFile_commitRadUpdates,
+ * and accounted in the radio config snapshot, to skip useless rewrite on next config creation.
+ *
+ * @param pR radio context
+ * @param bssName bss section of the params, or NULL for the general (radio) configuration
+ * @param pParams map of generated params values
+ * @param keys list of params to stage
+ * @param nKeys number of params to stage
+ */
+static void s_stageCfgParams(T_Radio* pR, const char* bssName, swl_mapChar_t* pParams, const char* const* keys, uint32_t nKeys) {
+    ASSERTS_NOT_NULL(pR->hostapd, , ME, "NULL");
+    ASSERTS_STR(pR->hostapd->cfgFile, , ME, "%s: no hostapd config file", pR->Name);
+    for(uint32_t i = 0; i < nKeys; i++) {
+        const char* value = swl_mapChar_get(pParams, (char*) keys[i]);
+        if(value == NULL) {
+            continue;
+        }
+        wld_hostapd_cfgFile_stageRadUpdate(pR, bssName, keys[i], value);
+    }
+}
+
+static void s_commitCfgParams(T_Radio* pR) {
+    ASSERTS_NOT_NULL(pR->hostapd, , ME, "NULL");
+    ASSERTS_STR(pR->hostapd->cfgFile, , ME, "%s: no hostapd config file", pR->Name);
+    wld_hostapd_cfgFile_commitRadUpdates(pR);
+}
+
 /**
  * @brief set main interface channel parameters
  *
@@ -342,6 +374,8 @@ wld_secDmn_action_rc_ne wld_rad_hostapd_setChannel(T_Radio* pR) {
     for(uint32_t i = 0; i < SWL_ARRAY_SIZE(chanParams); i++) {
         wld_ap_hostapd_setParamValue(primaryVap, chanParams[i], swl_mapChar_get(&radParams, (char*) chanParams[i]), "");
     }
+    s_stageCfgParams(pR, NULL, &radParams, chanParams, SWL_ARRAY_SIZE(chanParams));
+    s_commitCfgParams(pR);
     swl_mapChar_cleanup(&radParams);
     return SECDMN_ACTION_OK_NEED_TOGGLE;
 }
@@ -365,6 +399,7 @@ wld_secDmn_action_rc_ne wld_rad_hostapd_setMiscParams(T_Radio* pRad) {
     for(uint32_t i = 0; i < SWL_ARRAY_SIZE(miscRadParams); i++) {
         wld_ap_hostapd_setParamValue(primaryVap, miscRadParams[i], swl_mapChar_get(&radParams, (char*) miscRadParams[i]), "");
     }
+    s_stageCfgParams(pRad, NULL, &radParams, miscRadParams, SWL_ARRAY_SIZE(miscRadParams));
     swl_mapChar_cleanup(&radParams);
 
     swl_mapChar_t vapParams;
@@ -379,6 +414,9 @@ wld_secDmn_action_rc_ne wld_rad_hostapd_setMiscParams(T_Radio* pRad) {
             wld_ap_hostapd_setParamValue(pAP, miscVapParams[i], swl_mapChar_get(&vapParams, (char*) miscVapParams[i]), "");
         }
     }
+    // values are generated for the primary vap: only save them in its own section
+    s_stageCfgParams(pRad, wld_hostapd_ap_selectApLinkIface(primaryVap), &vapParams, miscVapParams, SWL_ARRAY_SIZE(miscVapParams));
+    s_commitCfgParams(pRad);
     swl_mapChar_cleanup(&vapParams);
     return SECDMN_ACTION_OK_NEED_TOGGLE;
 }
@@ -449,9 +487,9 @@ swl_rc_ne wld_rad_hostapd_disable(T_Radio* pR) {
     return SWL_RC_OK;
 }
 
-swl_trl_e wld_rad_hostapd_getCfgParamSupp(T_Radio* pRad, const char* param) {
+swl_trl_e wld_rad_hostapd_getCfgParamSupp(T_Radio* pRad, wld_secDmn_cfgParamId_t paramId) {
     ASSERT_NOT_NULL(pRad, SWL_TRL_UNKNOWN, ME, "NULL");
-    return wld_secDmn_getCfgParamSupp(pRad->hostapd, param);
+    return wld_secDmn_getCfgParamSuppById(pRad->hostapd, paramId);
 }
 
 T_AccessPoint* wld_rad_hostapd_getFirstConnectedVap(T_Radio* pRad) {
@@ -497,7 +535,7 @@ T_AccessPoint* wld_rad_hostapd_getRunMainVap(T_Radio* pRad) {
      * as main iface name is the MLD primary link iface
      */
     buf[0] = 0;
-    rc = wld_rad_hostapd_getCmdReplyParamStr(pRad, "STATUS", "bssid[0]", buf, sizeof(buf));
+    rc = wld_rad_hostapd_getCachedCmdReplyParamStr(pRad, "STATUS", "bssid[0]", MAIN_BSSID_MAX_AGE_MS, buf, sizeof(buf));
     ASSERTI_TRUE(swl_rc_isOk(rc), NULL, ME, "%s: fail to get main hapd iface bssid", pRad->Name);
     swl_macBin_t bssid = SWL_MAC_BIN_NEW();
     ASSERTI_TRUE(swl_typeMacBin_fromChar(&bssid, buf), NULL, ME, "%s: invalid main bssid (%s)", pRad->Name, buf);
@@ -519,11 +557,15 @@ bool wld_rad_hostapd_hasActiveApMld(T_Radio* pRad, uint32_t minNLinks) {
     return false;
 }
 
-swl_rc_ne wld_rad_hostapd_getCmdReplyParamStr(T_Radio* pRad, const char* cmd, const char* key, char* valStr, size_t valStrSize) {
+swl_rc_ne wld_rad_hostapd_getCachedCmdReplyParamStr(T_Radio* pRad, const char* cmd, const char* key, uint32_t maxAgeMs, char* valStr, size_t valStrSize) {
     ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
     wld_wpaCtrlMngr_t* pMgr = wld_secDmn_getWpaCtrlMgr(pRad->hostapd);
     wld_wpaCtrlInterface_t* pIface = wld_wpaCtrlMngr_getFirstReadyInterface(pMgr);
-    return wld_wpaCtrl_getSyncCmdParamVal(pIface, cmd, key, valStr, valStrSize);
+    return wld_wpaCtrl_getCachedCmdParamVal(pIface, cmd, key, maxAgeMs, valStr, valStrSize);
+}
+
+swl_rc_ne wld_rad_hostapd_getCmdReplyParamStr(T_Radio* pRad, const char* cmd, const char* key, char* valStr, size_t valStrSize) {
+    return wld_rad_hostapd_getCachedCmdReplyParamStr(pRad, cmd, key, 0, valStr, valStrSize);
 }
 
 int32_t wld_rad_hostapd_getCmdReplyParam32Def(T_Radio* pRad, const char* cmd, const char* key, int32_t defVal) {
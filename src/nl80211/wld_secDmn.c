@@ -65,6 +65,9 @@
 #include "swl/swl_string.h"
 #include "wld_secDmn.h"
 #include "wld_secDmnGrp_priv.h"
+#include "wld_secDmn_priv.h"
+#include "wld_wpaCtrl_api.h"
+#include "Utils/wld_cfgDoc.h"
 
 #define ME "secDmn"
 
@@ -78,6 +81,7 @@ static void s_restartProcCb(wld_process_t* pProc _UNUSED, void* userdata) {
     wld_secDmn_t* pSecDmn = (wld_secDmn_t*) userdata;
     ASSERT_NOT_NULL(pSecDmn, , ME, "NULL");
     wld_secDmn_setRestartNeeded(pSecDmn, false);
+    wld_wpaCtrl_flushConnPool(pSecDmn->ctrlIfaceDir);
     if(pSecDmn->handlers.restartCb != NULL) {
         pSecDmn->handlers.restartCb(pSecDmn, pSecDmn->userData);
         return;
@@ -89,6 +93,7 @@ static void s_onStopProcCb(wld_process_t* pProc _UNUSED, void* userdata) {
     wld_secDmn_t* pSecDmn = (wld_secDmn_t*) userdata;
     ASSERT_NOT_NULL(pSecDmn, , ME, "NULL");
     wld_wpaCtrlMngr_disconnect(pSecDmn->wpaCtrlMngr);
+    wld_wpaCtrl_flushConnPool(pSecDmn->ctrlIfaceDir);
     if(pSecDmn->handlers.stopCb) {
         pSecDmn->handlers.stopCb(pSecDmn, pSecDmn->userData);
         return;
@@ -100,6 +105,7 @@ static void s_onStopProcCb(wld_process_t* pProc _UNUSED, void* userdata) {
 static void s_onStartProcCb(wld_process_t* pProc _UNUSED, void* userdata) {
     wld_secDmn_t* pSecDmn = (wld_secDmn_t*) userdata;
     ASSERT_NOT_NULL(pSecDmn, , ME, "NULL");
+    wld_wpaCtrl_flushConnPool(pSecDmn->ctrlIfaceDir);
     wld_wpaCtrlMngr_connect(pSecDmn->wpaCtrlMngr);
     if(pSecDmn->handlers.startCb) {
         pSecDmn->handlers.startCb(pSecDmn, pSecDmn->userData);
@@ -132,6 +138,54 @@ static wld_deamonEvtHandlers fProcCbs = {
     .stop = s_stopProcCb,
 };
 
+/*
+ * interned config param names: id is the position in the names table
+ * table is released when the last secDmn is cleaned up
+ */
+static swl_mapCharInt32_t sCfgParamIds;
+static char* sCfgParamNames[WLD_SECDMN_CFG_PARAM_ID_MAX];
+static uint32_t sNCfgParamIds = 0;
+static uint32_t sNSecDmns = 0;
+
+/* names of known params, in wld_secDmn_cfgParamKnown_e order */
+static const char* sKnownCfgParamNames[WLD_SECDMN_CFG_PARAM_KNOWN_MAX] = {
+    "rnr",
+    "config_id",
+};
+
+static wld_secDmn_cfgParamId_t s_findCfgParamId(const char* param) {
+    ASSERTS_TRUE(sNCfgParamIds > 0, WLD_SECDMN_CFG_PARAM_ID_INVALID, ME, "no interned param");
+    int32_t* pId = swl_map_get(&sCfgParamIds, (char*) param);
+    ASSERTS_NOT_NULL(pId, WLD_SECDMN_CFG_PARAM_ID_INVALID, ME, "param %s not interned", param);
+    return *pId;
+}
+
+static void s_internCfgParam(const char* param) {
+    swl_mapCharInt32_addOrSet(&sCfgParamIds, (char*) param, sNCfgParamIds);
+    swl_str_copyMalloc(&sCfgParamNames[sNCfgParamIds], param);
+    sNCfgParamIds++;
+}
+
+/*
+ * known params are interned first, so that their id matches wld_secDmn_cfgParamKnown_e
+ */
+static void s_initCfgParamIds() {
+    ASSERTS_EQUALS(sNCfgParamIds, 0, , ME, "already initialized");
+    swl_mapCharInt32_init(&sCfgParamIds);
+    for(uint32_t i = 0; i < WLD_SECDMN_CFG_PARAM_KNOWN_MAX; i++) {
+        s_internCfgParam(sKnownCfgParamNames[i]);
+    }
+}
+
+static void s_clearCfgParamIds() {
+    ASSERTS_TRUE(sNCfgParamIds > 0, , ME, "no interned param");
+    for(uint32_t i = 0; i < sNCfgParamIds; i++) {
+        W_SWL_FREE(sCfgParamNames[i]);
+    }
+    swl_mapCharInt32_cleanup(&sCfgParamIds);
+    sNCfgParamIds = 0;
+}
+
 swl_rc_ne wld_secDmn_init(wld_secDmn_t** ppSecDmn, char* cmd, char* startArgs, char* cfgFile, char* ctrlIfaceDir) {
     ASSERT_STR(cmd, SWL_RC_INVALID_PARAM, ME, "invalid cmd");
     ASSERT_NOT_NULL(ppSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
@@ -153,6 +207,10 @@ swl_rc_ne wld_secDmn_init(wld_secDmn_t** ppSecDmn, char* cmd, char* startArgs, c
     swl_str_copyMalloc(&pSecDmn->ctrlIfaceDir, ctrlIfaceDir);
     swl_mapCharInt32_init(&pSecDmn->cfgParamSup);
     swl_mapCharInt32_init(&pSecDmn->cmdSup);
+    swl_mapCharInt32_init(&pSecDmn->cfgParamProbed);
+    swl_mapChar_init(&pSecDmn->cfgParamRejected);
+    s_initCfgParamIds();
+    sNSecDmns++;
     return SWL_RC_OK;
 }
 
@@ -171,6 +229,7 @@ swl_rc_ne wld_secDmn_cleanup(wld_secDmn_t** ppSecDmn) {
     ASSERTS_NOT_NULL(ppSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
     wld_secDmn_t* pSecDmn = *ppSecDmn;
     ASSERTS_NOT_NULL(pSecDmn, SWL_RC_OK, ME, "cleaned up");
+    wld_secDmn_dropCfgParamProbe(pSecDmn);
     wld_wpaCtrlMngr_cleanup(&pSecDmn->wpaCtrlMngr);
     wld_dmn_destroyDeamon(&pSecDmn->selfDmnProcess);
     if(wld_secDmn_isGrpMember(pSecDmn)) {
@@ -179,6 +238,12 @@ swl_rc_ne wld_secDmn_cleanup(wld_secDmn_t** ppSecDmn) {
     pSecDmn->dmnProcess = NULL;
     swl_mapCharInt32_cleanup(&pSecDmn->cfgParamSup);
     swl_mapCharInt32_cleanup(&pSecDmn->cmdSup);
+    swl_mapCharInt32_cleanup(&pSecDmn->cfgParamProbed);
+    swl_mapChar_cleanup(&pSecDmn->cfgParamRejected);
+    wld_cfgDoc_drop(pSecDmn->cfgFile);
+    if((sNSecDmns > 0) && (--sNSecDmns == 0)) {
+        s_clearCfgParamIds();
+    }
     W_SWL_FREE(pSecDmn->cfgFile);
     W_SWL_FREE(pSecDmn->ctrlIfaceDir);
     free(pSecDmn);
@@ -239,6 +304,9 @@ swl_rc_ne wld_secDmn_reload(wld_secDmn_t* pSecDmn) {
     ASSERT_NOT_NULL(pSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERT_NOT_NULL(pSecDmn->dmnProcess, SWL_RC_ERROR, ME, "NULL");
     ASSERT_TRUE(wld_dmn_isRunning(pSecDmn->dmnProcess), SWL_RC_ERROR, ME, "not running");
+    if(wld_secDmn_isGrpMember(pSecDmn)) {
+        return wld_secDmnGrp_reloadMember(pSecDmn->secDmnGroup, pSecDmn);
+    }
     wld_dmn_reloadDeamon(pSecDmn->dmnProcess);
     return SWL_RC_OK;
 }
@@ -305,6 +373,28 @@ bool wld_secDmn_isAlive(wld_secDmn_t* pSecDmn) {
              (wld_secDmnGrp_isMemberStarted(pSecDmn->secDmnGroup, pSecDmn))));
 }
 
+/*
+ * @brief check whether the daemon process keeps failing to start (supervisor mode)
+ */
+bool wld_secDmn_isCrashLooping(wld_secDmn_t* pSecDmn) {
+    ASSERTS_NOT_NULL(pSecDmn, false, ME, "NULL");
+    return wld_dmn_isCrashLooping(pSecDmn->dmnProcess);
+}
+
+/*
+ * @brief confirm to the daemon supervisor that the process is usable,
+ * once one connected ctrl iface answers PING
+ */
+swl_rc_ne wld_secDmn_checkReady(wld_secDmn_t* pSecDmn) {
+    ASSERTS_NOT_NULL(pSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTS_FALSE(wld_dmn_isReady(pSecDmn->dmnProcess), SWL_RC_DONE, ME, "already ready");
+    wld_wpaCtrlInterface_t* pIface = wld_wpaCtrlMngr_getFirstReadyInterface(pSecDmn->wpaCtrlMngr);
+    ASSERTI_NOT_NULL(pIface, SWL_RC_CONTINUE, ME, "no connected ctrl iface");
+    ASSERT_TRUE(wld_wpaCtrlInterface_ping(pIface), SWL_RC_ERROR, ME, "%s: no answer to PING", wld_wpaCtrlInterface_getName(pIface));
+    wld_dmn_setReady(pSecDmn->dmnProcess);
+    return SWL_RC_OK;
+}
+
 bool wld_secDmn_hasAvailableCtrlIface(wld_secDmn_t* pSecDmn) {
     ASSERTS_NOT_NULL(pSecDmn, false, ME, "NULL");
     return (wld_wpaCtrlMngr_getFirstAvailableInterface(pSecDmn->wpaCtrlMngr) != NULL);
@@ -315,11 +405,88 @@ wld_wpaCtrlMngr_t* wld_secDmn_getWpaCtrlMgr(wld_secDmn_t* pSecDmn) {
     return pSecDmn->wpaCtrlMngr;
 }
 
+/*
+ * @brief get the interned id of a config param, registering the param when new
+ *
+ * @param param parameter name
+ *
+ * @return param id, or WLD_SECDMN_CFG_PARAM_ID_INVALID when the table is full
+ */
+wld_secDmn_cfgParamId_t wld_secDmn_getCfgParamId(const char* param) {
+    ASSERT_STR(param, WLD_SECDMN_CFG_PARAM_ID_INVALID, ME, "empty param");
+    wld_secDmn_cfgParamId_t paramId = s_findCfgParamId(param);
+    ASSERTS_EQUALS(paramId, WLD_SECDMN_CFG_PARAM_ID_INVALID, paramId, ME, "param %s already interned", param);
+    ASSERT_TRUE(sNCfgParamIds < WLD_SECDMN_CFG_PARAM_ID_MAX, WLD_SECDMN_CFG_PARAM_ID_INVALID,
+                ME, "no room to intern param %s", param);
+    s_initCfgParamIds();
+    paramId = s_findCfgParamId(param);
+    ASSERTS_EQUALS(paramId, WLD_SECDMN_CFG_PARAM_ID_INVALID, paramId, ME, "param %s is known", param);
+    paramId = sNCfgParamIds;
+    s_internCfgParam(param);
+    return paramId;
+}
+
+const char* wld_secDmn_getCfgParamName(wld_secDmn_cfgParamId_t paramId) {
+    ASSERTS_TRUE((paramId >= 0) && ((uint32_t) paramId < sNCfgParamIds), NULL, ME, "invalid param id %d", paramId);
+    return sCfgParamNames[paramId];
+}
+
 bool wld_secDmn_setCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param, swl_trl_e supp) {
     ASSERTS_NOT_NULL(pSecDmn, false, ME, "NULL");
+    wld_secDmn_cfgParamId_t paramId = wld_secDmn_getCfgParamId(param);
+    if(paramId != WLD_SECDMN_CFG_PARAM_ID_INVALID) {
+        uint64_t mask = (1ULL << paramId);
+        wld_secDmn_cfgParamSuppMap_t* pMap = &pSecDmn->cfgParamSuppMap;
+        pMap->supp = (supp == SWL_TRL_TRUE) ? (pMap->supp | mask) : (pMap->supp & ~mask);
+        pMap->unsupp = (supp == SWL_TRL_FALSE) ? (pMap->unsupp | mask) : (pMap->unsupp & ~mask);
+        wld_secDmnGrp_updateCfgParamSupp(pSecDmn->secDmnGroup);
+    }
     return swl_mapCharInt32_addOrSet(&pSecDmn->cfgParamSup, (char*) param, supp);
 }
 
+/*
+ * @brief set config param support, using its interned id
+ *
+ * @param pSecDmn pointer to security daemon context
+ * @param paramId parameter id, as returned by wld_secDmn_getCfgParamId, or known param id
+ * @param supp param support
+ *
+ * @return true when saved, false otherwise
+ */
+bool wld_secDmn_setCfgParamSuppById(wld_secDmn_t* pSecDmn, wld_secDmn_cfgParamId_t paramId, swl_trl_e supp) {
+    const char* param = wld_secDmn_getCfgParamName(paramId);
+    ASSERTS_NOT_NULL(param, false, ME, "invalid param id %d", paramId);
+    return wld_secDmn_setCfgParamSupp(pSecDmn, param, supp);
+}
+
+/*
+ * @brief checks wether a config param is supported or not, using its interned id
+ * For grouped daemons, the support aggregated over all group members is returned.
+ *
+ * @param pSecDmn pointer to security daemon context
+ * @param paramId parameter id, as returned by wld_secDmn_getCfgParamId
+ *
+ * @return SWL_TRL_TRUE when the param is supported
+ *         SWL_TRL_FALSE when the param is not supported
+ *         SWL_TRL_UNKNOWN when the param support is not yet learned
+ */
+swl_trl_e wld_secDmn_getCfgParamSuppById(wld_secDmn_t* pSecDmn, wld_secDmn_cfgParamId_t paramId) {
+    ASSERTS_NOT_NULL(pSecDmn, SWL_TRL_UNKNOWN, ME, "NULL");
+    ASSERTS_TRUE((paramId >= 0) && ((uint32_t) paramId < sNCfgParamIds), SWL_TRL_UNKNOWN, ME, "invalid param id %d", paramId);
+    const wld_secDmn_cfgParamSuppMap_t* pMap = &pSecDmn->cfgParamSuppMap;
+    if(wld_secDmnGrp_getMembersCount(pSecDmn->secDmnGroup) > 1) {
+        pMap = wld_secDmnGrp_getCfgParamSuppMap(pSecDmn->secDmnGroup);
+    }
+    uint64_t mask = (1ULL << paramId);
+    if(pMap->unsupp & mask) {
+        return SWL_TRL_FALSE;
+    }
+    if(pMap->supp & mask) {
+        return SWL_TRL_TRUE;
+    }
+    return SWL_TRL_UNKNOWN;
+}
+
 /*
  * @brief checks wether a config param is supported or not (with dynamic detection)
  *
@@ -330,8 +497,7 @@ bool wld_secDmn_setCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param, swl_tr
  *         SWL_TRL_FALSE when the param is not supported
  *         SWL_TRL_UNKNOWN when the param support is not yet learned
  */
-swl_trl_e wld_secDmn_getCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param) {
-    ASSERTS_NOT_NULL(pSecDmn, SWL_TRL_UNKNOWN, ME, "NULL");
+static swl_trl_e s_getCfgParamSuppByName(wld_secDmn_t* pSecDmn, const char* param) {
     int32_t* pVal = swl_map_get(&pSecDmn->cfgParamSup, (char*) param);
     ASSERTS_NOT_NULL(pVal, SWL_TRL_UNKNOWN, ME, "not found");
     uint32_t nMbr = wld_secDmnGrp_getMembersCount(pSecDmn->secDmnGroup);
@@ -354,6 +520,16 @@ swl_trl_e wld_secDmn_getCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param) {
     return supp;
 }
 
+swl_trl_e wld_secDmn_getCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param) {
+    ASSERTS_NOT_NULL(pSecDmn, SWL_TRL_UNKNOWN, ME, "NULL");
+    wld_secDmn_cfgParamId_t paramId = s_findCfgParamId(param);
+    if(paramId == WLD_SECDMN_CFG_PARAM_ID_INVALID) {
+        /* param not interned (ids table full): use the name map */
+        return s_getCfgParamSuppByName(pSecDmn, param);
+    }
+    return wld_secDmn_getCfgParamSuppById(pSecDmn, paramId);
+}
+
 uint32_t wld_secDmn_countCfgParamSuppAll(wld_secDmn_t* pSecDmn) {
     ASSERTS_NOT_NULL(pSecDmn, 0, ME, "NULL");
     return swl_map_size(&pSecDmn->cfgParamSup);
@@ -66,11 +66,13 @@
 #include <amxc/amxc.h>
 #include <amxp/amxp.h>
 #include "swl/swl_maps.h"
+#include "swla/swla_time_spec.h"
 #include "wld_secDmnGrp_priv.h"
 
 #define ME "secDmnG"
 
 #define ACTION_DELAY_MS 500
+#define RTM_ACTION_WINDOW_MS 1000
 
 typedef enum {
     WLD_SECDMN_STATE_IDLE,                          /* member is idle: not started or fully terminated (after process end) */
@@ -84,19 +86,27 @@ struct wld_secDmnGrp {
     bool isRunning;                                 /* group running state */
     wld_process_t* dmnProcess;                      /* daemon context. */
     amxp_timer_t* actionTimer;                      /* delayed action timer: to give time to cumulate start/stop requests */
+    amxp_timer_t* rtmActionTimer;                   /* runtime action timer: to give time to merge members reload/restart requests */
     void* userData;                                 /* private user data */
     wld_secDmnGrp_EvtHandlers_t handlers;           /* group event handlers: to allow customizing group process (cmdline, args,...) */
     amxc_llist_t members;                           /* list of secDmn group members, running into same daemon process */
+    wld_secDmn_cfgParamSuppMap_t cfgParamSuppMap;   /* config params support aggregated over all members */
+    uint32_t nRtmActionExec;                        /* number of runtime actions executed on group process */
+    bool warmStandby;                               /* keep process running without members, attaching/detaching them at runtime */
 };
 
 /*
  * enum for secDmn group actions to execute at runtime
+ * sorted by increasing impact: a higher action subsumes all lower ones
+ * (ie. a restart reloads the configuration of all members)
  */
 typedef enum {
+    WLD_SECDMN_RTM_ACTION_RELOAD,
     WLD_SECDMN_RTM_ACTION_RESTART,
     WLD_SECDMN_RTM_ACTION_MAX,
 } wld_secDmn_runTimeAction_e;
 
+#define M_WLD_SECDMN_RTM_ACTION_RELOAD SWL_BIT_SHIFT(WLD_SECDMN_RTM_ACTION_RELOAD)
 #define M_WLD_SECDMN_RTM_ACTION_RESTART SWL_BIT_SHIFT(WLD_SECDMN_RTM_ACTION_RESTART)
 
 typedef swl_mask64_m wld_secDmn_runTimeAction_m;
@@ -107,9 +117,12 @@ typedef struct {
     wld_secDmn_t* pSecDmn;                          /* member secDmn context */
     wld_secDmn_state_e state;                       /* member state */
     bool isStartable;                               /* flag to indicate if daemon is started or ready to be */
+    bool isAttached;                                /* flag to indicate if member is loaded by the running group process */
     wld_deamonEvtHandlers dmnEvtHdlrs;              /* member evt handlers: to forward proc event from group to members */
     void* dmnEvtUserData;                           /* member evt user data */
     wld_secDmn_runTimeAction_m reqRtmActions;       /* bitmap of requested run time actions. */
+    swl_timeSpecMono_t reqRtmTime;                  /* time of oldest pending run time action request */
+    wld_secDmnGrp_rtmActionStats_t rtmStats;        /* run time action request/apply statistics */
 } wld_secDmnGrp_member_t;
 
 static void s_restartProcCb(wld_process_t* pProc, void* userdata) {
@@ -132,6 +145,7 @@ static void s_onStopProcCb(wld_process_t* pProc _UNUSED, void* userdata) {
         if(member->state == WLD_SECDMN_STATE_STOP) {
             member->state = WLD_SECDMN_STATE_IDLE;
         }
+        member->isAttached = false;
         SWL_CALL(member->dmnEvtHdlrs.stopCb, pProc, member->dmnEvtUserData);
     }
 }
@@ -150,6 +164,11 @@ static void s_onStartProcCb(wld_process_t* pProc, void* userdata) {
 static char* s_getArgsProcCb(wld_process_t* pProc, void* userdata) {
     wld_secDmnGrp_t* pSecDmnGrp = (wld_secDmnGrp_t*) userdata;
     ASSERT_NOT_NULL(pSecDmnGrp, NULL, ME, "NULL");
+    amxc_llist_for_each(it, &pSecDmnGrp->members) {
+        wld_secDmnGrp_member_t* member = amxc_container_of(it, wld_secDmnGrp_member_t, it);
+        /* started members are loaded with the process start args */
+        member->isAttached = (member->state == WLD_SECDMN_STATE_START);
+    }
     if(pSecDmnGrp->handlers.getArgsCb != NULL) {
         return pSecDmnGrp->handlers.getArgsCb(pSecDmnGrp, pSecDmnGrp->userData, pProc);
     }
@@ -179,6 +198,7 @@ static wld_deamonEvtHandlers fProcCbs = {
 };
 
 static void s_processGrpAction(amxp_timer_t* timer, void* userdata);
+static void s_processGrpRtmAction(amxp_timer_t* timer, void* userdata);
 
 swl_rc_ne wld_secDmnGrp_init(wld_secDmnGrp_t** ppSecDmnGrp, char* cmd, char* startArgs, const char* groupName) {
     ASSERT_STR(cmd, SWL_RC_INVALID_PARAM, ME, "invalid cmd");
@@ -189,6 +209,7 @@ swl_rc_ne wld_secDmnGrp_init(wld_secDmnGrp_t** ppSecDmnGrp, char* cmd, char* sta
         ASSERT_NOT_NULL(pSecDmnGrp, SWL_RC_ERROR, ME, "NULL");
         amxc_llist_init(&pSecDmnGrp->members);
         amxp_timer_new(&pSecDmnGrp->actionTimer, s_processGrpAction, pSecDmnGrp);
+        amxp_timer_new(&pSecDmnGrp->rtmActionTimer, s_processGrpRtmAction, pSecDmnGrp);
         *ppSecDmnGrp = pSecDmnGrp;
         if(!swl_str_isEmpty(groupName)) {
             swl_str_copyMalloc(&pSecDmnGrp->name, groupName);
@@ -259,6 +280,7 @@ swl_rc_ne wld_secDmnGrp_addMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSe
     }
     swl_str_copyMalloc(&member->name, name);
     amxc_llist_append(&pSecDmnGrp->members, &member->it);
+    wld_secDmnGrp_updateCfgParamSupp(pSecDmnGrp);
     SAH_TRACEZ_INFO(ME, "added member (%s/%p) to group (%s/%p)", member->name, pSecDmn, pSecDmnGrp->name, pSecDmnGrp);
     return SWL_RC_OK;
 }
@@ -296,27 +318,62 @@ static uint32_t s_countGrpMembersStartable(wld_secDmnGrp_t* pSecDmnGrp) {
     return count;
 }
 
-static bool s_hasGrpOngoingAction(wld_secDmnGrp_t* pSecDmnGrp) {
-    amxp_timer_state_t timerSt = amxp_timer_get_state(pSecDmnGrp->actionTimer);
+static bool s_isTimerPending(amxp_timer_t* timer) {
+    amxp_timer_state_t timerSt = amxp_timer_get_state(timer);
     return ((timerSt == amxp_timer_running) || (timerSt == amxp_timer_started));
 }
 
+static bool s_hasGrpOngoingAction(wld_secDmnGrp_t* pSecDmnGrp) {
+    return s_isTimerPending(pSecDmnGrp->actionTimer);
+}
+
+static bool s_hasGrpOngoingRtmAction(wld_secDmnGrp_t* pSecDmnGrp) {
+    return s_isTimerPending(pSecDmnGrp->rtmActionTimer);
+}
+
 static swl_rc_ne s_stopGrp(wld_secDmnGrp_t* pSecDmnGrp, bool force) {
     ASSERTS_NOT_NULL(pSecDmnGrp, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERTS_TRUE(wld_dmn_isRunning(pSecDmnGrp->dmnProcess), SWL_RC_OK, ME, "secDmn already stopped");
     uint32_t nbMStarted = s_countGrpMembersInState(pSecDmnGrp, WLD_SECDMN_STATE_START);
     ASSERTI_TRUE(force || (nbMStarted == 0), SWL_RC_CONTINUE,
                  ME, "secDmn group %s still has %d started member", pSecDmnGrp->name, nbMStarted);
-    if(s_hasGrpOngoingAction(pSecDmnGrp)) {
+    if(s_hasGrpOngoingAction(pSecDmnGrp) || s_hasGrpOngoingRtmAction(pSecDmnGrp)) {
         SAH_TRACEZ_INFO(ME, "%s: delayed actions are pending: cancelled", pSecDmnGrp->name);
     }
     amxp_timer_stop(pSecDmnGrp->actionTimer);
+    amxp_timer_stop(pSecDmnGrp->rtmActionTimer);
     SAH_TRACEZ_INFO(ME, "stop group %s (nbMS:%d,force:%d)", pSecDmnGrp->name, nbMStarted, force);
     s_onStopProcCb(pSecDmnGrp->dmnProcess, pSecDmnGrp);
     ASSERT_TRUE(wld_dmn_stopDeamon(pSecDmnGrp->dmnProcess), SWL_RC_ERROR, ME, "fail to stop secDmn group proc");
     return SWL_RC_OK;
 }
 
+/*
+ * @brief load member into the running group process (warm standby mode)
+ */
+static swl_rc_ne s_attachGrpMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_member_t* member) {
+    ASSERTS_FALSE(member->isAttached, SWL_RC_DONE, ME, "member %s already attached", member->name);
+    ASSERT_NOT_NULL(pSecDmnGrp->handlers.addMemberCb, SWL_RC_NOT_IMPLEMENTED, ME, "group %s has no handler to attach members", pSecDmnGrp->name);
+    swl_rc_ne rc = pSecDmnGrp->handlers.addMemberCb(pSecDmnGrp, pSecDmnGrp->userData, member->pSecDmn);
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "fail to attach member %s to group %s (rc:%d)", member->name, pSecDmnGrp->name, rc);
+    SAH_TRACEZ_INFO(ME, "member %s attached to running group %s", member->name, pSecDmnGrp->name);
+    member->isAttached = true;
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief unload member from the running group process (warm standby mode)
+ */
+static swl_rc_ne s_detachGrpMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_member_t* member) {
+    ASSERTS_TRUE(member->isAttached, SWL_RC_DONE, ME, "member %s not attached", member->name);
+    ASSERT_NOT_NULL(pSecDmnGrp->handlers.removeMemberCb, SWL_RC_NOT_IMPLEMENTED, ME, "group %s has no handler to detach members", pSecDmnGrp->name);
+    swl_rc_ne rc = pSecDmnGrp->handlers.removeMemberCb(pSecDmnGrp, pSecDmnGrp->userData, member->pSecDmn);
+    ASSERT_FALSE(rc < SWL_RC_OK, rc, ME, "fail to detach member %s from group %s (rc:%d)", member->name, pSecDmnGrp->name, rc);
+    SAH_TRACEZ_INFO(ME, "member %s detached from running group %s", member->name, pSecDmnGrp->name);
+    member->isAttached = false;
+    return SWL_RC_OK;
+}
+
 static swl_rc_ne s_stopGrpMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_member_t* member) {
     ASSERTS_NOT_NULL(member, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERTS_NOT_NULL(pSecDmnGrp, SWL_RC_INVALID_PARAM, ME, "NULL");
@@ -337,6 +394,16 @@ static swl_rc_ne s_stopGrpMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_memb
     }
     member->state = WLD_SECDMN_STATE_STOP;
     member->reqRtmActions = 0;
+    if(pSecDmnGrp->warmStandby) {
+        if(s_detachGrpMember(pSecDmnGrp, member) < SWL_RC_OK) {
+            SAH_TRACEZ_WARNING(ME, "fail to detach member %s: restart group %s to unload it", member->name, pSecDmnGrp->name);
+            wld_dmn_restartDeamon(pSecDmnGrp->dmnProcess);
+            return SWL_RC_CONTINUE;
+        }
+        member->state = WLD_SECDMN_STATE_IDLE;
+        SWL_CALL(member->dmnEvtHdlrs.stopCb, pSecDmnGrp->dmnProcess, member->dmnEvtUserData);
+        return SWL_RC_CONTINUE;
+    }
     return s_stopGrp(pSecDmnGrp, false);
 }
 
@@ -369,9 +436,33 @@ swl_rc_ne wld_secDmnGrp_delMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSe
     amxc_llist_it_take(&member->it);
     W_SWL_FREE(member->name);
     free(member);
+    wld_secDmnGrp_updateCfgParamSupp(pSecDmnGrp);
     return SWL_RC_OK;
 }
 
+/*
+ * @brief internal api to recompute the group config params support,
+ * when members are added/removed, or when a member support changes:
+ * a param is not supported when any member does not support it,
+ * and supported when at least one member supports it, and none rejects it
+ */
+void wld_secDmnGrp_updateCfgParamSupp(wld_secDmnGrp_t* pSecDmnGrp) {
+    ASSERTS_NOT_NULL(pSecDmnGrp, , ME, "NULL");
+    wld_secDmn_cfgParamSuppMap_t grpMap = {0, 0};
+    amxc_llist_for_each(it, &pSecDmnGrp->members) {
+        wld_secDmnGrp_member_t* member = amxc_container_of(it, wld_secDmnGrp_member_t, it);
+        grpMap.supp |= member->pSecDmn->cfgParamSuppMap.supp;
+        grpMap.unsupp |= member->pSecDmn->cfgParamSuppMap.unsupp;
+    }
+    grpMap.supp &= ~grpMap.unsupp;
+    pSecDmnGrp->cfgParamSuppMap = grpMap;
+}
+
+const wld_secDmn_cfgParamSuppMap_t* wld_secDmnGrp_getCfgParamSuppMap(wld_secDmnGrp_t* pSecDmnGrp) {
+    ASSERTS_NOT_NULL(pSecDmnGrp, NULL, ME, "NULL");
+    return &pSecDmnGrp->cfgParamSuppMap;
+}
+
 swl_rc_ne wld_secDmnGrp_dropMembers(wld_secDmnGrp_t* pSecDmnGrp) {
     ASSERTS_NOT_NULL(pSecDmnGrp, SWL_RC_INVALID_PARAM, ME, "NULL");
     s_stopGrp(pSecDmnGrp, true);
@@ -388,6 +479,7 @@ swl_rc_ne wld_secDmnGrp_cleanup(wld_secDmnGrp_t** ppSecDmnGrp) {
     ASSERTS_NOT_NULL(pSecDmnGrp, SWL_RC_INVALID_PARAM, ME, "NULL");
     wld_secDmnGrp_dropMembers(pSecDmnGrp);
     amxp_timer_delete(&pSecDmnGrp->actionTimer);
+    amxp_timer_delete(&pSecDmnGrp->rtmActionTimer);
     W_SWL_FREE(pSecDmnGrp->name);
     W_SWL_FREE(*ppSecDmnGrp);
     return SWL_RC_OK;
@@ -421,7 +513,7 @@ static swl_rc_ne s_startGrp(wld_secDmnGrp_t* pSecDmnGrp) {
     uint32_t nbMStartable = s_countGrpMembersStartable(pSecDmnGrp);
     uint32_t nbMStarted = s_countGrpMembersInState(pSecDmnGrp, WLD_SECDMN_STATE_START);
     if(wld_dmn_isRunning(pSecDmnGrp->dmnProcess)) {
-        if(!nbMStartable) {
+        if((!nbMStartable) && (!pSecDmnGrp->warmStandby)) {
             SAH_TRACEZ_WARNING(ME, "group %s proc running while it must not: members (started:%d/startable:%d) => force stop",
                                pSecDmnGrp->name, nbMStarted, nbMStartable);
             s_stopGrp(pSecDmnGrp, true);
@@ -433,6 +525,13 @@ static swl_rc_ne s_startGrp(wld_secDmnGrp_t* pSecDmnGrp) {
         }
         return SWL_RC_DONE;
     }
+    if(pSecDmnGrp->warmStandby) {
+        /* no need to wait for other members: they will be attached to the running process */
+        SAH_TRACEZ_INFO(ME, "start standby group %s (started:%d/startable:%d)", pSecDmnGrp->name, nbMStarted, nbMStartable);
+        bool ret = wld_dmn_startDeamon(pSecDmnGrp->dmnProcess);
+        ASSERT_TRUE(ret, SWL_RC_ERROR, ME, "fail to start group %s process", pSecDmnGrp->name);
+        return SWL_RC_OK;
+    }
     ASSERTW_TRUE(nbMStartable > 0, SWL_RC_INVALID_STATE, ME, "group %s has no startable members", pSecDmnGrp->name);
     ASSERTI_TRUE(nbMStarted > 0, SWL_RC_ERROR, ME, "group %s has no started members", pSecDmnGrp->name);
     if(nbMStarted >= nbMStartable) {
@@ -478,17 +577,39 @@ static uint32_t s_countGrpMembersCurRtmAction(wld_secDmnGrp_t* pSecDmnGrp, wld_s
     return count;
 }
 
+/*
+ * @brief count members having requested the action, or any higher one that subsumes it
+ */
 static uint32_t s_countGrpMembersReqRtmAction(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_runTimeAction_e action) {
     ASSERT_NOT_NULL(pSecDmnGrp, 0, ME, "NULL");
+    ASSERT_TRUE(action < WLD_SECDMN_RTM_ACTION_MAX, 0, ME, "out of bound");
     uint32_t count = 0;
     amxc_llist_for_each(it, &pSecDmnGrp->members) {
         wld_secDmnGrp_member_t* member = amxc_container_of(it, wld_secDmnGrp_member_t, it);
-        ASSERT_TRUE(action < SWL_BIT_SIZE(member->reqRtmActions), 0, ME, "out of bound");
-        count += SWL_BIT_IS_SET(member->reqRtmActions, action);
+        count += ((member->reqRtmActions >> action) != 0);
     }
     return count;
 }
 
+/*
+ * @brief get the highest runtime action requested by any group member
+ * @return action, or WLD_SECDMN_RTM_ACTION_MAX if none is requested
+ */
+static wld_secDmn_runTimeAction_e s_getGrpTopReqRtmAction(wld_secDmnGrp_t* pSecDmnGrp) {
+    ASSERT_NOT_NULL(pSecDmnGrp, WLD_SECDMN_RTM_ACTION_MAX, ME, "NULL");
+    wld_secDmn_runTimeAction_m reqActions = 0;
+    amxc_llist_for_each(it, &pSecDmnGrp->members) {
+        wld_secDmnGrp_member_t* member = amxc_container_of(it, wld_secDmnGrp_member_t, it);
+        reqActions |= member->reqRtmActions;
+    }
+    for(int32_t action = WLD_SECDMN_RTM_ACTION_MAX - 1; action >= 0; action--) {
+        if(SWL_BIT_IS_SET(reqActions, action)) {
+            return action;
+        }
+    }
+    return WLD_SECDMN_RTM_ACTION_MAX;
+}
+
 static wld_secDmnGrp_member_t* s_getFirstGrpMemberReqRtmAction(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_runTimeAction_e action) {
     ASSERT_NOT_NULL(pSecDmnGrp, NULL, ME, "NULL");
     amxc_llist_for_each(it, &pSecDmnGrp->members) {
@@ -502,12 +623,32 @@ static wld_secDmnGrp_member_t* s_getFirstGrpMemberReqRtmAction(wld_secDmnGrp_t*
     return NULL;
 }
 
+/*
+ * @brief clear the applied action and all lower ones it subsumes, from members requests
+ * and account the request-to-apply latency of each satisfied member
+ */
 static void s_clearGrpMembersReqRtmAction(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_runTimeAction_e action) {
     ASSERT_NOT_NULL(pSecDmnGrp, , ME, "NULL");
+    ASSERT_TRUE(action < WLD_SECDMN_RTM_ACTION_MAX, , ME, "out of bound");
+    wld_secDmn_runTimeAction_m appliedMask = SWL_BIT_SHIFT(action + 1) - 1;
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
     amxc_llist_for_each(it, &pSecDmnGrp->members) {
         wld_secDmnGrp_member_t* member = amxc_container_of(it, wld_secDmnGrp_member_t, it);
-        ASSERT_TRUE(action < SWL_BIT_SIZE(member->reqRtmActions), , ME, "out of bound");
-        W_SWL_BIT_CLEAR(member->reqRtmActions, action);
+        if((member->reqRtmActions & appliedMask) == 0) {
+            continue;
+        }
+        member->reqRtmActions &= ~appliedMask;
+        int64_t latencyMs = swl_timespec_diffToMillisec(&member->reqRtmTime, &now);
+        wld_secDmnGrp_rtmActionStats_t* pStats = &member->rtmStats;
+        pStats->nApplied++;
+        pStats->lastLatencyMs = (uint32_t) SWL_MAX(latencyMs, (int64_t) 0);
+        pStats->maxLatencyMs = SWL_MAX(pStats->maxLatencyMs, pStats->lastLatencyMs);
+        pStats->totalLatencyMs += pStats->lastLatencyMs;
+        SAH_TRACEZ_INFO(ME, "action %d applied to member %s after %u ms", action, member->name, pStats->lastLatencyMs);
+        if(member->reqRtmActions != 0) {
+            member->reqRtmTime = now;
+        }
     }
 }
 
@@ -517,39 +658,78 @@ static void s_execGrpRtmAction(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_runTimeAc
     ASSERTI_NOT_NULL(member, , ME, "No member of %s requesting action %d", pSecDmnGrp->name, action);
     ASSERT_NOT_NULL(member->pSecDmn, , ME, "member %s has no secDmn", member->name);
     switch(action) {
+    case WLD_SECDMN_RTM_ACTION_RELOAD: {
+        wld_dmn_reloadDeamon(member->pSecDmn->dmnProcess);
+        break;
+    }
     case WLD_SECDMN_RTM_ACTION_RESTART: {
         wld_dmn_restartDeamon(member->pSecDmn->dmnProcess);
         break;
     }
     default: break;
     }
+    pSecDmnGrp->nRtmActionExec++;
 }
 
-static swl_rc_ne s_tryGrpRtmAction(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_runTimeAction_e action) {
+/*
+ * @brief try to apply the highest pending runtime action of the group, once for all requesting members
+ *
+ * Requests are coalesced within a window starting from the first request:
+ * the action is applied as soon as all started members have requested it (or a higher one),
+ * or at window expiration, when no member has a scheduled restart still pending.
+ * Late requests do not extend the window.
+ *
+ * @param pSecDmnGrp security daemon group ctx
+ * @param windowEnd true when called on coalescing window expiration
+ *
+ * @return SWL_RC_OK when action is applied
+ *         SWL_RC_CONTINUE when action is delayed
+ *         SWL_RC_DONE when no action is requested
+ */
+static swl_rc_ne s_tryGrpRtmAction(wld_secDmnGrp_t* pSecDmnGrp, bool windowEnd) {
     ASSERT_NOT_NULL(pSecDmnGrp, SWL_RC_INVALID_PARAM, ME, "NULL");
+    wld_secDmn_runTimeAction_e action = s_getGrpTopReqRtmAction(pSecDmnGrp);
+    ASSERTS_TRUE(action < WLD_SECDMN_RTM_ACTION_MAX, SWL_RC_DONE, ME, "%s: No action requested", pSecDmnGrp->name);
     uint32_t nbMReq = s_countGrpMembersReqRtmAction(pSecDmnGrp, action);
-    ASSERTS_TRUE(nbMReq > 0, SWL_RC_DONE, ME, "%s: No action %d requested", pSecDmnGrp->name);
-    uint32_t nbMPend = s_countGrpMembersCurRtmAction(pSecDmnGrp, action);
-    if((pSecDmnGrp->isRunning) && (nbMPend == 0)) {
-        SAH_TRACEZ_INFO(ME, "%d members of group %s requested action %d, and none is pending: go ahead",
-                        nbMReq, pSecDmnGrp->name, action);
+    uint32_t nbMStarted = s_countGrpMembersInState(pSecDmnGrp, WLD_SECDMN_STATE_START);
+    uint32_t nbMPend = s_countGrpMembersCurRtmAction(pSecDmnGrp, WLD_SECDMN_RTM_ACTION_RESTART);
+    if((pSecDmnGrp->isRunning) && (nbMPend == 0) && (windowEnd || (nbMReq >= nbMStarted))) {
+        SAH_TRACEZ_INFO(ME, "%d/%d members of group %s requested action %d, and none is pending: go ahead",
+                        nbMReq, nbMStarted, pSecDmnGrp->name, action);
+        amxp_timer_stop(pSecDmnGrp->rtmActionTimer);
         s_execGrpRtmAction(pSecDmnGrp, action);
         s_clearGrpMembersReqRtmAction(pSecDmnGrp, action);
         return SWL_RC_OK;
     }
-    SAH_TRACEZ_INFO(ME, "delay rtm action %d for group %s, to wait for others to be ready (req:%d/pending:%d)",
-                    action, pSecDmnGrp->name, nbMReq, nbMPend);
-    amxp_timer_start(pSecDmnGrp->actionTimer, ACTION_DELAY_MS);
+    if(windowEnd) {
+        SAH_TRACEZ_INFO(ME, "delay rtm action %d for group %s, to wait for others to be ready (req:%d/pending:%d)",
+                        action, pSecDmnGrp->name, nbMReq, nbMPend);
+        amxp_timer_start(pSecDmnGrp->rtmActionTimer, ACTION_DELAY_MS);
+    } else if(!s_hasGrpOngoingRtmAction(pSecDmnGrp)) {
+        SAH_TRACEZ_INFO(ME, "open %d ms window to merge rtm action %d requests of group %s (req:%d/started:%d)",
+                        RTM_ACTION_WINDOW_MS, action, pSecDmnGrp->name, nbMReq, nbMStarted);
+        amxp_timer_start(pSecDmnGrp->rtmActionTimer, RTM_ACTION_WINDOW_MS);
+    }
     return SWL_RC_CONTINUE;
 }
 
+static void s_addGrpMemberRtmActionReq(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_member_t* member, wld_secDmn_runTimeAction_e action) {
+    SAH_TRACEZ_INFO(ME, "request action %d for member %s (st:%d) of group %s", action, member->name, member->state, pSecDmnGrp->name);
+    if(member->reqRtmActions == 0) {
+        swl_timespec_getMono(&member->reqRtmTime);
+    } else {
+        member->rtmStats.nMerged++;
+    }
+    W_SWL_BIT_SET(member->reqRtmActions, action);
+}
+
 static swl_rc_ne s_tryGrpMemberRtmAction(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_member_t* member, wld_secDmn_runTimeAction_e action) {
     ASSERTS_NOT_NULL(member, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERTS_NOT_NULL(pSecDmnGrp, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERTI_EQUALS(member->state, WLD_SECDMN_STATE_START, SWL_RC_INVALID_STATE, ME, "member %s not running (st:%d)", member->name, member->state);
-    SAH_TRACEZ_INFO(ME, "request action %d for member %s (st:%d) of group %s", action, member->name, member->state, pSecDmnGrp->name);
-    W_SWL_BIT_SET(member->reqRtmActions, action);
-    return s_tryGrpRtmAction(pSecDmnGrp, action);
+    ASSERT_TRUE(action < WLD_SECDMN_RTM_ACTION_MAX, SWL_RC_INVALID_PARAM, ME, "out of bound");
+    s_addGrpMemberRtmActionReq(pSecDmnGrp, member, action);
+    return s_tryGrpRtmAction(pSecDmnGrp, false);
 }
 
 swl_rc_ne wld_secDmnGrp_restartMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn) {
@@ -558,19 +738,72 @@ swl_rc_ne wld_secDmnGrp_restartMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t*
     return s_tryGrpMemberRtmAction(pSecDmnGrp, member, WLD_SECDMN_RTM_ACTION_RESTART);
 }
 
+/*
+ * @brief request a configuration reload of the group process on behalf of a member
+ * Like restarts, reload requests of started members are coalesced within the group
+ * runtime action window: the reload is applied once, as soon as all started members
+ * have requested it, or at window expiration.
+ * When a restart is also requested within the window, it is applied instead,
+ * as it loads the config of all members.
+ * Reload requested for a member not yet started is applied immediately.
+ *
+ * @return SWL_RC_OK when reload is applied
+ *         SWL_RC_CONTINUE when reload is delayed, or merged into a pending group restart
+ *         error code otherwise
+ */
+swl_rc_ne wld_secDmnGrp_reloadMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn) {
+    wld_secDmnGrp_member_t* member = s_getGrpMember(pSecDmnGrp, pSecDmn);
+    ASSERTS_NOT_NULL(member, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTI_TRUE(wld_dmn_isRunning(pSecDmnGrp->dmnProcess), SWL_RC_INVALID_STATE, ME, "group %s not running", pSecDmnGrp->name);
+    if(member->state == WLD_SECDMN_STATE_START) {
+        return s_tryGrpMemberRtmAction(pSecDmnGrp, member, WLD_SECDMN_RTM_ACTION_RELOAD);
+    }
+    s_addGrpMemberRtmActionReq(pSecDmnGrp, member, WLD_SECDMN_RTM_ACTION_RELOAD);
+    if(s_getGrpTopReqRtmAction(pSecDmnGrp) == WLD_SECDMN_RTM_ACTION_RESTART) {
+        SAH_TRACEZ_INFO(ME, "reload of member %s merged into pending restart of group %s", member->name, pSecDmnGrp->name);
+        return SWL_RC_CONTINUE;
+    }
+    if(!wld_dmn_reloadDeamon(pSecDmnGrp->dmnProcess)) {
+        SAH_TRACEZ_ERROR(ME, "fail to reload group %s for member %s", pSecDmnGrp->name, member->name);
+        W_SWL_BIT_CLEAR(member->reqRtmActions, WLD_SECDMN_RTM_ACTION_RELOAD);
+        return SWL_RC_ERROR;
+    }
+    pSecDmnGrp->nRtmActionExec++;
+    s_clearGrpMembersReqRtmAction(pSecDmnGrp, WLD_SECDMN_RTM_ACTION_RELOAD);
+    return SWL_RC_OK;
+}
+
 bool wld_secDmnGrp_isMemberRestarting(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn) {
     wld_secDmnGrp_member_t* member = s_getGrpMember(pSecDmnGrp, pSecDmn);
     ASSERTS_NOT_NULL(member, SWL_RC_INVALID_PARAM, ME, "NULL");
     return SWL_BIT_IS_SET(member->reqRtmActions, WLD_SECDMN_RTM_ACTION_RESTART);
 }
 
+swl_rc_ne wld_secDmnGrp_getMemberRtmActionStats(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn, wld_secDmnGrp_rtmActionStats_t* pStats) {
+    ASSERT_NOT_NULL(pStats, SWL_RC_INVALID_PARAM, ME, "NULL");
+    wld_secDmnGrp_member_t* member = s_getGrpMember(pSecDmnGrp, pSecDmn);
+    ASSERTS_NOT_NULL(member, SWL_RC_INVALID_PARAM, ME, "no member found");
+    *pStats = member->rtmStats;
+    return SWL_RC_OK;
+}
+
+uint32_t wld_secDmnGrp_getRtmActionExecCount(wld_secDmnGrp_t* pSecDmnGrp) {
+    ASSERTS_NOT_NULL(pSecDmnGrp, 0, ME, "NULL");
+    return pSecDmnGrp->nRtmActionExec;
+}
+
 static void s_processGrpAction(amxp_timer_t* timer _UNUSED, void* userdata) {
     wld_secDmnGrp_t* pSecDmnGrp = (wld_secDmnGrp_t*) userdata;
     ASSERT_NOT_NULL(pSecDmnGrp, , ME, "NULL");
     SAH_TRACEZ_INFO(ME, "process group %s actions", pSecDmnGrp->name);
-    if(s_startGrp(pSecDmnGrp) == SWL_RC_DONE) {
-        s_tryGrpRtmAction(pSecDmnGrp, WLD_SECDMN_RTM_ACTION_RESTART);
-    }
+    s_startGrp(pSecDmnGrp);
+}
+
+static void s_processGrpRtmAction(amxp_timer_t* timer _UNUSED, void* userdata) {
+    wld_secDmnGrp_t* pSecDmnGrp = (wld_secDmnGrp_t*) userdata;
+    ASSERT_NOT_NULL(pSecDmnGrp, , ME, "NULL");
+    SAH_TRACEZ_INFO(ME, "process group %s runtime actions", pSecDmnGrp->name);
+    s_tryGrpRtmAction(pSecDmnGrp, true);
 }
 
 static swl_rc_ne s_startGrpMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_member_t* member) {
@@ -584,6 +817,10 @@ static swl_rc_ne s_startGrpMember(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmnGrp_mem
     bool wasStarted = (member->state == WLD_SECDMN_STATE_START);
     member->state = WLD_SECDMN_STATE_START;
     if(wld_dmn_isRunning(pSecDmnGrp->dmnProcess)) {
+        if((pSecDmnGrp->warmStandby) && (!member->isAttached) && (s_attachGrpMember(pSecDmnGrp, member) < SWL_RC_OK)) {
+            SAH_TRACEZ_WARNING(ME, "fail to attach member %s: restart group %s to load it", member->name, pSecDmnGrp->name);
+            return s_tryGrpMemberRtmAction(pSecDmnGrp, member, WLD_SECDMN_RTM_ACTION_RESTART);
+        }
         SAH_TRACEZ_INFO(ME, "member %s already running", member->name);
         if(!wasStarted) {
             SAH_TRACEZ_INFO(ME, "notify start %s done to member %s", pSecDmnGrp->name, member->name);
@@ -694,4 +931,42 @@ bool wld_secDmnGrp_isMemberStarted(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pS
     return (member->state == WLD_SECDMN_STATE_START);
 }
 
+bool wld_secDmnGrp_isMemberAttached(wld_secDmnGrp_t* pSecDmnGrp, wld_secDmn_t* pSecDmn) {
+    wld_secDmnGrp_member_t* member = s_getGrpMember(pSecDmnGrp, pSecDmn);
+    ASSERTI_NOT_NULL(member, false, ME, "no member found");
+    return member->isAttached;
+}
 
+/*
+ * @brief enable/disable the warm standby mode of a secDmn group
+ * In warm standby mode, the group process is started without waiting for members,
+ * and is kept running when all members are stopped.
+ * Members are then attached/detached at runtime (with addMemberCb/removeMemberCb handlers)
+ * instead of restarting the group process.
+ *
+ * @param pSecDmnGrp security daemon group ctx
+ * @param enable warm standby mode
+ *
+ * @return SWL_RC_OK when mode is applied
+ *         SWL_RC_CONTINUE when standby is disabled but process is still used by started members
+ *         error code otherwise
+ */
+swl_rc_ne wld_secDmnGrp_setWarmStandby(wld_secDmnGrp_t* pSecDmnGrp, bool enable) {
+    ASSERT_NOT_NULL(pSecDmnGrp, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTS_NOT_EQUALS(pSecDmnGrp->warmStandby, enable, SWL_RC_OK, ME, "group %s warm standby already %d", pSecDmnGrp->name, enable);
+    SAH_TRACEZ_INFO(ME, "set group %s warm standby %d", pSecDmnGrp->name, enable);
+    pSecDmnGrp->warmStandby = enable;
+    if(!enable) {
+        /* idle process is no more needed */
+        return s_stopGrp(pSecDmnGrp, false);
+    }
+    ASSERTS_FALSE(wld_dmn_isEnabled(pSecDmnGrp->dmnProcess), SWL_RC_OK, ME, "group %s process already started", pSecDmnGrp->name);
+    SAH_TRACEZ_INFO(ME, "pre-start group %s process", pSecDmnGrp->name);
+    ASSERT_TRUE(wld_dmn_startDeamon(pSecDmnGrp->dmnProcess), SWL_RC_ERROR, ME, "fail to pre-start group %s process", pSecDmnGrp->name);
+    return SWL_RC_OK;
+}
+
+bool wld_secDmnGrp_isWarmStandby(wld_secDmnGrp_t* pSecDmnGrp) {
+    ASSERTS_NOT_NULL(pSecDmnGrp, false, ME, "NULL");
+    return pSecDmnGrp->warmStandby;
+}
@@ -0,0 +1,472 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "swl/swl_common.h"
+#include "swl/swl_string.h"
+#include "wld_secDmn.h"
+#include "wld_secDmn_priv.h"
+#include "wld_wpaCtrlInterface.h"
+#include "wld_wpaCtrl_api.h"
+
+#define ME "secDmn"
+
+/*
+ * Config params support found by probing the daemon binary is saved per binary,
+ * so that it is only probed once per binary version, instead of at each daemon startup.
+ * The profile is shared by all radios using the same binary: it only holds params
+ * accepted by the binary ("param=1"), and params rejected by the binary
+ * with the probed value ("!param=value"), as rejection may depend on the radio value.
+ * Runtime declarations are not saved.
+ */
+#define CFG_PARAM_PROFILE_DIR "/var/lib/wld"
+#define CFG_PARAM_PROFILE_EXT ".caps"
+#define CFG_PARAM_PROFILE_ID_KEY "binary"
+#define CFG_PARAM_PROFILE_REJECT_PREFIX '!'
+#define CFG_PARAM_PROFILE_DFLT_PATH "/usr/sbin:/usr/bin:/sbin:/bin"
+#define CFG_PARAM_PROBE_TMOUT_MS 1000
+
+static char sProfileDir[128] = CFG_PARAM_PROFILE_DIR;
+
+struct wld_secDmn_cfgParamProbe {
+    wld_secDmn_t* pSecDmn;     // NULL when secDmn is cleaned up before all probes are answered
+    swl_mapCharInt32_t params; // params probed in this pass
+    uint32_t nPending;         // probes waiting for reply
+    uint32_t nAccepted;        // params found supported
+    uint32_t nRejected;        // params values found rejected
+    amxp_timer_t* doneTimer;   // end of pass, deferred out of the config generation context
+};
+
+typedef struct {
+    wld_secDmn_cfgParamProbe_t* pProbe;
+    char* param;
+    char* valStr;
+} secDmnParamProbeCtx_t;
+
+static void s_freeProbeCtx(secDmnParamProbeCtx_t* pCtx) {
+    free(pCtx->param);
+    free(pCtx->valStr);
+    free(pCtx);
+}
+
+static void s_freeProbe(wld_secDmn_cfgParamProbe_t* pProbe) {
+    amxp_timer_delete(&pProbe->doneTimer);
+    swl_mapCharInt32_cleanup(&pProbe->params);
+    free(pProbe);
+}
+
+static void s_probeDoneTimerCb(amxp_timer_t* timer _UNUSED, void* userData) {
+    wld_secDmn_cfgParamProbe_t* pProbe = (wld_secDmn_cfgParamProbe_t*) userData;
+    ASSERT_NOT_NULL(pProbe, , ME, "NULL");
+    wld_secDmn_t* pSecDmn = pProbe->pSecDmn;
+    uint32_t nAccepted = pProbe->nAccepted;
+    uint32_t nRejected = pProbe->nRejected;
+    uint32_t nProbed = swl_map_size(&pProbe->params);
+    if(pSecDmn != NULL) {
+        pSecDmn->cfgParamProbe = NULL;
+    }
+    s_freeProbe(pProbe);
+    ASSERTS_NOT_NULL(pSecDmn, , ME, "secDmn cleaned up");
+    SAH_TRACEZ_INFO(ME, "probed cfg params: %u accepted, %u rejected, over %u", nAccepted, nRejected, nProbed);
+    ASSERTS_TRUE((nAccepted + nRejected) > 0, , ME, "nothing learned");
+    wld_secDmn_saveCfgParamSuppProfile(pSecDmn);
+    /* rejected params are left out of config: only accepted ones need config to be regenerated */
+    ASSERTS_TRUE(nAccepted > 0, , ME, "no param accepted");
+    SWL_CALL(pSecDmn->handlers.cfgParamSuppCb, pSecDmn, pSecDmn->userData);
+}
+
+static void s_probeDoneCb(void* userData, const char* cmd _UNUSED, swl_rc_ne rc, const char* reply) {
+    secDmnParamProbeCtx_t* pCtx = (secDmnParamProbeCtx_t*) userData;
+    ASSERT_NOT_NULL(pCtx, , ME, "NULL");
+    wld_secDmn_cfgParamProbe_t* pProbe = pCtx->pProbe;
+    if((pProbe->pSecDmn != NULL) && (rc == SWL_RC_OK)) {
+        swl_trl_e trl = swl_str_matches(reply, "OK") ? SWL_TRL_TRUE : SWL_TRL_FALSE;
+        SAH_TRACEZ_INFO(ME, "cfg param %s (%s) supported: %d", pCtx->param, pCtx->valStr, trl);
+        wld_secDmn_setProbedCfgParamSupp(pProbe->pSecDmn, pCtx->param, pCtx->valStr, trl);
+        if(trl == SWL_TRL_TRUE) {
+            pProbe->nAccepted++;
+        } else {
+            pProbe->nRejected++;
+        }
+    }
+    s_freeProbeCtx(pCtx);
+    if(pProbe->nPending > 0) {
+        pProbe->nPending--;
+    }
+    ASSERTS_EQUALS(pProbe->nPending, 0, , ME, "probes pending");
+    if(pProbe->pSecDmn == NULL) {
+        s_freeProbe(pProbe);
+        return;
+    }
+    amxp_timer_start(pProbe->doneTimer, 0);
+}
+
+/*
+ * @brief probe asynchronously whether a config param is supported by the running daemon,
+ * by setting its value at runtime.
+ * All probes sent during one config generation make one pass: once all are answered,
+ * the learned support is saved to the profile, and the cfgParamSuppCb handler is called
+ * when some param was accepted.
+ * A param value already rejected by the binary is not probed again.
+ *
+ * @param pSecDmn pointer to security daemon context
+ * @param pIface wpa_ctrl interface to which the probe is sent
+ * @param param parameter name
+ * @param valStr parameter value
+ *
+ * @return SWL_RC_CONTINUE when the probe is sent or already pending,
+ *         SWL_RC_INVALID_PARAM when the param value is known to be rejected, error code otherwise
+ */
+swl_rc_ne wld_secDmn_probeCfgParamSupp(wld_secDmn_t* pSecDmn, wld_wpaCtrlInterface_t* pIface, const char* param, const char* valStr) {
+    ASSERT_NOT_NULL(pSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_STR(param, SWL_RC_INVALID_PARAM, ME, "empty param");
+    ASSERT_STR(valStr, SWL_RC_INVALID_PARAM, ME, "empty value");
+    if(swl_str_matches(swl_mapChar_get(&pSecDmn->cfgParamRejected, (char*) param), valStr)) {
+        SAH_TRACEZ_INFO(ME, "cfg param %s (%s) already rejected by binary", param, valStr);
+        wld_secDmn_setCfgParamSupp(pSecDmn, param, SWL_TRL_FALSE);
+        return SWL_RC_INVALID_PARAM;
+    }
+    ASSERTS_TRUE(wld_wpaCtrlInterface_isReady(pIface), SWL_RC_INVALID_STATE, ME, "iface not ready");
+    wld_secDmn_cfgParamProbe_t* pProbe = pSecDmn->cfgParamProbe;
+    if(pProbe == NULL) {
+        pProbe = calloc(1, sizeof(*pProbe));
+        ASSERT_NOT_NULL(pProbe, SWL_RC_ERROR, ME, "fail to alloc probe");
+        pProbe->pSecDmn = pSecDmn;
+        swl_mapCharInt32_init(&pProbe->params);
+        amxp_timer_new(&pProbe->doneTimer, s_probeDoneTimerCb, pProbe);
+        pSecDmn->cfgParamProbe = pProbe;
+    }
+    ASSERTS_NULL(swl_map_get(&pProbe->params, (char*) param), SWL_RC_CONTINUE, ME, "param %s already probed", param);
+
+    char cmd[640] = {0};
+    ASSERT_TRUE(swl_str_catFormat(cmd, sizeof(cmd), "SET %s %s", param, valStr), SWL_RC_ERROR, ME, "probe of %s too long", param);
+    secDmnParamProbeCtx_t* pCtx = calloc(1, sizeof(*pCtx));
+    ASSERT_NOT_NULL(pCtx, SWL_RC_ERROR, ME, "fail to alloc probe ctx");
+    pCtx->pProbe = pProbe;
+    swl_str_copyMalloc(&pCtx->param, param);
+    swl_str_copyMalloc(&pCtx->valStr, valStr);
+    swl_rc_ne rc = wld_wpaCtrl_sendCmdAsync(pIface, cmd, CFG_PARAM_PROBE_TMOUT_MS, s_probeDoneCb, pCtx);
+    if(!swl_rc_isOk(rc)) {
+        SAH_TRACEZ_ERROR(ME, "fail to probe cfg param %s", param);
+        s_freeProbeCtx(pCtx);
+        return rc;
+    }
+    swl_mapCharInt32_addOrSet(&pProbe->params, (char*) param, 1);
+    pProbe->nPending++;
+    amxp_timer_stop(pProbe->doneTimer);
+    return SWL_RC_CONTINUE;
+}
+
+bool wld_secDmn_isProbingCfgParamSupp(wld_secDmn_t* pSecDmn) {
+    ASSERTS_NOT_NULL(pSecDmn, false, ME, "NULL");
+    return ((pSecDmn->cfgParamProbe != NULL) && (pSecDmn->cfgParamProbe->nPending > 0));
+}
+
+void wld_secDmn_dropCfgParamProbe(wld_secDmn_t* pSecDmn) {
+    ASSERTS_NOT_NULL(pSecDmn, , ME, "NULL");
+    wld_secDmn_cfgParamProbe_t* pProbe = pSecDmn->cfgParamProbe;
+    ASSERTS_NOT_NULL(pProbe, , ME, "no probe");
+    pSecDmn->cfgParamProbe = NULL;
+    pProbe->pSecDmn = NULL;
+    /* when replies are pending, the probe is freed with the last one */
+    if(pProbe->nPending == 0) {
+        s_freeProbe(pProbe);
+    }
+}
+
+/*
+ * @brief save the result of probing a config param support, to be recorded in the profile
+ * Rejection is recorded with the probed value, as it may be specific to
+ * the probing radio (eg. value not applicable).
+ *
+ * @param pSecDmn pointer to security daemon context
+ * @param param parameter name
+ * @param valStr probed value
+ * @param supp probing result
+ *
+ * @return true when saved, false otherwise
+ */
+bool wld_secDmn_setProbedCfgParamSupp(wld_secDmn_t* pSecDmn, const char* param, const char* valStr, swl_trl_e supp) {
+    ASSERT_NOT_NULL(pSecDmn, false, ME, "NULL");
+    ASSERT_STR(param, false, ME, "empty param");
+    if(supp == SWL_TRL_TRUE) {
+        swl_mapCharInt32_addOrSet(&pSecDmn->cfgParamProbed, (char*) param, supp);
+        swl_mapChar_delete(&pSecDmn->cfgParamRejected, (char*) param);
+    } else if((supp == SWL_TRL_FALSE) && !swl_str_isEmpty(valStr)) {
+        swl_mapChar_addOrSet(&pSecDmn->cfgParamRejected, (char*) param, (char*) valStr);
+    }
+    return wld_secDmn_setCfgParamSupp(pSecDmn, param, supp);
+}
+
+/*
+ * @brief set the directory where config params support profiles are saved
+ * (default: CFG_PARAM_PROFILE_DIR)
+ *
+ * @param dirPath directory path
+ *
+ * @return SWL_RC_OK when set, error code otherwise
+ */
+swl_rc_ne wld_secDmn_setCfgParamProfileDir(const char* dirPath) {
+    ASSERT_STR(dirPath, SWL_RC_INVALID_PARAM, ME, "empty dir path");
+    ASSERT_TRUE(swl_str_copy(sProfileDir, sizeof(sProfileDir), dirPath), SWL_RC_ERROR, ME, "dir path too long");
+    return SWL_RC_OK;
+}
+
+const char* wld_secDmn_getCfgParamProfileDir() {
+    return sProfileDir;
+}
+
+static bool s_resolveCmdPath(const char* cmd, char* path, size_t pathSize) {
+    if(strchr(cmd, '/') != NULL) {
+        return (swl_str_copy(path, pathSize, cmd) && (access(path, X_OK) == 0));
+    }
+    const char* envPath = getenv("PATH");
+    if(swl_str_isEmpty(envPath)) {
+        envPath = CFG_PARAM_PROFILE_DFLT_PATH;
+    }
+    char dirs[strlen(envPath) + 1];
+    swl_str_copy(dirs, sizeof(dirs), envPath);
+    char* savePtr = NULL;
+    for(char* dir = strtok_r(dirs, ":", &savePtr); dir != NULL; dir = strtok_r(NULL, ":", &savePtr)) {
+        if((snprintf(path, pathSize, "%s/%s", dir, cmd) < (int) pathSize) && (access(path, X_OK) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * @brief get the profile file path, and the identity (path, size, mtime) of the daemon binary
+ */
+static bool s_getProfileInfo(wld_secDmn_t* pSecDmn, char* binId, size_t binIdSize, char* profilePath, size_t profilePathSize) {
+    ASSERTS_NOT_NULL(pSecDmn->dmnProcess, false, ME, "no daemon");
+    const char* cmd = pSecDmn->dmnProcess->cmd;
+    ASSERT_STR(cmd, false, ME, "no daemon cmd");
+    char binPath[256] = {0};
+    ASSERT_TRUE(s_resolveCmdPath(cmd, binPath, sizeof(binPath)), false, ME, "binary of %s not found", cmd);
+    struct stat st;
+    ASSERT_EQUALS(stat(binPath, &st), 0, false, ME, "fail to stat %s (%d:%s)", binPath, errno, strerror(errno));
+    int ret = snprintf(binId, binIdSize, "%s:%lld:%lld", binPath, (long long) st.st_size, (long long) st.st_mtime);
+    ASSERT_TRUE((ret > 0) && (ret < (int) binIdSize), false, ME, "binary id too long");
+    const char* cmdName = strrchr(cmd, '/');
+    cmdName = (cmdName != NULL) ? (cmdName + 1) : cmd;
+    ret = snprintf(profilePath, profilePathSize, "%s/%s%s", sProfileDir, cmdName, CFG_PARAM_PROFILE_EXT);
+    ASSERT_TRUE((ret > 0) && (ret < (int) profilePathSize), false, ME, "profile path too long");
+    return true;
+}
+
+/*
+ * @brief read the params saved as supported, and the params values saved as rejected, in a profile file
+ *
+ * @return true when the profile is saved for the binary, false otherwise
+ */
+static bool s_readProfile(const char* profilePath, const char* binId, swl_mapCharInt32_t* pParams, swl_mapChar_t* pRejected) {
+    FILE* fp = fopen(profilePath, "r");
+    ASSERTI_NOT_NULL(fp, false, ME, "no profile %s", profilePath);
+    char line[256];
+    bool idMatch = false;
+    while(fgets(line, sizeof(line), fp) != NULL) {
+        line[strcspn(line, "\r\n")] = 0;
+        char* sep = strchr(line, '=');
+        if((line[0] == '#') || (sep == NULL)) {
+            continue;
+        }
+        *sep = 0;
+        const char* key = line;
+        const char* val = sep + 1;
+        if(swl_str_matches(key, CFG_PARAM_PROFILE_ID_KEY)) {
+            idMatch = swl_str_matches(val, binId);
+            if(!idMatch) {
+                break;
+            }
+            continue;
+        }
+        if(!idMatch) {
+            // binary id is expected first
+            break;
+        }
+        if(key[0] == CFG_PARAM_PROFILE_REJECT_PREFIX) {
+            if(key[1] != 0) {
+                swl_mapChar_addOrSet(pRejected, (char*) &key[1], (char*) val);
+            }
+            continue;
+        }
+        // unsupported params without value may be left by previous versions
+        if(swl_str_matches(val, "1")) {
+            swl_mapCharInt32_addOrSet(pParams, (char*) key, SWL_TRL_TRUE);
+        }
+    }
+    fclose(fp);
+    return idMatch;
+}
+
+/*
+ * @brief load config params support saved for the daemon binary.
+ * Support already declared (true/false) is kept, only unknown params are updated.
+ * The profile is ignored when saved for another binary version.
+ *
+ * @param pSecDmn pointer to security daemon context
+ *
+ * @return SWL_RC_OK when loaded, SWL_RC_NOT_AVAILABLE when no matching profile, error code otherwise
+ */
+swl_rc_ne wld_secDmn_loadCfgParamSuppProfile(wld_secDmn_t* pSecDmn) {
+    ASSERT_NOT_NULL(pSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    char binId[384] = {0};
+    char profilePath[256] = {0};
+    ASSERTS_TRUE(s_getProfileInfo(pSecDmn, binId, sizeof(binId), profilePath, sizeof(profilePath)), SWL_RC_ERROR, ME, "no profile info");
+    swl_mapCharInt32_t params;
+    swl_mapCharInt32_init(&params);
+    swl_mapChar_t rejected;
+    swl_mapChar_init(&rejected);
+    bool idMatch = s_readProfile(profilePath, binId, &params, &rejected);
+    uint32_t nLoaded = 0;
+    swl_mapIt_t mapIt;
+    swl_map_for_each(mapIt, &rejected) {
+        const char* param = (const char*) swl_map_itKey(&mapIt);
+        if(swl_map_get(&params, (char*) param) == NULL) {
+            swl_mapChar_addOrSet(&pSecDmn->cfgParamRejected, (char*) param, (char*) swl_map_itValue(&mapIt));
+        }
+    }
+    swl_mapChar_cleanup(&rejected);
+    swl_map_for_each(mapIt, &params) {
+        const char* param = (const char*) swl_map_itKey(&mapIt);
+        swl_mapCharInt32_addOrSet(&pSecDmn->cfgParamProbed, (char*) param, SWL_TRL_TRUE);
+        if(wld_secDmn_getCfgParamSupp(pSecDmn, param) != SWL_TRL_UNKNOWN) {
+            continue;
+        }
+        wld_secDmn_setCfgParamSupp(pSecDmn, param, SWL_TRL_TRUE);
+        nLoaded++;
+    }
+    swl_mapCharInt32_cleanup(&params);
+    ASSERTI_TRUE(idMatch, SWL_RC_NOT_AVAILABLE, ME, "profile %s not matching binary %s", profilePath, binId);
+    SAH_TRACEZ_INFO(ME, "loaded %u cfg params support from %s", nLoaded, profilePath);
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief save config params found supported by probing the daemon binary.
+ * Params saved by other users of the same binary (eg. other radios) are kept.
+ *
+ * @param pSecDmn pointer to security daemon context
+ *
+ * @return SWL_RC_OK when saved, error code otherwise
+ */
+swl_rc_ne wld_secDmn_saveCfgParamSuppProfile(wld_secDmn_t* pSecDmn) {
+    ASSERT_NOT_NULL(pSecDmn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    char binId[384] = {0};
+    char profilePath[256] = {0};
+    ASSERTS_TRUE(s_getProfileInfo(pSecDmn, binId, sizeof(binId), profilePath, sizeof(profilePath)), SWL_RC_ERROR, ME, "no profile info");
+    ASSERT_FALSE((mkdir(sProfileDir, 0755) < 0) && (errno != EEXIST), SWL_RC_ERROR,
+                 ME, "fail to create %s (%d:%s)", sProfileDir, errno, strerror(errno));
+    swl_mapCharInt32_t params;
+    swl_mapCharInt32_init(&params);
+    swl_mapChar_t rejected;
+    swl_mapChar_init(&rejected);
+    s_readProfile(profilePath, binId, &params, &rejected);
+    swl_mapIt_t mapIt;
+    swl_map_for_each(mapIt, &pSecDmn->cfgParamProbed) {
+        swl_mapCharInt32_addOrSet(&params, (char*) swl_map_itKey(&mapIt), SWL_TRL_TRUE);
+    }
+    swl_map_for_each(mapIt, &pSecDmn->cfgParamRejected) {
+        swl_mapChar_addOrSet(&rejected, (char*) swl_map_itKey(&mapIt), (char*) swl_map_itValue(&mapIt));
+    }
+    char tmpPath[sizeof(profilePath) + 4] = {0};
+    swl_str_catFormat(tmpPath, sizeof(tmpPath), "%s.tmp", profilePath);
+    FILE* fp = fopen(tmpPath, "w");
+    if(fp == NULL) {
+        SAH_TRACEZ_ERROR(ME, "fail to open %s (%d:%s)", tmpPath, errno, strerror(errno));
+        swl_mapCharInt32_cleanup(&params);
+        swl_mapChar_cleanup(&rejected);
+        return SWL_RC_ERROR;
+    }
+    fprintf(fp, "# config params supported (or values rejected) by binary\n");
+    fprintf(fp, "%s=%s\n", CFG_PARAM_PROFILE_ID_KEY, binId);
+    uint32_t nSaved = 0;
+    swl_map_for_each(mapIt, &params) {
+        fprintf(fp, "%s=1\n", (const char*) swl_map_itKey(&mapIt));
+        nSaved++;
+    }
+    swl_map_for_each(mapIt, &rejected) {
+        const char* param = (const char*) swl_map_itKey(&mapIt);
+        if(swl_map_get(&params, (char*) param) != NULL) {
+            continue;
+        }
+        fprintf(fp, "%c%s=%s\n", CFG_PARAM_PROFILE_REJECT_PREFIX, param, (const char*) swl_map_itValue(&mapIt));
+        nSaved++;
+    }
+    swl_mapCharInt32_cleanup(&params);
+    swl_mapChar_cleanup(&rejected);
+    bool ok = (fflush(fp) == 0);
+    ok &= (fclose(fp) == 0);
+    if((!ok) || (rename(tmpPath, profilePath) < 0)) {
+        SAH_TRACEZ_ERROR(ME, "fail to write %s (%d:%s)", profilePath, errno, strerror(errno));
+        unlink(tmpPath);
+        return SWL_RC_ERROR;
+    }
+    SAH_TRACEZ_INFO(ME, "saved %u cfg params support to %s", nSaved, profilePath);
+    return SWL_RC_OK;
+}
@@ -67,6 +67,7 @@
 #include <unistd.h>
 #include "wld.h"
 #include "wld_wpaCtrlConnection_priv.h"
+#include "wld_wpaCtrl_trace.h"
 #include <swl/fileOps/swl_fileUtils.h>
 
 #define ME "wpaCtrl"
@@ -75,7 +76,50 @@
 #define DEFAULT_MSG_LENGTH (12 * 1024)  //12KB
 #define MAX_MSG_LENGTH (64 * 1024)      //64KB
 
+#define RX_BURST_BUDGET 32 // max messages read per socket wakeup
+
 static size_t sMaxMsgLen = DEFAULT_MSG_LENGTH;
+static char sCliDirPath[64] = CTRL_IFACE_CLIENT_DIR;
+
+/*
+ * wpa_ctrl server answers the commands in the order they were received,
+ * so replies are correlated to the queued commands in FIFO order.
+ * Replies carry no command id: when one is not received in time, the connection
+ * moves to a new client socket, so that the late reply can not be taken
+ * for the reply of a following command.
+ */
+typedef struct {
+    amxc_llist_it_t it;
+    wpaCtrlConnection_t* pConn;
+    char* cmd;
+    uint32_t tmOutMSec;
+    wld_wpaCtrl_cmdDoneCb_f fDoneCb;
+    void* userData;
+    amxp_timer_t* timer;
+    bool sent;
+} wpaCtrlCmd_t;
+
+/*
+ * unsolicited message, or command completion, received while blocked
+ * waiting for a synchronous reply, and delivered later from the main loop
+ */
+typedef struct {
+    amxc_llist_it_t it;
+    wld_wpaCtrl_cmdDoneCb_f fDoneCb; // set for a command completion
+    void* userData;
+    char* cmd;
+    swl_rc_ne rc;
+    bool hasData;
+    size_t len;
+    char data[];
+} wpaCtrlDeferredMsg_t;
+
+typedef struct {
+    char* reply;
+    size_t replyLen;
+    bool done;
+    swl_rc_ne rc;
+} wpaCtrlSyncReply_t;
 
 static const char* s_getConnCliPath(wpaCtrlConnection_t* pConn) {
     ASSERTS_NOT_NULL(pConn, "", ME, "NULL");
@@ -98,6 +142,21 @@ swl_rc_ne wld_wpaCtrl_setMaxMsgLen(size_t msgLen) {
     return SWL_RC_OK;
 }
 
+const char* wld_wpaCtrl_getClientDir() {
+    return sCliDirPath;
+}
+
+/**
+ * @brief set the directory where client sockets are bound
+ * Only applies to connections initialized afterwards.
+ */
+swl_rc_ne wld_wpaCtrl_setClientDir(const char* dirPath) {
+    ASSERT_STR(dirPath, SWL_RC_INVALID_PARAM, ME, "empty dir path");
+    ASSERT_TRUE(swl_str_len(dirPath) < sizeof(sCliDirPath), SWL_RC_INVALID_PARAM, ME, "dir path (%s) too long", dirPath);
+    swl_str_copy(sCliDirPath, sizeof(sCliDirPath), dirPath);
+    return SWL_RC_OK;
+}
+
 const char* wld_wpaCtrlConnection_getConnCliPath(wpaCtrlConnection_t* pConn) {
     return s_getConnCliPath(pConn);
 }
@@ -107,7 +166,7 @@ const char* wld_wpaCtrlConnection_getConnSrvPath(wpaCtrlConnection_t* pConn) {
 }
 
 const char* wld_wpaCtrlConnection_getConnCliDirPath(wpaCtrlConnection_t* pConn _UNUSED) {
-    return CTRL_IFACE_CLIENT_DIR;
+    return sCliDirPath;
 }
 
 const char* wld_wpaCtrlConnection_getConnSrvDirPath(wpaCtrlConnection_t* pConn) {
@@ -122,8 +181,83 @@ const char* wld_wpaCtrlConnection_getConnSockName(wpaCtrlConnection_t* pConn) {
     return (pSep ? &pSep[1] : path);
 }
 
+static void s_freeCmd(wpaCtrlCmd_t* pCmd) {
+    ASSERTS_NOT_NULL(pCmd, , ME, "NULL");
+    amxc_llist_it_take(&pCmd->it);
+    amxp_timer_delete(&pCmd->timer);
+    W_SWL_FREE(pCmd->cmd);
+    free(pCmd);
+}
+
+static void s_syncCmdDoneCb(void* userData, const char* cmd _UNUSED, swl_rc_ne rc, const char* reply) {
+    wpaCtrlSyncReply_t* pSyncReply = (wpaCtrlSyncReply_t*) userData;
+    pSyncReply->done = true;
+    pSyncReply->rc = rc;
+    if(reply != NULL) {
+        swl_str_copy(pSyncReply->reply, pSyncReply->replyLen, reply);
+    }
+}
+
+static void s_deferMsg(wpaCtrlConnection_t* pConn, wld_wpaCtrl_cmdDoneCb_f fDoneCb, void* userData,
+                       const char* cmd, swl_rc_ne rc, const char* msgData, size_t msgLen);
+
+/*
+ * @brief call the command completion handler
+ * While blocked waiting for a synchronous reply, the completion of other
+ * commands is delivered later, from the main loop, as unsolicited messages are.
+ */
+static void s_completeCmd(wpaCtrlCmd_t* pCmd, swl_rc_ne rc, const char* reply) {
+    wld_wpaCtrl_cmdDoneCb_f fDoneCb = pCmd->fDoneCb;
+    pCmd->fDoneCb = NULL;
+    ASSERTS_NOT_NULL(fDoneCb, , ME, "no completion handler");
+    wpaCtrlConnection_t* pConn = pCmd->pConn;
+    if((pConn->syncWaitDepth == 0) || (fDoneCb == s_syncCmdDoneCb)) {
+        fDoneCb(pCmd->userData, pCmd->cmd, rc, reply);
+        return;
+    }
+    s_deferMsg(pConn, fDoneCb, pCmd->userData, pCmd->cmd, rc, reply, swl_str_len(reply));
+}
+
+/*
+ * @brief fail all queued commands, as no more reply can be received
+ */
+static void s_flushCmdQueue(wpaCtrlConnection_t* pConn) {
+    amxc_llist_it_t* it;
+    while((it = amxc_llist_take_first(&pConn->cmdQueue)) != NULL) {
+        wpaCtrlCmd_t* pCmd = amxc_container_of(it, wpaCtrlCmd_t, it);
+        SAH_TRACEZ_INFO(ME, "%s: drop pending cmd (%s)", wld_wpaCtrlConnection_getConnSockName(pConn), pCmd->cmd);
+        s_completeCmd(pCmd, SWL_RC_INVALID_STATE, NULL);
+        s_freeCmd(pCmd);
+    }
+    pConn->nrInFlightCmds = 0;
+}
+
+static void s_freeDeferredMsg(wpaCtrlDeferredMsg_t* pMsg) {
+    ASSERTS_NOT_NULL(pMsg, , ME, "NULL");
+    amxc_llist_it_take(&pMsg->it);
+    free(pMsg->cmd);
+    free(pMsg);
+}
+
+/*
+ * @brief drop the deferred messages, but still deliver the command completions,
+ * as their user data may only be released by their handler
+ */
+static void s_flushDeferredMsgs(wpaCtrlConnection_t* pConn) {
+    amxc_llist_t msgs;
+    amxc_llist_init(&msgs);
+    amxc_llist_move(&msgs, &pConn->deferredMsgs);
+    amxc_llist_it_t* it;
+    while((it = amxc_llist_take_first(&msgs)) != NULL) {
+        wpaCtrlDeferredMsg_t* pMsg = amxc_container_of(it, wpaCtrlDeferredMsg_t, it);
+        SWL_CALL(pMsg->fDoneCb, pMsg->userData, pMsg->cmd, pMsg->rc, pMsg->hasData ? pMsg->data : NULL);
+        s_freeDeferredMsg(pMsg);
+    }
+}
+
 swl_rc_ne wld_wpaCtrlConnection_close(wpaCtrlConnection_t* pConn) {
     ASSERTS_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    s_flushCmdQueue(pConn);
     ASSERTS_TRUE(pConn->wpaPeer > 0, SWL_RC_OK, ME, "NULL");
     SAH_TRACEZ_INFO(ME, "close connection (%s) to (%s)",
                     s_getConnCliPath(pConn),
@@ -131,6 +265,8 @@ swl_rc_ne wld_wpaCtrlConnection_close(wpaCtrlConnection_t* pConn) {
     amxo_connection_remove(get_wld_plugin_parser(), pConn->wpaPeer);
     close(pConn->wpaPeer);
     pConn->wpaPeer = 0;
+    pConn->rxBufBusy = false;
+    pConn->isAttached = false;
     unlink(pConn->clientAddr.sun_path);
     return SWL_RC_OK;
 }
@@ -143,11 +279,30 @@ swl_rc_ne wld_wpaCtrlConnection_cleanup(wpaCtrlConnection_t** ppConn) {
     SAH_TRACEZ_INFO(ME, "cleanup connection (%s) to (%s)",
                     s_getConnCliPath(pConn),
                     s_getConnSrvPath(pConn));
+    amxp_timer_delete(&pConn->deferredMsgsTimer);
+    s_flushDeferredMsgs(pConn);
+    W_SWL_FREE(pConn->rxBuf);
     W_SWL_FREE(pConn->srvDirPath);
     W_SWL_FREE(*ppConn);
     return SWL_RC_OK;
 }
 
+/*
+ * @brief set the client socket path, unique per connection
+ * A new path is used after each resync, so that late replies, sent to the previous one, are dropped
+ */
+static void s_setCliPath(wpaCtrlConnection_t* pConn) {
+    const char* sockName = wld_wpaCtrlConnection_getConnSockName(pConn);
+    pConn->clientAddr.sun_family = AF_UNIX;
+    if(pConn->nrResyncs == 0) {
+        snprintf(pConn->clientAddr.sun_path, sizeof(pConn->clientAddr.sun_path), "%s/" CTRL_IFACE_CLIENT_PREFIX "%s-%u",
+                 sCliDirPath, sockName, pConn->connId);
+    } else {
+        snprintf(pConn->clientAddr.sun_path, sizeof(pConn->clientAddr.sun_path), "%s/" CTRL_IFACE_CLIENT_PREFIX "%s-%u.%u",
+                 sCliDirPath, sockName, pConn->connId, pConn->nrResyncs);
+    }
+}
+
 swl_rc_ne wld_wpaCtrlConnection_init(wpaCtrlConnection_t** ppConn, uint32_t connId, const char* serverPath, const char* sockName) {
     ASSERT_NOT_NULL(ppConn, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERT_STR(serverPath, SWL_RC_INVALID_PARAM, ME, "empty server path");
@@ -157,6 +312,10 @@ swl_rc_ne wld_wpaCtrlConnection_init(wpaCtrlConnection_t** ppConn, uint32_t conn
     if(pConn == NULL) {
         pConn = calloc(1, sizeof(wpaCtrlConnection_t));
         ASSERT_NOT_NULL(pConn, SWL_RC_ERROR, ME, "%s: fail to alloc wpa_ctrl connection", sockName);
+        amxc_llist_init(&pConn->cmdQueue);
+        amxc_llist_init(&pConn->deferredMsgs);
+        pConn->maxInFlightCmds = DFLT_MAX_IN_FLIGHT_CMDS;
+        pConn->rxBurstBudget = RX_BURST_BUDGET;
         *ppConn = pConn;
     } else if(pConn->wpaPeer != 0) {
         wld_wpaCtrlConnection_close(pConn);
@@ -165,8 +324,9 @@ swl_rc_ne wld_wpaCtrlConnection_init(wpaCtrlConnection_t** ppConn, uint32_t conn
     swl_str_copyMalloc(&pConn->srvDirPath, serverPath);
     pConn->serverAddr.sun_family = AF_UNIX;
     snprintf(pConn->serverAddr.sun_path, sizeof(pConn->serverAddr.sun_path), "%s/%s", serverPath, sockName);
-    pConn->clientAddr.sun_family = AF_UNIX;
-    snprintf(pConn->clientAddr.sun_path, sizeof(pConn->clientAddr.sun_path), CTRL_IFACE_CLIENT "%s-%u", sockName, connId);
+    pConn->connId = connId;
+    pConn->nrResyncs = 0;
+    s_setCliPath(pConn);
 
     SAH_TRACEZ_INFO(ME, "%s: init connection (%s) to (%s)", sockName,
                     s_getConnCliPath(pConn),
@@ -186,33 +346,280 @@ swl_rc_ne wld_wpaCtrlConnection_setEvtHandlers(wpaCtrlConnection_t* pConn, void*
     return SWL_RC_OK;
 }
 
+static void s_deliverDeferredMsgsCb(amxp_timer_t* timer _UNUSED, void* priv) {
+    wpaCtrlConnection_t* pConn = (wpaCtrlConnection_t*) priv;
+    ASSERTS_NOT_NULL(pConn, , ME, "NULL");
+    /*
+     * work on local copies, as the handler may close the connection
+     * or wait again for a synchronous reply
+     */
+    amxc_llist_t msgs;
+    amxc_llist_init(&msgs);
+    amxc_llist_move(&msgs, &pConn->deferredMsgs);
+    wld_wpaCtrlConnection_evtHandlers_cb evtHdlrs = pConn->evtHdlrs;
+    void* userData = pConn->userData;
+    amxc_llist_it_t* it;
+    while((it = amxc_llist_take_first(&msgs)) != NULL) {
+        wpaCtrlDeferredMsg_t* pMsg = amxc_container_of(it, wpaCtrlDeferredMsg_t, it);
+        if(pMsg->fDoneCb != NULL) {
+            pMsg->fDoneCb(pMsg->userData, pMsg->cmd, pMsg->rc, pMsg->hasData ? pMsg->data : NULL);
+        } else {
+            SWL_CALL(evtHdlrs.fReadDataCb, userData, pMsg->data, pMsg->len);
+        }
+        s_freeDeferredMsg(pMsg);
+    }
+}
+
+static void s_deferMsg(wpaCtrlConnection_t* pConn, wld_wpaCtrl_cmdDoneCb_f fDoneCb, void* userData,
+                       const char* cmd, swl_rc_ne rc, const char* msgData, size_t msgLen) {
+    wpaCtrlDeferredMsg_t* pMsg = calloc(1, sizeof(*pMsg) + msgLen + 1);
+    ASSERT_NOT_NULL(pMsg, , ME, "%s: fail to defer msg (%s)", wld_wpaCtrlConnection_getConnSockName(pConn), msgData);
+    pMsg->fDoneCb = fDoneCb;
+    pMsg->userData = userData;
+    swl_str_copyMalloc(&pMsg->cmd, cmd);
+    pMsg->rc = rc;
+    pMsg->hasData = (msgData != NULL);
+    if(msgData != NULL) {
+        memcpy(pMsg->data, msgData, msgLen);
+    }
+    pMsg->len = msgLen;
+    amxc_llist_append(&pConn->deferredMsgs, &pMsg->it);
+    if(pConn->deferredMsgsTimer == NULL) {
+        amxp_timer_new(&pConn->deferredMsgsTimer, s_deliverDeferredMsgsCb, pConn);
+    }
+    amxp_timer_start(pConn->deferredMsgsTimer, 0);
+}
+
+/*
+ * @brief forward unsolicited message to the read data handler
+ * Messages received while blocked waiting for a synchronous reply
+ * are delivered later, from the main loop.
+ */
+static void s_deliverMsg(wpaCtrlConnection_t* pConn, char* msgData, size_t msgLen) {
+    if(pConn->syncWaitDepth == 0) {
+        SWL_CALL(pConn->evtHdlrs.fReadDataCb, pConn->userData, msgData, msgLen);
+        return;
+    }
+    ASSERTS_NOT_NULL(pConn->evtHdlrs.fReadDataCb, , ME, "no msg handler");
+    s_deferMsg(pConn, NULL, NULL, NULL, SWL_RC_OK, msgData, msgLen);
+}
+
+static swl_rc_ne s_sendRaw(wpaCtrlConnection_t* pConn, const char* cmd) {
+    int fd = pConn->wpaPeer;
+    ASSERTS_TRUE(fd > 0, SWL_RC_INVALID_STATE, ME, "fd <= 0");
+
+    const char* srvPath = s_getConnSrvPath(pConn);
+    size_t len = strlen(cmd);
+    ssize_t ret = send(fd, cmd, len, 0);
+    SAH_TRACEZ_INFO(ME, "send cmd (%s) to (%s)", cmd, srvPath);
+    ASSERT_EQUALS(ret, (ssize_t) len, SWL_RC_ERROR, ME, "Failed to send cmd (%s) to (%s): ret(%d), err(%d:%s)",
+                  cmd, srvPath,
+                  (int32_t) ret, errno, strerror(errno));
+    if(wld_wpaCtrl_isRecording()) {
+        wld_wpaCtrl_recordMsg(WLD_WPACTRL_TRACE_DIR_CMD, wld_wpaCtrlConnection_getConnSockName(pConn), cmd, len);
+    }
+
+    return SWL_RC_OK;
+}
+
+static void s_setCmdSent(wpaCtrlConnection_t* pConn, wpaCtrlCmd_t* pCmd) {
+    pCmd->sent = true;
+    pConn->nrInFlightCmds++;
+    amxp_timer_start(pCmd->timer, pCmd->tmOutMSec);
+}
+
+/*
+ * @brief send queued commands, within the limit of in-flight commands
+ */
+static void s_sendPendingCmds(wpaCtrlConnection_t* pConn) {
+    while(pConn->nrInFlightCmds < pConn->maxInFlightCmds) {
+        amxc_llist_it_t* it = amxc_llist_get_at(&pConn->cmdQueue, pConn->nrInFlightCmds);
+        if(it == NULL) {
+            break;
+        }
+        wpaCtrlCmd_t* pCmd = amxc_container_of(it, wpaCtrlCmd_t, it);
+        swl_rc_ne rc = s_sendRaw(pConn, pCmd->cmd);
+        if(swl_rc_isOk(rc)) {
+            s_setCmdSent(pConn, pCmd);
+            continue;
+        }
+        amxc_llist_it_take(&pCmd->it);
+        s_completeCmd(pCmd, rc, NULL);
+        s_freeCmd(pCmd);
+    }
+}
+
+static void s_resyncConn(wpaCtrlConnection_t* pConn);
+
+static void s_cmdTimeoutCb(amxp_timer_t* timer _UNUSED, void* priv) {
+    wpaCtrlCmd_t* pCmd = (wpaCtrlCmd_t*) priv;
+    ASSERTS_NOT_NULL(pCmd, , ME, "NULL");
+    SAH_TRACEZ_ERROR(ME, "%s: cmd(%s) timed out", wld_wpaCtrlConnection_getConnSockName(pCmd->pConn), pCmd->cmd);
+    s_resyncConn(pCmd->pConn);
+}
+
+static swl_rc_ne s_queueCmd(wpaCtrlConnection_t* pConn, const char* cmd, uint32_t tmOutMSec,
+                            wld_wpaCtrl_cmdDoneCb_f fDoneCb, void* userData, wpaCtrlCmd_t** ppCmd) {
+    ASSERTS_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_STR(cmd, SWL_RC_INVALID_PARAM, ME, "empty cmd");
+    ASSERTS_TRUE(pConn->wpaPeer > 0, SWL_RC_INVALID_STATE, ME, "fd <= 0");
+    const char* sockName = wld_wpaCtrlConnection_getConnSockName(pConn);
+    wpaCtrlCmd_t* pCmd = calloc(1, sizeof(*pCmd));
+    ASSERT_NOT_NULL(pCmd, SWL_RC_ERROR, ME, "%s: fail to alloc cmd (%s)", sockName, cmd);
+    pCmd->pConn = pConn;
+    swl_str_copyMalloc(&pCmd->cmd, cmd);
+    pCmd->tmOutMSec = SWL_MAX(tmOutMSec, (uint32_t) DFLT_SYNC_CMD_TMOUT_MS);
+    pCmd->fDoneCb = fDoneCb;
+    pCmd->userData = userData;
+    amxp_timer_new(&pCmd->timer, s_cmdTimeoutCb, pCmd);
+
+    if((pConn->nrInFlightCmds >= pConn->maxInFlightCmds) ||
+       (amxc_llist_size(&pConn->cmdQueue) > pConn->nrInFlightCmds)) {
+        SAH_TRACEZ_INFO(ME, "%s: queue cmd (%s) behind %zu cmds", sockName, cmd, amxc_llist_size(&pConn->cmdQueue));
+        amxc_llist_append(&pConn->cmdQueue, &pCmd->it);
+    } else {
+        swl_rc_ne rc = s_sendRaw(pConn, cmd);
+        if(!swl_rc_isOk(rc)) {
+            s_freeCmd(pCmd);
+            return rc;
+        }
+        amxc_llist_append(&pConn->cmdQueue, &pCmd->it);
+        s_setCmdSent(pConn, pCmd);
+    }
+    if(ppCmd != NULL) {
+        *ppCmd = pCmd;
+    }
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief correlate a received reply to the oldest in-flight command
+ */
+static void s_processReply(wpaCtrlConnection_t* pConn, char* msgData, size_t msgLen) {
+    amxc_llist_it_t* it = amxc_llist_get_first(&pConn->cmdQueue);
+    wpaCtrlCmd_t* pCmd = (it != NULL) ? amxc_container_of(it, wpaCtrlCmd_t, it) : NULL;
+    if((pCmd == NULL) || (!pCmd->sent)) {
+        SAH_TRACEZ_INFO(ME, "%s: uncorrelated reply (%s)", wld_wpaCtrlConnection_getConnSockName(pConn), msgData);
+        s_deliverMsg(pConn, msgData, msgLen);
+        return;
+    }
+    amxc_llist_it_take(&pCmd->it);
+    pConn->nrInFlightCmds--;
+    if(swl_str_matches(pCmd->cmd, "ATTACH") || swl_str_matches(pCmd->cmd, "DETACH")) {
+        pConn->isAttached = (swl_str_matches(pCmd->cmd, "ATTACH") && swl_str_startsWith(msgData, "OK"));
+    }
+    if(pCmd->fDoneCb != NULL) {
+        /* remove systematic carriage return at end of buffer */
+        if((msgLen > 0) && (msgData[msgLen - 1] == '\n')) {
+            msgData[msgLen - 1] = '\0';
+        }
+        s_completeCmd(pCmd, SWL_RC_OK, msgData);
+    } else {
+        /* no completion handler: reply is forwarded as previously done for not synced commands */
+        s_deliverMsg(pConn, msgData, msgLen);
+    }
+    s_freeCmd(pCmd);
+    s_sendPendingCmds(pConn);
+}
+
+static void s_processMsg(wpaCtrlConnection_t* pConn, char* msgData, size_t msgLen) {
+    /* unsolicited message received over a command connection */
+    bool isEvt = (((msgLen > 0) && (msgData[0] == '<')) ||
+                  ((msgLen > 6) && (strncmp(msgData, "IFNAME=", 7) == 0)));
+    if(wld_wpaCtrl_isRecording()) {
+        wld_wpaCtrl_recordMsg(isEvt ? WLD_WPACTRL_TRACE_DIR_EVT : WLD_WPACTRL_TRACE_DIR_REPLY,
+                              wld_wpaCtrlConnection_getConnSockName(pConn), msgData, msgLen);
+    }
+    if(isEvt) {
+        s_deliverMsg(pConn, msgData, msgLen);
+        return;
+    }
+    s_processReply(pConn, msgData, msgLen);
+}
+
+static wpaCtrlConnection_t* s_getConnOfFd(int fd) {
+    amxo_connection_t* con = amxo_connection_get(get_wld_plugin_parser(), fd);
+    ASSERTS_NOT_NULL(con, NULL, ME, "con NULL");
+    return (wpaCtrlConnection_t*) con->priv;
+}
+
+static ssize_t s_recvMsgInBuf(wpaCtrlConnection_t* pConn, char* msgData, size_t msgDataSize) {
+    ssize_t msgDataLen = recv(pConn->wpaPeer, msgData, (msgDataSize - 1), MSG_DONTWAIT);
+    ASSERTS_FALSE(msgDataLen <= 0, msgDataLen, ME, "recv() failed (%d:%s)", errno, strerror(errno));
+    msgData[msgDataLen] = '\0';
+    pConn->rxStats.nrMsgs++;
+    SAH_TRACEZ_INFO(ME, "received data(%s) from (%s)", msgData, s_getConnSrvPath(pConn));
+    s_processMsg(pConn, msgData, msgDataLen);
+    return msgDataLen;
+}
+
+/*
+ * @brief (re)allocate the connection receive buffer, when missing or when max msg length has changed
+ */
+static bool s_prepareRxBuf(wpaCtrlConnection_t* pConn) {
+    size_t maxMsgLen = wld_wpaCtrl_getMaxMsgLen();
+    if((pConn->rxBuf != NULL) && (pConn->rxBufSize == maxMsgLen)) {
+        return true;
+    }
+    char* rxBuf = realloc(pConn->rxBuf, maxMsgLen);
+    ASSERT_NOT_NULL(rxBuf, false, ME, "%s: fail to alloc rx buffer of %zu bytes", wld_wpaCtrlConnection_getConnSockName(pConn), maxMsgLen);
+    pConn->rxBuf = rxBuf;
+    pConn->rxBufSize = maxMsgLen;
+    return true;
+}
+
+static ssize_t s_recvMsg(wpaCtrlConnection_t* pConn) {
+    int fd = pConn->wpaPeer;
+    if((pConn->rxBufBusy) || (!s_prepareRxBuf(pConn))) {
+        /* nested reception, while the rx buffer is still being processed */
+        size_t maxMsgLen = wld_wpaCtrl_getMaxMsgLen();
+        char msgData[maxMsgLen];
+        return s_recvMsgInBuf(pConn, msgData, sizeof(msgData));
+    }
+    pConn->rxBufBusy = true;
+    ssize_t ret = s_recvMsgInBuf(pConn, pConn->rxBuf, pConn->rxBufSize);
+    /* connection may have been closed or released by the message handler */
+    if(s_getConnOfFd(fd) == pConn) {
+        pConn->rxBufBusy = false;
+    }
+    return ret;
+}
+
 static void s_readCtrl(int fd, void* priv _UNUSED) {
     SAH_TRACEZ_IN(ME);
-    size_t maxMsgLen = wld_wpaCtrl_getMaxMsgLen();
-    char msgData[maxMsgLen];
-    memset(msgData, 0, sizeof(msgData));
-    ssize_t msgDataLen;
     ASSERTS_TRUE(fd > 0, , ME, "fd <= 0");
-
-    msgDataLen = recv(fd, msgData, (sizeof(msgData) - 1), MSG_DONTWAIT);
-    ASSERTS_FALSE(msgDataLen <= 0, , ME, "recv() failed (%d:%s)", errno, strerror(errno));
-    msgData[msgDataLen] = '\0';
-    amxo_connection_t* con = amxo_connection_get(get_wld_plugin_parser(), fd);
-    ASSERT_NOT_NULL(con, , ME, "con NULL");
-    wpaCtrlConnection_t* pConn = (wpaCtrlConnection_t*) con->priv;
+    wpaCtrlConnection_t* pConn = s_getConnOfFd(fd);
     ASSERT_NOT_NULL(pConn, , ME, "failed to get connection context of fd:%d", fd);
-    const char* srvPath = s_getConnSrvPath(pConn);
-    SAH_TRACEZ_INFO(ME, "received data(%s) from (%s)", msgData, srvPath);
-    ASSERTS_NOT_NULL(pConn, , ME, "NULL");
-    SWL_CALL(pConn->evtHdlrs.fReadDataCb, pConn->userData, msgData, msgDataLen);
+    pConn->rxStats.nrWakeups++;
+    /* drain pending messages, within a budget, to save loop wakeups on bursts */
+    uint32_t nrMsgs = 0;
+    while((nrMsgs < pConn->rxBurstBudget) && (s_recvMsg(pConn) > 0)) {
+        nrMsgs++;
+        ASSERTS_EQUALS(s_getConnOfFd(fd), pConn, , ME, "connection closed by msg handler");
+    }
+    pConn->rxStats.lastMsgsPerWakeup = nrMsgs;
+    pConn->rxStats.maxMsgsPerWakeup = SWL_MAX(pConn->rxStats.maxMsgsPerWakeup, nrMsgs);
+    if(nrMsgs >= pConn->rxBurstBudget) {
+        pConn->rxStats.nrBudgetExhausted++;
+    }
     SAH_TRACEZ_OUT(ME);
 }
 
-swl_rc_ne wld_wpaCtrlConnection_open(wpaCtrlConnection_t* pConn) {
-    ASSERT_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
-    ASSERTS_FALSE(pConn->wpaPeer > 0, SWL_RC_OK, ME, "already connected");
+swl_rc_ne wld_wpaCtrlConnection_getRxStats(wpaCtrlConnection_t* pConn, wld_wpaCtrl_rxStats_t* pStats) {
+    ASSERTS_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTS_NOT_NULL(pStats, SWL_RC_INVALID_PARAM, ME, "NULL");
+    *pStats = pConn->rxStats;
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief create the client socket, bound to the client path and connected to the server
+ *
+ * @return socket fd, or -1 on error
+ */
+static int s_openSock(wpaCtrlConnection_t* pConn) {
     int fd = socket(PF_UNIX, SOCK_DGRAM, 0);
-    ASSERT_FALSE(fd < 0, SWL_RC_ERROR, ME, "socket(PF_UNIX, SOCK_DGRAM, 0) failed");
+    ASSERT_FALSE(fd < 0, -1, ME, "socket(PF_UNIX, SOCK_DGRAM, 0) failed");
     fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
 
     int ret = bind(fd, (struct sockaddr*) &(pConn->clientAddr), sizeof(struct sockaddr_un));
@@ -221,13 +628,97 @@ swl_rc_ne wld_wpaCtrlConnection_open(wpaCtrlConnection_t* pConn) {
         ret = bind(fd, (struct sockaddr*) &(pConn->clientAddr), sizeof(struct sockaddr_un));
     }
     if((ret < 0) ||
-       (connect(fd, (struct sockaddr*) &(pConn->serverAddr), sizeof(struct sockaddr_un)) < 0) ||
-       (amxo_connection_add(get_wld_plugin_parser(), fd, s_readCtrl, "readCtrl", AMXO_CUSTOM, pConn) != 0)) {
+       (connect(fd, (struct sockaddr*) &(pConn->serverAddr), sizeof(struct sockaddr_un)) < 0)) {
         SAH_TRACEZ_INFO(ME, "failed to open connection (%s) to (%s) err:%d:%s",
                         s_getConnCliPath(pConn),
                         s_getConnSrvPath(pConn),
                         errno, strerror(errno));
         close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * @brief move the connection to a new client socket
+ * The fd number is kept, as it may still be referenced by callers
+ * waiting for a reply.
+ */
+static swl_rc_ne s_reopenSock(wpaCtrlConnection_t* pConn) {
+    int fd = pConn->wpaPeer;
+    ASSERTS_TRUE(fd > 0, SWL_RC_INVALID_STATE, ME, "fd <= 0");
+    amxo_connection_remove(get_wld_plugin_parser(), fd);
+    unlink(pConn->clientAddr.sun_path);
+    pConn->nrResyncs++;
+    s_setCliPath(pConn);
+    int newFd = s_openSock(pConn);
+    if((newFd < 0) || (dup2(newFd, fd) < 0) ||
+       (amxo_connection_add(get_wld_plugin_parser(), fd, s_readCtrl, "readCtrl", AMXO_CUSTOM, pConn) != 0)) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to reopen connection (%s)", wld_wpaCtrlConnection_getConnSockName(pConn), s_getConnCliPath(pConn));
+        if(newFd >= 0) {
+            close(newFd);
+            unlink(pConn->clientAddr.sun_path);
+        }
+        close(fd);
+        pConn->wpaPeer = 0;
+        return SWL_RC_ERROR;
+    }
+    close(newFd);
+    return SWL_RC_OK;
+}
+
+static void s_reattachDoneCb(void* userData, const char* cmd, swl_rc_ne rc, const char* reply) {
+    wpaCtrlConnection_t* pConn = (wpaCtrlConnection_t*) userData;
+    ASSERT_TRUE(swl_rc_isOk(rc) && swl_str_startsWith(reply, "OK"), , ME, "%s: fail to %s after resync",
+                wld_wpaCtrlConnection_getConnSockName(pConn), cmd);
+}
+
+/*
+ * @brief recover from a lost reply
+ * The commands already sent can not be correlated any more with the received replies:
+ * they are failed, and the connection moves to a new client socket, where the late
+ * replies can not be received. The queued commands are then sent over the new socket.
+ * An event connection is attached again.
+ */
+static void s_resyncConn(wpaCtrlConnection_t* pConn) {
+    ASSERTS_NOT_NULL(pConn, , ME, "NULL");
+    amxc_llist_t lostCmds;
+    amxc_llist_init(&lostCmds);
+    amxc_llist_it_t* it;
+    while((pConn->nrInFlightCmds > 0) && ((it = amxc_llist_take_first(&pConn->cmdQueue)) != NULL)) {
+        amxc_llist_append(&lostCmds, it);
+        pConn->nrInFlightCmds--;
+    }
+    pConn->nrInFlightCmds = 0;
+    SAH_TRACEZ_WARNING(ME, "%s: resync connection, failing %zu sent cmds",
+                       wld_wpaCtrlConnection_getConnSockName(pConn), amxc_llist_size(&lostCmds));
+    bool wasAttached = pConn->isAttached;
+    pConn->isAttached = false;
+    if(swl_rc_isOk(s_reopenSock(pConn))) {
+        if(wasAttached) {
+            s_queueCmd(pConn, "ATTACH", DFLT_SYNC_CMD_TMOUT_MS, s_reattachDoneCb, pConn, NULL);
+        }
+        s_sendPendingCmds(pConn);
+    } else {
+        wld_wpaCtrlConnection_close(pConn);
+    }
+    /* completion handlers called last, as they may release the connection */
+    while((it = amxc_llist_take_first(&lostCmds)) != NULL) {
+        wpaCtrlCmd_t* pCmd = amxc_container_of(it, wpaCtrlCmd_t, it);
+        s_completeCmd(pCmd, SWL_RC_NOT_AVAILABLE, NULL);
+        s_freeCmd(pCmd);
+    }
+}
+
+swl_rc_ne wld_wpaCtrlConnection_open(wpaCtrlConnection_t* pConn) {
+    ASSERT_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTS_FALSE(pConn->wpaPeer > 0, SWL_RC_OK, ME, "already connected");
+    int fd = s_openSock(pConn);
+    if((fd < 0) ||
+       (amxo_connection_add(get_wld_plugin_parser(), fd, s_readCtrl, "readCtrl", AMXO_CUSTOM, pConn) != 0)) {
+        if(fd >= 0) {
+            close(fd);
+        }
         wld_wpaCtrlConnection_close(pConn);
         return SWL_RC_ERROR;
     }
@@ -239,22 +730,56 @@ swl_rc_ne wld_wpaCtrlConnection_open(wpaCtrlConnection_t* pConn) {
     return SWL_RC_OK;
 }
 
+/*
+ * @brief send command without waiting for the reply
+ * The reply will be forwarded to the read data handler.
+ */
 swl_rc_ne wld_wpaCtrlConnection_sendCmd(wpaCtrlConnection_t* pConn, const char* cmd) {
-    ASSERTS_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
-    int fd = pConn->wpaPeer;
-    ASSERTS_TRUE(fd > 0, SWL_RC_INVALID_STATE, ME, "fd <= 0");
+    return s_queueCmd(pConn, cmd, DFLT_SYNC_CMD_TMOUT_MS, NULL, NULL, NULL);
+}
 
-    const char* srvPath = s_getConnSrvPath(pConn);
-    size_t len = strlen(cmd);
-    ssize_t ret = send(fd, cmd, len, 0);
-    SAH_TRACEZ_INFO(ME, "send cmd (%s) to (%s)", cmd, srvPath);
-    ASSERT_EQUALS(ret, (ssize_t) len, SWL_RC_ERROR, ME, "Failed to send cmd (%s) to (%s): ret(%d), err(%d:%s)",
-                  cmd, srvPath,
-                  (int32_t) ret, errno, strerror(errno));
+/*
+ * @brief queue a command, to be sent as soon as the number of in-flight commands allows it
+ *
+ * @param pConn connection over which the command is sent
+ * @param cmd command string
+ * @param tmOutMSec max delay to receive the reply, once the command is sent
+ * @param fDoneCb handler called with the reply, or with the error
+ * @param userData user data given back to the completion handler
+ *
+ * @return SWL_RC_OK when the command is sent or queued,
+ *         error code otherwise (the completion handler is then not called)
+ */
+swl_rc_ne wld_wpaCtrlConnection_sendCmdAsync(wpaCtrlConnection_t* pConn, const char* cmd, uint32_t tmOutMSec, wld_wpaCtrl_cmdDoneCb_f fDoneCb, void* userData) {
+    return s_queueCmd(pConn, cmd, tmOutMSec, fDoneCb, userData, NULL);
+}
 
+swl_rc_ne wld_wpaCtrlConnection_setMaxInFlightCmds(wpaCtrlConnection_t* pConn, uint32_t maxInFlightCmds) {
+    ASSERT_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_TRUE(maxInFlightCmds > 0, SWL_RC_INVALID_PARAM, ME, "null max in-flight cmds");
+    pConn->maxInFlightCmds = maxInFlightCmds;
+    s_sendPendingCmds(pConn);
     return SWL_RC_OK;
 }
 
+swl_rc_ne wld_wpaCtrlConnection_setRxBurstBudget(wpaCtrlConnection_t* pConn, uint32_t rxBurstBudget) {
+    ASSERT_NOT_NULL(pConn, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_TRUE(rxBurstBudget > 0, SWL_RC_INVALID_PARAM, ME, "null rx burst budget");
+    pConn->rxBurstBudget = rxBurstBudget;
+    return SWL_RC_OK;
+}
+
+uint32_t wld_wpaCtrlConnection_getNrPendingCmds(wpaCtrlConnection_t* pConn) {
+    ASSERTS_NOT_NULL(pConn, 0, ME, "NULL");
+    return amxc_llist_size(&pConn->cmdQueue);
+}
+
+/*
+ * @brief send command and block until its reply is received
+ * The command is queued behind the pending asynchronous commands, whose replies
+ * are processed while waiting. Unsolicited messages received meanwhile are
+ * delivered afterwards, from the main loop.
+ */
 swl_rc_ne wld_wpaCtrlConnection_sendCmdSyncedExt(wpaCtrlConnection_t* pConn, const char* cmd, char* reply, size_t replyLen, uint32_t tmOutMSec) {
     SAH_TRACEZ_IN(ME);
     ASSERT_NOT_NULL(reply, SWL_RC_INVALID_PARAM, ME, "empty reply buf");
@@ -265,51 +790,54 @@ swl_rc_ne wld_wpaCtrlConnection_sendCmdSyncedExt(wpaCtrlConnection_t* pConn, con
     int fd = pConn->wpaPeer;
     ASSERT_TRUE(fd > 0, SWL_RC_INVALID_STATE, ME, "%s: invalid fd for cmd (%s)", sockName, cmd);
 
-    struct timeval tv;
-    uint32_t tvMs = tmOutMSec;
-    int res;
-    fd_set rfds;
-
-    /* clear pending replies to avoid getting answer of timeouted request */
-    char dropBuf[replyLen];
-    while(recv(fd, dropBuf, replyLen, 0) > 0) {
-    }
-
-    swl_rc_ne rc = wld_wpaCtrlConnection_sendCmd(pConn, cmd);
+    wpaCtrlSyncReply_t syncReply = {.reply = reply, .replyLen = replyLen, .done = false, .rc = SWL_RC_NOT_AVAILABLE};
+    wpaCtrlCmd_t* pCmd = NULL;
+    swl_rc_ne rc = s_queueCmd(pConn, cmd, tmOutMSec, s_syncCmdDoneCb, &syncReply, &pCmd);
     ASSERT_TRUE(swl_rc_isOk(rc), rc, ME, "%s: fail to send sync cmd(%s)", sockName, cmd);
 
-    do {
-        tvMs = SWL_MAX(tvMs, (uint32_t) DFLT_SYNC_CMD_TMOUT_MS);
-        tv.tv_sec = (tvMs / 1000);
-        tv.tv_usec = ((tvMs % 1000) * 1000);
+    uint32_t tmOut = pCmd->tmOutMSec;
+    swl_timeSpecMono_t start = swl_timespec_getMonoVal();
+    pConn->syncWaitDepth++;
+    while(!syncReply.done) {
+        swl_timeSpecMono_t now = swl_timespec_getMonoVal();
+        int64_t elapsed = swl_timespec_diffToMillisec(&start, &now);
+        if(elapsed >= tmOut) {
+            break;
+        }
+        uint32_t tvMs = tmOut - elapsed;
+        struct timeval tv = {.tv_sec = (tvMs / 1000), .tv_usec = ((tvMs % 1000) * 1000)};
+        fd_set rfds;
         FD_ZERO(&rfds);
         FD_SET(fd, &rfds);
-        res = select(fd + 1, &rfds, NULL, NULL, &tv);
-        tvMs = (tv.tv_sec * 1000) + (tv.tv_usec / 1000);
+        int res = select(fd + 1, &rfds, NULL, NULL, &tv);
         if((res < 0) && (errno == EINTR)) {
             continue;
         }
-        ASSERT_FALSE(res < 0, SWL_RC_NOT_AVAILABLE, ME, "%s: select err(%d:%s)", sockName, errno, strerror(errno));
-        ASSERT_NOT_EQUALS(res, 0, SWL_RC_NOT_AVAILABLE, ME, "%s: cmd(%s) timed out", sockName, cmd);
-        ASSERT_NOT_EQUALS(FD_ISSET(fd, &rfds), 0, SWL_RC_NOT_AVAILABLE, ME, "%s: missing reply on fd(%d)", sockName, fd);
-        ssize_t nr = recv(fd, reply, replyLen, 0);
-        ASSERT_FALSE(nr < 0, SWL_RC_ERROR, ME, "%s: recv err(%d:%s)", sockName, errno, strerror(errno));
-        /* ignore reply when looking like a wpactrl event */
-        if(((nr > 0) && (reply[0] == '<')) ||
-           ((nr > 6) && ( strncmp(reply, "IFNAME=", 7) == 0))) {
-            continue;
+        if(res < 0) {
+            SAH_TRACEZ_ERROR(ME, "%s: select err(%d:%s)", sockName, errno, strerror(errno));
+            break;
         }
-        nr = SWL_MIN(nr, (ssize_t) replyLen - 1);
-        reply[nr] = '\0';
-        /* remove systematic carriage return at end of buffer */
-        if((nr > 0) && (reply[nr - 1] == '\n')) {
-            reply[nr - 1] = '\0';
+        if((res > 0) && FD_ISSET(fd, &rfds)) {
+            s_recvMsg(pConn);
+        }
+    }
+    pConn->syncWaitDepth--;
+
+    if(!syncReply.done) {
+        SAH_TRACEZ_ERROR(ME, "%s: cmd(%s) timed out", sockName, cmd);
+        /* detach the caller reply buffer from the pending command */
+        pCmd->fDoneCb = NULL;
+        pCmd->userData = NULL;
+        if(pCmd->sent) {
+            s_resyncConn(pConn);
+        } else {
+            s_freeCmd(pCmd);
         }
-        break;
-    } while(1);
+        return SWL_RC_NOT_AVAILABLE;
+    }
 
     SAH_TRACEZ_OUT(ME);
-    return SWL_RC_OK;
+    return syncReply.rc;
 }
 
 swl_rc_ne wld_wpaCtrlConnection_sendCmdSynced(wpaCtrlConnection_t* pConn, const char* cmd, char* reply, size_t replyLen) {
@@ -340,6 +868,149 @@ bool wld_wpaCtrl_checkSockPath(const char* sockPath) {
     return (access(sockPath, F_OK) == 0);
 }
 
+/*
+ * Pool of client connections reused for one-shot queries to wpa_ctrl sockets,
+ * keyed by (server path, socket name), and closed when idle.
+ */
+#define CONN_POOL_IDLE_TMOUT_MS 30000 // pooled connection closed when unused for this delay
+#define CONN_POOL_CHECK_IDLE_MS 5000  // pooled connection checked with PING when reused after this idle delay
+#define CONN_POOL_MAX_SIZE 16
+#define CONN_POOL_FIRST_CONN_ID 16    // client socket ids, after the ones of managed interfaces
+
+typedef struct {
+    amxc_llist_it_t it;
+    wpaCtrlConnection_t* pConn;
+    swl_timeSpecMono_t lastUse;
+} wpaCtrlPoolEntry_t;
+
+static amxc_llist_t sConnPool = {NULL, NULL}; // ordered from the least recently used
+static amxp_timer_t* sConnPoolTimer = NULL;
+static uint32_t sConnPoolNextId = CONN_POOL_FIRST_CONN_ID;
+static uint32_t sConnPoolIdleTmoutMs = CONN_POOL_IDLE_TMOUT_MS;
+
+static void s_dropPooledConn(wpaCtrlPoolEntry_t* pEntry) {
+    ASSERTS_NOT_NULL(pEntry, , ME, "NULL");
+    amxc_llist_it_take(&pEntry->it);
+    wld_wpaCtrlConnection_cleanup(&pEntry->pConn);
+    free(pEntry);
+}
+
+static void s_connPoolTimerCb(amxp_timer_t* timer _UNUSED, void* priv _UNUSED) {
+    swl_timeSpecMono_t now = swl_timespec_getMonoVal();
+    amxc_llist_for_each(it, &sConnPool) {
+        wpaCtrlPoolEntry_t* pEntry = amxc_container_of(it, wpaCtrlPoolEntry_t, it);
+        if(swl_timespec_diffToMillisec(&pEntry->lastUse, &now) >= sConnPoolIdleTmoutMs) {
+            SAH_TRACEZ_INFO(ME, "close idle pooled connection to (%s)", s_getConnSrvPath(pEntry->pConn));
+            s_dropPooledConn(pEntry);
+        }
+    }
+    if(!amxc_llist_is_empty(&sConnPool)) {
+        amxp_timer_start(sConnPoolTimer, sConnPoolIdleTmoutMs);
+    }
+}
+
+static wpaCtrlPoolEntry_t* s_findPooledConn(const char* serverPath, const char* sockName) {
+    amxc_llist_for_each(it, &sConnPool) {
+        wpaCtrlPoolEntry_t* pEntry = amxc_container_of(it, wpaCtrlPoolEntry_t, it);
+        if(swl_str_matches(pEntry->pConn->srvDirPath, serverPath) &&
+           swl_str_matches(wld_wpaCtrlConnection_getConnSockName(pEntry->pConn), sockName)) {
+            return pEntry;
+        }
+    }
+    return NULL;
+}
+
+static wpaCtrlPoolEntry_t* s_newPooledConn(const char* serverPath, const char* sockName) {
+    if(amxc_llist_size(&sConnPool) >= CONN_POOL_MAX_SIZE) {
+        amxc_llist_it_t* it = amxc_llist_get_first(&sConnPool);
+        s_dropPooledConn(amxc_container_of(it, wpaCtrlPoolEntry_t, it));
+    }
+    wpaCtrlPoolEntry_t* pEntry = calloc(1, sizeof(*pEntry));
+    ASSERT_NOT_NULL(pEntry, NULL, ME, "%s: fail to alloc pool entry", sockName);
+    if((!swl_rc_isOk(wld_wpaCtrlConnection_init(&pEntry->pConn, sConnPoolNextId++, serverPath, sockName))) ||
+       (!swl_rc_isOk(wld_wpaCtrlConnection_open(pEntry->pConn)))) {
+        s_dropPooledConn(pEntry);
+        return NULL;
+    }
+    pEntry->lastUse = swl_timespec_getMonoVal();
+    amxc_llist_append(&sConnPool, &pEntry->it);
+    if(sConnPoolTimer == NULL) {
+        amxp_timer_new(&sConnPoolTimer, s_connPoolTimerCb, NULL);
+    }
+    if(amxp_timer_get_state(sConnPoolTimer) != amxp_timer_running) {
+        amxp_timer_start(sConnPoolTimer, sConnPoolIdleTmoutMs);
+    }
+    return pEntry;
+}
+
+/*
+ * @brief get a connection from the pool, or open a new one
+ * A pooled connection unused for a while is first checked with PING
+ *
+ * @param pReused output flag, set when the connection was already in the pool
+ */
+static wpaCtrlPoolEntry_t* s_getPooledConn(const char* serverPath, const char* sockName, bool* pReused) {
+    *pReused = false;
+    wpaCtrlPoolEntry_t* pEntry = s_findPooledConn(serverPath, sockName);
+    if(pEntry != NULL) {
+        swl_timeSpecMono_t now = swl_timespec_getMonoVal();
+        if((swl_timespec_diffToMillisec(&pEntry->lastUse, &now) < CONN_POOL_CHECK_IDLE_MS) ||
+           (swl_rc_isOk(wld_wpaCtrlConnection_sendCmdCheckResponse(pEntry->pConn, "PING", "PONG")))) {
+            *pReused = true;
+            return pEntry;
+        }
+        SAH_TRACEZ_INFO(ME, "%s: drop stale pooled connection to (%s)", sockName, serverPath);
+        s_dropPooledConn(pEntry);
+    }
+    return s_newPooledConn(serverPath, sockName);
+}
+
+/*
+ * @brief close pooled connections to a server (eg. when the daemon is stopped/restarted)
+ *
+ * @param serverPath server directory path of connections to close, NULL or empty to close all
+ */
+void wld_wpaCtrl_flushConnPool(const char* serverPath) {
+    amxc_llist_for_each(it, &sConnPool) {
+        wpaCtrlPoolEntry_t* pEntry = amxc_container_of(it, wpaCtrlPoolEntry_t, it);
+        if(swl_str_isEmpty(serverPath) || swl_str_matches(pEntry->pConn->srvDirPath, serverPath)) {
+            s_dropPooledConn(pEntry);
+        }
+    }
+    if(amxc_llist_is_empty(&sConnPool)) {
+        amxp_timer_delete(&sConnPoolTimer);
+    }
+}
+
+/*
+ * @brief set the delay after which unused pooled connections are closed
+ */
+swl_rc_ne wld_wpaCtrl_setConnPoolIdleTmout(uint32_t idleTmoutMs) {
+    ASSERT_TRUE(idleTmoutMs > 0, SWL_RC_INVALID_PARAM, ME, "null idle timeout");
+    sConnPoolIdleTmoutMs = idleTmoutMs;
+    amxp_timer_state_t tmState = amxp_timer_get_state(sConnPoolTimer);
+    if((tmState == amxp_timer_started) || (tmState == amxp_timer_running)) {
+        amxp_timer_start(sConnPoolTimer, sConnPoolIdleTmoutMs);
+    }
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief count pooled connections to a server
+ *
+ * @param serverPath server directory path of connections to count, NULL or empty to count all
+ */
+uint32_t wld_wpaCtrl_getConnPoolSize(const char* serverPath) {
+    uint32_t count = 0;
+    amxc_llist_for_each(it, &sConnPool) {
+        wpaCtrlPoolEntry_t* pEntry = amxc_container_of(it, wpaCtrlPoolEntry_t, it);
+        if(swl_str_isEmpty(serverPath) || swl_str_matches(pEntry->pConn->srvDirPath, serverPath)) {
+            count++;
+        }
+    }
+    return count;
+}
+
 swl_rc_ne wld_wpaCtrl_queryToSock(const char* serverPath, const char* sockName, const char* cmd, char* reply, size_t replyLen) {
     swl_str_copy(reply, replyLen, NULL);
     char sockPath[swl_str_len(serverPath) + swl_str_len(sockName) + 2];
@@ -347,13 +1018,23 @@ swl_rc_ne wld_wpaCtrl_queryToSock(const char* serverPath, const char* sockName,
     swl_str_cat(sockPath, sizeof(sockPath), "/");
     swl_str_cat(sockPath, sizeof(sockPath), sockName);
     ASSERT_TRUE(wld_wpaCtrl_checkSockPath(sockPath), SWL_RC_INVALID_PARAM, ME, "wrong socket path (%s)", sockPath);
-    wpaCtrlConnection_t* pConn = NULL;
-    swl_rc_ne rc;
-    if(((rc = wld_wpaCtrlConnection_init(&pConn, -1, serverPath, sockName)) >= SWL_RC_OK) &&
-       ((rc = wld_wpaCtrlConnection_open(pConn)) >= SWL_RC_OK)) {
-        rc = wld_wpaCtrlConnection_sendCmdSynced(pConn, cmd, reply, replyLen);
+    bool reused = false;
+    wpaCtrlPoolEntry_t* pEntry = s_getPooledConn(serverPath, sockName, &reused);
+    ASSERT_NOT_NULL(pEntry, SWL_RC_ERROR, ME, "fail to connect to (%s)", sockPath);
+    swl_rc_ne rc = wld_wpaCtrlConnection_sendCmdSynced(pEntry->pConn, cmd, reply, replyLen);
+    if((!swl_rc_isOk(rc)) && (rc != SWL_RC_NOT_AVAILABLE) && (reused)) {
+        /* command not sent: server socket may have been re-created, so retry over a new connection */
+        SAH_TRACEZ_INFO(ME, "retry query (%s) to (%s) over new connection", cmd, sockPath);
+        s_dropPooledConn(pEntry);
+        pEntry = s_newPooledConn(serverPath, sockName);
+        ASSERT_NOT_NULL(pEntry, SWL_RC_ERROR, ME, "fail to reconnect to (%s)", sockPath);
+        rc = wld_wpaCtrlConnection_sendCmdSynced(pEntry->pConn, cmd, reply, replyLen);
+    }
+    if(!swl_rc_isOk(rc)) {
+        s_dropPooledConn(pEntry);
+        return rc;
     }
-    wld_wpaCtrlConnection_cleanup(&pConn);
+    pEntry->lastUse = swl_timespec_getMonoVal();
+    amxc_llist_append(&sConnPool, &pEntry->it);
     return rc;
 }
-
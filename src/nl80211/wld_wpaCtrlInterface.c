@@ -76,6 +76,8 @@ typedef enum {
     WPA_CONNECTION_MAX
 } wld_wpaCtrlConnectionType_e;
 
+static void s_checkSnapshotCmd(wld_wpaCtrlInterface_t* pIface, const char* cmd);
+
 /**
  * @brief send command to wap_ctrl server
  *
@@ -87,9 +89,182 @@ typedef enum {
  */
 bool wld_wpaCtrl_sendCmd(wld_wpaCtrlInterface_t* pIface, const char* cmd) {
     ASSERTS_NOT_NULL(pIface, false, ME, "NULL");
+    s_checkSnapshotCmd(pIface, cmd);
     return swl_rc_isOk(wld_wpaCtrlConnection_sendCmd(pIface->cmdConn, cmd));
 }
 
+/**
+ * @brief send command to wpa_ctrl server without blocking,
+ * the reply being provided to the completion handler
+ *
+ * @param pIface :the wpa_ctrl interface to which the command is sent
+ * @param cmd : string command to be sent
+ * @param tmOutMSec : max delay to get the reply, once the command is sent
+ * @param fDoneCb : handler called with the reply, or with the failure reason
+ * @param userData : user data given back to the completion handler
+ *
+ * @return SWL_RC_OK if the command is sent or queued, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_sendCmdAsync(wld_wpaCtrlInterface_t* pIface, const char* cmd, uint32_t tmOutMSec, wld_wpaCtrl_cmdDoneCb_f fDoneCb, void* userData) {
+    ASSERTS_NOT_NULL(pIface, SWL_RC_INVALID_PARAM, ME, "NULL");
+    s_checkSnapshotCmd(pIface, cmd);
+    return wld_wpaCtrlConnection_sendCmdAsync(pIface->cmdConn, cmd, tmOutMSec, fDoneCb, userData);
+}
+
+struct wld_wpaCtrl_cmdBatch {
+    char* ifName;
+    uint32_t nrCmds;
+    uint32_t nrPending;
+    uint32_t nrFailed;
+    uint32_t nrDropped; // not answered, as the connection was closed
+    bool closed;        // no more commands can be added
+    wld_wpaCtrl_cmdBatchDoneCb_f fDoneCb;
+    void* userData;
+};
+
+typedef struct {
+    wld_wpaCtrl_cmdBatch_t* pBatch;
+    char* expectedResponse;
+} wpaCtrlBatchCmd_t;
+
+static void s_checkCmdBatchDone(wld_wpaCtrl_cmdBatch_t* pBatch) {
+    ASSERTS_TRUE(pBatch->closed, , ME, "batch still open");
+    ASSERTS_EQUALS(pBatch->nrPending, 0, , ME, "%s: %u cmds pending", pBatch->ifName, pBatch->nrPending);
+    SAH_TRACEZ_INFO(ME, "%s: batch done: %u cmds, %u failed, %u dropped", pBatch->ifName, pBatch->nrCmds, pBatch->nrFailed, pBatch->nrDropped);
+    SWL_CALL(pBatch->fDoneCb, pBatch->userData, pBatch->ifName, pBatch->nrCmds, pBatch->nrFailed);
+    free(pBatch->ifName);
+    free(pBatch);
+}
+
+static void s_batchCmdDoneCb(void* userData, const char* cmd, swl_rc_ne rc, const char* reply) {
+    wpaCtrlBatchCmd_t* pBatchCmd = (wpaCtrlBatchCmd_t*) userData;
+    ASSERTS_NOT_NULL(pBatchCmd, , ME, "NULL");
+    wld_wpaCtrl_cmdBatch_t* pBatch = pBatchCmd->pBatch;
+    if(rc == SWL_RC_INVALID_STATE) {
+        /* connection closed (eg. daemon stopped): not a rejection of the command */
+        SAH_TRACEZ_INFO(ME, "%s: batched cmd(%s) dropped", pBatch->ifName, cmd);
+        pBatch->nrDropped++;
+    } else if(!swl_rc_isOk(rc) || !swl_str_matches(reply, pBatchCmd->expectedResponse)) {
+        SAH_TRACEZ_ERROR(ME, "%s: batched cmd(%s) reply(%s): unmatch expect(%s) (rc:%d)",
+                         pBatch->ifName, cmd, (reply ? reply : ""), pBatchCmd->expectedResponse, rc);
+        pBatch->nrFailed++;
+    }
+    free(pBatchCmd->expectedResponse);
+    free(pBatchCmd);
+    pBatch->nrPending--;
+    s_checkCmdBatchDone(pBatch);
+}
+
+/*
+ * @brief detach the open batch from the interface, without reporting its result
+ */
+static void s_dropCmdBatch(wld_wpaCtrlInterface_t* pIface) {
+    wld_wpaCtrl_cmdBatch_t* pBatch = pIface->cmdBatch;
+    ASSERTS_NOT_NULL(pBatch, , ME, "no batch");
+    pIface->cmdBatch = NULL;
+    pBatch->closed = true;
+    pBatch->fDoneCb = NULL;
+    s_checkCmdBatchDone(pBatch);
+}
+
+/**
+ * @brief open a batch of commands on the wpa_ctrl interface
+ * Until the batch is ended, commands added with wld_wpaCtrl_batchCmdCheckResponse
+ * are pipelined over the command connection, without waiting for their replies.
+ *
+ * @param pIface :the wpa_ctrl interface
+ *
+ * @return SWL_RC_OK if the batch is open, SWL_RC_INVALID_STATE if a batch is already open
+ */
+swl_rc_ne wld_wpaCtrl_startCmdBatch(wld_wpaCtrlInterface_t* pIface) {
+    ASSERTS_NOT_NULL(pIface, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NULL(pIface->cmdBatch, SWL_RC_INVALID_STATE, ME, "%s: batch already open", pIface->name);
+    wld_wpaCtrl_cmdBatch_t* pBatch = calloc(1, sizeof(*pBatch));
+    ASSERT_NOT_NULL(pBatch, SWL_RC_ERROR, ME, "%s: fail to alloc batch", pIface->name);
+    swl_str_copyMalloc(&pBatch->ifName, pIface->name);
+    pIface->cmdBatch = pBatch;
+    return SWL_RC_OK;
+}
+
+bool wld_wpaCtrl_isCmdBatchOpen(const wld_wpaCtrlInterface_t* pIface) {
+    ASSERTS_NOT_NULL(pIface, false, ME, "NULL");
+    return (pIface->cmdBatch != NULL);
+}
+
+/**
+ * @brief add a command to the open batch, its reply being checked once received
+ * Without open batch, the command is sent synchronously.
+ *
+ * @param pIface :the wpa_ctrl interface to which the command is sent
+ * @param cmd : string command to be sent
+ * @param expectedResponse : string expected reply
+ *
+ * @return SWL_RC_OK if the command is sent or queued (or answered as expected when no batch is open),
+ *         error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_batchCmdCheckResponse(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* expectedResponse) {
+    ASSERTS_NOT_NULL(pIface, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_STR(cmd, SWL_RC_INVALID_PARAM, ME, "%s: empty cmd", pIface->name);
+    s_checkSnapshotCmd(pIface, cmd);
+    wld_wpaCtrl_cmdBatch_t* pBatch = pIface->cmdBatch;
+    if(pBatch == NULL) {
+        return wld_wpaCtrlConnection_sendCmdCheckResponse(pIface->cmdConn, (char*) cmd, (char*) expectedResponse);
+    }
+    wpaCtrlBatchCmd_t* pBatchCmd = calloc(1, sizeof(*pBatchCmd));
+    ASSERT_NOT_NULL(pBatchCmd, SWL_RC_ERROR, ME, "%s: fail to alloc batch cmd", pIface->name);
+    pBatchCmd->pBatch = pBatch;
+    swl_str_copyMalloc(&pBatchCmd->expectedResponse, expectedResponse);
+    pBatch->nrCmds++;
+    swl_rc_ne rc = wld_wpaCtrlConnection_sendCmdAsync(pIface->cmdConn, cmd, 0, s_batchCmdDoneCb, pBatchCmd);
+    if(!swl_rc_isOk(rc)) {
+        SAH_TRACEZ_ERROR(ME, "%s: fail to send batched cmd(%s)", pIface->name, cmd);
+        pBatch->nrFailed++;
+        free(pBatchCmd->expectedResponse);
+        free(pBatchCmd);
+        return rc;
+    }
+    pBatch->nrPending++;
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief close the open batch: the result is reported once all replies are received
+ * The handler is called immediately when no more reply is pending.
+ *
+ * @param pIface :the wpa_ctrl interface
+ * @param fDoneCb : handler called with the batch result
+ * @param userData : user data given back to the handler
+ *
+ * @return SWL_RC_OK if the batch is closed, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_endCmdBatch(wld_wpaCtrlInterface_t* pIface, wld_wpaCtrl_cmdBatchDoneCb_f fDoneCb, void* userData) {
+    ASSERTS_NOT_NULL(pIface, SWL_RC_INVALID_PARAM, ME, "NULL");
+    wld_wpaCtrl_cmdBatch_t* pBatch = pIface->cmdBatch;
+    ASSERT_NOT_NULL(pBatch, SWL_RC_INVALID_STATE, ME, "%s: no open batch", pIface->name);
+    pIface->cmdBatch = NULL;
+    pBatch->closed = true;
+    pBatch->fDoneCb = fDoneCb;
+    pBatch->userData = userData;
+    SAH_TRACEZ_INFO(ME, "%s: batch closed: %u cmds, %u pending", pBatch->ifName, pBatch->nrCmds, pBatch->nrPending);
+    s_checkCmdBatchDone(pBatch);
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief wait until all commands already queued on the interface are answered,
+ * so that commands sent later over other interfaces are handled after them
+ *
+ * @param pIface :the wpa_ctrl interface
+ *
+ * @return SWL_RC_OK if no command is pending anymore, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_waitPendingCmds(wld_wpaCtrlInterface_t* pIface) {
+    ASSERTS_NOT_NULL(pIface, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTS_TRUE(wld_wpaCtrlConnection_getNrPendingCmds(pIface->cmdConn) > 0, SWL_RC_OK, ME, "no pending cmd");
+    /* replies are received in order: the one of PING comes after all pending ones */
+    return wld_wpaCtrlConnection_sendCmdCheckResponse(pIface->cmdConn, "PING", "PONG");
+}
+
 /**
  * @brief send command to wpa_ctrl server and wait for the reply
  *
@@ -102,53 +277,274 @@ bool wld_wpaCtrl_sendCmd(wld_wpaCtrlInterface_t* pIface, const char* cmd) {
  */
 bool wld_wpaCtrl_sendCmdSynced(wld_wpaCtrlInterface_t* pIface, const char* cmd, char* reply, size_t reply_len) {
     ASSERTS_NOT_NULL(pIface, false, ME, "NULL");
+    s_checkSnapshotCmd(pIface, cmd);
     return swl_rc_isOk(wld_wpaCtrlConnection_sendCmdSynced(pIface->cmdConn, cmd, reply, reply_len));
 }
 
+#define SNAPSHOT_REFRESH_TMOUT_MS 1000
+
+static const char* sSnapshotCmds[WLD_WPACTRL_SNAPSHOT_MAX] = {
+    [WLD_WPACTRL_SNAPSHOT_STATUS] = "STATUS",
+    [WLD_WPACTRL_SNAPSHOT_GET_CONFIG] = "GET_CONFIG",
+};
+
+typedef struct {
+    const char* evtPrefix; // matched against the event name following the "<3>" level tag
+    bool radioWide;        // stale for all interfaces of the manager, and refreshed right away
+} wpaCtrlSnapshotEvt_t;
+
+/*
+ * Events making the snapshots stale.
+ * Radio wide events refresh the receiving interface snapshots right away,
+ * the other ones are refreshed when next read.
+ */
+static const wpaCtrlSnapshotEvt_t sSnapshotEvts[] = {
+    {"AP-ENABLED", true},
+    {"AP-DISABLED", true},
+    {"INTERFACE-ENABLED", true},
+    {"INTERFACE-DISABLED", true},
+    {"CTRL-EVENT-STARTED-CHANNEL-SWITCH", true},
+    {"CTRL-EVENT-CHANNEL-SWITCH", true},
+    {"AP-CSA-FINISHED", true},
+    {"DFS-", true},
+    {"ACS-", true},
+    {"AP-STA-CONNECTED", false},
+    {"AP-STA-DISCONNECTED", false},
+};
+
+/*
+ * Commands sent by wld that change the snapshot contents (config, state, channel):
+ * snapshots of all interfaces of the manager are made stale as soon as sent,
+ * and are fetched again when next read.
+ */
+static const char* sSnapshotMutatingCmds[] = {
+    "SET ",
+    "RELOAD",
+    "UPDATE_BEACON",
+    "ENABLE",
+    "DISABLE",
+    "CHAN_SWITCH",
+    "STOP_AP",
+};
+
+static int32_t s_getSnapshotId(const char* cmd) {
+    for(int32_t i = 0; i < WLD_WPACTRL_SNAPSHOT_MAX; i++) {
+        if(swl_str_matches(sSnapshotCmds[i], cmd)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void s_setSnapshot(wld_wpaCtrl_cmdSnapshot_t* pSnap, const char* reply) {
+    swl_str_copyMalloc(&pSnap->reply, reply);
+    /* split once, to serve all next reads of the kept reply */
+    if(pSnap->pPairs == NULL) {
+        pSnap->pPairs = calloc(1, sizeof(*pSnap->pPairs));
+    }
+    if(pSnap->pPairs != NULL) {
+        wld_wpaCtrl_reply_parse(pSnap->pPairs, pSnap->reply);
+    }
+    pSnap->updateTime = swl_timespec_getMonoVal();
+    pSnap->valid = true;
+    pSnap->gen++;
+}
+
+static void s_invalidateSnapshots(wld_wpaCtrlInterface_t* pIface) {
+    for(uint32_t i = 0; i < WLD_WPACTRL_SNAPSHOT_MAX; i++) {
+        pIface->snapshots[i].valid = false;
+        pIface->snapshots[i].gen++;
+    }
+}
+
+static void s_invalidateMgrSnapshots(wld_wpaCtrlInterface_t* pIface) {
+    uint32_t nIfaces = wld_wpaCtrlMngr_countInterfaces(pIface->pMgr);
+    for(uint32_t i = 0; i < nIfaces; i++) {
+        wld_wpaCtrlInterface_t* pMgrIface = wld_wpaCtrlMngr_getInterface(pIface->pMgr, i);
+        if(pMgrIface != NULL) {
+            s_invalidateSnapshots(pMgrIface);
+        }
+    }
+    s_invalidateSnapshots(pIface);
+}
+
+static void s_checkSnapshotCmd(wld_wpaCtrlInterface_t* pIface, const char* cmd) {
+    ASSERTS_STR(cmd, , ME, "empty cmd");
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sSnapshotMutatingCmds); i++) {
+        if(swl_str_startsWith(cmd, sSnapshotMutatingCmds[i])) {
+            SAH_TRACEZ_INFO(ME, "%s: cmd (%s) makes snapshots stale", pIface->name, cmd);
+            s_invalidateMgrSnapshots(pIface);
+            return;
+        }
+    }
+}
+
+static void s_clearSnapshots(wld_wpaCtrlInterface_t* pIface) {
+    s_invalidateSnapshots(pIface);
+    for(uint32_t i = 0; i < WLD_WPACTRL_SNAPSHOT_MAX; i++) {
+        W_SWL_FREE(pIface->snapshots[i].reply);
+        W_SWL_FREE(pIface->snapshots[i].pPairs);
+    }
+}
+
+static bool s_isSnapshotFresh(const wld_wpaCtrl_cmdSnapshot_t* pSnap, uint32_t maxAgeMs) {
+    ASSERTS_TRUE(pSnap->valid, false, ME, "stale");
+    ASSERTS_NOT_NULL(pSnap->reply, false, ME, "empty");
+    ASSERTS_NOT_NULL(pSnap->pPairs, false, ME, "not parsed");
+    ASSERTS_NOT_EQUALS(maxAgeMs, 0, false, ME, "fresh reply required");
+    if(maxAgeMs == WLD_WPACTRL_MAX_AGE_UNLIMITED) {
+        return true;
+    }
+    swl_timeSpecMono_t now = swl_timespec_getMonoVal();
+    return (swl_timespec_diffToMillisec(&pSnap->updateTime, &now) <= (int64_t) maxAgeMs);
+}
+
+static void s_snapshotRefreshDoneCb(void* userData, const char* cmd, swl_rc_ne rc, const char* reply) {
+    wld_wpaCtrlInterface_t* pIface = (wld_wpaCtrlInterface_t*) userData;
+    int32_t id = s_getSnapshotId(cmd);
+    ASSERT_TRUE(id >= 0, , ME, "%s: unexpected cmd (%s)", pIface->name, cmd);
+    wld_wpaCtrl_cmdSnapshot_t* pSnap = &pIface->snapshots[id];
+    pSnap->refreshing = false;
+    ASSERTI_TRUE(swl_rc_isOk(rc), , ME, "%s: fail to refresh %s snapshot (%d)", pIface->name, cmd, rc);
+    if(pSnap->refreshGen != pSnap->gen) {
+        /* reply may predate the last invalidation, or be older than a sync update */
+        SAH_TRACEZ_INFO(ME, "%s: discard outdated %s snapshot", pIface->name, cmd);
+        if(!pSnap->valid) {
+            wld_wpaCtrl_refreshCmdSnapshot(pIface, cmd);
+        }
+        return;
+    }
+    s_setSnapshot(pSnap, reply);
+}
+
 /**
- * @brief send synchronous command to wpa_ctrl server and check a parameter value in the reply
+ * @brief refresh, without blocking, the kept reply of a snapshot command (STATUS, GET_CONFIG)
+ *
+ * @param pIface :the wpa_ctrl interface to which the command is sent
+ * @param cmd : snapshot command
+ *
+ * @return SWL_RC_OK if the refresh is requested or already pending, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_refreshCmdSnapshot(wld_wpaCtrlInterface_t* pIface, const char* cmd) {
+    ASSERTS_NOT_NULL(pIface, SWL_RC_INVALID_PARAM, ME, "NULL");
+    int32_t id = s_getSnapshotId(cmd);
+    ASSERT_TRUE(id >= 0, SWL_RC_INVALID_PARAM, ME, "%s: cmd (%s) has no snapshot", pIface->name, cmd);
+    ASSERTS_TRUE(pIface->isReady, SWL_RC_INVALID_STATE, ME, "%s: not ready", pIface->name);
+    wld_wpaCtrl_cmdSnapshot_t* pSnap = &pIface->snapshots[id];
+    ASSERTS_FALSE(pSnap->refreshing, SWL_RC_OK, ME, "%s: %s refresh pending", pIface->name, cmd);
+    pSnap->refreshGen = pSnap->gen;
+    swl_rc_ne rc = wld_wpaCtrl_sendCmdAsync(pIface, cmd, SNAPSHOT_REFRESH_TMOUT_MS, s_snapshotRefreshDoneCb, pIface);
+    ASSERT_TRUE(swl_rc_isOk(rc), rc, ME, "%s: fail to send %s", pIface->name, cmd);
+    pSnap->refreshing = true;
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief mark all kept command replies as stale: next reads will fetch them again
+ *
+ * @param pIface :the wpa_ctrl interface
+ */
+void wld_wpaCtrl_invalidateCmdSnapshots(wld_wpaCtrlInterface_t* pIface) {
+    ASSERTS_NOT_NULL(pIface, , ME, "NULL");
+    s_invalidateSnapshots(pIface);
+}
+
+/**
+ * @brief invalidate (and refresh) the kept command replies, when receiving an event
+ * reporting a change of their content (state, channel, ...)
+ *
+ * @param pIface :the wpa_ctrl interface receiving the event
+ * @param msgData : the received event
+ */
+void wld_wpaCtrlInterface_checkSnapshotEvt(wld_wpaCtrlInterface_t* pIface, const char* msgData) {
+    ASSERTS_NOT_NULL(pIface, , ME, "NULL");
+    const char* pEvtName = strstr(msgData, WPA_MSG_LEVEL_INFO);
+    ASSERTS_NOT_NULL(pEvtName, , ME, "no level tag");
+    pEvtName += strlen(WPA_MSG_LEVEL_INFO);
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sSnapshotEvts); i++) {
+        if(!swl_str_startsWith(pEvtName, sSnapshotEvts[i].evtPrefix)) {
+            continue;
+        }
+        if(!sSnapshotEvts[i].radioWide) {
+            s_invalidateSnapshots(pIface);
+            return;
+        }
+        s_invalidateMgrSnapshots(pIface);
+        for(uint32_t j = 0; j < WLD_WPACTRL_SNAPSHOT_MAX; j++) {
+            if(pIface->snapshots[j].reply != NULL) {
+                wld_wpaCtrl_refreshCmdSnapshot(pIface, sSnapshotCmds[j]);
+            }
+        }
+        return;
+    }
+}
+
+static swl_rc_ne s_getReplyParamVal(wld_wpaCtrlInterface_t* pIface, const wld_wpaCtrl_reply_t* pReplyPairs, const char* key, char* valStr, size_t valStrSize) {
+    int valStrLen = wld_wpaCtrl_reply_getValueStr(pReplyPairs, key, valStr, valStrSize);
+    ASSERT_FALSE(valStrLen <= 0, SWL_RC_ERROR, ME, "%s: not found status field %s", pIface->name, key);
+    SAH_TRACEZ_INFO(ME, "%s: %s = (%s)", pIface->name, key, valStr);
+    ASSERT_TRUE(valStrLen < (int) valStrSize, SWL_RC_ERROR,
+                ME, "%s: buffer too short for field %s (l:%d,s:%zu)", pIface->name, key, valStrLen, valStrSize);
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief get a parameter value in the reply of a command, served from the kept reply
+ * when it is not older than the provided max age, and not made stale by an event.
+ * Otherwise, the command is sent synchronously and its reply kept for next reads.
+ * Only STATUS and GET_CONFIG replies are kept, other commands are always sent.
  *
  * @param pIface :the wpa_ctrl interface to which the command is sent
  * @param cmd : string command to be sent
  * @param key : parameter name to be fetched in the reply (key=value)
+ * @param maxAgeMs : max age of the kept reply, in milliseconds
+ *                   (0 to always send the command, WLD_WPACTRL_MAX_AGE_UNLIMITED to accept any valid reply)
  * @param valStr : buffer where to store the parameter value
  * @param valStrSize : max length of parameter value
  *
- * @return true if the command is answered, false otherwise
+ * @return SWL_RC_OK if the parameter is found, error code otherwise
  */
-swl_rc_ne wld_wpaCtrl_getSyncCmdParamVal(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, char* valStr, size_t valStrSize) {
+swl_rc_ne wld_wpaCtrl_getCachedCmdParamVal(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, uint32_t maxAgeMs, char* valStr, size_t valStrSize) {
     ASSERT_NOT_NULL(pIface, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERT_STR(key, SWL_RC_INVALID_PARAM, ME, "No key");
+    int32_t id = s_getSnapshotId(cmd);
+    wld_wpaCtrl_cmdSnapshot_t* pSnap = (id >= 0) ? &pIface->snapshots[id] : NULL;
+    if((pSnap != NULL) && (pIface->isReady) && (s_isSnapshotFresh(pSnap, maxAgeMs))) {
+        return s_getReplyParamVal(pIface, pSnap->pPairs, key, valStr, valStrSize);
+    }
     size_t maxMsgLen = wld_wpaCtrl_getMaxMsgLen();
     char reply[maxMsgLen];
     memset(reply, 0, sizeof(reply));
     bool ret = wld_wpaCtrl_sendCmdSynced(pIface, cmd, reply, sizeof(reply));
     ASSERT_TRUE(ret, SWL_RC_ERROR, ME, "failed to get cmd(%s) reply", cmd);
-    int valStrLen = wld_wpaCtrl_getValueStr(reply, key, valStr, valStrSize);
-    ASSERT_FALSE(valStrLen <= 0, SWL_RC_ERROR, ME, "%s: not found status field %s", pIface->name, key);
-    SAH_TRACEZ_INFO(ME, "%s: %s = (%s)", pIface->name, key, valStr);
-    ASSERT_TRUE(valStrLen < (int) valStrSize, SWL_RC_ERROR,
-                ME, "%s: buffer too short for field %s (l:%d,s:%zu)", pIface->name, key, valStrLen, valStrSize);
-    return SWL_RC_OK;
+    if(pSnap != NULL) {
+        s_setSnapshot(pSnap, reply);
+        if(pSnap->pPairs != NULL) {
+            return s_getReplyParamVal(pIface, pSnap->pPairs, key, valStr, valStrSize);
+        }
+    }
+    wld_wpaCtrl_reply_t replyPairs;
+    wld_wpaCtrl_reply_parse(&replyPairs, reply);
+    return s_getReplyParamVal(pIface, &replyPairs, key, valStr, valStrSize);
 }
 
 /**
- * @brief send synchronous command to wpa_ctrl server
- * and convert a parameter value in the reply (string in base 10) to int32
- * or return default value
+ * @brief get a parameter value in the reply of a command, converted to int32 (string in base 10),
+ * served from the kept reply when fresh enough (see wld_wpaCtrl_getCachedCmdParamVal)
  *
  * @param pIface :the wpa_ctrl interface to which the command is sent
  * @param cmd : string command to be sent
  * @param key : parameter name to be fetched in the reply (key=value)
+ * @param maxAgeMs : max age of the kept reply, in milliseconds
  * @param pRetVal: pointer to resulting int value
  * @param defVal : default value returned on failure
  *
- * @return converted int32 value or defVal on failure
+ * @return SWL_RC_OK if the parameter is found and converted, error code otherwise
  */
-swl_rc_ne wld_wpaCtrl_getSyncCmdParamValInt32Def(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, int32_t* pRetVal, int32_t defVal) {
+swl_rc_ne wld_wpaCtrl_getCachedCmdParamValInt32Def(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, uint32_t maxAgeMs, int32_t* pRetVal, int32_t defVal) {
     char valStr[32] = {0};
     W_SWL_SETPTR(pRetVal, defVal);
-    swl_rc_ne rc = wld_wpaCtrl_getSyncCmdParamVal(pIface, cmd, key, valStr, sizeof(valStr));
+    swl_rc_ne rc = wld_wpaCtrl_getCachedCmdParamVal(pIface, cmd, key, maxAgeMs, valStr, sizeof(valStr));
     ASSERTS_TRUE(swl_rc_isOk(rc), rc, ME, "Not found");
     ASSERTS_STR(valStr, SWL_RC_NOT_AVAILABLE, ME, "Empty");
     int32_t valInt = defVal;
@@ -158,6 +554,38 @@ swl_rc_ne wld_wpaCtrl_getSyncCmdParamValInt32Def(wld_wpaCtrlInterface_t* pIface,
     return SWL_RC_OK;
 }
 
+/**
+ * @brief send synchronous command to wpa_ctrl server and check a parameter value in the reply
+ *
+ * @param pIface :the wpa_ctrl interface to which the command is sent
+ * @param cmd : string command to be sent
+ * @param key : parameter name to be fetched in the reply (key=value)
+ * @param valStr : buffer where to store the parameter value
+ * @param valStrSize : max length of parameter value
+ *
+ * @return true if the command is answered, false otherwise
+ */
+swl_rc_ne wld_wpaCtrl_getSyncCmdParamVal(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, char* valStr, size_t valStrSize) {
+    return wld_wpaCtrl_getCachedCmdParamVal(pIface, cmd, key, 0, valStr, valStrSize);
+}
+
+/**
+ * @brief send synchronous command to wpa_ctrl server
+ * and convert a parameter value in the reply (string in base 10) to int32
+ * or return default value
+ *
+ * @param pIface :the wpa_ctrl interface to which the command is sent
+ * @param cmd : string command to be sent
+ * @param key : parameter name to be fetched in the reply (key=value)
+ * @param pRetVal: pointer to resulting int value
+ * @param defVal : default value returned on failure
+ *
+ * @return converted int32 value or defVal on failure
+ */
+swl_rc_ne wld_wpaCtrl_getSyncCmdParamValInt32Def(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, int32_t* pRetVal, int32_t defVal) {
+    return wld_wpaCtrl_getCachedCmdParamValInt32Def(pIface, cmd, key, 0, pRetVal, defVal);
+}
+
 /**
  * @brief send synchronous command to wpa_ctrl server and check the received reply
  * within a defined delay
@@ -171,6 +599,7 @@ swl_rc_ne wld_wpaCtrl_getSyncCmdParamValInt32Def(wld_wpaCtrlInterface_t* pIface,
  */
 bool wld_wpaCtrl_sendCmdCheckResponseExt(wld_wpaCtrlInterface_t* pIface, char* cmd, char* expectedResponse, uint32_t tmOutMSec) {
     ASSERTS_NOT_NULL(pIface, false, ME, "NULL");
+    s_checkSnapshotCmd(pIface, cmd);
     return swl_rc_isOk(wld_wpaCtrlConnection_sendCmdCheckResponseExt(pIface->cmdConn, cmd, expectedResponse, tmOutMSec));
 }
 
@@ -186,6 +615,7 @@ bool wld_wpaCtrl_sendCmdCheckResponseExt(wld_wpaCtrlInterface_t* pIface, char* c
  */
 bool wld_wpaCtrl_sendCmdCheckResponse(wld_wpaCtrlInterface_t* pIface, char* cmd, char* expectedResponse) {
     ASSERTS_NOT_NULL(pIface, false, ME, "NULL");
+    s_checkSnapshotCmd(pIface, cmd);
     return swl_rc_isOk(wld_wpaCtrlConnection_sendCmdCheckResponse(pIface->cmdConn, cmd, expectedResponse));
 }
 
@@ -213,6 +643,7 @@ swl_rc_ne wld_wpaCtrl_sendCmdFmtCheckResponse(wld_wpaCtrlInterface_t* pIface, ch
     ret = vsnprintf(cmdStr, sizeof(cmdStr), cmdFormat, args);
     va_end(args);
     ASSERT_FALSE(ret < 0, SWL_RC_INVALID_PARAM, ME, "Fail to format cmd string");
+    s_checkSnapshotCmd(pIface, cmdStr);
     if(wld_wpaCtrlInterface_isReady(pIface)) {
         return wld_wpaCtrlConnection_sendCmdCheckResponse(pIface->cmdConn, cmdStr, expectedResponse);
     }
@@ -254,12 +685,14 @@ void wld_wpaCtrlInterface_close(wld_wpaCtrlInterface_t* pIface) {
     // Close event socket
     wld_wpaCtrlConnection_close(pIface->eventConn);
     pIface->isReady = false;
+    s_clearSnapshots(pIface);
 }
 
 void wld_wpaCtrlInterface_cleanup(wld_wpaCtrlInterface_t** ppIface) {
     ASSERTS_NOT_NULL(ppIface, , ME, "NULL");
     wld_wpaCtrlInterface_t* pIface = *ppIface;
     ASSERTS_NOT_NULL(pIface, , ME, "NULL");
+    s_dropCmdBatch(pIface);
     wld_wpaCtrlInterface_close(pIface);
     wld_wpaCtrlConnection_cleanup(&pIface->cmdConn);
     wld_wpaCtrlConnection_cleanup(&pIface->eventConn);
@@ -381,6 +814,33 @@ bool wld_wpaCtrlInterface_checkConnectionPath(const wld_wpaCtrlInterface_t* pIfa
     return wld_wpaCtrl_checkSockPath(path);
 }
 
+/**
+ * @brief get the reception counters of the interface event connection
+ *
+ * @param pIface the wpa_ctrl interface
+ * @param pStats output counters
+ *
+ * @return true on success, false otherwise
+ */
+bool wld_wpaCtrlInterface_getEvtRxStats(const wld_wpaCtrlInterface_t* pIface, wld_wpaCtrl_rxStats_t* pStats) {
+    ASSERTS_NOT_NULL(pIface, false, ME, "NULL");
+    return swl_rc_isOk(wld_wpaCtrlConnection_getRxStats(pIface->eventConn, pStats));
+}
+
+/**
+ * @brief get the shedding counters of one event class
+ *
+ * @param pIface pointer to interface context
+ * @param evtClass event class
+ * @param pStats pointer to output counters
+ *
+ * @return true on success, false otherwise
+ */
+bool wld_wpaCtrlInterface_getEvtClassStats(const wld_wpaCtrlInterface_t* pIface, wld_wpaCtrl_evtClass_e evtClass, wld_wpaCtrl_evtClassStats_t* pStats) {
+    ASSERTS_NOT_NULL(pIface, false, ME, "NULL");
+    return swl_rc_isOk(wld_wpaCtrl_evtShaper_getStats(&pIface->evtShaper, evtClass, pStats));
+}
+
 const char* wld_wpaCtrlInterface_getConnectionSockName(const wld_wpaCtrlInterface_t* pIface) {
     ASSERTS_NOT_NULL(pIface, "", ME, "NULL");
     return wld_wpaCtrlConnection_getConnSockName(pIface->cmdConn);
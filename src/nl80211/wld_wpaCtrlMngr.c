@@ -60,10 +60,15 @@
 **
 ****************************************************************************/
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/inotify.h>
 #include "swl/swl_common.h"
 #include "swl/swl_string.h"
 #include "wld_wpaCtrlMngr_priv.h"
 #include "wld_wpaCtrlInterface_priv.h"
+#include "wld.h"
 #include "wld_ssid.h"
 #include <dirent.h>
 
@@ -93,6 +98,33 @@ static int s_filterNames(const struct dirent* pEntry) {
     return 1;
 }
 
+/*
+ * @brief connect the wpa_ctrl interface matching a socket of the ctrl iface dir
+ */
+static void s_checkIface(wld_wpaCtrlMngr_t* pMgr, const char* ctrlDirPath, const char* sockName) {
+    T_SSID* pSSID = s_fetchLinkSSID(pMgr, sockName);
+    wld_wpaCtrlInterface_t* pIface = wld_ssid_getWpaCtrlIface(pSSID);
+    wld_wpaCtrlMngr_t* pCurrMgr = wld_wpaCtrlInterface_getMgr(pIface);
+    ASSERTS_NOT_NULL(pCurrMgr, , ME, "sock(%s): no manager", sockName);
+    ASSERTS_TRUE(wld_secDmn_isRunning(pCurrMgr->pSecDmn), , ME, "sock(%s): server not running", sockName);
+    if(!swl_str_matches(wld_wpaCtrlInterface_getConnectionSockName(pIface), sockName)) {
+        wld_wpaCtrlInterface_setConnectionInfo(pIface, ctrlDirPath, sockName);
+    }
+    if((pCurrMgr == pMgr) && (!wld_wpaCtrlInterface_isReady(pIface))) {
+        bool isEnabled = wld_wpaCtrlInterface_isEnabled(pIface);
+        wld_wpaCtrlInterface_setEnable(pIface, true);
+        if(!wld_wpaCtrlInterface_open(pIface)) {
+            /*
+             * restore previous wpactrl iface enabling state
+             * when failing to connect, while a first one succeeded
+             */
+            if(wld_wpaCtrlMngr_countReadyInterfaces(pMgr) > 0) {
+                wld_wpaCtrlInterface_setEnable(pIface, isEnabled);
+            }
+        }
+    }
+}
+
 swl_rc_ne wld_wpaCtrlMngr_checkAllIfaces(wld_wpaCtrlMngr_t* pMgr) {
     ASSERTS_NOT_NULL(pMgr, SWL_RC_INVALID_PARAM, ME, "NULL");
     const char* ctrlDirPath = wld_secDmn_getCtrlIfaceDirPath(pMgr->pSecDmn);
@@ -101,28 +133,7 @@ swl_rc_ne wld_wpaCtrlMngr_checkAllIfaces(wld_wpaCtrlMngr_t* pMgr) {
     int n = scandir(ctrlDirPath, &namelist, s_filterNames, alphasort);
     ASSERT_NOT_EQUALS(n, -1, SWL_RC_ERROR, ME, "fail to scan dir %s", ctrlDirPath);
     for(int i = 0; i < n; i++) {
-        const char* sockName = namelist[i]->d_name;
-        T_SSID* pSSID = s_fetchLinkSSID(pMgr, sockName);
-        wld_wpaCtrlInterface_t* pIface = wld_ssid_getWpaCtrlIface(pSSID);
-        wld_wpaCtrlMngr_t* pCurrMgr = wld_wpaCtrlInterface_getMgr(pIface);
-        if((pCurrMgr != NULL) && (wld_secDmn_isRunning(pCurrMgr->pSecDmn))) {
-            if(!swl_str_matches(wld_wpaCtrlInterface_getConnectionSockName(pIface), sockName)) {
-                wld_wpaCtrlInterface_setConnectionInfo(pIface, ctrlDirPath, sockName);
-            }
-            if((pCurrMgr == pMgr) && (!wld_wpaCtrlInterface_isReady(pIface))) {
-                bool isEnabled = wld_wpaCtrlInterface_isEnabled(pIface);
-                wld_wpaCtrlInterface_setEnable(pIface, true);
-                if(!wld_wpaCtrlInterface_open(pIface)) {
-                    /*
-                     * restore previous wpactrl iface enabling state
-                     * when failing to connect, while a first one succeeded
-                     */
-                    if(wld_wpaCtrlMngr_countReadyInterfaces(pMgr) > 0) {
-                        wld_wpaCtrlInterface_setEnable(pIface, isEnabled);
-                    }
-                }
-            }
-        }
+        s_checkIface(pMgr, ctrlDirPath, namelist[i]->d_name);
         free(namelist[i]);
     }
     free(namelist);
@@ -145,11 +156,128 @@ swl_rc_ne s_checkMgrConnectedIfaces(wld_wpaCtrlMngr_t* pMgr) {
         wld_wpaCtrlInterface_t* pReadyIface = wld_wpaCtrlMngr_getFirstReadyInterface(pMgr);
         char* srvName = pReadyIface ? pReadyIface->name : pFstIface ? pFstIface->name : "";
         SAH_TRACEZ_INFO(ME, "%s: wpa_ctrl server is ready (%d/%d connected)", srvName, nIfacesReady, nExpecIfaces);
+        wld_secDmn_checkReady(pMgr->pSecDmn);
         CALL_MGR(pMgr, srvName, fMngrReadyCb, true);
     }
     return SWL_RC_DONE;
 }
 
+/*
+ * @brief max number of connection retries, covering the same delay,
+ * whether the ctrl iface dir is watched or polled
+ */
+static uint8_t s_getMaxConnectAttempts(const wld_wpaCtrlMngr_t* pMgr) {
+    if(pMgr->dirWatchFd > 0) {
+        return (MAX_CONNECTION_ATTEMPTS * RETRY_DELAY_MS) / DIR_WATCH_RETRY_DELAY_MS;
+    }
+    return MAX_CONNECTION_ATTEMPTS;
+}
+
+static void s_stopDirWatch(wld_wpaCtrlMngr_t* pMgr) {
+    ASSERTS_TRUE(pMgr->dirWatchFd > 0, , ME, "no dir watch");
+    SAH_TRACEZ_INFO(ME, "stop watching ctrl iface dir %s", pMgr->watchedDirPath);
+    amxo_connection_remove(get_wld_plugin_parser(), pMgr->dirWatchFd);
+    close(pMgr->dirWatchFd);
+    pMgr->dirWatchFd = 0;
+    W_SWL_FREE(pMgr->watchedDirPath);
+    amxp_timer_set_interval(pMgr->connectTimer, RETRY_DELAY_MS);
+}
+
+/*
+ * @brief close the ready interface connected to a removed socket
+ */
+static void s_dropIface(wld_wpaCtrlMngr_t* pMgr, const char* sockName) {
+    swl_unLiListIt_t it;
+    swl_unLiList_for_each(it, &pMgr->ifaces) {
+        wld_wpaCtrlInterface_t* pIface = *(swl_unLiList_data(&it, wld_wpaCtrlInterface_t * *));
+        if((wld_wpaCtrlInterface_isReady(pIface)) &&
+           (swl_str_matches(wld_wpaCtrlInterface_getConnectionSockName(pIface), sockName))) {
+            SAH_TRACEZ_WARNING(ME, "%s: socket %s removed: close connection", pIface->name, sockName);
+            wld_wpaCtrlInterface_close(pIface);
+        }
+    }
+}
+
+/*
+ * @brief handle socket creation/removal in the watched ctrl iface dir:
+ * new sockets are connected shortly after, instead of waiting for next polling,
+ * but not from this handler: the daemon may not serve the socket yet,
+ * and the blocking ATTACH would stall the main loop
+ */
+static void s_readDirEvents(int fd, void* priv) {
+    wld_wpaCtrlMngr_t* pMgr = (wld_wpaCtrlMngr_t*) priv;
+    ASSERT_NOT_NULL(pMgr, , ME, "NULL");
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool dirRemoved = false;
+    bool sockAdded = false;
+    ssize_t len;
+    while((len = read(fd, buf, sizeof(buf))) > 0) {
+        const struct inotify_event* pEvt = NULL;
+        for(char* ptr = buf; ptr < (buf + len); ptr += sizeof(struct inotify_event) + pEvt->len) {
+            pEvt = (const struct inotify_event*) ptr;
+            if(pEvt->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                dirRemoved = true;
+                continue;
+            }
+            if((pEvt->len == 0) || (swl_str_startsWith(pEvt->name, "."))) {
+                continue;
+            }
+            if(pEvt->mask & (IN_CREATE | IN_MOVED_TO)) {
+                SAH_TRACEZ_INFO(ME, "socket %s created in %s", pEvt->name, pMgr->watchedDirPath);
+                sockAdded = true;
+            } else if(pEvt->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                s_dropIface(pMgr, pEvt->name);
+            }
+            /* the handlers may have stopped the watch */
+            ASSERTS_EQUALS(pMgr->dirWatchFd, fd, , ME, "dir watch stopped");
+        }
+    }
+    if(dirRemoved) {
+        SAH_TRACEZ_WARNING(ME, "ctrl iface dir %s removed: fall back to polling", pMgr->watchedDirPath);
+        s_stopDirWatch(pMgr);
+        return;
+    }
+    if(sockAdded && (wld_secDmn_isRunning(pMgr->pSecDmn)) &&
+       (wld_wpaCtrlMngr_countReadyInterfaces(pMgr) < wld_wpaCtrlMngr_countEnabledInterfaces(pMgr))) {
+        /* connect timer keeps polling at the safety net period, if the socket is not yet served */
+        amxp_timer_start(pMgr->connectTimer, DIR_WATCH_NEW_SOCK_DELAY_MS);
+    }
+}
+
+/*
+ * @brief watch socket creation/removal in the ctrl iface dir
+ *
+ * @return true if the dir is watched, false if polling is needed
+ * (inotify not available, or dir not yet created)
+ */
+static bool s_startDirWatch(wld_wpaCtrlMngr_t* pMgr) {
+    const char* ctrlDirPath = wld_secDmn_getCtrlIfaceDirPath(pMgr->pSecDmn);
+    ASSERTS_STR(ctrlDirPath, false, ME, "no ctrl iface dir");
+    if(pMgr->dirWatchFd > 0) {
+        if(swl_str_matches(pMgr->watchedDirPath, ctrlDirPath)) {
+            return true;
+        }
+        s_stopDirWatch(pMgr);
+    }
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    ASSERT_FALSE(fd < 0, false, ME, "inotify not available (%d:%s): poll ctrl iface dir", errno, strerror(errno));
+    if(inotify_add_watch(fd, ctrlDirPath, IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF) < 0) {
+        SAH_TRACEZ_INFO(ME, "can not watch %s (%d:%s): poll until created", ctrlDirPath, errno, strerror(errno));
+        close(fd);
+        return false;
+    }
+    if(amxo_connection_add(get_wld_plugin_parser(), fd, s_readDirEvents, "wpaCtrlDirWatch", AMXO_CUSTOM, pMgr) != 0) {
+        SAH_TRACEZ_ERROR(ME, "fail to add dir watch connection");
+        close(fd);
+        return false;
+    }
+    pMgr->dirWatchFd = fd;
+    swl_str_copyMalloc(&pMgr->watchedDirPath, ctrlDirPath);
+    amxp_timer_set_interval(pMgr->connectTimer, DIR_WATCH_RETRY_DELAY_MS);
+    SAH_TRACEZ_INFO(ME, "watching ctrl iface dir %s", ctrlDirPath);
+    return true;
+}
+
 /**
  * @brief Try to connect to all detected wpa_ctrl interfaces
  *
@@ -162,6 +290,10 @@ static void s_reconnectMgrTimer(amxp_timer_t* timer, void* userdata) {
     ASSERTS_NOT_NULL(timer, , ME, "NULL");
     ASSERTS_NOT_NULL(userdata, , ME, "NULL");
     wld_wpaCtrlMngr_t* pMgr = (wld_wpaCtrlMngr_t*) userdata;
+    if(pMgr->dirWatchFd <= 0) {
+        /* ctrl iface dir may have been created since last check */
+        s_startDirWatch(pMgr);
+    }
     swl_rc_ne rc = wld_wpaCtrlMngr_checkAllIfaces(pMgr);
     ASSERT_TRUE(swl_rc_isOk(rc), , ME, "fail to check available wpactrl ifaces");
     wld_wpaCtrlInterface_t* pIfaceNotReady = wld_wpaCtrlMngr_getFirstNotReadyInterface(pMgr);
@@ -169,17 +301,18 @@ static void s_reconnectMgrTimer(amxp_timer_t* timer, void* userdata) {
     if(!wld_secDmn_isRunning(pMgr->pSecDmn)) {
         SAH_TRACEZ_ERROR(ME, "%s: daemon not started yet, no need to connect", srvName);
         //no need to retry, as long as sec daemon is not running
-        pMgr->wpaCtrlConnectAttempts += MAX_CONNECTION_ATTEMPTS;
+        pMgr->wpaCtrlConnectAttempts += s_getMaxConnectAttempts(pMgr);
     } else if(s_checkMgrConnectedIfaces(pMgr) == SWL_RC_CONTINUE) {
         pMgr->wpaCtrlConnectAttempts++;
     }
     if(pMgr->wpaCtrlConnectAttempts > 0) {
         uint32_t nIfacesReady = wld_wpaCtrlMngr_countReadyInterfaces(pMgr);
         uint32_t nExpecIfaces = wld_wpaCtrlMngr_countEnabledInterfaces(pMgr);
-        if((nExpecIfaces > 0) && (pMgr->wpaCtrlConnectAttempts < MAX_CONNECTION_ATTEMPTS)) {
+        uint8_t maxAttempts = s_getMaxConnectAttempts(pMgr);
+        if((nExpecIfaces > 0) && (pMgr->wpaCtrlConnectAttempts < maxAttempts)) {
             SAH_TRACEZ_WARNING(ME, "%s: wpa_ctrl server not yet ready (%d/%d), waiting (%d/%d)..",
                                srvName, nIfacesReady, nExpecIfaces,
-                               pMgr->wpaCtrlConnectAttempts, MAX_CONNECTION_ATTEMPTS);
+                               pMgr->wpaCtrlConnectAttempts, maxAttempts);
         } else {
             pMgr->wpaCtrlConnectAttempts = 0;
             amxp_timer_stop(pMgr->connectTimer);
@@ -437,8 +570,10 @@ bool wld_wpaCtrlMngr_isConnected(wld_wpaCtrlMngr_t* pMgr) {
  */
 bool wld_wpaCtrlMngr_connect(wld_wpaCtrlMngr_t* pMgr) {
     ASSERT_NOT_NULL(pMgr, false, ME, "NULL");
+    bool watched = s_startDirWatch(pMgr);
     ASSERTI_FALSE(wld_wpaCtrlMngr_isConnected(pMgr), true, ME, "already connected");
-    amxp_timer_start(pMgr->connectTimer, FIRST_DELAY_MS);
+    /* when watched, existing sockets are connected right away, and next ones on creation */
+    amxp_timer_start(pMgr->connectTimer, watched ? 0 : FIRST_DELAY_MS);
     return true;
 }
 
@@ -472,6 +607,7 @@ bool wld_wpaCtrlMngr_disconnect(wld_wpaCtrlMngr_t* pMgr) {
     ASSERT_NOT_NULL(pMgr, false, ME, "NULL");
     pMgr->wpaCtrlConnectAttempts = 0;
     amxp_timer_stop(pMgr->connectTimer);
+    s_stopDirWatch(pMgr);
     swl_unLiListIt_t it;
     swl_unLiList_for_each(it, &pMgr->ifaces) {
         wld_wpaCtrlInterface_t* pIface = *(swl_unLiList_data(&it, wld_wpaCtrlInterface_t * *));
@@ -493,6 +629,7 @@ void wld_wpaCtrlMngr_cleanup(wld_wpaCtrlMngr_t** ppMgr) {
         }
         swl_unLiList_remove(&pMgr->ifaces, i);
     }
+    s_stopDirWatch(pMgr);
     amxp_timer_delete(&pMgr->connectTimer);
     free(pMgr);
     *ppMgr = NULL;
@@ -69,10 +69,16 @@
 #include "wld_wpaCtrlMngr_priv.h"
 #include "wld_wpaCtrl_events.h"
 #include "wld_wpaSupp_parser.h"
+#include "wld_util.h"
 
 #define ME "wpaCtrl"
 
-static int s_getValueStr(const char* pData, const char* pKey, char* pValue, int* length) {
+/*
+ * @brief locate the value of a key in a "key=value" list
+ *
+ * @return value length, and the value start in ppValue, 0 if not found
+ */
+static int s_locateValue(const char* pData, const char* pKey, const char** ppValue) {
     ASSERTS_STR(pData, 0, ME, "Empty data");
     ASSERTS_STR(pKey, 0, ME, "Empty key");
     char* paramStart = (char*) pData;
@@ -110,7 +116,11 @@ static int s_getValueStr(const char* pData, const char* pKey, char* pValue, int*
     }
     ASSERTI_NOT_NULL(valueEnd, 0, ME, "Can locate string value end of token %s", pKey);
 
-    int valueLen = valueEnd - valueStart;
+    *ppValue = valueStart;
+    return valueEnd - valueStart;
+}
+
+static int s_copyValue(const char* valueStart, int valueLen, char* pValue, int* length) {
     if(pValue == NULL) {
         if(length) {
             *length = 0;
@@ -129,6 +139,13 @@ static int s_getValueStr(const char* pData, const char* pKey, char* pValue, int*
     return valueLen;
 }
 
+static int s_getValueStr(const char* pData, const char* pKey, char* pValue, int* length) {
+    const char* valueStart = NULL;
+    int valueLen = s_locateValue(pData, pKey, &valueStart);
+    ASSERTS_NOT_NULL(valueStart, 0, ME, "not found");
+    return s_copyValue(valueStart, valueLen, pValue, length);
+}
+
 /* Extension functions We don't care about the length string.*/
 int wld_wpaCtrl_getValueStr(const char* pData, const char* pKey, char* pValue, int length) {
     return s_getValueStr(pData, pKey, pValue, &length);
@@ -150,6 +167,136 @@ int wld_wpaCtrl_getValueInt(const char* pData, const char* pKey) {
     return val;
 }
 
+static uint32_t s_hashKey(const char* pKey, size_t keyLen) {
+    return wld_util_fnv32Update(WLD_UTIL_FNV32_OFFSET_BASIS, pKey, keyLen);
+}
+
+/*
+ * @brief split a wpactrl reply, in one pass, into an indexed table of key=value pairs
+ * Tokens without '=' are part of the previous value (values may include spaces),
+ * or are ignored when located before the first key (eg. station mac, event name).
+ *
+ * @param pReply table to fill, referring to pData
+ * @param pData reply string
+ *
+ * @return SWL_RC_OK on success, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_reply_parse(wld_wpaCtrl_reply_t* pReply, const char* pData) {
+    ASSERT_NOT_NULL(pReply, SWL_RC_INVALID_PARAM, ME, "NULL");
+    pReply->pData = pData;
+    pReply->nrPairs = 0;
+    pReply->truncated = false;
+    memset(pReply->buckets, 0xff, sizeof(pReply->buckets));
+    ASSERTS_NOT_NULL(pData, SWL_RC_OK, ME, "Empty data");
+    ASSERT_TRUE(strlen(pData) < UINT16_MAX, SWL_RC_INVALID_PARAM, ME, "too long data");
+
+    wld_wpaCtrl_replyPair_t* pCurPair = NULL;
+    const char* p = pData;
+    while(*p != 0) {
+        while((*p != 0) && isspace(*p)) {
+            p++;
+        }
+        if(*p == 0) {
+            break;
+        }
+        const char* pToken = p;
+        const char* pSep = NULL;
+        for(; (*p != 0) && !isspace(*p); p++) {
+            if((pSep == NULL) && (*p == '=')) {
+                pSep = p;
+            }
+        }
+        if((pSep == NULL) || (pSep == pToken)) {
+            if(pCurPair != NULL) {
+                pCurPair->valLen = (p - pData) - pCurPair->valOffset;
+            }
+            continue;
+        }
+        if(pReply->nrPairs >= WLD_WPACTRL_REPLY_MAX_PAIRS) {
+            SAH_TRACEZ_INFO(ME, "too many pairs in reply: keep remaining unindexed");
+            pReply->truncated = true;
+            break;
+        }
+        uint16_t idx = pReply->nrPairs++;
+        pCurPair = &pReply->pairs[idx];
+        pCurPair->keyOffset = pToken - pData;
+        pCurPair->keyLen = pSep - pToken;
+        pCurPair->valOffset = (pSep + 1) - pData;
+        pCurPair->valLen = p - (pSep + 1);
+        uint32_t bucket = s_hashKey(pToken, pCurPair->keyLen) % WLD_WPACTRL_REPLY_NR_BUCKETS;
+        pCurPair->hashNext = pReply->buckets[bucket];
+        pReply->buckets[bucket] = idx;
+    }
+    return SWL_RC_OK;
+}
+
+/*
+ * @brief get reference to the value of a key in a tokenized reply
+ *
+ * @param pReply tokenized reply
+ * @param pKey key to look for (the first occurrence is returned)
+ * @param pLen pointer to output value length
+ *
+ * @return pointer to value start in the reply string (not null terminated), NULL if not found
+ */
+const char* wld_wpaCtrl_reply_getValueRef(const wld_wpaCtrl_reply_t* pReply, const char* pKey, size_t* pLen) {
+    ASSERTS_NOT_NULL(pReply, NULL, ME, "NULL");
+    ASSERTS_NOT_NULL(pReply->pData, NULL, ME, "Empty data");
+    ASSERTS_STR(pKey, NULL, ME, "Empty key");
+    size_t keyLen = strlen(pKey);
+    const wld_wpaCtrl_replyPair_t* pFound = NULL;
+    uint32_t bucket = s_hashKey(pKey, keyLen) % WLD_WPACTRL_REPLY_NR_BUCKETS;
+    /* bucket chains are ordered from the last parsed pair */
+    for(uint16_t idx = pReply->buckets[bucket]; idx != WLD_WPACTRL_REPLY_NO_IDX; idx = pReply->pairs[idx].hashNext) {
+        const wld_wpaCtrl_replyPair_t* pPair = &pReply->pairs[idx];
+        if((pPair->keyLen == keyLen) && (memcmp(&pReply->pData[pPair->keyOffset], pKey, keyLen) == 0)) {
+            pFound = pPair;
+        }
+    }
+    if(pFound != NULL) {
+        W_SWL_SETPTR(pLen, pFound->valLen);
+        return &pReply->pData[pFound->valOffset];
+    }
+    ASSERTI_TRUE(pReply->truncated, NULL, ME, "Failed to find token %s", pKey);
+    const char* valueStart = NULL;
+    int valueLen = s_locateValue(pReply->pData, pKey, &valueStart);
+    W_SWL_SETPTR(pLen, valueLen);
+    return valueStart;
+}
+
+/*
+ * @brief copy the value of a key in a tokenized reply
+ * (as wld_wpaCtrl_getValueStr, but never writing beyond length, including null terminator)
+ *
+ * @return the value length (may be larger than the copied string), 0 if not found
+ */
+int wld_wpaCtrl_reply_getValueStr(const wld_wpaCtrl_reply_t* pReply, const char* pKey, char* pValue, int length) {
+    size_t valueLen = 0;
+    const char* valueStart = wld_wpaCtrl_reply_getValueRef(pReply, pKey, &valueLen);
+    if((pValue != NULL) && (length > 0)) {
+        pValue[0] = 0;
+    }
+    ASSERTS_NOT_NULL(valueStart, 0, ME, "not found");
+    /* keep room for the null terminator */
+    length = (length > 0) ? (length - 1) : length;
+    return s_copyValue(valueStart, valueLen, pValue, &length);
+}
+
+bool wld_wpaCtrl_reply_getValueIntExt(const wld_wpaCtrl_reply_t* pReply, const char* pKey, int32_t* pVal) {
+    char strbuf[64] = {0};
+    ASSERTS_TRUE(wld_wpaCtrl_reply_getValueStr(pReply, pKey, strbuf, sizeof(strbuf)) > 0, false,
+                 ME, "key (%s) not found", pKey);
+    ASSERT_TRUE(swl_typeInt32_fromChar(pVal, strbuf), false,
+                ME, "key (%s) val (%s) num conversion failed", pKey, strbuf);
+    return true;
+}
+
+int wld_wpaCtrl_reply_getValueInt(const wld_wpaCtrl_reply_t* pReply, const char* pKey) {
+    int32_t val = 0;
+    wld_wpaCtrl_reply_getValueIntExt(pReply, pKey, &val);
+    return val;
+}
+
 #define CALL_IFACE(PIFACE, FNAME, ...) \
     if((PIFACE != NULL)) { \
         SWL_CALL(PIFACE->handlers.FNAME, PIFACE->userData, PIFACE->name, __VA_ARGS__); \
@@ -963,6 +1110,10 @@ void wld_wpaCtrl_processMsg(wld_wpaCtrlInterface_t* pInterface, char* msgData, s
     ASSERTS_STR(msgData, , ME, "empty");
     ASSERTS_TRUE(len > 0, , ME, "null length");
     SAH_TRACEZ_NOTICE(ME, "%s: receive event len: %zu (%s)", wld_wpaCtrlInterface_getName(pInterface), len, msgData);
+    if(!wld_wpaCtrl_evtShaper_accept(&pInterface->evtShaper, msgData)) {
+        SAH_TRACEZ_INFO(ME, "%s: shed event (%s)", pInterface->name, msgData);
+        return;
+    }
 
     // 1) prepare custom msg for processing: target interface, msg content
     char* newIfName = NULL;
@@ -985,6 +1136,7 @@ void wld_wpaCtrl_processMsg(wld_wpaCtrlInterface_t* pInterface, char* msgData, s
         }
     }
     W_SWL_FREE(newIfName);
+    wld_wpaCtrlInterface_checkSnapshotEvt(pInterface, msgData);
 
     // 2) try to process msg as custom, then as standard
     if(!s_processCustomEvent(pInterface, msgData)) {
@@ -0,0 +1,373 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#include <string.h>
+#include "wld.h"
+#include "wld_util.h"
+#include "wld_wpaCtrl_events.h"
+#include "wld_wpaCtrl_evtPolicy.h"
+
+#define ME "wpaCtrl"
+
+#define MILLI_EVT_PER_EVT 1000
+
+const char* wld_wpaCtrl_evtClass_str[WLD_WPACTRL_EVT_CLASS_MAX] = {"Critical", "Normal", "Low"};
+
+static wld_wpaCtrl_evtClassPolicy_t sEvtClassPolicies[WLD_WPACTRL_EVT_CLASS_MAX] = {
+    [WLD_WPACTRL_EVT_CLASS_CRITICAL] = {.maxRate = 0, .burst = 0, .sampleWindowMs = 0},
+    [WLD_WPACTRL_EVT_CLASS_NORMAL] = {.maxRate = 0, .burst = 0, .sampleWindowMs = 0},
+    [WLD_WPACTRL_EVT_CLASS_LOW] = {.maxRate = 100, .burst = 200, .sampleWindowMs = 1000},
+};
+
+/* 802.11 management frame subtypes (frame control bits 4-7) that wld acts upon */
+#define MGMT_FRAME_STYPE_ASSOC_REQ 0x0
+#define MGMT_FRAME_STYPE_REASSOC_REQ 0x2
+#define MGMT_FRAME_STYPE_DISASSOC 0xa
+#define MGMT_FRAME_STYPE_DEAUTH 0xc
+#define MGMT_FRAME_STYPE_ACTION 0xd
+#define MGMT_FRAME_ACTION_CAT_WNM 0x0a
+
+/* offsets in the hex dumped frame (two chars per byte) */
+#define MGMT_FRAME_HEX_DURATION_OFF 4
+#define MGMT_FRAME_HEX_SEQ_CTRL_OFF 44
+#define MGMT_FRAME_HEX_FIELD_LEN 4
+#define MGMT_FRAME_HEX_BODY_OFF 48
+
+typedef struct {
+    const char* evtPrefix;                                        // matched against the event name following the "<3>" level tag
+    wld_wpaCtrl_evtClass_e evtClass;
+    wld_wpaCtrl_evtClass_e (* getEvtClass)(const char* pEvtName); // optional, refines the class from the event params
+    uint32_t (* getSampleKey)(const char* pEvtName);              // optional, returns 0 when the event is not sampled
+} wpaCtrlEvtClassDesc_t;
+
+/*
+ * never returns 0 (reserved for empty sample slot)
+ */
+static uint32_t s_hashFinal(uint32_t hash) {
+    return (hash != 0) ? hash : 1;
+}
+
+/*
+ * @return hex dumped frame following the "buf=" tag, with its length in pLen
+ */
+static const char* s_getMgmtFrameHex(const char* pEvtName, size_t* pLen) {
+    const char* pHex = strstr(pEvtName, "buf=");
+    ASSERTS_NOT_NULL(pHex, NULL, ME, "no frame buffer");
+    pHex += strlen("buf=");
+    *pLen = strcspn(pHex, " \r\n");
+    return pHex;
+}
+
+static int32_t s_hexVal(char c) {
+    if((c >= '0') && (c <= '9')) {
+        return c - '0';
+    }
+    if((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    if((c >= 'A') && (c <= 'F')) {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/*
+ * @return byte at hex offset, or -1 when beyond the dumped frame or not hex
+ */
+static int32_t s_getHexByte(const char* pHex, size_t len, size_t offset) {
+    ASSERTS_TRUE(offset + 2 <= len, -1, ME, "offset %zu out of frame", offset);
+    int32_t high = s_hexVal(pHex[offset]);
+    int32_t low = s_hexVal(pHex[offset + 1]);
+    ASSERTS_FALSE((high < 0) || (low < 0), -1, ME, "invalid hex");
+    return (high << 4) | low;
+}
+
+/*
+ * Assoc requests, disassoc, deauth and WNM action frames update the station
+ * context (capabilities, last deauth reason, BTM), so they are never shed.
+ * Other received management frames are only notified.
+ */
+static wld_wpaCtrl_evtClass_e s_getMgmtFrameClass(const char* pEvtName) {
+    size_t len = 0;
+    const char* pHex = s_getMgmtFrameHex(pEvtName, &len);
+    ASSERTS_NOT_NULL(pHex, WLD_WPACTRL_EVT_CLASS_LOW, ME, "no frame");
+    int32_t fc0 = s_getHexByte(pHex, len, 0);
+    ASSERTS_TRUE(fc0 >= 0, WLD_WPACTRL_EVT_CLASS_LOW, ME, "no frame control");
+    switch(fc0 >> 4) {
+    case MGMT_FRAME_STYPE_ASSOC_REQ:
+    case MGMT_FRAME_STYPE_REASSOC_REQ:
+    case MGMT_FRAME_STYPE_DISASSOC:
+    case MGMT_FRAME_STYPE_DEAUTH:
+        return WLD_WPACTRL_EVT_CLASS_CRITICAL;
+    case MGMT_FRAME_STYPE_ACTION:
+        if(s_getHexByte(pHex, len, MGMT_FRAME_HEX_BODY_OFF) == MGMT_FRAME_ACTION_CAT_WNM) {
+            return WLD_WPACTRL_EVT_CLASS_CRITICAL;
+        }
+        break;
+    default:
+        break;
+    }
+    return WLD_WPACTRL_EVT_CLASS_LOW;
+}
+
+/*
+ * key: the whole frame, header and body, except duration and sequence control
+ * which change between retransmissions of the same frame
+ */
+static uint32_t s_getMgmtFrameSampleKey(const char* pEvtName) {
+    size_t len = 0;
+    const char* pHex = s_getMgmtFrameHex(pEvtName, &len);
+    ASSERTS_NOT_NULL(pHex, 0, ME, "no frame");
+    const size_t skipOffsets[] = {MGMT_FRAME_HEX_DURATION_OFF, MGMT_FRAME_HEX_SEQ_CTRL_OFF};
+    uint32_t hash = WLD_UTIL_FNV32_OFFSET_BASIS;
+    size_t pos = 0;
+    for(uint32_t i = 0; (i < SWL_ARRAY_SIZE(skipOffsets)) && (pos < len); i++) {
+        size_t end = SWL_MIN(skipOffsets[i], len);
+        hash = wld_util_fnv32Update(hash, &pHex[pos], end - pos);
+        pos = end + MGMT_FRAME_HEX_FIELD_LEN;
+    }
+    if(pos < len) {
+        hash = wld_util_fnv32Update(hash, &pHex[pos], len - pos);
+    }
+    return s_hashFinal(hash);
+}
+
+/*
+ * key: reporting station mac, first event param
+ */
+static uint32_t s_getStaSampleKey(const char* pEvtName) {
+    const char* pKey = strchr(pEvtName, ' ');
+    ASSERTS_NOT_NULL(pKey, 0, ME, "no event params");
+    pKey++;
+    return s_hashFinal(wld_util_fnv32Update(WLD_UTIL_FNV32_OFFSET_BASIS, pKey, strnlen(pKey, SWL_MAC_CHAR_LEN - 1)));
+}
+
+/*
+ * Events not listed here are of normal class.
+ */
+static const wpaCtrlEvtClassDesc_t sEvtClassDescs[] = {
+    {"AP-STA-CONNECTED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"AP-STA-DISCONNECTED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"EAPOL-4WAY-HS-COMPLETED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"DFS-", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"CTRL-EVENT-TERMINATING", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"AP-ENABLED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"AP-DISABLED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"INTERFACE-ENABLED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"INTERFACE-DISABLED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"CTRL-EVENT-STARTED-CHANNEL-SWITCH", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"CTRL-EVENT-CHANNEL-SWITCH", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"AP-CSA-FINISHED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"CTRL-EVENT-CONNECTED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"CTRL-EVENT-DISCONNECTED", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"WPS-", WLD_WPACTRL_EVT_CLASS_CRITICAL, NULL, NULL},
+    {"AP-MGMT-FRAME-RECEIVED", WLD_WPACTRL_EVT_CLASS_LOW, s_getMgmtFrameClass, s_getMgmtFrameSampleKey},
+    {"BEACON-RESP-RX", WLD_WPACTRL_EVT_CLASS_LOW, NULL, s_getStaSampleKey},
+};
+
+static const wpaCtrlEvtClassDesc_t* s_getEvtClassDesc(const char* msgData, const char** ppEvtName) {
+    const char* pEvtName = strstr(msgData, WPA_MSG_LEVEL_INFO);
+    ASSERTS_NOT_NULL(pEvtName, NULL, ME, "no level tag");
+    pEvtName += strlen(WPA_MSG_LEVEL_INFO);
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sEvtClassDescs); i++) {
+        if(strncmp(pEvtName, sEvtClassDescs[i].evtPrefix, strlen(sEvtClassDescs[i].evtPrefix)) == 0) {
+            if(ppEvtName != NULL) {
+                *ppEvtName = pEvtName;
+            }
+            return &sEvtClassDescs[i];
+        }
+    }
+    return NULL;
+}
+
+static wld_wpaCtrl_evtClass_e s_getDescEvtClass(const wpaCtrlEvtClassDesc_t* pDesc, const char* pEvtName) {
+    ASSERTS_NOT_NULL(pDesc, WLD_WPACTRL_EVT_CLASS_NORMAL, ME, "unclassified event");
+    if(pDesc->getEvtClass != NULL) {
+        return pDesc->getEvtClass(pEvtName);
+    }
+    return pDesc->evtClass;
+}
+
+/*
+ * @brief classify an unsolicited wpa_ctrl message
+ *
+ * @param msgData raw message, optionally prefixed with "IFNAME=<name> "
+ *
+ * @return event class, normal when the event is not known
+ */
+wld_wpaCtrl_evtClass_e wld_wpaCtrl_getEvtClass(const char* msgData) {
+    ASSERTS_NOT_NULL(msgData, WLD_WPACTRL_EVT_CLASS_NORMAL, ME, "NULL");
+    const char* pEvtName = NULL;
+    const wpaCtrlEvtClassDesc_t* pDesc = s_getEvtClassDesc(msgData, &pEvtName);
+    return s_getDescEvtClass(pDesc, pEvtName);
+}
+
+swl_rc_ne wld_wpaCtrl_setEvtClassPolicy(wld_wpaCtrl_evtClass_e evtClass, const wld_wpaCtrl_evtClassPolicy_t* pPolicy) {
+    ASSERT_TRUE(evtClass < WLD_WPACTRL_EVT_CLASS_MAX, SWL_RC_INVALID_PARAM, ME, "invalid class %d", evtClass);
+    ASSERT_NOT_NULL(pPolicy, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_EQUALS(evtClass, WLD_WPACTRL_EVT_CLASS_CRITICAL, SWL_RC_INVALID_PARAM, ME, "critical events can not be shed");
+    ASSERT_FALSE((pPolicy->maxRate > 0) && (pPolicy->burst == 0), SWL_RC_INVALID_PARAM, ME, "null burst with limited rate");
+    sEvtClassPolicies[evtClass] = *pPolicy;
+    SAH_TRACEZ_INFO(ME, "evt class %s: maxRate %u burst %u sampleWindow %u ms",
+                    wld_wpaCtrl_evtClass_str[evtClass], pPolicy->maxRate, pPolicy->burst, pPolicy->sampleWindowMs);
+    return SWL_RC_OK;
+}
+
+swl_rc_ne wld_wpaCtrl_getEvtClassPolicy(wld_wpaCtrl_evtClass_e evtClass, wld_wpaCtrl_evtClassPolicy_t* pPolicy) {
+    ASSERT_TRUE(evtClass < WLD_WPACTRL_EVT_CLASS_MAX, SWL_RC_INVALID_PARAM, ME, "invalid class %d", evtClass);
+    ASSERT_NOT_NULL(pPolicy, SWL_RC_INVALID_PARAM, ME, "NULL");
+    *pPolicy = sEvtClassPolicies[evtClass];
+    return SWL_RC_OK;
+}
+
+void wld_wpaCtrl_evtShaper_reset(wld_wpaCtrl_evtShaper_t* pShaper) {
+    ASSERTS_NOT_NULL(pShaper, , ME, "NULL");
+    memset(pShaper, 0, sizeof(*pShaper));
+}
+
+static void s_refill(wld_wpaCtrl_evtShaper_t* pShaper, wld_wpaCtrl_evtClass_e evtClass, const wld_wpaCtrl_evtClassPolicy_t* pPolicy, int64_t nowMs) {
+    int64_t capacity = (int64_t) pPolicy->burst * MILLI_EVT_PER_EVT;
+    if(!pShaper->initialized) {
+        for(uint32_t i = 0; i < WLD_WPACTRL_EVT_CLASS_MAX; i++) {
+            pShaper->tokens[i] = -1;
+        }
+        pShaper->initialized = true;
+    }
+    if(pShaper->tokens[evtClass] < 0) {
+        pShaper->tokens[evtClass] = capacity;
+        pShaper->lastRefillMs[evtClass] = nowMs;
+        return;
+    }
+    int64_t elapsed = nowMs - pShaper->lastRefillMs[evtClass];
+    if(elapsed > 0) {
+        /* ms * events/s = milli-events */
+        pShaper->tokens[evtClass] = SWL_MIN(capacity, pShaper->tokens[evtClass] + elapsed * pPolicy->maxRate);
+        pShaper->lastRefillMs[evtClass] = nowMs;
+    } else if(pShaper->tokens[evtClass] > capacity) {
+        pShaper->tokens[evtClass] = capacity;
+    }
+}
+
+/*
+ * @brief check whether an unsolicited message may be processed, given its class policy
+ * Critical events and events of unlimited classes are always accepted.
+ * Otherwise, the event consumes one token of its class bucket.
+ * When less than half of the burst remains, repeated events (same sample key) within
+ * the sampling window are dropped first, then events are dropped when the bucket is empty.
+ *
+ * @param pShaper per interface shaping state
+ * @param msgData raw message
+ * @param nowMs monotonic time in milliseconds
+ *
+ * @return true if the message must be processed, false if it is shed
+ */
+bool wld_wpaCtrl_evtShaper_acceptAt(wld_wpaCtrl_evtShaper_t* pShaper, const char* msgData, int64_t nowMs) {
+    ASSERTS_NOT_NULL(pShaper, true, ME, "NULL");
+    ASSERTS_NOT_NULL(msgData, true, ME, "NULL");
+    const char* pEvtName = NULL;
+    const wpaCtrlEvtClassDesc_t* pDesc = s_getEvtClassDesc(msgData, &pEvtName);
+    wld_wpaCtrl_evtClass_e evtClass = s_getDescEvtClass(pDesc, pEvtName);
+    const wld_wpaCtrl_evtClassPolicy_t* pPolicy = &sEvtClassPolicies[evtClass];
+    wld_wpaCtrl_evtClassStats_t* pStats = &pShaper->stats[evtClass];
+
+    if((evtClass == WLD_WPACTRL_EVT_CLASS_CRITICAL) || (pPolicy->maxRate == 0)) {
+        pStats->nrPassed++;
+        return true;
+    }
+
+    s_refill(pShaper, evtClass, pPolicy, nowMs);
+
+    uint32_t key = ((pDesc != NULL) && (pDesc->getSampleKey != NULL)) ? pDesc->getSampleKey(pEvtName) : 0;
+    wld_wpaCtrl_evtSample_t* pSample = &pShaper->samples[key % WLD_WPACTRL_EVT_SAMPLE_SLOTS];
+    int64_t capacity = (int64_t) pPolicy->burst * MILLI_EVT_PER_EVT;
+    if((key != 0) && (pPolicy->sampleWindowMs > 0) && (pShaper->tokens[evtClass] < (capacity / 2)) &&
+       (pSample->key == key) && ((nowMs - pSample->lastMs) < pPolicy->sampleWindowMs)) {
+        pStats->nrSampledOut++;
+        return false;
+    }
+    if(pShaper->tokens[evtClass] < MILLI_EVT_PER_EVT) {
+        pStats->nrRateDropped++;
+        return false;
+    }
+    pShaper->tokens[evtClass] -= MILLI_EVT_PER_EVT;
+    if(key != 0) {
+        pSample->key = key;
+        pSample->lastMs = nowMs;
+    }
+    pStats->nrPassed++;
+    return true;
+}
+
+bool wld_wpaCtrl_evtShaper_accept(wld_wpaCtrl_evtShaper_t* pShaper, const char* msgData) {
+    swl_timeSpecMono_t now;
+    swl_timespec_getMono(&now);
+    int64_t nowMs = ((int64_t) now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+    return wld_wpaCtrl_evtShaper_acceptAt(pShaper, msgData, nowMs);
+}
+
+swl_rc_ne wld_wpaCtrl_evtShaper_getStats(const wld_wpaCtrl_evtShaper_t* pShaper, wld_wpaCtrl_evtClass_e evtClass, wld_wpaCtrl_evtClassStats_t* pStats) {
+    ASSERT_NOT_NULL(pShaper, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(pStats, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_TRUE(evtClass < WLD_WPACTRL_EVT_CLASS_MAX, SWL_RC_INVALID_PARAM, ME, "invalid class %d", evtClass);
+    *pStats = pShaper->stats[evtClass];
+    return SWL_RC_OK;
+}
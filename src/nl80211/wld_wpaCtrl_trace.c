@@ -0,0 +1,298 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "wld.h"
+#include "wld_wpaCtrl_trace.h"
+
+#define ME "wpaCtrl"
+
+const char* wld_wpaCtrl_traceDir_str[WLD_WPACTRL_TRACE_DIR_MAX] = {"Cmd", "Reply", "Evt"};
+
+typedef struct SWL_PACKED {
+    uint32_t deltaUs;
+    uint8_t dir;
+    uint8_t sockNameLen;
+    uint16_t dataLen;
+} wpaCtrlTraceRecordHdr_t;
+
+typedef struct {
+    FILE* fp;
+    char* path;
+    swl_timeSpecMono_t lastTs;
+    uint32_t nrRecords;
+} wpaCtrlTraceRecorder_t;
+
+static wpaCtrlTraceRecorder_t sRecorder;
+
+/*
+ * parameters whose values must never be written in a trace:
+ * "SET <key> <val>", "SET_NETWORK <id> <key> <val>", "<key>=<val>" lines, WPS pin commands
+ */
+static const char* sSecretKeys[] = {
+    "wpa_passphrase", "wpa_psk", "sae_password", "psk", "password",
+    "wep_key0", "wep_key1", "wep_key2", "wep_key3",
+    "auth_server_shared_secret", "acct_server_shared_secret",
+    "WPS_PIN", "WPS_AP_PIN",
+};
+
+struct wld_wpaCtrl_traceReader {
+    FILE* fp;
+    uint64_t tsUs;
+    char data[UINT16_MAX + 1];
+};
+
+/**
+ * @brief start capturing all wpa_ctrl commands, replies and unsolicited messages
+ * into a trace file
+ *
+ * @param path path of the trace file (overwritten)
+ *
+ * @return SWL_RC_OK on success, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_startRecord(const char* path) {
+    ASSERT_STR(path, SWL_RC_INVALID_PARAM, ME, "empty path");
+    wld_wpaCtrl_stopRecord();
+    FILE* fp = fopen(path, "w");
+    ASSERT_NOT_NULL(fp, SWL_RC_ERROR, ME, "fail to open trace file (%s)", path);
+    uint8_t version = WLD_WPACTRL_TRACE_VERSION;
+    if((fwrite(WLD_WPACTRL_TRACE_MAGIC, strlen(WLD_WPACTRL_TRACE_MAGIC), 1, fp) != 1) ||
+       (fwrite(&version, sizeof(version), 1, fp) != 1)) {
+        SAH_TRACEZ_ERROR(ME, "fail to write trace header (%s)", path);
+        fclose(fp);
+        return SWL_RC_ERROR;
+    }
+    sRecorder.fp = fp;
+    swl_str_copyMalloc(&sRecorder.path, path);
+    sRecorder.lastTs = swl_timespec_getMonoVal();
+    sRecorder.nrRecords = 0;
+    SAH_TRACEZ_WARNING(ME, "start recording wpa_ctrl traffic to (%s)", path);
+    return SWL_RC_OK;
+}
+
+void wld_wpaCtrl_stopRecord() {
+    ASSERTS_NOT_NULL(sRecorder.fp, , ME, "not recording");
+    SAH_TRACEZ_WARNING(ME, "stop recording wpa_ctrl traffic to (%s): %u records", sRecorder.path, sRecorder.nrRecords);
+    fclose(sRecorder.fp);
+    sRecorder.fp = NULL;
+    W_SWL_FREE(sRecorder.path);
+}
+
+bool wld_wpaCtrl_isRecording() {
+    return (sRecorder.fp != NULL);
+}
+
+static size_t s_matchSecretKey(const char* data, size_t len) {
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sSecretKeys); i++) {
+        size_t keyLen = strlen(sSecretKeys[i]);
+        if((len > keyLen) && (strncmp(data, sSecretKeys[i], keyLen) == 0) &&
+           ((data[keyLen] == ' ') || (data[keyLen] == '='))) {
+            return keyLen + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief copy a wpa_ctrl message, replacing the values of secret parameters
+ * with WLD_WPACTRL_TRACE_REDACTED (up to the end of line)
+ *
+ * @param data message to redact
+ * @param len message length
+ * @param buf output buffer, nul terminated, truncated if too small
+ * @param bufSize output buffer size
+ *
+ * @return length of the redacted message
+ */
+size_t wld_wpaCtrl_traceRedact(const char* data, size_t len, char* buf, size_t bufSize) {
+    ASSERTS_NOT_NULL(buf, 0, ME, "NULL");
+    ASSERTS_TRUE(bufSize > 0, 0, ME, "null buf size");
+    size_t outLen = 0;
+    size_t i = 0;
+    while((data != NULL) && (i < len) && (outLen < bufSize - 1)) {
+        size_t keyLen = 0;
+        if((i == 0) || (data[i - 1] == ' ') || (data[i - 1] == '\n')) {
+            keyLen = s_matchSecretKey(&data[i], len - i);
+        }
+        if(keyLen == 0) {
+            buf[outLen++] = data[i++];
+            continue;
+        }
+        size_t cpLen = SWL_MIN(keyLen, bufSize - 1 - outLen);
+        memcpy(&buf[outLen], &data[i], cpLen);
+        outLen += cpLen;
+        cpLen = SWL_MIN(strlen(WLD_WPACTRL_TRACE_REDACTED), bufSize - 1 - outLen);
+        memcpy(&buf[outLen], WLD_WPACTRL_TRACE_REDACTED, cpLen);
+        outLen += cpLen;
+        for(i += keyLen; (i < len) && (data[i] != '\n'); i++) {
+        }
+    }
+    buf[outLen] = '\0';
+    return outLen;
+}
+
+/*
+ * @brief append one datagram to the trace file, when recording
+ * Secret values are redacted before being written.
+ */
+void wld_wpaCtrl_recordMsg(wld_wpaCtrl_traceDir_e dir, const char* sockName, const char* data, size_t len) {
+    ASSERTS_NOT_NULL(sRecorder.fp, , ME, "not recording");
+    ASSERTS_TRUE(dir < WLD_WPACTRL_TRACE_DIR_MAX, , ME, "invalid dir %d", dir);
+    ASSERTS_NOT_NULL(data, , ME, "NULL");
+    /* each redacted value replaces at least "psk=" */
+    size_t redactedSize = SWL_MIN(len, (size_t) UINT16_MAX) * 4 + sizeof(WLD_WPACTRL_TRACE_REDACTED);
+    char* redacted = malloc(redactedSize);
+    ASSERT_NOT_NULL(redacted, , ME, "fail to alloc trace record");
+    len = wld_wpaCtrl_traceRedact(data, len, redacted, redactedSize);
+    swl_timeSpecMono_t now = swl_timespec_getMonoVal();
+    int64_t deltaUs = swl_timespec_diffToNanosec(&sRecorder.lastTs, &now) / 1000;
+    sRecorder.lastTs = now;
+    size_t sockNameLen = SWL_MIN(swl_str_len(sockName), (size_t) (WLD_WPACTRL_TRACE_SOCK_NAME_MAX - 1));
+    wpaCtrlTraceRecordHdr_t hdr = {
+        .deltaUs = (uint32_t) SWL_MIN(SWL_MAX(deltaUs, (int64_t) 0), (int64_t) UINT32_MAX),
+        .dir = dir,
+        .sockNameLen = sockNameLen,
+        .dataLen = SWL_MIN(len, (size_t) UINT16_MAX),
+    };
+    if((fwrite(&hdr, sizeof(hdr), 1, sRecorder.fp) != 1) ||
+       ((sockNameLen > 0) && (fwrite(sockName, sockNameLen, 1, sRecorder.fp) != 1)) ||
+       ((hdr.dataLen > 0) && (fwrite(redacted, hdr.dataLen, 1, sRecorder.fp) != 1))) {
+        SAH_TRACEZ_ERROR(ME, "fail to write trace record: stop recording");
+        wld_wpaCtrl_stopRecord();
+        free(redacted);
+        return;
+    }
+    free(redacted);
+    sRecorder.nrRecords++;
+}
+
+/**
+ * @brief open a trace file for reading
+ *
+ * @param ppReader pointer to the allocated reader
+ * @param path path of the trace file
+ *
+ * @return SWL_RC_OK on success, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_traceReader_open(wld_wpaCtrl_traceReader_t** ppReader, const char* path) {
+    ASSERT_NOT_NULL(ppReader, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_STR(path, SWL_RC_INVALID_PARAM, ME, "empty path");
+    FILE* fp = fopen(path, "r");
+    ASSERT_NOT_NULL(fp, SWL_RC_ERROR, ME, "fail to open trace file (%s)", path);
+    char magic[sizeof(WLD_WPACTRL_TRACE_MAGIC)] = {0};
+    uint8_t version = 0;
+    if((fread(magic, strlen(WLD_WPACTRL_TRACE_MAGIC), 1, fp) != 1) ||
+       (fread(&version, sizeof(version), 1, fp) != 1) ||
+       (!swl_str_matches(magic, WLD_WPACTRL_TRACE_MAGIC)) || (version != WLD_WPACTRL_TRACE_VERSION)) {
+        SAH_TRACEZ_ERROR(ME, "invalid trace file (%s)", path);
+        fclose(fp);
+        return SWL_RC_INVALID_PARAM;
+    }
+    wld_wpaCtrl_traceReader_t* pReader = calloc(1, sizeof(*pReader));
+    if(pReader == NULL) {
+        SAH_TRACEZ_ERROR(ME, "fail to alloc trace reader");
+        fclose(fp);
+        return SWL_RC_ERROR;
+    }
+    pReader->fp = fp;
+    *ppReader = pReader;
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief read the next record of a trace file
+ *
+ * @param pReader trace reader
+ * @param pRecord filled with the read record; record data is valid until the next read
+ *
+ * @return SWL_RC_OK when a record is read, SWL_RC_DONE at end of file, error code otherwise
+ */
+swl_rc_ne wld_wpaCtrl_traceReader_next(wld_wpaCtrl_traceReader_t* pReader, wld_wpaCtrl_traceRecord_t* pRecord) {
+    ASSERT_NOT_NULL(pReader, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(pRecord, SWL_RC_INVALID_PARAM, ME, "NULL");
+    wpaCtrlTraceRecordHdr_t hdr;
+    size_t nRead = fread(&hdr, sizeof(hdr), 1, pReader->fp);
+    ASSERTS_EQUALS(nRead, 1, SWL_RC_DONE, ME, "end of trace");
+    ASSERT_TRUE(hdr.dir < WLD_WPACTRL_TRACE_DIR_MAX, SWL_RC_ERROR, ME, "invalid record dir %d", hdr.dir);
+    ASSERT_TRUE(hdr.sockNameLen < WLD_WPACTRL_TRACE_SOCK_NAME_MAX, SWL_RC_ERROR, ME, "invalid sock name len %d", hdr.sockNameLen);
+    memset(pRecord, 0, sizeof(*pRecord));
+    if(((hdr.sockNameLen > 0) && (fread(pRecord->sockName, hdr.sockNameLen, 1, pReader->fp) != 1)) ||
+       ((hdr.dataLen > 0) && (fread(pReader->data, hdr.dataLen, 1, pReader->fp) != 1))) {
+        SAH_TRACEZ_ERROR(ME, "truncated trace record");
+        return SWL_RC_ERROR;
+    }
+    pReader->data[hdr.dataLen] = '\0';
+    pReader->tsUs += hdr.deltaUs;
+    pRecord->tsUs = pReader->tsUs;
+    pRecord->dir = hdr.dir;
+    pRecord->data = pReader->data;
+    pRecord->len = hdr.dataLen;
+    return SWL_RC_OK;
+}
+
+void wld_wpaCtrl_traceReader_close(wld_wpaCtrl_traceReader_t** ppReader) {
+    ASSERTS_NOT_NULL(ppReader, , ME, "NULL");
+    ASSERTS_NOT_NULL(*ppReader, , ME, "NULL");
+    fclose((*ppReader)->fp);
+    W_SWL_FREE(*ppReader);
+}
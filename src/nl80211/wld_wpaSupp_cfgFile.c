@@ -68,6 +68,7 @@
 #include "wld_wpaSupp_cfgManager.h"
 #include "wld_wpaSupp_cfgManager_priv.h"
 #include "wld_wpaSupp_cfgFile.h"
+#include "Utils/wld_cfgDoc.h"
 
 #define ME "wSupCfg"
 
@@ -372,18 +373,15 @@ swl_rc_ne wld_wpaSupp_cfgFile_createExt(T_EndPoint* pEP) {
 swl_rc_ne s_cfgFile_update(char* configPath, const char* key, const char* value, bool isGlobal) {
     SAH_TRACEZ_INFO(ME, "%s: updateConfig key:%s, value:%s", configPath, key, value);
 
-    wld_wpaSupp_config_t* config;
-    bool ret = wld_wpaSupp_loadConfig(&config, configPath);
-    ASSERT_TRUE(ret, SWL_RC_ERROR, ME, "Bad config");
-
-    ret = wld_wpaSupp_addConfigParam(config, key, value, isGlobal);
-    ASSERT_TRUE(ret, SWL_RC_ERROR, ME, "Update config error");
+    static const char* const sectionKeys[] = {"network"};
+    wld_cfgDoc_t* pDoc = wld_cfgDoc_get(configPath, sectionKeys, SWL_ARRAY_SIZE(sectionKeys));
+    ASSERT_NOT_NULL(pDoc, SWL_RC_ERROR, ME, "Bad config");
 
-    ret = wld_wpaSupp_writeConfig(config, configPath);
-    ASSERT_TRUE(ret, SWL_RC_ERROR, ME, "Write config error");
+    swl_rc_ne rc = wld_cfgDoc_set(pDoc, isGlobal ? NULL : "network", key, value);
+    ASSERT_TRUE(swl_rc_isOk(rc), SWL_RC_ERROR, ME, "Update config error");
 
-    ret = wld_wpaSupp_deleteConfig(config);
-    ASSERT_TRUE(ret, SWL_RC_ERROR, ME, "Delete config error");
+    rc = wld_cfgDoc_commit(pDoc);
+    ASSERT_TRUE(swl_rc_isOk(rc), SWL_RC_ERROR, ME, "Write config error");
 
     return SWL_RC_OK;
 }
@@ -61,11 +61,11 @@
 ****************************************************************************/
 #include <errno.h>
 #include <swl/fileOps/swl_fileUtils.h>
-#include <swl/fileOps/swl_mapWriterKVP.h>
 #include "wld.h"
 #include "wld_util.h"
 #include "wld_wpaSupp_cfgManager.h"
 #include "wld_wpaSupp_cfgManager_priv.h"
+#include "Utils/wld_cfgWriter.h"
 
 #define ME "fileMgr"
 
@@ -199,41 +199,18 @@ bool wld_wpaSupp_deleteConfig(wld_wpaSupp_config_t* conf) {
 bool wld_wpaSupp_writeConfig(wld_wpaSupp_config_t* conf, char* path) {
     ASSERTS_NOT_NULL(conf, false, ME, "NULL");
     ASSERT_STR(path, false, ME, "Empty path");
-    char tmpName[128];
-    bool ret;
-
-    // create a temporary file in write mode
-    snprintf(tmpName, sizeof(tmpName), "%s.tmp.txt", path);
-    FILE* fptr = fopen(tmpName, "w");
-    ASSERTS_NOT_NULL(fptr, false, ME, "NULL");
 
-    // Write the global config into a temporary file
-    ret = swl_mapWriterKVP_writeToFptrEsc(&(conf->global), fptr, "\\", '\\');
-    if(!ret) {
-        SAH_TRACEZ_ERROR(ME, "writing global config failed");
-        fclose(fptr);
-        unlink(tmpName);
-        return false;
-    }
-
-    // Write the network config into a temporary file
-    fprintf(fptr, "\nnetwork={\n");
-    ret = swl_mapWriterKVP_writeToFptrEsc(&(conf->network), fptr, "\\", '\\');
-    if(!ret) {
-        SAH_TRACEZ_ERROR(ME, "writing network config failed");
-    }
-    fprintf(fptr, "}\n");
+    // Render the whole config, then write it at once
+    wld_cfgWriter_t* pWriter = wld_cfgWriter_start();
+    bool ret = wld_cfgWriter_addMapEsc(pWriter, &(conf->global), "\\", '\\');
+    ASSERT_TRUE(ret, false, ME, "writing global config failed");
 
-    // close the temporary
-    fclose(fptr);
+    wld_cfgWriter_addStr(pWriter, "\nnetwork={\n");
+    ret = wld_cfgWriter_addMapEsc(pWriter, &(conf->network), "\\", '\\');
+    ASSERT_TRUE(ret, false, ME, "writing network config failed");
+    wld_cfgWriter_addStr(pWriter, "}\n");
 
-    // Rename the file
-    if(ret) {
-        ret = rename(tmpName, path) >= 0 ? true : false;
-    }
-    unlink(tmpName);
-
-    return ret;
+    return swl_rc_isOk(wld_cfgWriter_commit(pWriter, path, wld_cfgWriter_getDefaultFlags()));
 }
 
 /**
@@ -129,11 +129,29 @@ swl_rc_ne wld_wpaSupp_ep_getAllStatusDetails(T_EndPoint* pEP, char* reply, size_
     return SWL_RC_OK;
 }
 
+/**
+ * @brief get the endpoint status details, split once into key=value pairs
+ *
+ * @param pEP endpoint
+ * @param reply output buffer, where the STATUS reply is saved
+ * @param replySize output buffer size
+ * @param pStatus output tokenized reply, referring to the reply buffer
+ *
+ * @return SWL_RC_OK on success, error code otherwise
+ */
+swl_rc_ne wld_wpaSupp_ep_getStatusDetails(T_EndPoint* pEP, char* reply, size_t replySize, wld_wpaCtrl_reply_t* pStatus) {
+    ASSERT_NOT_NULL(pStatus, SWL_RC_INVALID_PARAM, ME, "NULL");
+    swl_rc_ne rc = wld_wpaSupp_ep_getAllStatusDetails(pEP, reply, replySize);
+    ASSERT_TRUE(swl_rc_isOk(rc), rc, ME, "failed to get global ep status");
+    return wld_wpaCtrl_reply_parse(pStatus, reply);
+}
+
 swl_rc_ne wld_wpaSupp_ep_getOneStatusDetail(T_EndPoint* pEP, const char* key, char* valStr, size_t valStrSize) {
     char reply[1024] = {0};
-    swl_rc_ne rc = wld_wpaSupp_ep_getAllStatusDetails(pEP, reply, sizeof(reply));
+    wld_wpaCtrl_reply_t status;
+    swl_rc_ne rc = wld_wpaSupp_ep_getStatusDetails(pEP, reply, sizeof(reply), &status);
     ASSERT_TRUE(swl_rc_isOk(rc), rc, ME, "failed to get global ep status");
-    int valStrLen = wld_wpaCtrl_getValueStr(reply, key, valStr, valStrSize);
+    int valStrLen = wld_wpaCtrl_reply_getValueStr(&status, key, valStr, valStrSize);
     ASSERT_FALSE(valStrLen <= 0, SWL_RC_ERROR, ME, "%s: not found status field %s", pEP->Name, key);
     SAH_TRACEZ_INFO(ME, "%s: %s = (%s)", pEP->Name, key, valStr);
     ASSERT_TRUE(valStrLen < (int) valStrSize, SWL_RC_ERROR,
@@ -65,7 +65,7 @@
 #include "wld_util.h"
 #include "wld_wps.h"
 #include "swl/swl_hex.h"
-#include "swl/swl_tlv.h"
+#include "wld_wpaSupp_parser.h"
 
 #define ME "wSupPsr"
 
@@ -184,15 +184,124 @@ SWL_TABLE(sEncrMap,
               {SWL_SECURITY_APMODE_WPA2_P, WPS_SUPPLICANT_ENCR_AES},
               ));
 
+#define WPS_ATTR_HDR_LEN 4
+/* range of attribute ids covered by the direct-indexed parser table */
+#define WPS_ATTR_ID_BASE 0x1000
+#define WPS_ATTR_ID_LAST WPS_ATTR_REQUESTED_DEV_TYPE
+/* max nesting of credential attributes */
+#define WPS_CRED_MAX_DEPTH 2
+
 static inline uint16_t WPS_SUPPLICANT_GET_BE16(const uint8_t* a) {
     return (a[0] << 8) | a[1];
 }
 
-static inline void WPS_SUPPLICANT_SET_BE16(char* a, const uint16_t val) {
+static inline void WPS_SUPPLICANT_SET_BE16(uint8_t* a, const uint16_t val) {
     a[0] = val >> 8;
     a[1] = val & 0xff;
 }
 
+void wld_wpsTlv_initReader(wld_wpsTlvReader_t* pReader, const uint8_t* data, size_t dataLen) {
+    ASSERTS_NOT_NULL(pReader, , ME, "NULL");
+    pReader->pos = data;
+    pReader->end = (data != NULL) ? (data + dataLen) : NULL;
+}
+
+/**
+ * @brief read next attribute, without copying its value
+ *
+ * @param pReader reader
+ * @param pAttr attribute id
+ * @param pLen attribute value length
+ * @param ppVal attribute value, pointing into the read buffer
+ *
+ * @return SWL_RC_OK when an attribute is read, SWL_RC_DONE at end of buffer,
+ *         SWL_RC_ERROR when the attribute overruns the buffer
+ */
+swl_rc_ne wld_wpsTlv_next(wld_wpsTlvReader_t* pReader, uint16_t* pAttr, uint16_t* pLen, const uint8_t** ppVal) {
+    ASSERT_NOT_NULL(pReader, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERTS_NOT_NULL(pReader->pos, SWL_RC_DONE, ME, "no data");
+    ASSERTS_TRUE(pReader->pos < pReader->end, SWL_RC_DONE, ME, "end of data");
+    size_t remainingSize = pReader->end - pReader->pos;
+    ASSERT_FALSE(remainingSize < WPS_ATTR_HDR_LEN, SWL_RC_ERROR, ME, "data buff too small for attr %zu", remainingSize);
+    uint16_t len = WPS_SUPPLICANT_GET_BE16(&pReader->pos[2]);
+    remainingSize -= WPS_ATTR_HDR_LEN;
+    ASSERT_FALSE(len > remainingSize, SWL_RC_ERROR, ME, "data buff too small for value %zu %u", remainingSize, len);
+    W_SWL_SETPTR(pAttr, WPS_SUPPLICANT_GET_BE16(pReader->pos));
+    W_SWL_SETPTR(pLen, len);
+    W_SWL_SETPTR(ppVal, &pReader->pos[WPS_ATTR_HDR_LEN]);
+    pReader->pos += WPS_ATTR_HDR_LEN + len;
+    return SWL_RC_OK;
+}
+
+void wld_wpsTlv_initWriter(wld_wpsTlvWriter_t* pWriter, uint8_t* buf, size_t bufSize) {
+    ASSERTS_NOT_NULL(pWriter, , ME, "NULL");
+    pWriter->buf = buf;
+    pWriter->size = (buf != NULL) ? bufSize : 0;
+    pWriter->len = 0;
+    pWriter->overflow = false;
+}
+
+/**
+ * @brief append an attribute to the written buffer.
+ * When it does not fit, the writer is marked as overflowed, and ignores next attributes.
+ */
+void wld_wpsTlv_put(wld_wpsTlvWriter_t* pWriter, uint16_t attr, uint16_t len, const void* val) {
+    ASSERTS_NOT_NULL(pWriter, , ME, "NULL");
+    ASSERTS_FALSE(pWriter->overflow, , ME, "overflowed");
+    if((size_t) (WPS_ATTR_HDR_LEN + len) > (pWriter->size - pWriter->len)) {
+        SAH_TRACEZ_ERROR(ME, "no room for attr 0x%04x len %u (%zu/%zu)", attr, len, pWriter->len, pWriter->size);
+        pWriter->overflow = true;
+        return;
+    }
+    uint8_t* pos = &pWriter->buf[pWriter->len];
+    WPS_SUPPLICANT_SET_BE16(pos, attr);
+    WPS_SUPPLICANT_SET_BE16(&pos[2], len);
+    if((len > 0) && (val != NULL)) {
+        memcpy(&pos[WPS_ATTR_HDR_LEN], val, len);
+    } else {
+        memset(&pos[WPS_ATTR_HDR_LEN], 0, len);
+    }
+    pWriter->len += WPS_ATTR_HDR_LEN + len;
+}
+
+void wld_wpsTlv_putU8(wld_wpsTlvWriter_t* pWriter, uint16_t attr, uint8_t val) {
+    wld_wpsTlv_put(pWriter, attr, sizeof(val), &val);
+}
+
+void wld_wpsTlv_putBe16(wld_wpsTlvWriter_t* pWriter, uint16_t attr, uint16_t val) {
+    uint8_t beVal[2];
+    WPS_SUPPLICANT_SET_BE16(beVal, val);
+    wld_wpsTlv_put(pWriter, attr, sizeof(beVal), beVal);
+}
+
+/**
+ * @brief start an attribute nesting the next appended ones
+ *
+ * @return offset of the container, to be provided when closing it
+ */
+size_t wld_wpsTlv_openContainer(wld_wpsTlvWriter_t* pWriter, uint16_t attr) {
+    ASSERTS_NOT_NULL(pWriter, 0, ME, "NULL");
+    size_t offset = pWriter->len;
+    wld_wpsTlv_put(pWriter, attr, 0, NULL);
+    return offset;
+}
+
+/**
+ * @brief set the container length, to cover all attributes appended since it was opened
+ */
+void wld_wpsTlv_closeContainer(wld_wpsTlvWriter_t* pWriter, size_t containerOffset) {
+    ASSERTS_NOT_NULL(pWriter, , ME, "NULL");
+    ASSERTS_FALSE(pWriter->overflow, , ME, "overflowed");
+    ASSERT_TRUE(containerOffset + WPS_ATTR_HDR_LEN <= pWriter->len, , ME, "invalid container offset %zu", containerOffset);
+    size_t len = pWriter->len - containerOffset - WPS_ATTR_HDR_LEN;
+    if(len > UINT16_MAX) {
+        SAH_TRACEZ_ERROR(ME, "container too long %zu", len);
+        pWriter->overflow = true;
+        return;
+    }
+    WPS_SUPPLICANT_SET_BE16(&pWriter->buf[containerOffset + 2], len);
+}
+
 swl_rc_ne wpaSupp_buildWpsCredentials(T_AccessPoint* pAP, char* buf, size_t* bufLen) {
     ASSERTS_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERTS_NOT_NULL(buf, SWL_RC_INVALID_PARAM, ME, "NULL");
@@ -201,43 +310,43 @@ swl_rc_ne wpaSupp_buildWpsCredentials(T_AccessPoint* pAP, char* buf, size_t* buf
     ASSERT_NOT_NULL(bufLen, SWL_RC_INVALID_PARAM, ME, "NULL");
     ASSERT_TRUE(*bufLen > 0, SWL_RC_INVALID_PARAM, ME, "Empty");
 
-    swl_tlvList_t tlvList;
-    swl_tlvList_init(&tlvList);
+    wld_wpsTlvWriter_t writer;
+    wld_wpsTlv_initWriter(&writer, (uint8_t*) buf, *bufLen);
 
-    uint8_t networkAttrVal = 0;
-    swl_tlvList_appendType(&tlvList, WPS_ATTR_NETWORK_INDEX, 1, &networkAttrVal, &gtSwl_type_uint8);
-    swl_tlvList_append(&tlvList, WPS_ATTR_SSID, strlen(pSSID->SSID), pSSID->SSID);
-    swl_tlvList_appendType(&tlvList, WPS_ATTR_AUTH_TYPE, 2, swl_table_getMatchingValue(&sAuthMap, 1, 0, &pAP->secModeEnabled), &gtSwl_type_uint16);
-    swl_tlvList_appendType(&tlvList, WPS_ATTR_ENCR_TYPE, 2, swl_table_getMatchingValue(&sEncrMap, 1, 0, &pAP->secModeEnabled), &gtSwl_type_uint16);
-    swl_tlvList_append(&tlvList, WPS_ATTR_NETWORK_KEY, strlen(pAP->keyPassPhrase), pAP->keyPassPhrase);
-    swl_tlvList_append(&tlvList, WPS_ATTR_MAC_ADDR, SWL_MAC_BIN_LEN, pSSID->BSSID);
+    size_t credOffset = wld_wpsTlv_openContainer(&writer, WPS_ATTR_CRED);
+    wld_wpsTlv_putU8(&writer, WPS_ATTR_NETWORK_INDEX, 0);
+    wld_wpsTlv_put(&writer, WPS_ATTR_SSID, strlen(pSSID->SSID), pSSID->SSID);
+    uint16_t* pAuth = (uint16_t*) swl_table_getMatchingValue(&sAuthMap, 1, 0, &pAP->secModeEnabled);
+    uint16_t* pEncr = (uint16_t*) swl_table_getMatchingValue(&sEncrMap, 1, 0, &pAP->secModeEnabled);
+    ASSERT_NOT_NULL(pAuth, SWL_RC_ERROR, ME, "%s: no wps auth type for secMode %d", pAP->alias, pAP->secModeEnabled);
+    ASSERT_NOT_NULL(pEncr, SWL_RC_ERROR, ME, "%s: no wps encr type for secMode %d", pAP->alias, pAP->secModeEnabled);
+    wld_wpsTlv_putBe16(&writer, WPS_ATTR_AUTH_TYPE, *pAuth);
+    wld_wpsTlv_putBe16(&writer, WPS_ATTR_ENCR_TYPE, *pEncr);
+    wld_wpsTlv_put(&writer, WPS_ATTR_NETWORK_KEY, strlen(pAP->keyPassPhrase), pAP->keyPassPhrase);
+    wld_wpsTlv_put(&writer, WPS_ATTR_MAC_ADDR, SWL_MAC_BIN_LEN, pSSID->BSSID);
+    wld_wpsTlv_closeContainer(&writer, credOffset);
+    ASSERT_FALSE(writer.overflow, SWL_RC_ERROR, ME, "%s: buffer too short for credentials (%zu)", pAP->alias, *bufLen);
 
-    swl_tlvList_prepend(&tlvList, WPS_ATTR_CRED, swl_tlvList_getTotalSize(&tlvList), NULL);
+    *bufLen = writer.len;
 
-    size_t remainingLen = *bufLen;
-    swl_rc_ne ret = swl_tlvList_toBuffer(&tlvList, buf, *bufLen, &remainingLen);
-    swl_tlvList_cleanup(&tlvList);
-
-    *bufLen -= remainingLen;
-
-    return ret;
+    return SWL_RC_OK;
 }
 
-static swl_rc_ne s_parseSsid(T_WPSCredentials* creds, uint16_t attr _UNUSED, uint16_t len, uint8_t* data) {
+static swl_rc_ne s_parseSsid(T_WPSCredentials* creds, uint16_t attr _UNUSED, uint16_t len, const uint8_t* data) {
     ASSERT_FALSE(len >= sizeof(creds->ssid), SWL_RC_ERROR, ME, "Invalid ssid size %u", len);
     bool success = swl_str_ncopy(creds->ssid, sizeof(creds->ssid), (const char*) data, len);
     ASSERT_TRUE(success, SWL_RC_ERROR, ME, " FAIL");
     return SWL_RC_OK;
 }
 
-static swl_rc_ne s_parseKey(T_WPSCredentials* creds, uint16_t attr _UNUSED, uint16_t len, uint8_t* data) {
+static swl_rc_ne s_parseKey(T_WPSCredentials* creds, uint16_t attr _UNUSED, uint16_t len, const uint8_t* data) {
     ASSERT_FALSE(len >= sizeof(creds->key), SWL_RC_ERROR, ME, "Invalid key size %u", len);
     bool success = swl_str_ncopy(creds->key, sizeof(creds->key), (const char*) data, len);
     ASSERT_TRUE(success, SWL_RC_ERROR, ME, "FAIL");
     return SWL_RC_OK;
 }
 
-static swl_rc_ne s_parseAuthType(T_WPSCredentials* creds, uint16_t attr _UNUSED, uint16_t len, uint8_t* data) {
+static swl_rc_ne s_parseAuthType(T_WPSCredentials* creds, uint16_t attr _UNUSED, uint16_t len, const uint8_t* data) {
     ASSERT_FALSE(len != 2, SWL_RC_ERROR, ME, "Invalid auth type size %u", len);
     uint16_t auth = WPS_SUPPLICANT_GET_BE16(data);
     if(auth == WPS_SUPPLICANT_AUTH_WPAPSK) {
@@ -250,53 +359,75 @@ static swl_rc_ne s_parseAuthType(T_WPSCredentials* creds, uint16_t attr _UNUSED,
     return SWL_RC_OK;
 }
 
-SWL_TABLE(attrParseTable,
-          ARR(uint16_t index; void* val; ),
-          ARR(swl_type_int16, swl_type_voidPtr),
-          ARR({WPS_ATTR_SSID, (void*) s_parseSsid},
-              {WPS_ATTR_NETWORK_KEY, (void*) s_parseKey},
-              {WPS_ATTR_AUTH_TYPE, (void*) s_parseAuthType}, )
-          );
+typedef swl_rc_ne (* elementParseFun_f) (T_WPSCredentials* creds, uint16_t attr, uint16_t len, const uint8_t* data);
 
-typedef swl_rc_ne (* elementParseFun_f) (T_WPSCredentials* creds, uint16_t attr _UNUSED, uint16_t len, uint8_t* data);
+/*
+ * attribute parsers, indexed by attribute id offset
+ */
+static const elementParseFun_f sAttrParsers[WPS_ATTR_ID_LAST - WPS_ATTR_ID_BASE + 1] = {
+    [WPS_ATTR_SSID - WPS_ATTR_ID_BASE] = s_parseSsid,
+    [WPS_ATTR_NETWORK_KEY - WPS_ATTR_ID_BASE] = s_parseKey,
+    [WPS_ATTR_AUTH_TYPE - WPS_ATTR_ID_BASE] = s_parseAuthType,
+};
 
-swl_rc_ne wpaSup_parseWpsReceiveCredentialsEvt(T_WPSCredentials* creds, char* data, size_t dataLen) {
-    ASSERT_NOT_NULL(creds, SWL_RC_INVALID_PARAM, ME, "NULL");
-    ASSERT_NOT_NULL(data, SWL_RC_INVALID_PARAM, ME, "NULL");
+static elementParseFun_f s_getAttrParser(uint16_t attr) {
+    ASSERTS_TRUE((attr >= WPS_ATTR_ID_BASE) && (attr <= WPS_ATTR_ID_LAST), NULL, ME, "attr out of range");
+    return sAttrParsers[attr - WPS_ATTR_ID_BASE];
+}
 
-    SAH_TRACEZ_INFO(ME, "Parse cred %zu -%s-", dataLen, data);
-    size_t binLen = (dataLen / 2) + (dataLen % 2);
-    swl_bit8_t binData[binLen];
-    bool success = swl_hex_toBytes(binData, binLen, data, dataLen);
-    ASSERT_TRUE(success, SWL_RC_ERROR, ME, "HEX CONVERT FAIL");
-    size_t index = 0;
-    while(index < binLen) {
-        size_t remainingSize = binLen - index;
-        ASSERT_FALSE(remainingSize < 4, SWL_RC_ERROR, ME, "data buff too small for attr %zu", remainingSize);
-        uint16_t attr = WPS_SUPPLICANT_GET_BE16(&binData[index]);
-        index += 2;
-        uint16_t len = WPS_SUPPLICANT_GET_BE16(&binData[index]);
+static swl_rc_ne s_parseAttrs(T_WPSCredentials* creds, const uint8_t* data, size_t dataLen, uint32_t depth) {
+    wld_wpsTlvReader_t reader;
+    wld_wpsTlv_initReader(&reader, data, dataLen);
+    uint16_t attr = 0;
+    uint16_t len = 0;
+    const uint8_t* val = NULL;
+    swl_rc_ne rc;
+    while((rc = wld_wpsTlv_next(&reader, &attr, &len, &val)) == SWL_RC_OK) {
         ASSERT_TRUE(len != 0, SWL_RC_ERROR, ME, "ZERO LEN");
-        index += 2;
-        remainingSize = binLen - index;
-        ASSERT_FALSE(len > remainingSize, SWL_RC_ERROR, ME, "data buff too small for hex %zu %u", remainingSize, len);
         SAH_TRACEZ_INFO(ME, "parsing attr(%u), len(%u)", attr, len);
-
-        void** func = (void**) swl_table_getMatchingValue(&attrParseTable, 1, 0, &attr);
-        if(func != NULL) {
-            elementParseFun_f myFun = (elementParseFun_f) (*func);
-            swl_rc_ne ret = myFun(creds, attr, len, &binData[index]);
-            ASSERT_FALSE(ret < SWL_RC_OK, SWL_RC_ERROR, ME, "Parsing Fail");
-        } else {
-            SAH_TRACEZ_INFO(ME, "Unsupported element id %d", attr);
+        if(attr == WPS_ATTR_CRED) {
+            // credential content is made of nested attributes
+            ASSERT_TRUE(depth < WPS_CRED_MAX_DEPTH, SWL_RC_ERROR, ME, "credential nested too deep");
+            rc = s_parseAttrs(creds, val, len, depth + 1);
+            ASSERTS_FALSE(rc < SWL_RC_OK, rc, ME, "Parsing Fail");
+            continue;
         }
-        // Skip empty data for WPS_ATTR_CRED attr
-        if(attr != WPS_ATTR_CRED) {
-            index += len;
+        elementParseFun_f fParse = s_getAttrParser(attr);
+        if(fParse == NULL) {
+            SAH_TRACEZ_INFO(ME, "Unsupported element id %d", attr);
+            continue;
         }
+        ASSERT_FALSE(fParse(creds, attr, len, val) < SWL_RC_OK, SWL_RC_ERROR, ME, "Parsing Fail");
     }
+    ASSERTS_EQUALS(rc, SWL_RC_DONE, SWL_RC_ERROR, ME, "malformed attributes");
+    return SWL_RC_OK;
+}
+
+/**
+ * @brief parse WPS credentials from binary attributes
+ */
+swl_rc_ne wpaSup_parseWpsCredentials(T_WPSCredentials* creds, const uint8_t* data, size_t dataLen) {
+    ASSERT_NOT_NULL(creds, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(data, SWL_RC_INVALID_PARAM, ME, "NULL");
+    swl_rc_ne rc = s_parseAttrs(creds, data, dataLen, 0);
+    ASSERTS_FALSE(rc < SWL_RC_OK, rc, ME, "Parsing Fail");
     SAH_TRACEZ_INFO(ME, "Retrieved credentials: SSID: %s; security mode: %d; key: %s",
                     creds->ssid, creds->secMode, creds->key);
-
     return SWL_RC_OK;
 }
+
+/**
+ * @brief parse WPS credentials from hex dumped attributes, as reported by WPS-CRED-RECEIVED event
+ */
+swl_rc_ne wpaSup_parseWpsReceiveCredentialsEvt(T_WPSCredentials* creds, char* data, size_t dataLen) {
+    ASSERT_NOT_NULL(creds, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(data, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_TRUE(dataLen > 0, SWL_RC_INVALID_PARAM, ME, "Empty");
+
+    SAH_TRACEZ_INFO(ME, "Parse cred %zu -%s-", dataLen, data);
+    size_t binLen = (dataLen / 2) + (dataLen % 2);
+    swl_bit8_t binData[binLen];
+    bool success = swl_hex_toBytes(binData, binLen, data, dataLen);
+    ASSERT_TRUE(success, SWL_RC_ERROR, ME, "HEX CONVERT FAIL");
+    return wpaSup_parseWpsCredentials(creds, binData, binLen);
+}
@@ -81,6 +81,9 @@
 #include "wld_chanmgt.h"
 #include "Utils/wld_autoCommitMgr.h"
 #include "wld_nl80211_types.h"
+#include "wld_wpaCtrl_api.h"
+#include "wld_wpaCtrl_trace.h"
+#include "wld_hostapd_cfgManager.h"
 #include "Features/wld_persist.h"
 #include "wld/wld_vendorModule_mgr.h"
 #include "wld/wld_linuxIfUtils.h"
@@ -200,6 +203,11 @@ bool wld_plugin_start() {
     }
     swl_timespec_getMono(&initTime);
 
+    const char* recordFile = getenv(WLD_WPACTRL_TRACE_ENV_VAR);
+    if(!swl_str_isEmpty(recordFile)) {
+        wld_wpaCtrl_startRecord(recordFile);
+    }
+
     SAH_TRACEZ_WARNING(ME, "Initializing wld (%s:%s)", __DATE__, __TIME__);
 
     swl_lib_initialize(wld_plugin_amx);
@@ -245,6 +253,8 @@ void wld_cleanup() {
     wld_deleteAllRadios();
     wld_ssid_cleanAll();
     wld_event_destroy();
+    wld_wpaCtrl_flushConnPool(NULL);
+    wld_wpaCtrl_stopRecord();
     wld_nl80211_cleanupAll();
     wld_channel_cleanAll();
     wld_unregisterAllVendors();
@@ -570,6 +580,8 @@ void wld_deleteRadioObj(T_Radio* pRad) {
     free(pRad->dbgOutput);
     pRad->dbgOutput = NULL;
 
+    wld_hostapd_deleteConfigSnapshot(&pRad->hapdCfgSnapshot);
+
     amxc_llist_it_take(&pRad->it);
     free(pRad);
 
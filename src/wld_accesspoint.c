@@ -89,6 +89,7 @@
 #include "Utils/wld_autoNeighAdd.h"
 #include "wld_ap_nl80211.h"
 #include "wld_hostapd_ap_api.h"
+#include "wld_wpaCtrlInterface.h"
 #include "wld_dm_trans.h"
 #include "Features/wld_persist.h"
 #include "wld_extMod.h"
@@ -2155,7 +2156,11 @@ void wld_vap_syncNrDev(T_AccessPoint* pAP) {
         if(pAP->AssociatedDevice[i]->Active) {
             active++;
         }
+        wld_ad_refreshStaCounters(pAP, pAP->AssociatedDevice[i]);
     }
+#ifdef WLD_DEBUG_STA_COUNTERS
+    wld_ad_checkStaCounters(pAP);
+#endif
 
     SAH_TRACEZ_INFO(ME, "%s: sync Assocdev %u %u", pAP->alias,
                     active, pAP->ActiveAssociatedDeviceNumberOfEntries);
@@ -2666,6 +2671,64 @@ amxd_status_t _AccessPoint_disassocStation(amxd_object_t* object _UNUSED,
     return amxd_status_ok;
 }
 
+static void s_dumpWpaCtrlEvtStats(T_AccessPoint* pAP, amxc_var_t* retMap) {
+    for(uint32_t i = 0; i < WLD_WPACTRL_EVT_CLASS_MAX; i++) {
+        wld_wpaCtrl_evtClassStats_t stats;
+        if(!wld_wpaCtrlInterface_getEvtClassStats(pAP->wpaCtrlInterface, i, &stats)) {
+            amxc_var_add_key(cstring_t, retMap, "Error", "No wpaCtrl interface");
+            return;
+        }
+        amxc_var_t* pClassMap = amxc_var_add_key(amxc_htable_t, retMap, wld_wpaCtrl_evtClass_str[i], NULL);
+        amxc_var_add_key(uint32_t, pClassMap, "NrPassed", stats.nrPassed);
+        amxc_var_add_key(uint32_t, pClassMap, "NrRateDropped", stats.nrRateDropped);
+        amxc_var_add_key(uint32_t, pClassMap, "NrSampledOut", stats.nrSampledOut);
+    }
+    wld_wpaCtrl_rxStats_t rxStats;
+    if(wld_wpaCtrlInterface_getEvtRxStats(pAP->wpaCtrlInterface, &rxStats)) {
+        amxc_var_t* pRxMap = amxc_var_add_key(amxc_htable_t, retMap, "Rx", NULL);
+        amxc_var_add_key(uint32_t, pRxMap, "NrWakeups", rxStats.nrWakeups);
+        amxc_var_add_key(uint64_t, pRxMap, "NrMsgs", rxStats.nrMsgs);
+        amxc_var_add_key(uint32_t, pRxMap, "LastMsgsPerWakeup", rxStats.lastMsgsPerWakeup);
+        amxc_var_add_key(uint32_t, pRxMap, "MaxMsgsPerWakeup", rxStats.maxMsgsPerWakeup);
+        amxc_var_add_key(uint32_t, pRxMap, "NrBudgetExhausted", rxStats.nrBudgetExhausted);
+    }
+}
+
+/*
+ * Event class policies are common to all wpaCtrl interfaces.
+ * When a class is given, its provided policy fields are updated before dumping.
+ */
+static void s_setWpaCtrlEvtPolicy(amxc_var_t* args, amxc_var_t* retMap) {
+    const char* className = GET_CHAR(args, "class");
+    if(!swl_str_isEmpty(className)) {
+        wld_wpaCtrl_evtClass_e evtClass = swl_conv_charToEnum(className, wld_wpaCtrl_evtClass_str,
+                                                              WLD_WPACTRL_EVT_CLASS_MAX, WLD_WPACTRL_EVT_CLASS_MAX);
+        wld_wpaCtrl_evtClassPolicy_t policy;
+        swl_rc_ne rc = wld_wpaCtrl_getEvtClassPolicy(evtClass, &policy);
+        if(swl_rc_isOk(rc)) {
+            if(GET_ARG(args, "maxRate") != NULL) {
+                policy.maxRate = GET_UINT32(args, "maxRate");
+            }
+            if(GET_ARG(args, "burst") != NULL) {
+                policy.burst = GET_UINT32(args, "burst");
+            }
+            if(GET_ARG(args, "sampleWindowMs") != NULL) {
+                policy.sampleWindowMs = GET_UINT32(args, "sampleWindowMs");
+            }
+            rc = wld_wpaCtrl_setEvtClassPolicy(evtClass, &policy);
+        }
+        amxc_var_add_key(cstring_t, retMap, "Result", swl_rc_toString(rc));
+    }
+    for(uint32_t i = 0; i < WLD_WPACTRL_EVT_CLASS_MAX; i++) {
+        wld_wpaCtrl_evtClassPolicy_t policy;
+        wld_wpaCtrl_getEvtClassPolicy(i, &policy);
+        amxc_var_t* pClassMap = amxc_var_add_key(amxc_htable_t, retMap, wld_wpaCtrl_evtClass_str[i], NULL);
+        amxc_var_add_key(uint32_t, pClassMap, "MaxRate", policy.maxRate);
+        amxc_var_add_key(uint32_t, pClassMap, "Burst", policy.burst);
+        amxc_var_add_key(uint32_t, pClassMap, "SampleWindowMs", policy.sampleWindowMs);
+    }
+}
+
 amxd_status_t _AccessPoint_debug(amxd_object_t* obj,
                                  amxd_function_t* func _UNUSED,
                                  amxc_var_t* args,
@@ -2764,6 +2827,10 @@ amxd_status_t _AccessPoint_debug(amxd_object_t* obj,
         const char* macStr = GET_CHAR(args, "macStr");
         swl_rc_ne ret = wld_ap_hostapd_delMacFilteringEntry(pAP, (char*) macStr);
         amxc_var_add_key(cstring_t, retMap, "Result", swl_rc_toString(ret));
+    } else if(swl_str_matchesIgnoreCase(feature, "wpaCtrlEvtStats")) {
+        s_dumpWpaCtrlEvtStats(pAP, retMap);
+    } else if(swl_str_matchesIgnoreCase(feature, "wpaCtrlEvtPolicy")) {
+        s_setWpaCtrlEvtPolicy(args, retMap);
     } else if(!strcasecmp(feature, "writeSta")) {
         swl_print_args_t tmpArgs = g_swl_print_json;
         FILE* fp = fopen("/tmp/vapStaDump.txt", "w");
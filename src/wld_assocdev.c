@@ -108,12 +108,6 @@ SWL_TABLE(modeToStandard,
 #define FAST_RECONNECT_EVENT_TIMEOUT 30
 #define FAST_RECONNECT_USER_MIN_TIME_MS 1500
 
-#define X_WLD_AD_DC_LOG_T(X, Y) \
-    X(Y, gtSwl_type_macBin, macAddress) \
-    X(Y, gtSwl_type_timeSpecMono, dcTime)
-SWL_TT(tWld_ad_dcLog, wld_ad_dcLog_t, X_WLD_AD_DC_LOG_T, )
-char* tupleNames[] = {"macAddress", "dcTime"};
-
 const char* fastReconnectTypes[WLD_FAST_RECONNECT_MAX] = {"Default", "OnStateChange", "OnScan", "User"};
 
 static void s_incrementObjCounter(amxd_object_t* obj, char* counterName) {
@@ -137,20 +131,13 @@ static void s_incrementFastReconnectType(T_AccessPoint* pAP, wld_fastReconnectTy
     s_incrementObjCounter(counter, "Count");
 }
 
-static wld_ad_dcLog_t* s_findDcEntry(T_AccessPoint* pAP, swl_macBin_t* macAddress) {
-    SAH_TRACEZ_INFO(ME, "%s: search %u", pAP->alias, swl_unLiList_size(&pAP->staDcList.list));
-    swl_unLiListIt_t listIt;
-    swl_unLiList_for_each(listIt, &pAP->staDcList.list) {
-        wld_ad_dcLog_t* dcEntry = listIt.data;
-        if(swl_mac_binMatches(&dcEntry->macAddress, macAddress)) {
-            return dcEntry;
-        }
-    }
-    return NULL;
+static wld_apDcLog_entry_t* s_findDcEntry(T_AccessPoint* pAP, swl_macBin_t* macAddress) {
+    SAH_TRACEZ_INFO(ME, "%s: search %u", pAP->alias, wld_apDcLog_getCount(&pAP->staDcLog));
+    return wld_apDcLog_find(&pAP->staDcLog, macAddress);
 }
 
 
-static void s_dcEntryConnected(T_AccessPoint* pAP, wld_ad_dcLog_t* entry) {
+static void s_dcEntryConnected(T_AccessPoint* pAP, wld_apDcLog_entry_t* entry) {
     ASSERTI_NOT_NULL(entry, , ME, "NULL");
     swl_timeSpecMono_t now;
     swl_timespec_getMono(&now);
@@ -247,6 +234,97 @@ static void s_dcEntryConnected(T_AccessPoint* pAP, wld_ad_dcLog_t* entry) {
 
 SWL_NTT(gtWld_ad_disassocEvent, wld_ad_disassocEvent_t, X_WLD_AD_DISASSOC_EVENT, )
 
+/*
+ * Station changes pending delivery to gWld_queue_sta_onBatchChangeEvent subscribers.
+ * Changes are merged per station, and delivered once per event loop turn, or per window if configured.
+ */
+static struct {
+    wld_ad_batchChange_t* changes;
+    uint32_t nrChanges;
+    uint32_t maxChanges;
+    uint32_t windowMs;
+    amxp_timer_t* timer;
+} s_batchChanges;
+
+static void s_flushBatchChanges(amxp_timer_t* timer _UNUSED, void* userdata _UNUSED) {
+    wld_ad_batchChange_t* changes = s_batchChanges.changes;
+    uint32_t nrChanges = s_batchChanges.nrChanges;
+    s_batchChanges.changes = NULL;
+    s_batchChanges.nrChanges = 0;
+    s_batchChanges.maxChanges = 0;
+    amxp_timer_delete(&s_batchChanges.timer);
+
+    /* stations changing during delivery are added to a new batch */
+    for(uint32_t i = 0; i < nrChanges; i++) {
+        if(changes[i].ad != NULL) {
+            changes[i].ad->pendingBatchChange = 0;
+        }
+    }
+    if(nrChanges > 0) {
+        SAH_TRACEZ_INFO(ME, "deliver %u coalesced sta changes", nrChanges);
+        wld_ad_batchChangeEvent_t event = {.nrChanges = nrChanges, .changes = changes};
+        wld_event_trigger_callback(gWld_queue_sta_onBatchChangeEvent, &event);
+    }
+    free(changes);
+}
+
+static void s_addBatchChange(T_AccessPoint* pAP, T_AssociatedDevice* pAD, wld_ad_changeEvent_e event) {
+    wld_ad_batchChange_t* change = NULL;
+    if(pAD->pendingBatchChange != 0) {
+        /* always update a pending entry, even if subscribers left: it must not keep a destroyed station */
+        change = &s_batchChanges.changes[pAD->pendingBatchChange - 1];
+    } else {
+        ASSERTS_TRUE(wld_event_hasSubscribers(gWld_queue_sta_onBatchChangeEvent), , ME, "no batch subscriber");
+        if(s_batchChanges.nrChanges == s_batchChanges.maxChanges) {
+            uint32_t newMax = SWL_MAX(2 * s_batchChanges.maxChanges, 16U);
+            wld_ad_batchChange_t* newChanges = realloc(s_batchChanges.changes, newMax * sizeof(wld_ad_batchChange_t));
+            ASSERT_NOT_NULL(newChanges, , ME, "fail to grow sta change batch to %u", newMax);
+            s_batchChanges.changes = newChanges;
+            s_batchChanges.maxChanges = newMax;
+        }
+        change = &s_batchChanges.changes[s_batchChanges.nrChanges];
+        memset(change, 0, sizeof(*change));
+        change->ad = pAD;
+        memcpy(change->macAddress.bMac, pAD->MACAddress, SWL_MAC_BIN_LEN);
+        s_batchChanges.nrChanges++;
+        pAD->pendingBatchChange = s_batchChanges.nrChanges;
+    }
+    change->vap = pAP;
+    change->changeMask |= SWL_BIT_SHIFT(event);
+    change->lastChangeType = event;
+    change->nrEvents++;
+    if(event == WLD_AD_CHANGE_EVENT_DESTROY) {
+        change->ad = NULL;
+        pAD->pendingBatchChange = 0;
+    }
+
+    if(s_batchChanges.timer == NULL) {
+        amxp_timer_new(&s_batchChanges.timer, s_flushBatchChanges, NULL);
+        amxp_timer_start(s_batchChanges.timer, s_batchChanges.windowMs);
+    }
+}
+
+/**
+ * Set the time window in which station changes are coalesced before delivery
+ * to gWld_queue_sta_onBatchChangeEvent subscribers.
+ * With 0, changes are delivered at the next event loop turn.
+ */
+void wld_ad_setBatchChangeWindow(uint32_t windowMs) {
+    s_batchChanges.windowMs = windowMs;
+}
+
+uint32_t wld_ad_getBatchChangeWindow() {
+    return s_batchChanges.windowMs;
+}
+
+/**
+ * Immediately deliver all pending coalesced station changes.
+ */
+void wld_ad_flushBatchChanges() {
+    ASSERTS_NOT_EQUALS(s_batchChanges.nrChanges, 0, , ME, "no pending changes");
+    s_flushBatchChanges(NULL, NULL);
+}
+
 static void s_sendChangeEvent(T_AccessPoint* pAP, T_AssociatedDevice* pAD, wld_ad_changeEvent_e event, void* data) {
     wld_ad_changeEvent_t change;
     change.vap = pAP;
@@ -254,6 +332,148 @@ static void s_sendChangeEvent(T_AccessPoint* pAP, T_AssociatedDevice* pAD, wld_a
     change.changeType = event;
     change.data = data;
     wld_event_trigger_callback(gWld_queue_sta_onChangeEvent, &change);
+    s_addBatchChange(pAP, pAD, event);
+}
+
+static uint8_t s_getRssiBucket(int32_t signalStrength) {
+    int32_t rssi = SWL_MAX(WLD_AD_RSSI_BUCKET_MIN, SWL_MIN(WLD_AD_RSSI_BUCKET_MAX, signalStrength));
+    return (uint8_t) (rssi - WLD_AD_RSSI_BUCKET_MIN);
+}
+
+static void s_getStaCountKey(T_AccessPoint* pAP, T_AssociatedDevice* pAD, wld_ad_staCountKey_t* key) {
+    memset(key, 0, sizeof(wld_ad_staCountKey_t));
+    key->pAP = pAP;
+    key->pRad = pAP->pRadio;
+    key->active = pAD->Active;
+    key->authenticated = pAD->AuthenticationState;
+    key->video = (pAD->deviceType == DEVICE_TYPE_VIDEO);
+    key->operatingStandard = pAD->operatingStandard;
+    key->freqCapabilities = pAD->assocCaps.freqCapabilities;
+    if((key->freqCapabilities == 0) && (pAP->pRadio != NULL)) {
+        key->freqCapabilities = SWL_BIT_SHIFT(pAP->pRadio->operatingFrequencyBand);
+    }
+    key->rssiBucket = s_getRssiBucket(pAD->SignalStrength);
+}
+
+static bool s_staCountKeyMatches(const wld_ad_staCountKey_t* key1, const wld_ad_staCountKey_t* key2) {
+    return (key1->pAP == key2->pAP) &&
+           (key1->pRad == key2->pRad) &&
+           (key1->active == key2->active) &&
+           (key1->authenticated == key2->authenticated) &&
+           (key1->video == key2->video) &&
+           (key1->operatingStandard == key2->operatingStandard) &&
+           (key1->freqCapabilities == key2->freqCapabilities) &&
+           (key1->rssiBucket == key2->rssiBucket);
+}
+
+static void s_updateStaCounters(wld_ad_staCounters_t* counters, const wld_ad_staCountKey_t* key, int32_t delta) {
+    if(key->authenticated) {
+        counters->nrAuthenticated += delta;
+    }
+    if(!key->active) {
+        return;
+    }
+    counters->nrActive += delta;
+    if(key->video) {
+        counters->nrActiveVideo += delta;
+    }
+    if(key->operatingStandard < SWL_RADSTD_MAX) {
+        counters->nrActivePerStd[key->operatingStandard] += delta;
+    }
+    for(uint32_t band = 0; band < SWL_FREQ_BAND_EXT_MAX; band++) {
+        if(SWL_BIT_IS_SET(key->freqCapabilities, band)) {
+            counters->nrActivePerBand[band] += delta;
+        }
+    }
+    counters->nrActivePerRssi[key->rssiBucket] += delta;
+}
+
+static void s_accountSta(const wld_ad_staCountKey_t* key, int32_t delta) {
+    if(key->pAP != NULL) {
+        s_updateStaCounters(&key->pAP->staCounters, key, delta);
+    }
+    if(key->pRad != NULL) {
+        s_updateStaCounters(&key->pRad->staCounters, key, delta);
+    }
+}
+
+static void s_unaccountSta(T_AssociatedDevice* pAD) {
+    s_accountSta(&pAD->staCountKey, -1);
+    memset(&pAD->staCountKey, 0, sizeof(wld_ad_staCountKey_t));
+}
+
+/**
+ * Update the aggregate station counters of the accesspoint and its radio
+ * with the current state of the given station.
+ * Must be called each time the station active / authenticated state, device type,
+ * operating standard, frequency capabilities or signal strength is changed.
+ */
+void wld_ad_refreshStaCounters(T_AccessPoint* pAP, T_AssociatedDevice* pAD) {
+    ASSERTS_NOT_NULL(pAP, , ME, "NULL");
+    ASSERTS_NOT_NULL(pAD, , ME, "NULL");
+    wld_ad_staCountKey_t newKey;
+    s_getStaCountKey(pAP, pAD, &newKey);
+    ASSERTS_FALSE(s_staCountKeyMatches(&pAD->staCountKey, &newKey), , ME, "no change");
+    s_accountSta(&pAD->staCountKey, -1);
+    s_accountSta(&newKey, 1);
+    pAD->staCountKey = newKey;
+}
+
+/**
+ * Check that the aggregate station counters of the accesspoint match
+ * the current state of its stations.
+ * Returns true if counters are consistent, false otherwise.
+ */
+bool wld_ad_checkStaCounters(T_AccessPoint* pAP) {
+    ASSERT_NOT_NULL(pAP, false, ME, "NULL");
+    wld_ad_staCounters_t expected;
+    memset(&expected, 0, sizeof(expected));
+    bool ok = true;
+    for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
+        T_AssociatedDevice* pAD = pAP->AssociatedDevice[i];
+        if(pAD == NULL) {
+            continue;
+        }
+        wld_ad_staCountKey_t key;
+        s_getStaCountKey(pAP, pAD, &key);
+        if(!s_staCountKeyMatches(&pAD->staCountKey, &key)) {
+            SAH_TRACEZ_ERROR(ME, "%s: sta %s not accounted with its current state", pAP->alias, pAD->Name);
+            ok = false;
+        }
+        s_updateStaCounters(&expected, &key, 1);
+    }
+    if(memcmp(&expected, &pAP->staCounters, sizeof(expected)) != 0) {
+        SAH_TRACEZ_ERROR(ME, "%s: sta counters mismatch: active %u/%u auth %u/%u video %u/%u", pAP->alias,
+                         pAP->staCounters.nrActive, expected.nrActive,
+                         pAP->staCounters.nrAuthenticated, expected.nrAuthenticated,
+                         pAP->staCounters.nrActiveVideo, expected.nrActiveVideo);
+        ok = false;
+    }
+    return ok;
+}
+
+const wld_ad_staCounters_t* wld_ad_getStaCounters(T_AccessPoint* pAP) {
+    ASSERT_NOT_NULL(pAP, NULL, ME, "NULL");
+    return &pAP->staCounters;
+}
+
+const wld_ad_staCounters_t* wld_rad_getStaCounters(T_Radio* pRad) {
+    ASSERT_NOT_NULL(pRad, NULL, ME, "NULL");
+    return &pRad->staCounters;
+}
+
+/**
+ * Return the number of active stations with a signal strength strictly below threshold (dBm),
+ * based on the given aggregate counters.
+ */
+uint32_t wld_ad_getFarStaCountFromCounters(const wld_ad_staCounters_t* counters, int threshold) {
+    ASSERTS_NOT_NULL(counters, 0, ME, "NULL");
+    uint32_t count = 0;
+    int32_t nrBuckets = SWL_MIN(threshold, WLD_AD_RSSI_BUCKET_MAX + 1) - WLD_AD_RSSI_BUCKET_MIN;
+    for(int32_t i = 0; i < nrBuckets; i++) {
+        count += counters->nrActivePerRssi[i];
+    }
+    return count;
 }
 
 static void s_sendDisassocNotification(T_AccessPoint* pAP, T_AssociatedDevice* pAD) {
@@ -455,6 +675,7 @@ void wld_ad_destroy_associatedDevice(T_AccessPoint* pAP, int index) {
         free(afSta);
     }
 
+    s_unaccountSta(pAD);
     if(pAD->Active) {
         pAD->Active = false;
         pAD->AuthenticationState = false;
@@ -714,7 +935,191 @@ void wld_ad_printDbmDoubleArray(char* buf, uint32_t bufSize, double* array, uint
 static void wld_update_station_stats(T_AccessPoint* pAP) {
     for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
         s_updateStationStatsHistory(pAP->AssociatedDevice[i]);
+        wld_ad_refreshStaCounters(pAP, pAP->AssociatedDevice[i]);
+    }
+}
+
+/* Global station stats generation, incremented each time a station stats record changes */
+static uint64_t s_statsGeneration = 0;
+
+static void s_fillStatsRecord(T_AccessPoint* pAP, T_AssociatedDevice* pAD, wld_ad_statsRecord_t* record) {
+    memset(record, 0, sizeof(*record));
+    record->txBytes = pAD->TxBytes;
+    record->rxBytes = pAD->RxBytes;
+    record->rxFailures = pAD->RxFailures;
+    record->lastSampleTimeMs = (uint64_t) pAD->lastSampleTime.tv_sec * 1000 + pAD->lastSampleTime.tv_nsec / 1000000;
+    record->apIndex = pAP->ref_index;
+    record->txPacketCount = pAD->TxPacketCount;
+    record->rxPacketCount = pAD->RxPacketCount;
+    record->txFailures = pAD->TxFailures;
+    record->retransmissions = pAD->Retransmissions;
+    record->lastDataDownlinkRate = pAD->LastDataDownlinkRate;
+    record->lastDataUplinkRate = pAD->LastDataUplinkRate;
+    record->maxDownlinkRateReached = pAD->MaxDownlinkRateReached;
+    record->maxUplinkRateReached = pAD->MaxUplinkRateReached;
+    record->inactive = pAD->Inactive;
+    record->connectionDuration = pAD->connectionDuration;
+    record->associationTime = pAD->associationTime;
+    record->signalStrength = pAD->SignalStrength;
+    record->noise = pAD->noise;
+    record->signalNoiseRatio = pAD->SignalNoiseRatio;
+    memcpy(record->macAddress, pAD->MACAddress, ETHER_ADDR_LEN);
+    record->downlinkMcs = pAD->DownlinkMCS;
+    record->uplinkMcs = pAD->UplinkMCS;
+    record->downlinkNss = pAD->downLinkRateSpec.numberOfSpatialStream;
+    record->uplinkNss = pAD->upLinkRateSpec.numberOfSpatialStream;
+    record->operatingStandard = pAD->operatingStandard;
+    record->flags = (pAD->Active ? WLD_AD_STATS_RECORD_FLAG_ACTIVE : 0)
+        | (pAD->AuthenticationState ? WLD_AD_STATS_RECORD_FLAG_AUTHENTICATED : 0)
+        | (pAD->powerSave ? WLD_AD_STATS_RECORD_FLAG_POWERSAVE : 0);
+}
+
+/*
+ * Refresh the cached stats record of a station.
+ * The stats generation is incremented if any field, besides the sample time, has changed
+ * since the previous export.
+ */
+static const wld_ad_statsRecord_t* s_refreshStatsRecord(T_AccessPoint* pAP, T_AssociatedDevice* pAD) {
+    wld_ad_statsRecord_t record;
+    s_fillStatsRecord(pAP, pAD, &record);
+    uint64_t sampleTimeMs = record.lastSampleTimeMs;
+    record.generation = pAD->statsRecord.generation;
+    record.lastSampleTimeMs = pAD->statsRecord.lastSampleTimeMs;
+    if((record.generation == 0) || (memcmp(&record, &pAD->statsRecord, sizeof(record)) != 0)) {
+        s_statsGeneration++;
+        record.generation = s_statsGeneration;
+    }
+    record.lastSampleTimeMs = sampleTimeMs;
+    pAD->statsRecord = record;
+    return &pAD->statsRecord;
+}
+
+static void s_exportApStaStats(T_AccessPoint* pAP, uint64_t sinceGeneration, wld_ad_statsSnapshot_t* pSnapshot,
+                               wld_ad_statsRecord_t* records, uint32_t maxRecords) {
+    for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
+        T_AssociatedDevice* pAD = pAP->AssociatedDevice[i];
+        if(pAD == NULL) {
+            continue;
+        }
+        pSnapshot->nrStations++;
+        const wld_ad_statsRecord_t* record = s_refreshStatsRecord(pAP, pAD);
+        if(record->generation <= sinceGeneration) {
+            continue;
+        }
+        pSnapshot->nrChanged++;
+        if(pSnapshot->nrRecords < maxRecords) {
+            records[pSnapshot->nrRecords] = *record;
+            pSnapshot->nrRecords++;
+        }
+    }
+}
+
+static void s_initStatsSnapshot(wld_ad_statsSnapshot_t* pSnapshot) {
+    memset(pSnapshot, 0, sizeof(*pSnapshot));
+    pSnapshot->version = WLD_AD_STATS_RECORD_VERSION;
+    pSnapshot->recordSize = sizeof(wld_ad_statsRecord_t);
+}
+
+/**
+ * Export the statistics of all stations of an accesspoint in a single pass,
+ * without going through the data model.
+ * Statistics are exported as currently known, this does not trigger a driver update.
+ *
+ * @param pAP the accesspoint of which to export stations
+ * @param sinceGeneration only export stations of which the stats changed after this generation.
+ * Use 0 to export all stations, or the generation returned by a previous export to only get changes.
+ * @param pSnapshot the export header to fill
+ * @param records caller provided array, filled with up to maxRecords station records
+ * @param maxRecords size of the records array
+ */
+swl_rc_ne wld_ad_exportStaStats(T_AccessPoint* pAP, uint64_t sinceGeneration, wld_ad_statsSnapshot_t* pSnapshot,
+                                wld_ad_statsRecord_t* records, uint32_t maxRecords) {
+    ASSERT_NOT_NULL(pAP, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(pSnapshot, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_TRUE((records != NULL) || (maxRecords == 0), SWL_RC_INVALID_PARAM, ME, "NULL");
+    s_initStatsSnapshot(pSnapshot);
+    s_exportApStaStats(pAP, sinceGeneration, pSnapshot, records, maxRecords);
+    pSnapshot->generation = s_statsGeneration;
+    return SWL_RC_OK;
+}
+
+/**
+ * Export the statistics of all stations of all accesspoints of a radio in a single pass.
+ * See wld_ad_exportStaStats.
+ */
+swl_rc_ne wld_rad_exportStaStats(T_Radio* pRad, uint64_t sinceGeneration, wld_ad_statsSnapshot_t* pSnapshot,
+                                 wld_ad_statsRecord_t* records, uint32_t maxRecords) {
+    ASSERT_NOT_NULL(pRad, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_NOT_NULL(pSnapshot, SWL_RC_INVALID_PARAM, ME, "NULL");
+    ASSERT_TRUE((records != NULL) || (maxRecords == 0), SWL_RC_INVALID_PARAM, ME, "NULL");
+    s_initStatsSnapshot(pSnapshot);
+    T_AccessPoint* pAP = NULL;
+    wld_rad_forEachAp(pAP, pRad) {
+        s_exportApStaStats(pAP, sinceGeneration, pSnapshot, records, maxRecords);
+    }
+    pSnapshot->generation = s_statsGeneration;
+    return SWL_RC_OK;
+}
+
+/*
+ * Set a key of a variant map, replacing the value in place if the key already exists.
+ */
+#define S_SET_STATS_KEY(type, map, key, value) \
+    do { \
+        amxc_var_t* pKeyVar = amxc_var_get_key(map, key, AMXC_VAR_FLAG_DEFAULT); \
+        if(pKeyVar == NULL) { \
+            amxc_var_add_key(type, map, key, value); \
+        } else { \
+            amxc_var_set(type, pKeyVar, value); \
+        } \
+    } while(0)
+
+/*
+ * Set the statistics of a station record in a variant map, using the AssociatedDevice parameter names.
+ * Used by both getStationStats and getStationStatsSnapshot, so both return the same exported values.
+ */
+static void s_setStatsRecordValues(amxc_var_t* map, const wld_ad_statsRecord_t* record) {
+    S_SET_STATS_KEY(bool, map, "Active", (record->flags & WLD_AD_STATS_RECORD_FLAG_ACTIVE) != 0);
+    S_SET_STATS_KEY(bool, map, "AuthenticationState", (record->flags & WLD_AD_STATS_RECORD_FLAG_AUTHENTICATED) != 0);
+    S_SET_STATS_KEY(bool, map, "PowerSave", (record->flags & WLD_AD_STATS_RECORD_FLAG_POWERSAVE) != 0);
+    S_SET_STATS_KEY(int32_t, map, "SignalStrength", record->signalStrength);
+    S_SET_STATS_KEY(int32_t, map, "Noise", record->noise);
+    S_SET_STATS_KEY(int32_t, map, "SignalNoiseRatio", record->signalNoiseRatio);
+    S_SET_STATS_KEY(uint32_t, map, "LastDataDownlinkRate", record->lastDataDownlinkRate);
+    S_SET_STATS_KEY(uint32_t, map, "LastDataUplinkRate", record->lastDataUplinkRate);
+    S_SET_STATS_KEY(uint32_t, map, "MaxDownlinkRateReached", record->maxDownlinkRateReached);
+    S_SET_STATS_KEY(uint32_t, map, "MaxUplinkRateReached", record->maxUplinkRateReached);
+    S_SET_STATS_KEY(uint32_t, map, "DownlinkMCS", record->downlinkMcs);
+    S_SET_STATS_KEY(uint32_t, map, "UplinkMCS", record->uplinkMcs);
+    S_SET_STATS_KEY(uint64_t, map, "TxBytes", record->txBytes);
+    S_SET_STATS_KEY(uint64_t, map, "RxBytes", record->rxBytes);
+    S_SET_STATS_KEY(uint32_t, map, "TxPacketCount", record->txPacketCount);
+    S_SET_STATS_KEY(uint32_t, map, "RxPacketCount", record->rxPacketCount);
+    S_SET_STATS_KEY(uint32_t, map, "TxErrors", record->txFailures);
+    S_SET_STATS_KEY(uint64_t, map, "RxErrors", record->rxFailures);
+    S_SET_STATS_KEY(uint32_t, map, "Retransmissions", record->retransmissions);
+    S_SET_STATS_KEY(uint32_t, map, "Inactive", record->inactive);
+    S_SET_STATS_KEY(uint32_t, map, "ConnectionDuration", record->connectionDuration);
+}
+
+/* Record array reused by the data model export, grown to the largest accesspoint */
+static wld_ad_statsRecord_t* sStatsRecords = NULL;
+static uint32_t sNrStatsRecords = 0;
+
+/*
+ * Export the stats of all stations of an accesspoint in the shared record array.
+ * The returned array is valid until the next call.
+ */
+static wld_ad_statsRecord_t* s_exportApStaStatsBuf(T_AccessPoint* pAP, uint64_t sinceGeneration, wld_ad_statsSnapshot_t* pSnapshot) {
+    uint32_t maxRecords = SWL_MAX(pAP->AssociatedDeviceNumberOfEntries, 1);
+    if(maxRecords > sNrStatsRecords) {
+        wld_ad_statsRecord_t* records = realloc(sStatsRecords, maxRecords * sizeof(wld_ad_statsRecord_t));
+        ASSERT_NOT_NULL(records, NULL, ME, "%s: fail to alloc %u records", pAP->alias, maxRecords);
+        sStatsRecords = records;
+        sNrStatsRecords = maxRecords;
     }
+    wld_ad_exportStaStats(pAP, sinceGeneration, pSnapshot, sStatsRecords, maxRecords);
+    return sStatsRecords;
 }
 
 /**
@@ -746,6 +1151,8 @@ static void s_addStaStatsValues(T_AccessPoint* pAP, swl_rc_ne ret, amxc_var_t* r
         amxc_var_t tmpVar;
         amxc_var_init(&tmpVar);
         swla_dm_getObjectParams(pAD->object, &tmpVar, &pAD->onActionReadCtx);
+        // same per station export step as wld_ad_exportStaStats
+        s_setStatsRecordValues(&tmpVar, s_refreshStatsRecord(pAP, pAD));
 
         amxc_var_t affiliatedStaList;
         amxc_var_init(&affiliatedStaList);
@@ -779,7 +1186,6 @@ static void s_addStaStatsValues(T_AccessPoint* pAP, swl_rc_ne ret, amxc_var_t* r
 
         amxc_var_clean(&tmpVar);
     }
-
 }
 
 static void s_staStatsDoneHandler(T_AccessPoint* pAP, bool success) {
@@ -872,6 +1278,42 @@ amxd_status_t _getStationStats(amxd_object_t* obj_AP,
     return amxd_status_ok;
 }
 
+/**
+ * Data model wrapper of wld_ad_exportStaStats.
+ */
+amxd_status_t _getStationStatsSnapshot(amxd_object_t* object,
+                                       amxd_function_t* func _UNUSED,
+                                       amxc_var_t* args,
+                                       amxc_var_t* retval) {
+    T_AccessPoint* pAP = wld_ap_fromObj(object);
+    ASSERT_NOT_NULL(pAP, amxd_status_unknown_error, ME, "Invalid AP Ctx");
+    uint64_t sinceGeneration = amxc_var_dyncast(uint64_t, GET_ARG(args, "sinceGeneration"));
+
+    wld_ad_statsSnapshot_t snapshot;
+    wld_ad_statsRecord_t* records = s_exportApStaStatsBuf(pAP, sinceGeneration, &snapshot);
+    ASSERT_NOT_NULL(records, amxd_status_unknown_error, ME, "%s: fail to export stats", pAP->alias);
+
+    amxc_var_set_type(retval, AMXC_VAR_ID_HTABLE);
+    amxc_var_add_key(uint32_t, retval, "Version", snapshot.version);
+    amxc_var_add_key(uint64_t, retval, "Generation", snapshot.generation);
+    amxc_var_add_key(uint32_t, retval, "NrStations", snapshot.nrStations);
+    amxc_var_t* list = amxc_var_add_key(amxc_llist_t, retval, "Stations", NULL);
+    for(uint32_t i = 0; i < snapshot.nrRecords; i++) {
+        const wld_ad_statsRecord_t* record = &records[i];
+        amxc_var_t* map = amxc_var_add(amxc_htable_t, list, NULL);
+        amxc_var_add_key(cstring_t, map, "MACAddress", swl_typeMacBin_toBuf32Ref((swl_macBin_t*) record->macAddress).buf);
+        amxc_var_add_key(uint64_t, map, "Generation", record->generation);
+        s_setStatsRecordValues(map, record);
+        amxc_var_add_key(uint32_t, map, "DownlinkNSS", record->downlinkNss);
+        amxc_var_add_key(uint32_t, map, "UplinkNSS", record->uplinkNss);
+        amxc_var_add_key(cstring_t, map, "OperatingStandard", swl_radStd_unknown_str[record->operatingStandard]);
+        amxc_var_add_key(uint32_t, map, "AssociationTime", record->associationTime);
+        amxc_var_add_key(uint64_t, map, "LastSampleTime", record->lastSampleTimeMs);
+    }
+
+    return amxd_status_ok;
+}
+
 static swl_rc_ne s_getSingleStationStats(amxd_object_t* const object) {
     ASSERT_NOT_NULL(object, SWL_RC_INVALID_PARAM, ME, "NULL");
     T_AssociatedDevice* pAD = wld_ad_fromObj(object);
@@ -884,6 +1326,7 @@ static swl_rc_ne s_getSingleStationStats(amxd_object_t* const object) {
         // Update here stats parameters
         // and let status parameters been updated via transaction when needed
         s_updateStationStatsHistory(pAD);
+        wld_ad_refreshStaCounters(pAP, pAD);
         wld_ad_syncStats(pAD);
     }
 
@@ -910,81 +1353,34 @@ amxd_status_t _wld_assocDev_getStats_orf(amxd_object_t* const object,
  *  the RSSI threshold in dbm below which a station is considered far
  */
 bool wld_ad_has_far_station(T_AccessPoint* pAP, int threshold) {
-    int i = 0;
-    T_AssociatedDevice* pAD;
-    for(i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
-        pAD = pAP->AssociatedDevice[i];
-        if(pAD == NULL) {
-            SAH_TRACEZ_ERROR(ME, "Null assoc dev on ap %s", pAP->alias);
-        } else if(pAD->SignalStrength < threshold) {
-            return true;
-        }
-    }
-    return false;
+    return (wld_ad_getFarStaCount(pAP, threshold) > 0);
 }
 
 bool wld_ad_has_active_stations(T_AccessPoint* pAP) {
-    int i = 0;
-    T_AssociatedDevice* pAD;
-    for(i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
-        pAD = pAP->AssociatedDevice[i];
-        if(pAD == NULL) {
-            SAH_TRACEZ_ERROR(ME, "Null assoc dev on ap %s", pAP->alias);
-        } else if(pAD->Active == 1) {
-            return true;
-        }
-    }
-    return false;
+    ASSERT_NOT_NULL(pAP, false, ME, "NULL");
+    return (pAP->staCounters.nrActive > 0);
 }
 
 bool wld_ad_hasAuthenticatedStations(T_AccessPoint* pAP) {
-    int i = 0;
-    T_AssociatedDevice* pAD;
-    for(i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
-        pAD = pAP->AssociatedDevice[i];
-        if(pAD == NULL) {
-            SAH_TRACEZ_ERROR(ME, "Null assoc dev on ap %s", pAP->alias);
-        } else if(pAD->AuthenticationState == 1) {
-            return true;
-        }
-    }
-    return false;
+    ASSERT_NOT_NULL(pAP, false, ME, "NULL");
+    return (pAP->staCounters.nrAuthenticated > 0);
 }
 
 
 bool wld_ad_has_active_video_stations(T_AccessPoint* pAP) {
-    int i = 0;
-    T_AssociatedDevice* pAD;
-    for(i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
-        pAD = pAP->AssociatedDevice[i];
-        if(pAD == NULL) {
-            SAH_TRACEZ_ERROR(ME, "Null assoc dev on ap %s", pAP->alias);
-        } else if(( pAD->Active == 1) && ( pAD->deviceType == DEVICE_TYPE_VIDEO)) {
-            return true;
-        }
-    }
-    return false;
+    ASSERT_NOT_NULL(pAP, false, ME, "NULL");
+    return (pAP->staCounters.nrActiveVideo > 0);
 }
 
 
 bool wld_rad_has_active_stations(T_Radio* pRad) {
-    T_AccessPoint* pAP = NULL;
-    wld_rad_forEachAp(pAP, pRad) {
-        if(wld_ad_has_active_stations(pAP)) {
-            return true;
-        }
-    }
-    return false;
+    ASSERT_NOT_NULL(pRad, false, ME, "NULL");
+    return (pRad->staCounters.nrActive > 0);
 }
 
 bool wld_rad_has_active_video_stations(T_Radio* pRad) {
-    T_AccessPoint* pAP = NULL;
-    wld_rad_forEachAp(pAP, pRad) {
-        if(wld_ad_has_active_video_stations(pAP)) {
-            return true;
-        }
-    }
-    return false;
+    ASSERT_NOT_NULL(pRad, false, ME, "NULL");
+    return (pRad->staCounters.nrActiveVideo > 0);
 }
 
 
@@ -996,35 +1392,13 @@ bool wld_rad_has_active_video_stations(T_Radio* pRad) {
  *  the RSSI threshold in dbm below which a station is considered far
  */
 int wld_ad_get_nb_active_stations(T_AccessPoint* pAP) {
-    int nr_sta = 0;
-
-    for(int i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
-        T_AssociatedDevice* pAD = pAP->AssociatedDevice[i];
-        if(pAD == NULL) {
-            continue;
-            SAH_TRACEZ_ERROR(ME, "Null assoc dev on ap %s", pAP->alias);
-        }
-        if(!pAD->Active) {
-            continue;
-        }
-        nr_sta++;
-    }
-    return nr_sta;
+    ASSERT_NOT_NULL(pAP, 0, ME, "NULL");
+    return pAP->staCounters.nrActive;
 }
 
 int wld_ad_get_nb_active_video_stations(T_AccessPoint* pAP) {
-    int i = 0;
-    T_AssociatedDevice* pAD;
-    int nr_sta = 0;
-    for(i = 0; i < pAP->AssociatedDeviceNumberOfEntries; i++) {
-        pAD = pAP->AssociatedDevice[i];
-        if(pAD == NULL) {
-            SAH_TRACEZ_ERROR(ME, "Null assoc dev on ap %s", pAP->alias);
-        } else if(( pAD->Active == 1) && ( pAD->deviceType == DEVICE_TYPE_VIDEO)) {
-            nr_sta++;
-        }
-    }
-    return nr_sta;
+    ASSERT_NOT_NULL(pAP, 0, ME, "NULL");
+    return pAP->staCounters.nrActiveVideo;
 }
 
 int wld_rad_get_nb_active_stations(T_Radio* pRad) {
@@ -1032,13 +1406,8 @@ int wld_rad_get_nb_active_stations(T_Radio* pRad) {
 }
 
 int wld_rad_get_nb_active_video_stations(T_Radio* pRad) {
-    T_AccessPoint* pAP = NULL;
-    int nr_sta = 0;
-
-    wld_rad_forEachAp(pAP, pRad) {
-        nr_sta += wld_ad_get_nb_active_video_stations(pAP);
-    }
-    return nr_sta;
+    ASSERT_NOT_NULL(pRad, 0, ME, "NULL");
+    return pRad->staCounters.nrActiveVideo;
 }
 
 bool wld_ad_has_assocdev(T_AccessPoint* pAP, const unsigned char macAddress[ETHER_ADDR_LEN]) {
@@ -1159,19 +1528,8 @@ bool wld_rad_has_assocdev(T_Radio* pRad, const unsigned char macAddress[ETHER_AD
  *  the RSSI threshold in dbm below which a station is considered far
  */
 uint16_t wld_ad_getFarStaCount(T_AccessPoint* pAP, int threshold) {
-    int i = 0;
-    uint16_t count = 0;
-    ASSERT_NOT_NULL(pAP, count, ME, "pAP is NULL");
-    T_AssociatedDevice* pAD;
-    for(i = 0; i < pAP->ActiveAssociatedDeviceNumberOfEntries; i++) {
-        pAD = pAP->AssociatedDevice[i];
-        if(pAD == NULL) {
-            SAH_TRACEZ_ERROR(ME, "Null assoc dev on ap %s", pAP->alias);
-        } else if(pAD->SignalStrength < threshold) {
-            count++;
-        }
-    }
-    return count;
+    ASSERT_NOT_NULL(pAP, 0, ME, "pAP is NULL");
+    return wld_ad_getFarStaCountFromCounters(&pAP->staCounters, threshold);
 }
 
 amxd_status_t _getFarAssociatedDevicesCount(amxd_object_t* object,
@@ -1223,6 +1581,7 @@ static void s_activate(T_AccessPoint* pAP, T_AssociatedDevice* pAD) {
     pAD->latestStateChangeTime = swl_time_getMonoSec();
 
     swl_timespec_reset(&pAD->lastSampleTime);
+    wld_ad_refreshStaCounters(pAP, pAD);
 
     //kick from all other AP's
     wld_ad_checkRoamSta(pAP, pAD);
@@ -1244,15 +1603,10 @@ void wld_ad_add_connection_try(T_AccessPoint* pAP, T_AssociatedDevice* pAD) {
     wld_vap_syncNrDev(pAP);
 }
 
-static wld_ad_dcLog_t* s_getOrAddDcEntry(T_AccessPoint* pAP, T_AssociatedDevice* pAD) {
-    wld_ad_dcLog_t* log = s_findDcEntry(pAP, (swl_macBin_t*) &pAD->MACAddress);
-    bool hasLog = (log != NULL);
-    if(!hasLog) {
-        log = swl_unLiList_allocElement(&pAP->staDcList.list);
-        ASSERT_NOT_NULL(log, NULL, ME, "%s: failed to create dc entry for %s", pAP->name, pAD->Name);
-        memcpy(&log->macAddress, &pAD->MACAddress, ETHER_ADDR_LEN);
-    }
-    swl_timespec_getMono(&log->dcTime);
+static wld_apDcLog_entry_t* s_getOrAddDcEntry(T_AccessPoint* pAP, T_AssociatedDevice* pAD, swl_IEEE80211deauthReason_ne deauthReason) {
+    bool hasLog = (s_findDcEntry(pAP, (swl_macBin_t*) &pAD->MACAddress) != NULL);
+    wld_apDcLog_entry_t* log = wld_apDcLog_add(&pAP->staDcLog, (swl_macBin_t*) &pAD->MACAddress, deauthReason);
+    ASSERT_NOT_NULL(log, NULL, ME, "%s: failed to create dc entry for %s", pAP->name, pAD->Name);
     SAH_TRACEZ_INFO(ME, "%s: addLog %s (had %u)", swl_typeMacBin_toBuf32(log->macAddress).buf,
                     swl_typeTimeSpecMono_toBuf32(log->dcTime).buf, hasLog);
     return log;
@@ -1352,12 +1706,13 @@ static void s_add_dc_sta(T_AccessPoint* pAP, T_AssociatedDevice* pAD, bool failS
                        pAP->alias, pAD->Name, pAD->AuthenticationState, swl_typeTimeMono_toBuf32(pAD->associationTime).buf,
                        pAD->connectionDuration, pAD->SignalNoiseRatio, deauthReason);
 
-    wld_ad_dcLog_t* log = s_getOrAddDcEntry(pAP, pAD);
+    wld_apDcLog_entry_t* log = s_getOrAddDcEntry(pAP, pAD, deauthReason);
     s_sendChangeEvent(pAP, pAD, WLD_AD_CHANGE_EVENT_DISASSOC, log);
 
     pAD->AuthenticationState = 0;
     pAD->Active = 0;
     pAD->Inactive = 0;
+    wld_ad_refreshStaCounters(pAP, pAD);
 
     amxc_llist_for_each(it, &pAD->affiliatedStaList) {
         wld_affiliatedSta_t* afSta = amxc_llist_it_get_data(it, wld_affiliatedSta_t, it);
@@ -1383,7 +1738,7 @@ void wld_ad_add_connection_success(T_AccessPoint* pAP, T_AssociatedDevice* pAD)
         wld_ad_add_connection_try(pAP, pAD);
     }
 
-    wld_ad_dcLog_t* entry = s_findDcEntry(pAP, (swl_macBin_t*) &pAD->MACAddress);
+    wld_apDcLog_entry_t* entry = s_findDcEntry(pAP, (swl_macBin_t*) &pAD->MACAddress);
     SAH_TRACEZ_WARNING(ME, "%s: Connect %s (dc %s)", pAP->alias, pAD->Name, entry != NULL ?
                        swl_typeTimeSpecMono_toBuf32(entry->dcTime).buf : "NA");
     pAD->AuthenticationState = 1;
@@ -1397,6 +1752,7 @@ void wld_ad_add_connection_success(T_AccessPoint* pAP, T_AssociatedDevice* pAD)
     }
     //Update device type when connection succeeds.
     pAP->pFA->mfn_wvap_update_assoc_dev(pAP, pAD);
+    wld_ad_refreshStaCounters(pAP, pAD);
 
     if(entry != NULL) {
         s_dcEntryConnected(pAP, entry);
@@ -1589,8 +1945,22 @@ static void s_setResetCounters_pwf(void* priv _UNUSED, amxd_object_t* object, am
     SAH_TRACEZ_OUT(ME);
 }
 
+static void s_setDisconnectLogSize_pwf(void* priv _UNUSED, amxd_object_t* object, amxd_param_t* param _UNUSED, const amxc_var_t* const newValue) {
+    SAH_TRACEZ_IN(ME);
+
+    T_AccessPoint* pAP = wld_ap_fromObj(amxd_object_get_parent(object));
+    ASSERTS_NOT_NULL(pAP, , ME, "no AP mapped");
+    uint32_t size = amxc_var_dyncast(uint32_t, newValue);
+    SAH_TRACEZ_INFO(ME, "%s: set disconnect log size %u", pAP->alias, size);
+    wld_apDcLog_setCapacity(&pAP->staDcLog, size);
+
+    SAH_TRACEZ_OUT(ME);
+}
+
 SWLA_DM_HDLRS(sApAssocCountDmHdlrs,
-              ARR(SWLA_DM_PARAM_HDLR("ResetCounters", s_setResetCounters_pwf)));
+              ARR(SWLA_DM_PARAM_HDLR("ResetCounters", s_setResetCounters_pwf),
+                  SWLA_DM_PARAM_HDLR("DisconnectLogSize", s_setDisconnectLogSize_pwf),
+                  ));
 
 void _wld_ap_setAssocCountConf_ocf(const char* const sig_name,
                                    const amxc_var_t* const data,
@@ -1630,6 +2000,7 @@ static void s_updateAssocDev_ocf(void* priv _UNUSED, amxd_object_t* object, cons
     if(needSyncAd) {
         SAH_TRACEZ_INFO(ME, "%s: update assocdev %s type %u prio %u", pAP->alias, assocDev->Name, assocDev->deviceType, assocDev->devicePriority);
         pAP->pFA->mfn_wvap_update_assoc_dev(pAP, assocDev);
+        wld_ad_refreshStaCounters(pAP, assocDev);
     }
 
     SAH_TRACEZ_OUT(ME);
@@ -1985,8 +2356,8 @@ int32_t wld_ad_getAvgSignalStrengthByChain(T_AssociatedDevice* pAD) {
 }
 
 void wld_ad_initAp(T_AccessPoint* pAP) {
-    swl_unLiTable_initExt(&pAP->staDcList, &tWld_ad_dcLog, 3);
-    swl_unLiList_setKeepsLastBlock(&pAP->staDcList.list, true);
+    memset(&pAP->staCounters, 0, sizeof(pAP->staCounters));
+    wld_apDcLog_init(&pAP->staDcLog, WLD_AP_DCLOG_DEFAULT_SIZE);
 }
 
 void wld_ad_initFastReconnectCounters(T_AccessPoint* pAP) {
@@ -2008,11 +2379,13 @@ void wld_ad_initFastReconnectCounters(T_AccessPoint* pAP) {
 
 
 void wld_ad_cleanAp(T_AccessPoint* pAP) {
-    swl_unLiTable_destroy(&pAP->staDcList);
+    /* deliver pending changes while the accesspoint is still valid */
+    wld_ad_flushBatchChanges();
+    wld_apDcLog_destroy(&pAP->staDcLog);
 }
 
 void wld_ad_listRecentDisconnects(T_AccessPoint* pAP, amxc_var_t* variant) {
-    swl_unLiTable_toListOfMaps(&pAP->staDcList, variant, tupleNames);
+    wld_apDcLog_toListOfMaps(&pAP->staDcLog, variant);
 }
 
 void wld_assocDev_copyAssocDevInfoFromIEs(T_Radio* pRad, T_AssociatedDevice* pDev, wld_assocDev_capabilities_t* cap, swl_wirelessDevice_infoElements_t* pWirelessDevIE) {
@@ -2084,6 +2457,7 @@ void wld_ad_handleAssocMsg(T_AccessPoint* pAP, T_AssociatedDevice* pAD, swl_bit8
     ASSERTW_FALSE(parsedLen < (ssize_t) iesLen, , ME, "Partial IEs parsing (%zi/%zu)", parsedLen, iesLen);
 
     wld_assocDev_copyAssocDevInfoFromIEs(pAP->pRadio, pAD, &pAD->assocCaps, &wirelessDevIE);
+    wld_ad_refreshStaCounters(pAP, pAD);
 }
 
 
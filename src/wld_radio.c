@@ -94,6 +94,7 @@
 #include "wld_assocdev.h"
 #include "wld_eventing.h"
 #include "Utils/wld_autoCommitMgr.h"
+#include "Utils/wld_cfgWriter.h"
 #include "wld/Utils/wld_autoNeighAdd.h"
 
 #include "wld_hostapd_cfgFile.h"
@@ -4558,6 +4559,18 @@ amxd_status_t _Radio_debug(amxd_object_t* object,
         }
     } else if(!strcasecmp(feature, "listFeatures")) {
         s_listRadioFeatures(pR, retval);
+    } else if(!strcasecmp(feature, "hapdStatus")) {
+        wld_dmn_debug((pR->hostapd != NULL) ? pR->hostapd->dmnProcess : NULL, retval);
+    } else if(!strcasecmp(feature, "cfgWriterStats")) {
+        const wld_cfgWriter_stats_t* pStats = wld_cfgWriter_getStats();
+        amxc_var_add_key(uint32_t, retval, "Flags", wld_cfgWriter_getDefaultFlags());
+        amxc_var_add_key(uint32_t, retval, "NrWrites", pStats->nWrites);
+        amxc_var_add_key(uint32_t, retval, "NrErrors", pStats->nErrors);
+        amxc_var_add_key(uint64_t, retval, "LastSize", pStats->lastSize);
+        amxc_var_add_key(uint32_t, retval, "LastRenderUs", pStats->lastRenderUs);
+        amxc_var_add_key(uint32_t, retval, "LastWriteUs", pStats->lastWriteUs);
+        amxc_var_add_key(uint32_t, retval, "MaxRenderUs", pStats->maxRenderUs);
+        amxc_var_add_key(uint32_t, retval, "MaxWriteUs", pStats->maxWriteUs);
     } else if(!strcasecmp(feature, "hapdCfg")) {
         char tmpName[128];
         snprintf(tmpName, sizeof(tmpName), "%s-%s.tmp.txt", "/tmp/hostapd", pR->Name);
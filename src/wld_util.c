@@ -2431,3 +2431,20 @@ wld_spectrumChannelInfoEntry_t* wld_util_addorUpdateSpectrumEntry(amxc_llist_t*
     return pEntry;
 }
 
+uint32_t wld_util_fnv32Update(uint32_t hash, const void* pData, size_t len) {
+    const uint8_t* pBytes = (const uint8_t*) pData;
+    for(size_t i = 0; i < len; i++) {
+        hash ^= pBytes[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+uint64_t wld_util_fnv64Update(uint64_t hash, const void* pData, size_t len) {
+    const uint8_t* pBytes = (const uint8_t*) pData;
+    for(size_t i = 0; i < len; i++) {
+        hash ^= pBytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
@@ -71,6 +71,7 @@
 #include "wld_util.h"
 #include "wld_ssid.h"
 #include "Utils/wld_config.h"
+#include "Utils/wld_cfgWriter.h"
 #include "test-toolbox/ttb_mockClock.h"
 #include "test-toolbox/ttb_assert.h"
 #include "../testHelper/wld_th_mockVendor.h"
@@ -445,6 +446,22 @@ static void test_syncFromIntf(void** state _UNUSED) {
     test_syncSSIDToEndpointNotWorks();
 }
 
+static void test_configFileWriteFlags(void** state _UNUSED) {
+    ttb_assert_int_eq(wld_cfgWriter_getDefaultFlags(), 0);
+
+    swl_typeCharPtr_commitObjectParam(configObj, "ConfigFileWriteFlags", "Fsync,Direct");
+    ttb_mockTimer_goToFutureMs(10);
+    ttb_assert_int_eq(wld_cfgWriter_getDefaultFlags(), M_WLD_CFG_WRITER_FSYNC | M_WLD_CFG_WRITER_DIRECT);
+
+    swl_typeCharPtr_commitObjectParam(configObj, "ConfigFileWriteFlags", "Fsync");
+    ttb_mockTimer_goToFutureMs(10);
+    ttb_assert_int_eq(wld_cfgWriter_getDefaultFlags(), M_WLD_CFG_WRITER_FSYNC);
+
+    swl_typeCharPtr_commitObjectParam(configObj, "ConfigFileWriteFlags", "");
+    ttb_mockTimer_goToFutureMs(10);
+    ttb_assert_int_eq(wld_cfgWriter_getDefaultFlags(), 0);
+}
+
 int main(int argc _UNUSED, char* argv[] _UNUSED) {
     sahTraceOpen("testApp", TRACE_TYPE_STDERR);
 
@@ -457,6 +474,7 @@ int main(int argc _UNUSED, char* argv[] _UNUSED) {
         cmocka_unit_test(test_syncOff),
         cmocka_unit_test(test_syncToIntf),
         cmocka_unit_test(test_syncFromIntf),
+        cmocka_unit_test(test_configFileWriteFlags),
     };
     int rc = cmocka_run_group_tests(tests, s_setupSuite, s_teardownSuite);
     sahTraceClose();
@@ -0,0 +1,543 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+#include <stdarg.h>    // needed for cmocka
+#include <sys/types.h> // needed for cmocka
+#include <setjmp.h>    // needed for cmocka
+#include <cmocka.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include "wld.h"
+#include "wld_th_wpaCtrlReplay.h"
+
+#define REPLAY_IDLE_EXIT_MS 300 // mock server exits after being idle this long, once all events are sent
+#define REPLAY_POLL_MS 10
+#define REPLAY_MAX_PLUGIN_FDS 64
+
+typedef struct {
+    uint32_t sockIdx;
+    char* cmd;
+    char* reply;
+    bool used;
+} replayCmd_t;
+
+typedef struct {
+    uint32_t sockIdx;
+    uint64_t tsUs;
+    char* data;
+    size_t len;
+} replayEvt_t;
+
+typedef struct {
+    replayCmd_t* cmds;
+    uint32_t nrCmds;
+    replayEvt_t* evts;
+    uint32_t nrEvts;
+    struct sockaddr_un clients[WLD_TH_WPACTRL_REPLAY_MAX_SOCKS];
+    bool attached[WLD_TH_WPACTRL_REPLAY_MAX_SOCKS];
+} replayServer_t;
+
+static uint64_t s_getClockUs(clockid_t clockId) {
+    struct timespec ts;
+    clock_gettime(clockId, &ts);
+    return (uint64_t) ts.tv_sec * 1000000 + (uint64_t) ts.tv_nsec / 1000;
+}
+
+static uint64_t s_nowUs() {
+    return s_getClockUs(CLOCK_MONOTONIC);
+}
+
+static int32_t s_getSockIdx(wld_th_wpaCtrlReplay_t* pReplay, const char* sockName) {
+    for(uint32_t i = 0; i < pReplay->nrSocks; i++) {
+        if(swl_str_matches(pReplay->sockNames[i], sockName)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void s_getServerSockPath(wld_th_wpaCtrlReplay_t* pReplay, uint32_t sockIdx, char* path, size_t pathSize) {
+    snprintf(path, pathSize, "%s/%s", pReplay->srvDir, pReplay->sockNames[sockIdx]);
+}
+
+static bool s_bindServerSock(wld_th_wpaCtrlReplay_t* pReplay, uint32_t sockIdx) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    s_getServerSockPath(pReplay, sockIdx, addr.sun_path, sizeof(addr.sun_path));
+    unlink(addr.sun_path);
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if(fd < 0) {
+        return false;
+    }
+    if(bind(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0) {
+        printf("fail to bind replay server socket %s (%d:%s)\n", addr.sun_path, errno, strerror(errno));
+        close(fd);
+        return false;
+    }
+    pReplay->srvFds[sockIdx] = fd;
+    return true;
+}
+
+/**
+ * Scan the trace, and bind one server socket per recorded socket name in srvDir.
+ */
+bool wld_th_wpaCtrlReplay_init(wld_th_wpaCtrlReplay_t* pReplay, const char* tracePath, const char* srvDir, bool realTime) {
+    assert_non_null(pReplay);
+    memset(pReplay, 0, sizeof(*pReplay));
+    swl_str_copy(pReplay->tracePath, sizeof(pReplay->tracePath), tracePath);
+    swl_str_copy(pReplay->srvDir, sizeof(pReplay->srvDir), srvDir);
+    pReplay->realTime = realTime;
+
+    /* plugin client sockets are bound in this directory (see wld_wpaCtrl_setClientDir) */
+    const char* cliDir = wld_wpaCtrl_getClientDir();
+    if((mkdir(cliDir, 0755) < 0) && (errno != EEXIST)) {
+        printf("fail to create client socket dir %s (%d:%s)\n", cliDir, errno, strerror(errno));
+        return false;
+    }
+
+    wld_wpaCtrl_traceReader_t* pReader = NULL;
+    if(!swl_rc_isOk(wld_wpaCtrl_traceReader_open(&pReader, tracePath))) {
+        return false;
+    }
+    wld_wpaCtrl_traceRecord_t record;
+    while(wld_wpaCtrl_traceReader_next(pReader, &record) == SWL_RC_OK) {
+        if((s_getSockIdx(pReplay, record.sockName) < 0) && (pReplay->nrSocks < WLD_TH_WPACTRL_REPLAY_MAX_SOCKS)) {
+            swl_str_copy(pReplay->sockNames[pReplay->nrSocks], sizeof(pReplay->sockNames[0]), record.sockName);
+            pReplay->srvFds[pReplay->nrSocks] = -1;
+            pReplay->nrSocks++;
+        }
+        if(record.dir == WLD_WPACTRL_TRACE_DIR_EVT) {
+            pReplay->stats.nrEvts++;
+        }
+    }
+    wld_wpaCtrl_traceReader_close(&pReader);
+
+    for(uint32_t i = 0; i < pReplay->nrSocks; i++) {
+        if(!s_bindServerSock(pReplay, i)) {
+            wld_th_wpaCtrlReplay_cleanup(pReplay);
+            return false;
+        }
+    }
+    printf("replay trace %s: %u sockets, %u events\n", tracePath, pReplay->nrSocks, pReplay->stats.nrEvts);
+    return true;
+}
+
+static void s_loadTrace(wld_th_wpaCtrlReplay_t* pReplay, replayServer_t* pSrv) {
+    wld_wpaCtrl_traceReader_t* pReader = NULL;
+    if(!swl_rc_isOk(wld_wpaCtrl_traceReader_open(&pReader, pReplay->tracePath))) {
+        return;
+    }
+    wld_wpaCtrl_traceRecord_t record;
+    while(wld_wpaCtrl_traceReader_next(pReader, &record) == SWL_RC_OK) {
+        int32_t sockIdx = s_getSockIdx(pReplay, record.sockName);
+        if(sockIdx < 0) {
+            continue;
+        }
+        if(record.dir == WLD_WPACTRL_TRACE_DIR_CMD) {
+            pSrv->cmds = realloc(pSrv->cmds, (pSrv->nrCmds + 1) * sizeof(replayCmd_t));
+            replayCmd_t* pCmd = &pSrv->cmds[pSrv->nrCmds++];
+            memset(pCmd, 0, sizeof(*pCmd));
+            pCmd->sockIdx = sockIdx;
+            pCmd->cmd = strdup(record.data);
+        } else if(record.dir == WLD_WPACTRL_TRACE_DIR_REPLY) {
+            /* replies come in order: pair with the oldest unanswered command of the socket */
+            for(uint32_t i = 0; i < pSrv->nrCmds; i++) {
+                if((pSrv->cmds[i].sockIdx == (uint32_t) sockIdx) && (pSrv->cmds[i].reply == NULL)) {
+                    pSrv->cmds[i].reply = strdup(record.data);
+                    break;
+                }
+            }
+        } else {
+            pSrv->evts = realloc(pSrv->evts, (pSrv->nrEvts + 1) * sizeof(replayEvt_t));
+            replayEvt_t* pEvt = &pSrv->evts[pSrv->nrEvts++];
+            pEvt->sockIdx = sockIdx;
+            pEvt->tsUs = record.tsUs;
+            pEvt->data = malloc(record.len + 1);
+            memcpy(pEvt->data, record.data, record.len + 1);
+            pEvt->len = record.len;
+        }
+    }
+    wld_wpaCtrl_traceReader_close(&pReader);
+}
+
+static const char* s_getReply(replayServer_t* pSrv, uint32_t sockIdx, const char* rawCmd) {
+    /* recorded commands have their secret values redacted */
+    char cmd[4096];
+    wld_wpaCtrl_traceRedact(rawCmd, strlen(rawCmd), cmd, sizeof(cmd));
+    const char* lastReply = NULL;
+    for(uint32_t i = 0; i < pSrv->nrCmds; i++) {
+        replayCmd_t* pCmd = &pSrv->cmds[i];
+        if((pCmd->sockIdx != sockIdx) || (pCmd->reply == NULL) || (!swl_str_matches(pCmd->cmd, cmd))) {
+            continue;
+        }
+        if(!pCmd->used) {
+            pCmd->used = true;
+            return pCmd->reply;
+        }
+        lastReply = pCmd->reply;
+    }
+    if(lastReply != NULL) {
+        return lastReply;
+    }
+    if(swl_str_matches(cmd, "PING")) {
+        return "PONG\n";
+    }
+    if(swl_str_matches(cmd, "ATTACH") || swl_str_matches(cmd, "DETACH") || swl_str_startsWith(cmd, "LEVEL ")) {
+        return "OK\n";
+    }
+    return "FAIL\n";
+}
+
+static void s_closeServerSock(wld_th_wpaCtrlReplay_t* pReplay, uint32_t sockIdx) {
+    if(pReplay->srvFds[sockIdx] >= 0) {
+        close(pReplay->srvFds[sockIdx]);
+        pReplay->srvFds[sockIdx] = -1;
+    }
+    char path[sizeof(((struct sockaddr_un*) 0)->sun_path)];
+    s_getServerSockPath(pReplay, sockIdx, path, sizeof(path));
+    unlink(path);
+}
+
+/*
+ * emulate the hostapd global ctrl iface commands:
+ * "ADD <ifname> ..." binds the interface server socket, "REMOVE <ifname>" unbinds it,
+ * so that interfaces added at runtime (warm standby) can then be used as recorded ones
+ */
+static const char* s_serveIfaceCmd(wld_th_wpaCtrlReplay_t* pReplay, const char* cmd) {
+    bool add = swl_str_startsWith(cmd, "ADD ");
+    const char* args = strchr(cmd, ' ') + 1;
+    size_t len = strcspn(args, " ");
+    char ifName[WLD_WPACTRL_TRACE_SOCK_NAME_MAX] = {0};
+    if((len == 0) || (len >= sizeof(ifName))) {
+        return "FAIL\n";
+    }
+    memcpy(ifName, args, len);
+    int32_t sockIdx = s_getSockIdx(pReplay, ifName);
+    bool isBound = ((sockIdx >= 0) && (pReplay->srvFds[sockIdx] >= 0));
+    if(!add) {
+        if(!isBound) {
+            return "FAIL\n";
+        }
+        s_closeServerSock(pReplay, sockIdx);
+        return "OK\n";
+    }
+    if(isBound) {
+        return "FAIL\n";
+    }
+    if(sockIdx < 0) {
+        if(pReplay->nrSocks >= WLD_TH_WPACTRL_REPLAY_MAX_SOCKS) {
+            return "FAIL\n";
+        }
+        sockIdx = pReplay->nrSocks++;
+        swl_str_copy(pReplay->sockNames[sockIdx], sizeof(pReplay->sockNames[0]), ifName);
+        pReplay->srvFds[sockIdx] = -1;
+    }
+    return s_bindServerSock(pReplay, sockIdx) ? "OK\n" : "FAIL\n";
+}
+
+static void s_serveCmd(wld_th_wpaCtrlReplay_t* pReplay, replayServer_t* pSrv, uint32_t sockIdx) {
+    char cmd[4096];
+    struct sockaddr_un from;
+    socklen_t fromLen = sizeof(from);
+    ssize_t len = recvfrom(pReplay->srvFds[sockIdx], cmd, sizeof(cmd) - 1, MSG_DONTWAIT, (struct sockaddr*) &from, &fromLen);
+    if(len <= 0) {
+        return;
+    }
+    cmd[len] = '\0';
+    if(swl_str_matches(cmd, "ATTACH")) {
+        pSrv->clients[sockIdx] = from;
+        pSrv->attached[sockIdx] = true;
+    } else if(swl_str_matches(cmd, "DETACH")) {
+        pSrv->attached[sockIdx] = false;
+    }
+    const char* reply = NULL;
+    if(swl_str_startsWith(cmd, "ADD ") || swl_str_startsWith(cmd, "REMOVE ")) {
+        reply = s_serveIfaceCmd(pReplay, cmd);
+    } else {
+        reply = s_getReply(pSrv, sockIdx, cmd);
+    }
+    if((pReplay->replyDelayMs > 0) && swl_str_matches(cmd, pReplay->delayedCmd)) {
+        /* blocking, as a busy daemon does not answer the following commands either */
+        usleep(pReplay->replyDelayMs * 1000);
+    }
+    sendto(pReplay->srvFds[sockIdx], reply, strlen(reply), 0, (struct sockaddr*) &from, fromLen);
+}
+
+static void s_freeServer(replayServer_t* pSrv) {
+    for(uint32_t i = 0; i < pSrv->nrCmds; i++) {
+        free(pSrv->cmds[i].cmd);
+        free(pSrv->cmds[i].reply);
+    }
+    free(pSrv->cmds);
+    for(uint32_t i = 0; i < pSrv->nrEvts; i++) {
+        free(pSrv->evts[i].data);
+    }
+    free(pSrv->evts);
+}
+
+/*
+ * mock server main loop, run in the child process:
+ * answer commands, and send events once their socket is attached
+ */
+static void s_runServer(wld_th_wpaCtrlReplay_t* pReplay) {
+    replayServer_t srv;
+    memset(&srv, 0, sizeof(srv));
+    s_loadTrace(pReplay, &srv);
+    uint32_t nrTraceSocks = pReplay->nrSocks;
+    struct pollfd pfds[WLD_TH_WPACTRL_REPLAY_MAX_SOCKS];
+    uint32_t evtIdx = 0;
+    uint64_t startUs = 0;
+    uint64_t lastActivityUs = s_nowUs();
+    bool evtBlocked = false;
+    while(true) {
+        uint64_t nowUs = s_nowUs();
+        int tmOutMs = REPLAY_POLL_MS;
+        bool evtDue = false;
+        if((evtIdx < srv.nrEvts) && (startUs > 0) && (srv.attached[srv.evts[evtIdx].sockIdx])) {
+            uint64_t dueUs = 0;
+            if(pReplay->realTime) {
+                dueUs = startUs + (srv.evts[evtIdx].tsUs - srv.evts[0].tsUs);
+            }
+            if(dueUs <= nowUs) {
+                evtDue = true;
+            } else {
+                tmOutMs = SWL_MIN((int) ((dueUs - nowUs) / 1000), REPLAY_POLL_MS);
+            }
+        }
+        if(evtDue) {
+            /* retry a blocked event shortly, otherwise send it right away */
+            tmOutMs = evtBlocked ? 1 : 0;
+        }
+        /* sockets may be added/removed at runtime: closed ones are ignored by poll */
+        uint32_t nFds = pReplay->nrSocks;
+        for(uint32_t i = 0; i < nFds; i++) {
+            pfds[i].fd = pReplay->srvFds[i];
+            pfds[i].events = POLLIN;
+            pfds[i].revents = 0;
+        }
+        int nReady = poll(pfds, nFds, tmOutMs);
+        for(uint32_t i = 0; (nReady > 0) && (i < nFds); i++) {
+            if(pfds[i].revents & POLLIN) {
+                s_serveCmd(pReplay, &srv, i);
+                lastActivityUs = s_nowUs();
+                if((startUs == 0) && (srv.attached[i])) {
+                    startUs = lastActivityUs;
+                }
+            }
+        }
+        evtBlocked = false;
+        if(evtDue) {
+            replayEvt_t* pEvt = &srv.evts[evtIdx];
+            /* not blocking, to keep answering commands while the plugin has not drained its event socket */
+            ssize_t ret = sendto(pReplay->srvFds[pEvt->sockIdx], pEvt->data, pEvt->len, MSG_DONTWAIT,
+                                 (struct sockaddr*) &srv.clients[pEvt->sockIdx], sizeof(srv.clients[0]));
+            if((ret < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+                evtBlocked = true;
+            } else {
+                evtIdx++;
+                lastActivityUs = s_nowUs();
+            }
+        }
+        if((evtIdx >= srv.nrEvts) && ((s_nowUs() - lastActivityUs) > (REPLAY_IDLE_EXIT_MS * 1000))) {
+            break;
+        }
+    }
+    /* sockets added at runtime are unknown to the test process */
+    for(uint32_t i = nrTraceSocks; i < pReplay->nrSocks; i++) {
+        s_closeServerSock(pReplay, i);
+    }
+    s_freeServer(&srv);
+}
+
+/**
+ * Delay the reply of a command, to be set before starting the server.
+ */
+void wld_th_wpaCtrlReplay_setReplyDelay(wld_th_wpaCtrlReplay_t* pReplay, const char* cmd, uint32_t delayMs) {
+    assert_non_null(pReplay);
+    swl_str_copy(pReplay->delayedCmd, sizeof(pReplay->delayedCmd), cmd);
+    pReplay->replyDelayMs = delayMs;
+}
+
+/**
+ * Fork the mock server process. Server sockets are then only used by the child.
+ */
+bool wld_th_wpaCtrlReplay_startServer(wld_th_wpaCtrlReplay_t* pReplay) {
+    assert_non_null(pReplay);
+    fflush(stdout);
+    pid_t pid = fork();
+    if(pid < 0) {
+        return false;
+    }
+    if(pid == 0) {
+        s_runServer(pReplay);
+        _exit(0);
+    }
+    pReplay->serverPid = pid;
+    for(uint32_t i = 0; i < pReplay->nrSocks; i++) {
+        close(pReplay->srvFds[i]);
+        pReplay->srvFds[i] = -1;
+    }
+    return true;
+}
+
+static uint64_t s_getNrRxEvts(wld_wpaCtrlInterface_t** ifaces, uint32_t nrIfaces) {
+    uint64_t nrMsgs = 0;
+    for(uint32_t i = 0; i < nrIfaces; i++) {
+        wld_wpaCtrl_rxStats_t rxStats;
+        if(wld_wpaCtrlInterface_getEvtRxStats(ifaces[i], &rxStats)) {
+            nrMsgs += rxStats.nrMsgs;
+        }
+    }
+    return nrMsgs;
+}
+
+/**
+ * Pump the plugin wpa_ctrl connections (and timers) until the mock server
+ * has sent all the events and exited, and no more data is pending.
+ *
+ * @return true if the replay completed within tmOutMs
+ */
+bool wld_th_wpaCtrlReplay_run(wld_th_wpaCtrlReplay_t* pReplay, wld_wpaCtrlInterface_t** ifaces, uint32_t nrIfaces, uint32_t tmOutMs) {
+    assert_non_null(pReplay);
+    assert_true(pReplay->serverPid > 0);
+    amxo_parser_t* parser = get_wld_plugin_parser();
+    assert_non_null(parser);
+    uint64_t nrRxEvtsStart = s_getNrRxEvts(ifaces, nrIfaces);
+    uint64_t startUs = s_nowUs();
+    bool serverDone = false;
+    while(true) {
+        struct pollfd pfds[REPLAY_MAX_PLUGIN_FDS];
+        uint32_t nFds = 0;
+        amxc_llist_for_each(it, amxo_parser_get_connections(parser)) {
+            amxo_connection_t* con = amxc_container_of(it, amxo_connection_t, it);
+            if((con->type == AMXO_CUSTOM) && (nFds < REPLAY_MAX_PLUGIN_FDS)) {
+                pfds[nFds].fd = con->fd;
+                pfds[nFds].events = POLLIN;
+                pfds[nFds].revents = 0;
+                nFds++;
+            }
+        }
+        int nReady = poll(pfds, nFds, REPLAY_POLL_MS);
+        for(uint32_t i = 0; (nReady > 0) && (i < nFds); i++) {
+            if(!(pfds[i].revents & POLLIN)) {
+                continue;
+            }
+            /* a previous handler may have closed the connection */
+            amxo_connection_t* con = amxo_connection_get(parser, pfds[i].fd);
+            if((con == NULL) || (con->reader == NULL)) {
+                continue;
+            }
+            uint64_t t0 = s_nowUs();
+            uint64_t cpuT0 = s_getClockUs(CLOCK_THREAD_CPUTIME_ID);
+            con->reader(con->fd, con->priv);
+            uint64_t dt = s_nowUs() - t0;
+            pReplay->stats.nrWakeups++;
+            pReplay->stats.totalHandlingUs += dt;
+            pReplay->stats.totalHandlingCpuUs += s_getClockUs(CLOCK_THREAD_CPUTIME_ID) - cpuT0;
+            pReplay->stats.maxWakeupUs = SWL_MAX(pReplay->stats.maxWakeupUs, dt);
+        }
+        amxp_timers_calculate();
+        amxp_timers_check();
+
+        int status = 0;
+        if(!serverDone && (waitpid(pReplay->serverPid, &status, WNOHANG) == pReplay->serverPid)) {
+            serverDone = true;
+            pReplay->serverPid = 0;
+        }
+        if(serverDone && (nReady <= 0)) {
+            break;
+        }
+        if((s_nowUs() - startUs) > ((uint64_t) tmOutMs * 1000)) {
+            printf("replay timed out after %u ms\n", tmOutMs);
+            break;
+        }
+    }
+    pReplay->stats.durationUs = s_nowUs() - startUs;
+    pReplay->stats.nrMsgsHandled = s_getNrRxEvts(ifaces, nrIfaces) - nrRxEvtsStart;
+    printf("replay: %u evts, %" PRIu64 " handled, %u wakeups, handling %" PRIu64 " us (cpu %" PRIu64 " us, max %" PRIu64 " us/wakeup), duration %" PRIu64 " us\n",
+           pReplay->stats.nrEvts, pReplay->stats.nrMsgsHandled, pReplay->stats.nrWakeups,
+           pReplay->stats.totalHandlingUs, pReplay->stats.totalHandlingCpuUs, pReplay->stats.maxWakeupUs, pReplay->stats.durationUs);
+    return serverDone;
+}
+
+void wld_th_wpaCtrlReplay_cleanup(wld_th_wpaCtrlReplay_t* pReplay) {
+    assert_non_null(pReplay);
+    if(pReplay->serverPid > 0) {
+        kill(pReplay->serverPid, SIGKILL);
+        waitpid(pReplay->serverPid, NULL, 0);
+        pReplay->serverPid = 0;
+    }
+    for(uint32_t i = 0; i < pReplay->nrSocks; i++) {
+        s_closeServerSock(pReplay, i);
+    }
+}
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+
+#ifndef SRC_TEST_TESTHELPER_WLD_TH_WPACTRLREPLAY_H_
+#define SRC_TEST_TESTHELPER_WLD_TH_WPACTRLREPLAY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include "wld_wpaCtrlInterface.h"
+#include "wld_wpaCtrl_trace.h"
+
+/*
+ * Mock wpa_ctrl server (hostapd/wpa_supplicant) replaying a recorded trace:
+ * - commands are answered with their recorded replies
+ * - unsolicited messages are sent to the attached clients,
+ *   either with their recorded timing or as fast as possible
+ * - global ctrl iface commands ADD/REMOVE bind/unbind interface sockets,
+ *   as hostapd does when interfaces are added at runtime (warm standby)
+ * The server runs in a child process, while the test process pumps
+ * the plugin wpa_ctrl connections, and measures their handling time.
+ */
+
+#define WLD_TH_WPACTRL_REPLAY_MAX_SOCKS 16
+
+typedef struct {
+    uint32_t nrEvts;             // unsolicited messages of the trace
+    uint64_t nrMsgsHandled;      // unsolicited messages received on event connections
+    uint32_t nrWakeups;          // plugin connection read handler calls
+    uint64_t totalHandlingUs;    // time spent in plugin read handlers
+    uint64_t totalHandlingCpuUs; // cpu time spent in plugin read handlers, not affected by scheduling
+    uint64_t maxWakeupUs;        // max time spent in one read handler call
+    uint64_t durationUs;         // replay wall time
+} wld_th_wpaCtrlReplayStats_t;
+
+typedef struct {
+    char tracePath[128];
+    char srvDir[64];
+    char sockNames[WLD_TH_WPACTRL_REPLAY_MAX_SOCKS][WLD_WPACTRL_TRACE_SOCK_NAME_MAX];
+    int srvFds[WLD_TH_WPACTRL_REPLAY_MAX_SOCKS];
+    uint32_t nrSocks;
+    bool realTime;
+    char delayedCmd[64]; // command answered late, as by a busy daemon
+    uint32_t replyDelayMs;
+    pid_t serverPid;
+    wld_th_wpaCtrlReplayStats_t stats;
+} wld_th_wpaCtrlReplay_t;
+
+bool wld_th_wpaCtrlReplay_init(wld_th_wpaCtrlReplay_t* pReplay, const char* tracePath, const char* srvDir, bool realTime);
+void wld_th_wpaCtrlReplay_setReplyDelay(wld_th_wpaCtrlReplay_t* pReplay, const char* cmd, uint32_t delayMs);
+bool wld_th_wpaCtrlReplay_startServer(wld_th_wpaCtrlReplay_t* pReplay);
+bool wld_th_wpaCtrlReplay_run(wld_th_wpaCtrlReplay_t* pReplay, wld_wpaCtrlInterface_t** ifaces, uint32_t nrIfaces, uint32_t tmOutMs);
+void wld_th_wpaCtrlReplay_cleanup(wld_th_wpaCtrlReplay_t* pReplay);
+
+#endif /* SRC_TEST_TESTHELPER_WLD_TH_WPACTRLREPLAY_H_ */
@@ -123,6 +123,46 @@ static void s_checkHistory(T_AccessPoint* vap, ttb_object_t* evObj, const char*
 
 }
 
+/*
+ * getStationStats and getStationStatsSnapshot must report the same values, as both come from the stats export.
+ * The snapshot does not trigger a driver update, so it matches the previous getStationStats reply.
+ */
+static void s_checkStatsSnapshot(T_AccessPoint* vap, ttb_object_t* vapObj, ttb_var_t* statsVar) {
+    printf("%s: check stats snapshot\n", vap->name);
+
+    ttb_var_t* args = ttb_object_createArgs();
+    assert_non_null(args);
+    amxc_var_set_type(args, AMXC_VAR_ID_HTABLE);
+    amxc_var_add_key(uint64_t, args, "sinceGeneration", 0);
+    ttb_var_t* snapshotVar = NULL;
+    ttb_reply_t* reply = ttb_object_callFun(dm.ttbBus, vapObj, "getStationStatsSnapshot", &args, &snapshotVar);
+    assert_true(ttb_object_replySuccess(reply));
+
+    assert_int_equal(GET_UINT32(snapshotVar, "Version"), WLD_AD_STATS_RECORD_VERSION);
+    assert_int_equal(GET_UINT32(snapshotVar, "NrStations"), vap->AssociatedDeviceNumberOfEntries);
+    const amxc_llist_t* stations = amxc_var_constcast(amxc_llist_t, GET_ARG(snapshotVar, "Stations"));
+    const amxc_llist_t* stats = amxc_var_constcast(amxc_llist_t, statsVar);
+    assert_non_null(stations);
+    assert_non_null(stats);
+    assert_int_equal(amxc_llist_size(stations), amxc_llist_size(stats));
+
+    uint32_t index = 0;
+    amxc_llist_for_each(it, stations) {
+        amxc_var_t* station = amxc_var_from_llist_it(it);
+        amxc_var_t* staStats = amxc_var_from_llist_it(amxc_llist_get_at(stats, index));
+        assert_non_null(staStats);
+        const char* keys[] = {"Active", "AuthenticationState", "SignalStrength", "Noise", "LastDataDownlinkRate",
+            "LastDataUplinkRate", "TxBytes", "RxBytes", "TxPacketCount", "RxPacketCount", "TxErrors", "Retransmissions"};
+        for(uint32_t i = 0; i < SWL_ARRAY_SIZE(keys); i++) {
+            int result = -1;
+            assert_int_equal(amxc_var_compare(GET_ARG(station, keys[i]), GET_ARG(staStats, keys[i]), &result), 0);
+            assert_int_equal(result, 0);
+        }
+        index++;
+    }
+    ttb_object_cleanReply(&reply, &snapshotVar);
+}
+
 static void s_checkStaStats(T_AccessPoint* vap, ttb_object_t* vapObj) {
     printf("%s: check stats\n", vap->name);
 
@@ -135,10 +175,53 @@ static void s_checkStaStats(T_AccessPoint* vap, ttb_object_t* vapObj) {
     char fileBuf[64] = {0};
     snprintf(fileBuf, sizeof(fileBuf), "stationStats/stats_%s", vendorD->staStatsFileName);
     swl_ttbVariant_assertToFileMatchesFile(replyVar, fileBuf);
+    s_checkStatsSnapshot(vap, vapObj, replyVar);
     ttb_object_cleanReply(&reply, &replyVar);
 }
 
 
+static void s_checkStatsExport(T_AccessPoint* vap) {
+    printf("%s: check stats export\n", vap->name);
+
+    wld_ad_statsRecord_t records[NR_TEST_DEV];
+    wld_ad_statsSnapshot_t snapshot;
+    assert_int_equal(wld_ad_exportStaStats(vap, 0, &snapshot, records, NR_TEST_DEV), SWL_RC_OK);
+    assert_int_equal(snapshot.version, WLD_AD_STATS_RECORD_VERSION);
+    assert_int_equal(snapshot.recordSize, sizeof(wld_ad_statsRecord_t));
+    assert_int_equal(snapshot.nrStations, vap->AssociatedDeviceNumberOfEntries);
+    assert_int_equal(snapshot.nrRecords, snapshot.nrStations);
+    for(uint32_t i = 0; i < snapshot.nrRecords; i++) {
+        T_AssociatedDevice* pAD = vap->AssociatedDevice[i];
+        assert_memory_equal(records[i].macAddress, pAD->MACAddress, ETHER_ADDR_LEN);
+        assert_int_equal(records[i].signalStrength, pAD->SignalStrength);
+        assert_int_equal(records[i].txBytes, pAD->TxBytes);
+        assert_int_equal(records[i].lastDataDownlinkRate, pAD->LastDataDownlinkRate);
+        assert_true(records[i].generation <= snapshot.generation);
+    }
+
+    /* nothing changed since last export */
+    uint64_t generation = snapshot.generation;
+    assert_int_equal(wld_ad_exportStaStats(vap, generation, &snapshot, records, NR_TEST_DEV), SWL_RC_OK);
+    assert_int_equal(snapshot.nrChanged, 0);
+    assert_int_equal(snapshot.nrRecords, 0);
+    assert_int_equal(snapshot.generation, generation);
+
+    /* only the changed station is exported */
+    T_AssociatedDevice* pAD = vap->AssociatedDevice[0];
+    pAD->TxBytes++;
+    assert_int_equal(wld_ad_exportStaStats(vap, generation, &snapshot, records, NR_TEST_DEV), SWL_RC_OK);
+    assert_int_equal(snapshot.nrChanged, 1);
+    assert_int_equal(snapshot.nrRecords, 1);
+    assert_memory_equal(records[0].macAddress, pAD->MACAddress, ETHER_ADDR_LEN);
+    assert_int_equal(records[0].generation, snapshot.generation);
+    pAD->TxBytes--;
+
+    /* record array too small */
+    assert_int_equal(wld_ad_exportStaStats(vap, 0, &snapshot, records, 1), SWL_RC_OK);
+    assert_int_equal(snapshot.nrChanged, snapshot.nrStations);
+    assert_int_equal(snapshot.nrRecords, 1);
+}
+
 static void test_getStats(void** state _UNUSED) {
     T_AccessPoint* vap = dm.bandList[SWL_FREQ_BAND_EXT_5GHZ].vapPriv;
     ttb_object_t* vapObj = dm.bandList[SWL_FREQ_BAND_EXT_5GHZ].vapPrivObj;
@@ -190,6 +273,7 @@ static void test_getStats(void** state _UNUSED) {
     s_checkHistory(vap, evObj, "history3.txt");
 
     s_checkStaStats(vap, vapObj);
+    s_checkStatsExport(vap);
     ttb_mockTimer_goToFutureSec(1);
 
     swl_macBin_t macBin;
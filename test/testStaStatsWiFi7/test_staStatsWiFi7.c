@@ -68,6 +68,7 @@
 #include "wld_radio.h"
 #include "wld_accesspoint.h"
 #include "wld_assocdev.h"
+#include "wld_eventing.h"
 #include "wld_radio.h"
 #include "test-toolbox/ttb_mockTimer.h"
 #include "test-toolbox/ttb.h"
@@ -286,6 +287,130 @@ static void test_deactivate(void** state _UNUSED) {
     wld_ad_destroy(vap5, pAD);
 }
 
+static void test_staCounters(void** state _UNUSED) {
+    T_AccessPoint* vap5 = dm.bandList[SWL_FREQ_BAND_EXT_5GHZ].vapPriv;
+    assert_non_null(vap5);
+    T_Radio* rad5 = vap5->pRadio;
+    assert_non_null(rad5);
+
+    ttb_mockTimer_goToFutureSec(1);
+
+    ttb_assert_int_eq(wld_ad_get_nb_active_stations(vap5), 0);
+    uint32_t nrRadActive = wld_rad_getStaCounters(rad5)->nrActive;
+    uint32_t nrRadVideo = wld_rad_get_nb_active_video_stations(rad5);
+    assert_false(wld_ad_hasAuthenticatedStations(vap5));
+
+    swl_macBin_t myBin = {.bMac = {0xaa, 0xbb, 0xaa, 0xbb, 0xaa, 0x02}};
+    T_AssociatedDevice* pAD = wld_ad_create_associatedDevice(vap5, &myBin);
+    assert_non_null(pAD);
+    pAD->operatingStandard = SWL_RADSTD_AX;
+    pAD->SignalStrength = -80;
+
+    wld_ad_add_connection_try(vap5, pAD);
+    ttb_assert_int_eq(wld_ad_get_nb_active_stations(vap5), 1);
+    assert_false(wld_ad_hasAuthenticatedStations(vap5));
+    ttb_assert_int_eq(wld_rad_getStaCounters(rad5)->nrActive, nrRadActive + 1);
+
+    wld_ad_add_connection_success(vap5, pAD);
+    assert_true(wld_ad_hasAuthenticatedStations(vap5));
+    ttb_assert_int_eq(wld_ad_getStaCounters(vap5)->nrActivePerStd[SWL_RADSTD_AX], 1);
+    ttb_assert_int_eq(wld_ad_getStaCounters(vap5)->nrActivePerBand[SWL_FREQ_BAND_EXT_5GHZ], 1);
+    ttb_assert_int_eq(wld_ad_getFarStaCount(vap5, -70), 1);
+    ttb_assert_int_eq(wld_ad_getFarStaCount(vap5, -80), 0);
+    assert_true(wld_ad_has_far_station(vap5, -79));
+
+    pAD->SignalStrength = -60;
+    pAD->deviceType = DEVICE_TYPE_VIDEO;
+    wld_ad_refreshStaCounters(vap5, pAD);
+    ttb_assert_int_eq(wld_ad_getFarStaCount(vap5, -70), 0);
+    ttb_assert_int_eq(wld_ad_get_nb_active_video_stations(vap5), 1);
+    ttb_assert_int_eq(wld_rad_get_nb_active_video_stations(rad5), nrRadVideo + 1);
+    assert_true(wld_ad_checkStaCounters(vap5));
+
+    wld_ad_add_disconnection(vap5, pAD);
+    ttb_assert_int_eq(wld_ad_get_nb_active_stations(vap5), 0);
+    assert_false(wld_ad_has_active_video_stations(vap5));
+    ttb_assert_int_eq(wld_rad_getStaCounters(rad5)->nrActive, nrRadActive);
+    assert_false(wld_ad_hasAuthenticatedStations(vap5));
+    assert_true(wld_ad_checkStaCounters(vap5));
+
+    wld_ad_destroy(vap5, pAD);
+    assert_true(wld_ad_checkStaCounters(vap5));
+}
+
+static swl_macBin_t s_batchTestMac = {.bMac = {0xaa, 0xbb, 0xaa, 0xbb, 0xaa, 0x03}};
+static uint32_t s_nrBatches = 0;
+static wld_ad_batchChange_t s_lastBatchChange;
+
+static void s_onBatchChange(const wld_ad_batchChangeEvent_t* event) {
+    for(uint32_t i = 0; i < event->nrChanges; i++) {
+        if(swl_mac_binMatches(&event->changes[i].macAddress, &s_batchTestMac)) {
+            s_nrBatches++;
+            s_lastBatchChange = event->changes[i];
+        }
+    }
+}
+
+static wld_event_callback_t s_batchChangeCb = {
+    .callback = (wld_event_callback_fun) s_onBatchChange,
+};
+
+static void test_staBatchChanges(void** state _UNUSED) {
+    T_AccessPoint* vap5 = dm.bandList[SWL_FREQ_BAND_EXT_5GHZ].vapPriv;
+    assert_non_null(vap5);
+    wld_event_add_callback(gWld_queue_sta_onBatchChangeEvent, &s_batchChangeCb);
+    ttb_mockTimer_goToFutureSec(1);
+    s_nrBatches = 0;
+
+    T_AssociatedDevice* pAD = wld_ad_create_associatedDevice(vap5, &s_batchTestMac);
+    assert_non_null(pAD);
+    wld_ad_add_connection_try(vap5, pAD);
+    wld_ad_add_connection_success(vap5, pAD);
+    wld_ad_add_disconnection(vap5, pAD);
+    ttb_assert_int_eq(s_nrBatches, 0);
+
+    /* all changes are delivered at once */
+    ttb_mockTimer_goToFutureMs(1);
+    ttb_assert_int_eq(s_nrBatches, 1);
+    assert_ptr_equal(s_lastBatchChange.vap, vap5);
+    assert_ptr_equal(s_lastBatchChange.ad, pAD);
+    ttb_assert_int_eq(s_lastBatchChange.changeMask,
+                      SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_CREATE) | SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_ASSOC)
+                      | SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_AUTH) | SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_DISASSOC));
+    ttb_assert_int_eq(s_lastBatchChange.lastChangeType, WLD_AD_CHANGE_EVENT_DISASSOC);
+    ttb_assert_int_eq(s_lastBatchChange.nrEvents, 4);
+
+    /* changes within the window are merged, destroyed station is reported without pointer */
+    wld_ad_setBatchChangeWindow(500);
+    wld_ad_add_connection_try(vap5, pAD);
+    ttb_mockTimer_goToFutureMs(100);
+    wld_ad_destroy(vap5, pAD);
+    ttb_mockTimer_goToFutureMs(100);
+    ttb_assert_int_eq(s_nrBatches, 1);
+    ttb_mockTimer_goToFutureMs(400);
+    ttb_assert_int_eq(s_nrBatches, 2);
+    assert_null(s_lastBatchChange.ad);
+    assert_true(s_lastBatchChange.changeMask & SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_ASSOC));
+    assert_true(s_lastBatchChange.changeMask & SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_DESTROY));
+    ttb_assert_int_eq(s_lastBatchChange.lastChangeType, WLD_AD_CHANGE_EVENT_DESTROY);
+
+    /* station destroyed after last subscriber left: pending entry still drops the pointer */
+    pAD = wld_ad_create_associatedDevice(vap5, &s_batchTestMac);
+    assert_non_null(pAD);
+    wld_event_remove_callback(gWld_queue_sta_onBatchChangeEvent, &s_batchChangeCb);
+    wld_ad_destroy(vap5, pAD);
+    wld_event_add_callback(gWld_queue_sta_onBatchChangeEvent, &s_batchChangeCb);
+    ttb_mockTimer_goToFutureMs(500);
+    ttb_assert_int_eq(s_nrBatches, 3);
+    assert_null(s_lastBatchChange.ad);
+    ttb_assert_int_eq(s_lastBatchChange.changeMask,
+                      SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_CREATE) | SWL_BIT_SHIFT(WLD_AD_CHANGE_EVENT_DESTROY));
+    ttb_assert_int_eq(s_lastBatchChange.lastChangeType, WLD_AD_CHANGE_EVENT_DESTROY);
+
+    wld_ad_setBatchChangeWindow(0);
+    wld_event_remove_callback(gWld_queue_sta_onBatchChangeEvent, &s_batchChangeCb);
+}
+
 int main(int argc _UNUSED, char* argv[] _UNUSED) {
     sahTraceSetLevel(TRACE_LEVEL_INFO);
     sahTraceAddZone(500, "apRssi");
@@ -296,6 +421,8 @@ int main(int argc _UNUSED, char* argv[] _UNUSED) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_getStats),
         cmocka_unit_test(test_deactivate),
+        cmocka_unit_test(test_staCounters),
+        cmocka_unit_test(test_staBatchChanges),
     };
     return cmocka_run_group_tests(tests, setup_suite, teardown_suite);
 }
@@ -0,0 +1,260 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2022 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <cmocka.h>
+
+#include <debug/sahtrace.h>
+
+#include "wld.h"
+#include "wld_ap_staDcLog.h"
+
+static swl_macBin_t s_getMac(uint32_t id) {
+    swl_macBin_t mac = {.bMac = {0x02, 0x00, 0x00, (id >> 16) & 0xFF, (id >> 8) & 0xFF, id & 0xFF}};
+    return mac;
+}
+
+static void test_addFind(void** state _UNUSED) {
+    wld_apDcLog_t log;
+    assert_int_equal(wld_apDcLog_init(&log, 4), SWL_RC_OK);
+
+    swl_macBin_t mac1 = s_getMac(1);
+    swl_macBin_t mac2 = s_getMac(2);
+    assert_null(wld_apDcLog_find(&log, &mac1));
+
+    wld_apDcLog_entry_t* entry = wld_apDcLog_add(&log, &mac1, 3);
+    assert_non_null(entry);
+    assert_ptr_equal(wld_apDcLog_find(&log, &mac1), entry);
+    assert_null(wld_apDcLog_find(&log, &mac2));
+    assert_int_equal(entry->reason, 3);
+
+    /* re-adding a logged station updates its entry */
+    assert_ptr_equal(wld_apDcLog_add(&log, &mac1, 8), entry);
+    assert_int_equal(entry->reason, 8);
+    assert_int_equal(wld_apDcLog_getCount(&log), 1);
+
+    wld_apDcLog_destroy(&log);
+}
+
+static void test_lruEviction(void** state _UNUSED) {
+    wld_apDcLog_t log;
+    assert_int_equal(wld_apDcLog_init(&log, 3), SWL_RC_OK);
+
+    for(uint32_t i = 0; i < 3; i++) {
+        swl_macBin_t mac = s_getMac(i);
+        wld_apDcLog_add(&log, &mac, 1);
+    }
+    /* refresh station 0, so station 1 becomes least recent */
+    swl_macBin_t mac0 = s_getMac(0);
+    wld_apDcLog_add(&log, &mac0, 1);
+
+    swl_macBin_t mac3 = s_getMac(3);
+    wld_apDcLog_add(&log, &mac3, 1);
+    assert_int_equal(wld_apDcLog_getCount(&log), 3);
+
+    swl_macBin_t mac1 = s_getMac(1);
+    swl_macBin_t mac2 = s_getMac(2);
+    assert_null(wld_apDcLog_find(&log, &mac1));
+    assert_non_null(wld_apDcLog_find(&log, &mac0));
+    assert_non_null(wld_apDcLog_find(&log, &mac2));
+    assert_non_null(wld_apDcLog_find(&log, &mac3));
+
+    wld_apDcLog_entry_t* results[4];
+    assert_int_equal(wld_apDcLog_getRecent(&log, NULL, results, 4), 3);
+    assert_true(swl_mac_binMatches(&results[0]->macAddress, &mac3));
+    assert_true(swl_mac_binMatches(&results[1]->macAddress, &mac0));
+    assert_true(swl_mac_binMatches(&results[2]->macAddress, &mac2));
+
+    wld_apDcLog_destroy(&log);
+}
+
+static void test_manyStations(void** state _UNUSED) {
+    wld_apDcLog_t log;
+    assert_int_equal(wld_apDcLog_init(&log, 64), SWL_RC_OK);
+
+    for(uint32_t i = 0; i < 1000; i++) {
+        swl_macBin_t mac = s_getMac(i);
+        wld_apDcLog_add(&log, &mac, i % 5);
+    }
+    assert_int_equal(wld_apDcLog_getCount(&log), 64);
+    for(uint32_t i = 0; i < 1000; i++) {
+        swl_macBin_t mac = s_getMac(i);
+        wld_apDcLog_entry_t* entry = wld_apDcLog_find(&log, &mac);
+        if(i < 1000 - 64) {
+            assert_null(entry);
+        } else {
+            assert_non_null(entry);
+            assert_int_equal(entry->reason, i % 5);
+        }
+    }
+
+    wld_apDcLog_destroy(&log);
+}
+
+static void test_filter(void** state _UNUSED) {
+    wld_apDcLog_t log;
+    assert_int_equal(wld_apDcLog_init(&log, 8), SWL_RC_OK);
+
+    /* reasons 2 and 18 share a reason bucket */
+    uint16_t reasons[] = {2, 18, 2, 3, 18, 2};
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(reasons); i++) {
+        swl_macBin_t mac = s_getMac(i);
+        wld_apDcLog_add(&log, &mac, reasons[i]);
+    }
+
+    wld_apDcLog_entry_t* results[8];
+    wld_apDcLog_filter_t filter = {.filterReason = true, .reason = 2};
+    assert_int_equal(wld_apDcLog_getRecent(&log, &filter, results, 8), 3);
+    swl_macBin_t mac = s_getMac(5);
+    assert_true(swl_mac_binMatches(&results[0]->macAddress, &mac));
+    mac = s_getMac(0);
+    assert_true(swl_mac_binMatches(&results[2]->macAddress, &mac));
+
+    filter.reason = 18;
+    assert_int_equal(wld_apDcLog_getRecent(&log, &filter, results, 8), 2);
+    assert_int_equal(wld_apDcLog_getRecent(&log, &filter, results, 1), 1);
+
+    /* station moves to another reason bucket */
+    mac = s_getMac(4);
+    wld_apDcLog_add(&log, &mac, 3);
+    assert_int_equal(wld_apDcLog_getRecent(&log, &filter, results, 8), 1);
+    filter.reason = 3;
+    assert_int_equal(wld_apDcLog_getRecent(&log, &filter, results, 8), 2);
+
+    /* shift all entries back in time, only the refreshed one stays in the window */
+    for(uint32_t i = 0; i < log.count; i++) {
+        log.entries[i].dcTime.tv_sec -= 10;
+    }
+    mac = s_getMac(1);
+    wld_apDcLog_add(&log, &mac, 18);
+    wld_apDcLog_filter_t ageFilter = {.maxAgeMs = 5000};
+    assert_int_equal(wld_apDcLog_getRecent(&log, &ageFilter, results, 8), 1);
+    assert_true(swl_mac_binMatches(&results[0]->macAddress, &mac));
+    ageFilter.maxAgeMs = 0;
+    assert_int_equal(wld_apDcLog_getRecent(&log, &ageFilter, results, 8), 6);
+
+    wld_apDcLog_destroy(&log);
+}
+
+static void test_setCapacity(void** state _UNUSED) {
+    wld_apDcLog_t log;
+    assert_int_equal(wld_apDcLog_init(&log, 8), SWL_RC_OK);
+
+    for(uint32_t i = 0; i < 8; i++) {
+        swl_macBin_t mac = s_getMac(i);
+        wld_apDcLog_add(&log, &mac, i);
+    }
+    assert_int_equal(wld_apDcLog_setCapacity(&log, 3), SWL_RC_OK);
+    assert_int_equal(wld_apDcLog_getCount(&log), 3);
+    for(uint32_t i = 0; i < 8; i++) {
+        swl_macBin_t mac = s_getMac(i);
+        wld_apDcLog_entry_t* entry = wld_apDcLog_find(&log, &mac);
+        if(i < 5) {
+            assert_null(entry);
+        } else {
+            assert_non_null(entry);
+            assert_int_equal(entry->reason, i);
+        }
+    }
+
+    assert_int_equal(wld_apDcLog_setCapacity(&log, 16), SWL_RC_OK);
+    assert_int_equal(wld_apDcLog_getCount(&log), 3);
+    wld_apDcLog_entry_t* results[16];
+    assert_int_equal(wld_apDcLog_getRecent(&log, NULL, results, 16), 3);
+    assert_int_equal(results[0]->reason, 7);
+    assert_int_equal(results[2]->reason, 5);
+
+    amxc_var_t list;
+    amxc_var_init(&list);
+    wld_apDcLog_toListOfMaps(&log, &list);
+    assert_int_equal(amxc_llist_size(amxc_var_constcast(amxc_llist_t, &list)), 3);
+    amxc_var_t* first = amxc_var_get_first(&list);
+    assert_int_equal(GET_UINT32(first, "reason"), 5);
+    amxc_var_clean(&list);
+
+    assert_int_not_equal(wld_apDcLog_setCapacity(&log, 0), SWL_RC_OK);
+    wld_apDcLog_destroy(&log);
+}
+
+int main(int argc _UNUSED, char* argv[] _UNUSED) {
+    sahTraceOpen(__FILE__, TRACE_TYPE_STDERR);
+    if(!sahTraceIsOpen()) {
+        fprintf(stderr, "FAILED to open SAH TRACE\n");
+    }
+    sahTraceSetLevel(TRACE_LEVEL_WARNING);
+    sahTraceSetTimeFormat(TRACE_TIME_APP_SECONDS);
+    sahTraceAddZone(sahTraceLevel(), "pcb");
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_addFind),
+        cmocka_unit_test(test_lruEviction),
+        cmocka_unit_test(test_manyStations),
+        cmocka_unit_test(test_filter),
+        cmocka_unit_test(test_setCapacity),
+    };
+    int rc = cmocka_run_group_tests(tests, NULL, NULL);
+    sahTraceClose();
+    return rc;
+}
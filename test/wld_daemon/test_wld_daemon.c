@@ -122,6 +122,103 @@ static void test_wld_daemon_setArgList_reset(void** state) {
     wld_dmn_cleanupDaemon(&dmnProcess);
 }
 
+static void test_wld_daemon_startupBackoff(void** state _UNUSED) {
+    wld_daemonMonitorConf_t conf = {
+        .backoffInitMs = 1000,
+        .backoffMaxMs = 30000,
+    };
+    for(uint32_t i = 0; i < 100; i++) {
+        uint32_t delay = wld_dmn_getStartupBackoffMs(&conf, 1);
+        assert_in_range(delay, 800, 1200);
+        delay = wld_dmn_getStartupBackoffMs(&conf, 3);
+        assert_in_range(delay, 3200, 4800);
+        /* capped */
+        delay = wld_dmn_getStartupBackoffMs(&conf, 10);
+        assert_in_range(delay, 24000, 30000);
+        delay = wld_dmn_getStartupBackoffMs(&conf, 100);
+        assert_in_range(delay, 24000, 30000);
+    }
+}
+
+static void test_wld_daemon_setReady(void** state _UNUSED) {
+    wld_process_t dmnProcess = {0};
+    assert_true(wld_dmn_initializeDeamon(&dmnProcess, "hostapd"));
+
+    /* not started: readiness ignored */
+    wld_dmn_setReady(&dmnProcess);
+    assert_false(wld_dmn_isReady(&dmnProcess));
+    assert_int_equal(wld_dmn_getReadyStats(&dmnProcess)->nReady, 0);
+
+    dmnProcess.status = WLD_DAEMON_STATE_UP;
+    dmnProcess.startupFails = 5;
+    dmnProcess.crashLoop = true;
+    swl_timespec_getMono(&dmnProcess.startTime);
+    wld_dmn_setReady(&dmnProcess);
+    assert_true(wld_dmn_isReady(&dmnProcess));
+    assert_false(wld_dmn_isCrashLooping(&dmnProcess));
+    assert_int_equal(dmnProcess.startupFails, 0);
+    const wld_dmn_readyStats_t* pStats = wld_dmn_getReadyStats(&dmnProcess);
+    assert_int_equal(pStats->nReady, 1);
+    assert_int_equal(pStats->hist[0], 1);
+
+    /* counted once per startup */
+    wld_dmn_setReady(&dmnProcess);
+    assert_int_equal(pStats->nReady, 1);
+
+    dmnProcess.status = WLD_DAEMON_STATE_DOWN;
+    wld_dmn_cleanupDaemon(&dmnProcess);
+}
+
+static void test_wld_daemon_crashRestartDelay(void** state _UNUSED) {
+    wld_daemonMonitorConf_t conf = {
+        .instantRestartLimit = 3,
+        .minRestartInterval = 1800,
+    };
+    /* instant restart below the limit */
+    assert_int_equal(wld_dmn_getCrashRestartDelayMs(&conf, 1, 10), 100);
+    assert_int_equal(wld_dmn_getCrashRestartDelayMs(&conf, 3, 10), 100);
+    /* first crash above the limit waits the full interval, next ones the remaining time */
+    assert_int_equal(wld_dmn_getCrashRestartDelayMs(&conf, 4, 10), 1800 * 1000);
+    assert_int_equal(wld_dmn_getCrashRestartDelayMs(&conf, 5, 800), 1000 * 1000);
+    /* previous crash old enough */
+    assert_int_equal(wld_dmn_getCrashRestartDelayMs(&conf, 5, 2000), 100);
+    /* no limit */
+    conf.instantRestartLimit = -1;
+    assert_int_equal(wld_dmn_getCrashRestartDelayMs(&conf, 10, 1), 100);
+}
+
+static void test_wld_daemon_debug(void** state _UNUSED) {
+    wld_process_t dmnProcess = {0};
+    assert_true(wld_dmn_initializeDeamon(&dmnProcess, "hostapd"));
+    dmnProcess.status = WLD_DAEMON_STATE_UP;
+    dmnProcess.crashLoop = true;
+    dmnProcess.startupFails = 5;
+    swl_timespec_getMono(&dmnProcess.startTime);
+    wld_dmn_setReady(&dmnProcess);
+
+    amxc_var_t map;
+    amxc_var_init(&map);
+    amxc_var_set_type(&map, AMXC_VAR_ID_HTABLE);
+    wld_dmn_debug(&dmnProcess, &map);
+    assert_string_equal(GET_CHAR(&map, "Cmd"), "hostapd");
+    assert_string_equal(GET_CHAR(&map, "Status"), "Up");
+    assert_true(GET_BOOL(&map, "Ready"));
+    assert_false(GET_BOOL(&map, "CrashLoop"));
+    assert_int_equal(GET_UINT32(&map, "StartupFails"), 0);
+    amxc_var_t* pStats = GET_ARG(&map, "ReadyStats");
+    assert_non_null(pStats);
+    assert_int_equal(GET_UINT32(pStats, "NrReady"), 1);
+    amxc_var_t* pHist = GET_ARG(pStats, "Histogram");
+    assert_non_null(pHist);
+    assert_int_equal(GET_UINT32(pHist, "Below100Ms"), 1);
+    assert_int_equal(GET_UINT32(pHist, "Above10000Ms"), 0);
+    assert_int_equal(amxc_htable_size(amxc_var_constcast(amxc_htable_t, pHist)), WLD_DMN_READY_HIST_SIZE);
+    amxc_var_clean(&map);
+
+    dmnProcess.status = WLD_DAEMON_STATE_DOWN;
+    wld_dmn_cleanupDaemon(&dmnProcess);
+}
+
 static int s_setupSuite(void** state) {
     (void) state;
     return 0;
@@ -143,6 +240,10 @@ int main(int argc _UNUSED, char* argv[] _UNUSED) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_wld_daemon_setArgList),
         cmocka_unit_test(test_wld_daemon_setArgList_reset),
+        cmocka_unit_test(test_wld_daemon_startupBackoff),
+        cmocka_unit_test(test_wld_daemon_setReady),
+        cmocka_unit_test(test_wld_daemon_crashRestartDelay),
+        cmocka_unit_test(test_wld_daemon_debug),
     };
     int rc = cmocka_run_group_tests(tests, s_setupSuite, s_teardownSuite);
     sahTraceClose();
@@ -64,6 +64,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 #include <stdint.h>
 #include <setjmp.h>
 #include <stdarg.h>
@@ -76,6 +77,15 @@
 #include "wld.h"
 #include "wld_hostapd_ap_api.h"
 #include "wld_wpaCtrl_events.h"
+#include "wld_wpaCtrl_evtPolicy.h"
+#include "wld_wps.h"
+#include "wld_wpaSupp_parser.h"
+#include "wld_secDmnGrp.h"
+#include "wld_secDmn_priv.h"
+#include "wld_hostapd_cfgManager.h"
+#include "wld_hostapd_cfgFile.h"
+#include "Utils/wld_cfgDoc.h"
+#include "Utils/wld_cfgWriter.h"
 
 static void test_wld_ap_hostapd_getParamAction(void** state) {
     (void) state;
@@ -110,6 +120,116 @@ static void test_wld_ap_hostapd_setParamAction(void** state) {
     assert_int_equal(pMappedAction, SECDMN_ACTION_OK_NEED_SIGHUP);
 }
 
+static void test_wld_ap_hostapd_classifyParamsDelta(void** state _UNUSED) {
+    /* param changes replayed against the cheapest expected action */
+    struct {
+        const char* param;
+        const char* oldValue;
+        const char* newValue;
+        wld_secDmn_action_rc_ne expAction;
+    } changes[] = {
+        {"max_num_sta", "32", "16", SECDMN_ACTION_OK_DONE},
+        {"config_id", "0123456789abcdef", "fedcba9876543210", SECDMN_ACTION_OK_DONE},
+        {"ap_isolate", "0", "0", SECDMN_ACTION_OK_DONE},
+        {"ap_isolate", "0", "1", SECDMN_ACTION_OK_NEED_UPDATE_BEACON},
+        {"ignore_broadcast_ssid", NULL, "2", SECDMN_ACTION_OK_NEED_UPDATE_BEACON},
+        {"wpa_passphrase", "password1", "password2", SECDMN_ACTION_OK_NEED_RELOAD_SECKEY},
+        {"rsn_pairwise", "CCMP", "CCMP GCMP", SECDMN_ACTION_OK_NEED_SIGHUP},
+        {"vendor_elements", NULL, "dd0411223344", SECDMN_ACTION_OK_NEED_SIGHUP},
+        {"ap_isolate", "1", NULL, SECDMN_ACTION_OK_NEED_SIGHUP},
+        {"wpa", "2", "3", SECDMN_ACTION_OK_NEED_TOGGLE},
+        {"mld_ap", "0", "1", SECDMN_ACTION_OK_NEED_RESTART},
+    };
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(changes); i++) {
+        assert_int_equal(wld_ap_hostapd_classifyParamChange(changes[i].param, changes[i].oldValue, changes[i].newValue), changes[i].expAction);
+    }
+    assert_int_equal(wld_ap_hostapd_classifyParamChange(NULL, "0", "1"), SECDMN_ACTION_ERROR);
+
+    /* the plan of a whole section delta keeps the cheapest action applying all changes */
+    swl_mapChar_t currParams;
+    swl_mapChar_t newParams;
+    swl_mapChar_init(&currParams);
+    swl_mapChar_init(&newParams);
+    swl_mapChar_add(&currParams, "bss", "wlan1");
+    swl_mapChar_add(&currParams, "ssid", "a");
+    swl_mapChar_add(&currParams, "ap_isolate", "0");
+    swl_mapChar_add(&currParams, "max_num_sta", "32");
+    swl_mapChar_add(&newParams, "bss", "wlan1");
+    swl_mapChar_add(&newParams, "ssid", "a");
+    swl_mapChar_add(&newParams, "ap_isolate", "0");
+    swl_mapChar_add(&newParams, "max_num_sta", "32");
+    wld_ap_hostapd_cfgDeltaPlan_t plan;
+    assert_int_equal(wld_ap_hostapd_classifyParamsDelta(&currParams, &newParams, &plan), SECDMN_ACTION_OK_DONE);
+    assert_int_equal(plan.nChanged, 0);
+
+    swl_map_addOrSet(&newParams, "max_num_sta", "16");
+    assert_int_equal(wld_ap_hostapd_classifyParamsDelta(&currParams, &newParams, &plan), SECDMN_ACTION_OK_DONE);
+    assert_int_equal(plan.nChanged, 1);
+    assert_int_equal(plan.nParamsByAction[SECDMN_ACTION_OK_DONE], 1);
+
+    swl_map_addOrSet(&newParams, "ap_isolate", "1");
+    assert_int_equal(wld_ap_hostapd_classifyParamsDelta(&currParams, &newParams, &plan), SECDMN_ACTION_OK_NEED_UPDATE_BEACON);
+    assert_int_equal(plan.nChanged, 2);
+
+    swl_mapChar_delete(&newParams, "ap_isolate");
+    swl_mapChar_add(&newParams, "wpa", "2");
+    assert_int_equal(wld_ap_hostapd_classifyParamsDelta(&currParams, &newParams, &plan), SECDMN_ACTION_OK_NEED_TOGGLE);
+    assert_int_equal(plan.nChanged, 3);
+    assert_int_equal(plan.nParamsByAction[SECDMN_ACTION_OK_NEED_SIGHUP], 1);
+    assert_int_equal(plan.nParamsByAction[SECDMN_ACTION_OK_NEED_TOGGLE], 1);
+
+    swl_map_addOrSet(&newParams, "bss", "wlan2");
+    assert_int_equal(wld_ap_hostapd_classifyParamsDelta(&currParams, &newParams, NULL), SECDMN_ACTION_OK_NEED_RESTART);
+    assert_int_equal(wld_ap_hostapd_classifyParamsDelta(NULL, &newParams, NULL), SECDMN_ACTION_ERROR);
+
+    swl_mapChar_cleanup(&currParams);
+    swl_mapChar_cleanup(&newParams);
+}
+
+static void test_wld_ap_hostapd_classifyNoSecParamsDelta(void** state _UNUSED) {
+    const char* syncedParams[] = {"ap_isolate", "ignore_broadcast_ssid", "wps_state", "ieee80211w", "rnr", "vendor_elements"};
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(syncedParams); i++) {
+        assert_true(wld_ap_hostapd_isNoSecSyncParam(syncedParams[i]));
+    }
+    const char* excludedParams[] = {
+        "bss", "bssid", "ssid", "wpa", "wpa_key_mgmt", "wpa_passphrase", "sae_password",
+        "rsn_pairwise", "wep_key0", "auth_server_addr", "mld_ap", "start_disabled", "max_num_sta",
+    };
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(excludedParams); i++) {
+        assert_false(wld_ap_hostapd_isNoSecSyncParam(excludedParams[i]));
+    }
+    assert_false(wld_ap_hostapd_isNoSecSyncParam(NULL));
+
+    swl_mapChar_t currParams;
+    swl_mapChar_t newParams;
+    swl_mapChar_init(&currParams);
+    swl_mapChar_init(&newParams);
+    swl_mapChar_add(&currParams, "bss", "wlan1");
+    swl_mapChar_add(&currParams, "ssid", "a");
+    swl_mapChar_add(&currParams, "wpa_passphrase", "password1");
+    swl_mapChar_add(&currParams, "ap_isolate", "0");
+    swl_mapChar_add(&newParams, "bss", "wlan2");
+    swl_mapChar_add(&newParams, "ssid", "b");
+    swl_mapChar_add(&newParams, "wpa_passphrase", "password2");
+    swl_mapChar_add(&newParams, "ap_isolate", "0");
+    wld_ap_hostapd_cfgDeltaPlan_t plan;
+    /* security and structural changes are left to dedicated paths */
+    assert_int_equal(wld_ap_hostapd_classifyNoSecParamsDelta(&currParams, &newParams, &plan), SECDMN_ACTION_OK_DONE);
+    assert_int_equal(plan.nChanged, 0);
+
+    swl_map_addOrSet(&newParams, "ap_isolate", "1");
+    assert_int_equal(wld_ap_hostapd_classifyNoSecParamsDelta(&currParams, &newParams, &plan), SECDMN_ACTION_OK_NEED_UPDATE_BEACON);
+    assert_int_equal(plan.nChanged, 1);
+
+    swl_mapChar_add(&newParams, "vendor_elements", "dd0411223344");
+    assert_int_equal(wld_ap_hostapd_classifyNoSecParamsDelta(&currParams, &newParams, &plan), SECDMN_ACTION_OK_NEED_SIGHUP);
+    assert_int_equal(plan.nChanged, 2);
+    assert_int_equal(wld_ap_hostapd_classifyNoSecParamsDelta(&currParams, NULL, NULL), SECDMN_ACTION_ERROR);
+
+    swl_mapChar_cleanup(&currParams);
+    swl_mapChar_cleanup(&newParams);
+}
+
 static void test_wld_parse_wpactrl_event(void** state) {
     (void) state;
     struct testInfo {
@@ -255,6 +375,815 @@ static void test_wld_fetch_wpactrl_event(void** state) {
     W_SWL_FREE(pParams);
 }
 
+static void test_wld_wpactrl_reply_tokenizer(void** state) {
+    (void) state;
+    const char* staReply =
+        "aa:bb:cc:dd:ee:ff\n"
+        "flags=[AUTH][ASSOC][AUTHORIZED][WMM][HT][VHT][HE]\n"
+        "aid=1\n"
+        "capability=0x1511\n"
+        "listen_interval=10\n"
+        "supported_rates=8c 12 98 24 b0 48 60 6c\n"
+        "timeout_next=NULLFUNC POLL\n"
+        "rx_packets=1042\n"
+        "tx_packets=987\n"
+        "wpa=2\n"
+        "AKMSuiteSelector=00-0f-ac-2\n"
+        "hostapd_WPA_PTK_STATE=14\n"
+        "vendor_oui=00:50:f2\n"
+        "empty=\n"
+        "last=end";
+    const char* keys[] = {
+        "flags", "aid", "capability", "listen_interval", "supported_rates", "timeout_next",
+        "rx_packets", "tx_packets", "wpa", "AKMSuiteSelector", "hostapd_WPA_PTK_STATE", "vendor_oui", "last",
+    };
+
+    wld_wpaCtrl_reply_t reply;
+    assert_int_equal(wld_wpaCtrl_reply_parse(&reply, staReply), SWL_RC_OK);
+    assert_int_equal(reply.nrPairs, 14);
+    assert_false(reply.truncated);
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(keys); i++) {
+        char expVal[128] = {0};
+        char val[128] = {0};
+        int expLen = wld_wpaCtrl_getValueStr(staReply, keys[i], expVal, sizeof(expVal) - 1);
+        assert_true(expLen > 0);
+        assert_int_equal(wld_wpaCtrl_reply_getValueStr(&reply, keys[i], val, sizeof(val)), expLen);
+        assert_string_equal(val, expVal);
+    }
+    char val[16] = {0};
+    assert_string_equal((wld_wpaCtrl_reply_getValueStr(&reply, "supported_rates", val, sizeof(val)), val), "8c 12 98 24 b0 ");
+    assert_int_equal(wld_wpaCtrl_reply_getValueStr(&reply, "empty", val, sizeof(val)), 0);
+    assert_int_equal(wld_wpaCtrl_reply_getValueStr(&reply, "rates", val, sizeof(val)), 0);
+    assert_int_equal(wld_wpaCtrl_reply_getValueStr(&reply, "aa:bb:cc:dd:ee:ff", val, sizeof(val)), 0);
+    assert_int_equal(wld_wpaCtrl_reply_getValueInt(&reply, "rx_packets"), 1042);
+    int32_t intVal = 0;
+    assert_false(wld_wpaCtrl_reply_getValueIntExt(&reply, "flags", &intVal));
+    size_t len = 0;
+    const char* pVal = wld_wpaCtrl_reply_getValueRef(&reply, "vendor_oui", &len);
+    assert_non_null(pVal);
+    assert_int_equal(len, 8);
+    assert_int_equal(strncmp(pVal, "00:50:f2", len), 0);
+
+    /* first occurrence is returned */
+    assert_int_equal(wld_wpaCtrl_reply_parse(&reply, "a=1 b=2 a=3"), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrl_reply_getValueInt(&reply, "a"), 1);
+
+    /* keys beyond the table capacity are still found */
+    char bigReply[WLD_WPACTRL_REPLY_MAX_PAIRS * 16] = {0};
+    for(uint32_t i = 0; i <= WLD_WPACTRL_REPLY_MAX_PAIRS; i++) {
+        char pair[16];
+        snprintf(pair, sizeof(pair), "k%u=%u\n", i, i);
+        swl_str_cat(bigReply, sizeof(bigReply), pair);
+    }
+    assert_int_equal(wld_wpaCtrl_reply_parse(&reply, bigReply), SWL_RC_OK);
+    assert_true(reply.truncated);
+    assert_int_equal(wld_wpaCtrl_reply_getValueInt(&reply, "k0"), 0);
+    assert_int_equal(wld_wpaCtrl_reply_getValueInt(&reply, "k100"), 100);
+    assert_int_equal(wld_wpaCtrl_reply_getValueInt(&reply, "k256"), 256);
+
+    assert_int_equal(wld_wpaCtrl_reply_parse(&reply, NULL), SWL_RC_OK);
+    assert_int_equal(reply.nrPairs, 0);
+    assert_null(wld_wpaCtrl_reply_getValueRef(&reply, "a", &len));
+}
+
+static void s_fmtBeaconResp(char* buf, size_t bufSize, uint32_t id) {
+    snprintf(buf, bufSize, "<3>BEACON-RESP-RX 00:11:22:33:%02x:%02x 1 00 0102030405", (id >> 8) & 0xff, id & 0xff);
+}
+
+/* hex dumped management frame header, after frame control and duration: DA, SA, BSSID */
+#define MGMT_FRAME_ADDRS "001122334455" "66778899aabb" "001122334455"
+#define MGMT_FRAME_EVT "<3>AP-MGMT-FRAME-RECEIVED buf="
+#define DEAUTH_FRAME_EVT MGMT_FRAME_EVT "c0003a01" MGMT_FRAME_ADDRS "1000" "0700"
+#define DISASSOC_FRAME_EVT MGMT_FRAME_EVT "a0003a01" MGMT_FRAME_ADDRS "1000" "0800"
+#define ASSOC_REQ_FRAME_EVT MGMT_FRAME_EVT "00003a01" MGMT_FRAME_ADDRS "2000" "31040a00"
+#define BTM_RESP_FRAME_EVT MGMT_FRAME_EVT "d0003a01" MGMT_FRAME_ADDRS "3000" "0a080100"
+#define PUBLIC_ACTION_FRAME_EVT(dur, seq, body) MGMT_FRAME_EVT "d000" dur MGMT_FRAME_ADDRS seq "04" body
+
+static void test_wld_wpactrl_evt_shedding(void** state) {
+    (void) state;
+    assert_int_equal(wld_wpaCtrl_getEvtClass("<3>AP-STA-CONNECTED 00:11:22:33:44:55"), WLD_WPACTRL_EVT_CLASS_CRITICAL);
+    assert_int_equal(wld_wpaCtrl_getEvtClass("IFNAME=wlan0 <3>DFS-CAC-START freq=5500"), WLD_WPACTRL_EVT_CLASS_CRITICAL);
+    assert_int_equal(wld_wpaCtrl_getEvtClass("<3>AP-MGMT-FRAME-RECEIVED buf=d0003a01"), WLD_WPACTRL_EVT_CLASS_LOW);
+    assert_int_equal(wld_wpaCtrl_getEvtClass(PUBLIC_ACTION_FRAME_EVT("3a01", "1000", "09")), WLD_WPACTRL_EVT_CLASS_LOW);
+    assert_int_equal(wld_wpaCtrl_getEvtClass(DEAUTH_FRAME_EVT), WLD_WPACTRL_EVT_CLASS_CRITICAL);
+    assert_int_equal(wld_wpaCtrl_getEvtClass(DISASSOC_FRAME_EVT), WLD_WPACTRL_EVT_CLASS_CRITICAL);
+    assert_int_equal(wld_wpaCtrl_getEvtClass(ASSOC_REQ_FRAME_EVT), WLD_WPACTRL_EVT_CLASS_CRITICAL);
+    assert_int_equal(wld_wpaCtrl_getEvtClass(BTM_RESP_FRAME_EVT), WLD_WPACTRL_EVT_CLASS_CRITICAL);
+    assert_int_equal(wld_wpaCtrl_getEvtClass("<3>RRM-BEACON-REP-RECEIVED wlan0"), WLD_WPACTRL_EVT_CLASS_NORMAL);
+    assert_int_equal(wld_wpaCtrl_getEvtClass("OK"), WLD_WPACTRL_EVT_CLASS_NORMAL);
+
+    wld_wpaCtrl_evtClassPolicy_t policy;
+    assert_int_equal(wld_wpaCtrl_getEvtClassPolicy(WLD_WPACTRL_EVT_CLASS_LOW, &policy), SWL_RC_OK);
+    assert_int_equal(policy.maxRate, 100);
+    assert_int_equal(policy.burst, 200);
+    assert_int_not_equal(wld_wpaCtrl_setEvtClassPolicy(WLD_WPACTRL_EVT_CLASS_CRITICAL, &policy), SWL_RC_OK);
+
+    wld_wpaCtrl_evtShaper_t shaper;
+    wld_wpaCtrl_evtShaper_reset(&shaper);
+    char msg[128];
+    uint32_t id = 0;
+
+    /* first half of the burst: no sampling */
+    for(; id < 100; id++) {
+        s_fmtBeaconResp(msg, sizeof(msg), id);
+        assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 0));
+    }
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 0));
+    /* under pressure: repeats are sampled out, new keys still pass */
+    assert_false(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 0));
+    for(; id < 199; id++) {
+        s_fmtBeaconResp(msg, sizeof(msg), id);
+        assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 0));
+    }
+    /* bucket empty */
+    s_fmtBeaconResp(msg, sizeof(msg), id++);
+    assert_false(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 0));
+    /* critical and normal events are never shed */
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, "<3>AP-STA-DISCONNECTED 00:11:22:33:44:55", 0));
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, "<3>CTRL-EVENT-EAP-STARTED 00:11:22:33:44:55", 0));
+    /* neither are management frames updating station context */
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, DEAUTH_FRAME_EVT, 0));
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, DEAUTH_FRAME_EVT, 0));
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, ASSOC_REQ_FRAME_EVT, 0));
+    assert_false(wld_wpaCtrl_evtShaper_acceptAt(&shaper, PUBLIC_ACTION_FRAME_EVT("3a01", "1000", "09"), 0));
+    /* refill at sustained rate */
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 10));
+    assert_false(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 10));
+
+    wld_wpaCtrl_evtClassStats_t stats;
+    assert_int_equal(wld_wpaCtrl_evtShaper_getStats(&shaper, WLD_WPACTRL_EVT_CLASS_LOW, &stats), SWL_RC_OK);
+    assert_int_equal(stats.nrPassed, 201);
+    assert_int_equal(stats.nrSampledOut, 2);
+    assert_int_equal(stats.nrRateDropped, 2);
+    assert_int_equal(wld_wpaCtrl_evtShaper_getStats(&shaper, WLD_WPACTRL_EVT_CLASS_CRITICAL, &stats), SWL_RC_OK);
+    assert_int_equal(stats.nrPassed, 4);
+
+    /* mgmt frame sample key: retransmissions (duration, seq ctrl) match, other frame bodies do not */
+    wld_wpaCtrl_evtShaper_reset(&shaper);
+    for(id = 0; id < 101; id++) {
+        s_fmtBeaconResp(msg, sizeof(msg), id);
+        assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, msg, 0));
+    }
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, PUBLIC_ACTION_FRAME_EVT("3a01", "1000", "0901"), 0));
+    assert_false(wld_wpaCtrl_evtShaper_acceptAt(&shaper, PUBLIC_ACTION_FRAME_EVT("0000", "1100", "0901"), 0));
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, PUBLIC_ACTION_FRAME_EVT("3a01", "1000", "0902"), 0));
+    assert_true(wld_wpaCtrl_evtShaper_acceptAt(&shaper, PUBLIC_ACTION_FRAME_EVT("3a01", "1000", "0a01"), 0));
+    assert_int_equal(wld_wpaCtrl_evtShaper_getStats(&shaper, WLD_WPACTRL_EVT_CLASS_LOW, &stats), SWL_RC_OK);
+    assert_int_equal(stats.nrSampledOut, 1);
+}
+
+#define WPS_ATTR_CRED 0x100e
+#define WPS_ATTR_NETWORK_INDEX 0x1026
+#define WPS_ATTR_SSID 0x1045
+#define WPS_ATTR_AUTH_TYPE 0x1003
+#define WPS_ATTR_NETWORK_KEY 0x1027
+#define WPS_ATTR_VENDOR_EXT 0x1049
+
+static size_t s_buildWpsCred(uint8_t* buf, size_t bufSize) {
+    wld_wpsTlvWriter_t writer;
+    wld_wpsTlv_initWriter(&writer, buf, bufSize);
+    size_t credOffset = wld_wpsTlv_openContainer(&writer, WPS_ATTR_CRED);
+    wld_wpsTlv_putU8(&writer, WPS_ATTR_NETWORK_INDEX, 1);
+    wld_wpsTlv_put(&writer, WPS_ATTR_SSID, strlen("wps_ssid"), "wps_ssid");
+    wld_wpsTlv_putBe16(&writer, WPS_ATTR_AUTH_TYPE, 0x0020);
+    wld_wpsTlv_put(&writer, WPS_ATTR_NETWORK_KEY, strlen("passphrase"), "passphrase");
+    wld_wpsTlv_closeContainer(&writer, credOffset);
+    wld_wpsTlv_put(&writer, WPS_ATTR_VENDOR_EXT, 3, "\x00\x37\x2a");
+    return writer.overflow ? 0 : writer.len;
+}
+
+static void test_wld_wps_cred_tlv(void** state) {
+    (void) state;
+    uint8_t buf[128];
+    size_t len = s_buildWpsCred(buf, sizeof(buf));
+    assert_int_equal(len, 4 + (5 + 12 + 6 + 14) + 7);
+    assert_int_equal(buf[0], 0x10);
+    assert_int_equal(buf[1], 0x0e);
+    assert_int_equal((buf[2] << 8) | buf[3], 5 + 12 + 6 + 14);
+
+    wld_wpsTlvReader_t reader;
+    wld_wpsTlv_initReader(&reader, buf, len);
+    uint16_t attr = 0;
+    uint16_t attrLen = 0;
+    const uint8_t* val = NULL;
+    assert_int_equal(wld_wpsTlv_next(&reader, &attr, &attrLen, &val), SWL_RC_OK);
+    assert_int_equal(attr, WPS_ATTR_CRED);
+    assert_ptr_equal(val, &buf[4]);
+    assert_int_equal(wld_wpsTlv_next(&reader, &attr, &attrLen, &val), SWL_RC_OK);
+    assert_int_equal(attr, WPS_ATTR_VENDOR_EXT);
+    assert_int_equal(attrLen, 3);
+    assert_int_equal(wld_wpsTlv_next(&reader, &attr, &attrLen, &val), SWL_RC_DONE);
+
+    T_WPSCredentials creds;
+    memset(&creds, 0, sizeof(creds));
+    assert_int_equal(wpaSup_parseWpsCredentials(&creds, buf, len), SWL_RC_OK);
+    assert_string_equal(creds.ssid, "wps_ssid");
+    assert_string_equal(creds.key, "passphrase");
+    assert_int_equal(creds.secMode, SWL_SECURITY_APMODE_WPA2_P);
+
+    /* hex dumped, as in WPS-CRED-RECEIVED event */
+    char hex[2 * sizeof(buf) + 1] = {0};
+    for(size_t i = 0; i < len; i++) {
+        snprintf(&hex[2 * i], 3, "%02x", buf[i]);
+    }
+    memset(&creds, 0, sizeof(creds));
+    assert_int_equal(wpaSup_parseWpsReceiveCredentialsEvt(&creds, hex, strlen(hex)), SWL_RC_OK);
+    assert_string_equal(creds.ssid, "wps_ssid");
+
+    /* writer never overruns its buffer */
+    uint8_t smallBuf[20];
+    assert_int_equal(s_buildWpsCred(smallBuf, sizeof(smallBuf)), 0);
+
+    /* any truncation of the credential container is rejected */
+    size_t credLen = 4 + (5 + 12 + 6 + 14);
+    for(size_t i = 1; i < credLen; i++) {
+        assert_true(wpaSup_parseWpsCredentials(&creds, buf, i) < SWL_RC_OK);
+    }
+
+    /* zero length value */
+    const uint8_t zeroLen[] = {0x10, 0x45, 0x00, 0x00};
+    assert_true(wpaSup_parseWpsCredentials(&creds, zeroLen, sizeof(zeroLen)) < SWL_RC_OK);
+    /* value overrunning buffer */
+    const uint8_t overrun[] = {0x10, 0x45, 0x00, 0x08, 'a', 'b'};
+    assert_true(wpaSup_parseWpsCredentials(&creds, overrun, sizeof(overrun)) < SWL_RC_OK);
+    /* ssid longer than supported */
+    uint8_t longSsid[4 + 64];
+    memset(longSsid, 'a', sizeof(longSsid));
+    longSsid[0] = 0x10;
+    longSsid[1] = 0x45;
+    longSsid[2] = 0x00;
+    longSsid[3] = 64;
+    assert_true(wpaSup_parseWpsCredentials(&creds, longSsid, sizeof(longSsid)) < SWL_RC_OK);
+    /* bounded credential nesting */
+    const uint8_t nested[] = {0x10, 0x0e, 0x00, 0x10, 0x10, 0x0e, 0x00, 0x0c, 0x10, 0x0e, 0x00, 0x08,
+        0x10, 0x45, 0x00, 0x04, 'a', 'b', 'c', 'd'};
+    assert_true(wpaSup_parseWpsCredentials(&creds, nested, sizeof(nested)) < SWL_RC_OK);
+    /* out of range attribute ids are ignored */
+    const uint8_t unknown[] = {0xff, 0xff, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00};
+    assert_int_equal(wpaSup_parseWpsCredentials(&creds, unknown, sizeof(unknown)), SWL_RC_OK);
+
+    /* random mutations: parsing must stay within buffer and keep strings terminated */
+    uint32_t seed = 0x5eed;
+    uint8_t fuzzBuf[sizeof(buf)];
+    for(uint32_t i = 0; i < 5000; i++) {
+        memcpy(fuzzBuf, buf, len);
+        seed = seed * 1103515245 + 12345;
+        uint32_t nMut = 1 + ((seed >> 16) % 4);
+        for(uint32_t j = 0; j < nMut; j++) {
+            seed = seed * 1103515245 + 12345;
+            fuzzBuf[(seed >> 16) % len] = (seed >> 8) & 0xff;
+        }
+        seed = seed * 1103515245 + 12345;
+        size_t fuzzLen = 1 + ((seed >> 16) % len);
+        memset(&creds, 0, sizeof(creds));
+        swl_rc_ne rc = wpaSup_parseWpsCredentials(&creds, fuzzBuf, fuzzLen);
+        assert_true((rc == SWL_RC_OK) || (rc < SWL_RC_OK));
+        assert_true(strnlen(creds.ssid, sizeof(creds.ssid)) < sizeof(creds.ssid));
+        assert_true(strnlen(creds.key, sizeof(creds.key)) < sizeof(creds.key));
+    }
+}
+
+static void test_wld_secDmn_cfgParamSuppProfile(void** state _UNUSED) {
+    char profileDir[] = "/tmp/wld_caps_XXXXXX";
+    assert_non_null(mkdtemp(profileDir));
+    assert_int_equal(wld_secDmn_setCfgParamProfileDir(profileDir), SWL_RC_OK);
+    char profilePath[128];
+    snprintf(profilePath, sizeof(profilePath), "%s/sh.caps", profileDir);
+
+    /* two radios, sharing the same daemon binary */
+    wld_secDmn_t* pSecDmn1 = NULL;
+    wld_secDmn_t* pSecDmn2 = NULL;
+    assert_int_equal(wld_secDmn_init(&pSecDmn1, "/bin/sh", NULL, "/tmp/h1.conf", "/tmp/h1"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_init(&pSecDmn2, "/bin/sh", NULL, "/tmp/h2.conf", "/tmp/h2"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_loadCfgParamSuppProfile(pSecDmn1), SWL_RC_NOT_AVAILABLE);
+
+    /* runtime declarations are not saved, rejections are saved with the probed value */
+    wld_secDmn_setCfgParamSupp(pSecDmn1, "config_id", SWL_TRL_TRUE);
+    wld_secDmn_setCfgParamSupp(pSecDmn1, "declared_off", SWL_TRL_FALSE);
+    assert_true(wld_secDmn_setProbedCfgParamSupp(pSecDmn1, "probed_1", "1", SWL_TRL_TRUE));
+    assert_true(wld_secDmn_setProbedCfgParamSupp(pSecDmn1, "rnr", "1", SWL_TRL_FALSE));
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn1, "rnr"), SWL_TRL_FALSE);
+    assert_int_equal(wld_secDmn_saveCfgParamSuppProfile(pSecDmn1), SWL_RC_OK);
+    /* saving from another radio keeps what the first one learned */
+    wld_secDmn_setProbedCfgParamSupp(pSecDmn2, "probed_2", "1", SWL_TRL_TRUE);
+    assert_int_equal(wld_secDmn_saveCfgParamSuppProfile(pSecDmn2), SWL_RC_OK);
+
+    wld_secDmn_t* pSecDmn3 = NULL;
+    assert_int_equal(wld_secDmn_init(&pSecDmn3, "/bin/sh", NULL, "/tmp/h3.conf", "/tmp/h3"), SWL_RC_OK);
+    /* declared support is not overridden by the profile */
+    wld_secDmn_setCfgParamSupp(pSecDmn3, "probed_2", SWL_TRL_FALSE);
+    assert_int_equal(wld_secDmn_loadCfgParamSuppProfile(pSecDmn3), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn3, "probed_1"), SWL_TRL_TRUE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn3, "probed_2"), SWL_TRL_FALSE);
+    /* rejection only applies to the probed value: same value is not probed again */
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn3, "rnr"), SWL_TRL_UNKNOWN);
+    assert_int_equal(wld_secDmn_probeCfgParamSupp(pSecDmn3, NULL, "rnr", "1"), SWL_RC_INVALID_PARAM);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn3, "rnr"), SWL_TRL_FALSE);
+    assert_int_equal(wld_secDmn_probeCfgParamSupp(pSecDmn3, NULL, "rnr", "2"), SWL_RC_INVALID_STATE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn3, "config_id"), SWL_TRL_UNKNOWN);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn3, "declared_off"), SWL_TRL_UNKNOWN);
+
+    /* unsupported entries left by previous versions are ignored */
+    FILE* fp = fopen(profilePath, "a");
+    assert_non_null(fp);
+    fputs("legacy_off=0\n", fp);
+    fclose(fp);
+    wld_secDmn_t* pSecDmn4 = NULL;
+    assert_int_equal(wld_secDmn_init(&pSecDmn4, "/bin/sh", NULL, "/tmp/h4.conf", "/tmp/h4"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_loadCfgParamSuppProfile(pSecDmn4), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn4, "legacy_off"), SWL_TRL_UNKNOWN);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn4, "probed_2"), SWL_TRL_TRUE);
+    /* accepting a rejected param drops its rejection */
+    assert_string_equal(swl_mapChar_get(&pSecDmn4->cfgParamRejected, "rnr"), "1");
+    wld_secDmn_setProbedCfgParamSupp(pSecDmn4, "rnr", "2", SWL_TRL_TRUE);
+    assert_null(swl_mapChar_get(&pSecDmn4->cfgParamRejected, "rnr"));
+    assert_int_equal(wld_secDmn_saveCfgParamSuppProfile(pSecDmn4), SWL_RC_OK);
+    wld_secDmn_t* pSecDmn5 = NULL;
+    assert_int_equal(wld_secDmn_init(&pSecDmn5, "/bin/sh", NULL, "/tmp/h5.conf", "/tmp/h5"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_loadCfgParamSuppProfile(pSecDmn5), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn5, "rnr"), SWL_TRL_TRUE);
+    assert_null(swl_mapChar_get(&pSecDmn5->cfgParamRejected, "rnr"));
+    wld_secDmn_cleanup(&pSecDmn5);
+
+    /* profile of another binary version is ignored */
+    fp = fopen(profilePath, "w");
+    assert_non_null(fp);
+    fputs("binary=/bin/sh:0:0\nprobed_3=1\n", fp);
+    fclose(fp);
+    assert_int_equal(wld_secDmn_loadCfgParamSuppProfile(pSecDmn4), SWL_RC_NOT_AVAILABLE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn4, "probed_3"), SWL_TRL_UNKNOWN);
+
+    wld_secDmn_cleanup(&pSecDmn1);
+    wld_secDmn_cleanup(&pSecDmn2);
+    wld_secDmn_cleanup(&pSecDmn3);
+    wld_secDmn_cleanup(&pSecDmn4);
+    unlink(profilePath);
+    rmdir(profileDir);
+}
+
+static void test_wld_secDmn_cfgParamSuppIds(void** state _UNUSED) {
+    wld_secDmn_t* pSecDmn1 = NULL;
+    wld_secDmn_t* pSecDmn2 = NULL;
+    wld_secDmnGrp_t* pSecDmnGrp = NULL;
+    assert_int_equal(wld_secDmn_init(&pSecDmn1, "hostapd", NULL, "/tmp/h1.conf", "/tmp/h1"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_init(&pSecDmn2, "hostapd", NULL, "/tmp/h2.conf", "/tmp/h2"), SWL_RC_OK);
+
+    /* ids are shared by all secDmns */
+    assert_true(wld_secDmn_setCfgParamSupp(pSecDmn1, "rnr", SWL_TRL_TRUE));
+    assert_true(wld_secDmn_setCfgParamSupp(pSecDmn1, "config_id", SWL_TRL_UNKNOWN));
+    assert_true(wld_secDmn_setCfgParamSupp(pSecDmn2, "rnr", SWL_TRL_FALSE));
+    assert_true(wld_secDmn_setCfgParamSupp(pSecDmn2, "config_id", SWL_TRL_TRUE));
+    wld_secDmn_cfgParamId_t rnrId = wld_secDmn_getCfgParamId("rnr");
+    assert_int_not_equal(rnrId, WLD_SECDMN_CFG_PARAM_ID_INVALID);
+    assert_int_equal(wld_secDmn_getCfgParamId("rnr"), rnrId);
+    assert_string_equal(wld_secDmn_getCfgParamName(rnrId), "rnr");
+    assert_null(wld_secDmn_getCfgParamName(WLD_SECDMN_CFG_PARAM_ID_MAX));
+    /* known params have static ids */
+    assert_int_equal(rnrId, WLD_SECDMN_CFG_PARAM_RNR);
+    assert_int_equal(wld_secDmn_getCfgParamId("config_id"), WLD_SECDMN_CFG_PARAM_CONFIG_ID);
+    assert_true(wld_secDmn_setCfgParamSuppById(pSecDmn2, WLD_SECDMN_CFG_PARAM_CONFIG_ID, SWL_TRL_TRUE));
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn2, "config_id"), SWL_TRL_TRUE);
+    assert_false(wld_secDmn_setCfgParamSuppById(pSecDmn2, WLD_SECDMN_CFG_PARAM_ID_INVALID, SWL_TRL_TRUE));
+
+    /* standalone daemons */
+    assert_int_equal(wld_secDmn_getCfgParamSuppById(pSecDmn1, rnrId), SWL_TRL_TRUE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn2, "rnr"), SWL_TRL_FALSE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn1, "config_id"), SWL_TRL_UNKNOWN);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn1, "undeclared"), SWL_TRL_UNKNOWN);
+
+    /* params beyond the ids table capacity are still learned, by name */
+    char pname[32];
+    for(uint32_t i = 0; i < WLD_SECDMN_CFG_PARAM_ID_MAX; i++) {
+        snprintf(pname, sizeof(pname), "filler_%u", i);
+        wld_secDmn_setCfgParamSupp(pSecDmn1, pname, SWL_TRL_TRUE);
+    }
+    assert_int_equal(wld_secDmn_getCfgParamId(pname), WLD_SECDMN_CFG_PARAM_ID_INVALID);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn1, pname), SWL_TRL_TRUE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn2, pname), SWL_TRL_UNKNOWN);
+
+    /* grouped daemons: rejected by any member, or supported by one */
+    assert_int_equal(wld_secDmnGrp_init(&pSecDmnGrp, "hostapd", NULL, "testGrp"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_addToGrp(pSecDmn1, pSecDmnGrp, "m1"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_addToGrp(pSecDmn2, pSecDmnGrp, "m2"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn1, "rnr"), SWL_TRL_FALSE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn1, "config_id"), SWL_TRL_TRUE);
+
+    /* aggregate follows member changes */
+    wld_secDmn_setCfgParamSupp(pSecDmn2, "rnr", SWL_TRL_UNKNOWN);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn2, "rnr"), SWL_TRL_TRUE);
+    wld_secDmn_setCfgParamSupp(pSecDmn1, "config_id", SWL_TRL_FALSE);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn2, "config_id"), SWL_TRL_FALSE);
+    wld_secDmn_delFromGrp(pSecDmn1);
+    assert_int_equal(wld_secDmn_getCfgParamSupp(pSecDmn2, "config_id"), SWL_TRL_TRUE);
+
+    wld_secDmn_cleanup(&pSecDmn1);
+    wld_secDmn_cleanup(&pSecDmn2);
+    wld_secDmnGrp_cleanup(&pSecDmnGrp);
+    assert_null(wld_secDmn_getCfgParamName(rnrId));
+}
+
+static uint32_t s_nGrpReloads = 0;
+
+static bool s_grpReloadCb(wld_process_t* pProc _UNUSED, void* userdata _UNUSED) {
+    s_nGrpReloads++;
+    return true;
+}
+
+static void test_wld_secDmnGrp_rtmActions(void** state _UNUSED) {
+    wld_secDmn_t* pSecDmn1 = NULL;
+    wld_secDmn_t* pSecDmn2 = NULL;
+    wld_secDmnGrp_t* pSecDmnGrp = NULL;
+    wld_secDmnGrp_rtmActionStats_t stats1;
+    wld_secDmnGrp_rtmActionStats_t stats2;
+    assert_int_equal(wld_secDmn_init(&pSecDmn1, "hostapd", NULL, "/tmp/h1.conf", "/tmp/h1"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_init(&pSecDmn2, "hostapd", NULL, "/tmp/h2.conf", "/tmp/h2"), SWL_RC_OK);
+    assert_int_equal(wld_secDmnGrp_init(&pSecDmnGrp, "hostapd", NULL, "rtmGrp"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_addToGrp(pSecDmn1, pSecDmnGrp, "m1"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_addToGrp(pSecDmn2, pSecDmnGrp, "m2"), SWL_RC_OK);
+
+    /* reload needs a running process */
+    assert_int_equal(wld_secDmn_reload(pSecDmn1), SWL_RC_ERROR);
+
+    /* fake running group process: reloads are counted instead of being signaled */
+    wld_process_t* pProc = wld_secDmnGrp_getProc(pSecDmnGrp);
+    pProc->handlers.reload = s_grpReloadCb;
+    pProc->status = WLD_DAEMON_STATE_UP;
+    pProc->handlers.startCb(pProc, pProc->userData);
+
+    /* reload is applied immediately, even when member is not started */
+    assert_int_equal(wld_secDmn_reload(pSecDmn1), SWL_RC_OK);
+    assert_int_equal(s_nGrpReloads, 1);
+    assert_int_equal(wld_secDmnGrp_getRtmActionExecCount(pSecDmnGrp), 1);
+    assert_int_equal(wld_secDmnGrp_getMemberRtmActionStats(pSecDmnGrp, pSecDmn1, &stats1), SWL_RC_OK);
+    assert_int_equal(stats1.nApplied, 1);
+    assert_int_equal(stats1.nMerged, 0);
+
+    assert_int_equal(wld_secDmn_start(pSecDmn1), SWL_RC_DONE);
+    assert_int_equal(wld_secDmn_start(pSecDmn2), SWL_RC_DONE);
+
+    /* reloads of started members are merged: applied once, when all started members requested it */
+    assert_int_equal(wld_secDmn_reload(pSecDmn1), SWL_RC_CONTINUE);
+    assert_int_equal(s_nGrpReloads, 1);
+    assert_int_equal(wld_secDmn_reload(pSecDmn2), SWL_RC_OK);
+    assert_int_equal(s_nGrpReloads, 2);
+    assert_int_equal(wld_secDmnGrp_getRtmActionExecCount(pSecDmnGrp), 2);
+    assert_int_equal(wld_secDmnGrp_getMemberRtmActionStats(pSecDmnGrp, pSecDmn1, &stats1), SWL_RC_OK);
+    assert_int_equal(stats1.nApplied, 2);
+
+    /* first restart request opens the merge window */
+    assert_int_equal(wld_secDmn_restart(pSecDmn1), SWL_RC_CONTINUE);
+    assert_true(wld_secDmnGrp_isMemberRestarting(pSecDmnGrp, pSecDmn1));
+    assert_int_equal(wld_secDmnGrp_getRtmActionExecCount(pSecDmnGrp), 2);
+
+    /* restart subsumes reloads: merged, not applied */
+    assert_int_equal(wld_secDmn_reload(pSecDmn1), SWL_RC_CONTINUE);
+    assert_int_equal(wld_secDmn_reload(pSecDmn2), SWL_RC_CONTINUE);
+    assert_int_equal(s_nGrpReloads, 2);
+    assert_int_equal(wld_secDmnGrp_getRtmActionExecCount(pSecDmnGrp), 2);
+
+    usleep(50 * 1000);
+
+    /* restart applied once, when all started members requested it */
+    assert_int_equal(wld_secDmn_restart(pSecDmn2), SWL_RC_OK);
+    assert_int_equal(wld_secDmnGrp_getRtmActionExecCount(pSecDmnGrp), 3);
+    assert_int_equal(s_nGrpReloads, 2);
+    assert_false(wld_secDmnGrp_isMemberRestarting(pSecDmnGrp, pSecDmn1));
+    assert_false(wld_secDmnGrp_isMemberRestarting(pSecDmnGrp, pSecDmn2));
+
+    /* latency accounted from the oldest pending request of each member */
+    assert_int_equal(wld_secDmnGrp_getMemberRtmActionStats(pSecDmnGrp, pSecDmn1, &stats1), SWL_RC_OK);
+    assert_int_equal(wld_secDmnGrp_getMemberRtmActionStats(pSecDmnGrp, pSecDmn2, &stats2), SWL_RC_OK);
+    assert_int_equal(stats1.nApplied, 3);
+    assert_int_equal(stats1.nMerged, 1);
+    assert_in_range(stats1.lastLatencyMs, 50, 1000);
+    assert_int_equal(stats1.maxLatencyMs, stats1.lastLatencyMs);
+    assert_in_range(stats1.totalLatencyMs, stats1.lastLatencyMs, stats1.lastLatencyMs + 10);
+    assert_int_equal(stats2.nApplied, 2);
+    assert_int_equal(stats2.nMerged, 1);
+    assert_in_range(stats2.lastLatencyMs, 50, 1000);
+    assert_true(stats2.lastLatencyMs <= stats1.lastLatencyMs);
+
+    /* reload pending in window is upgraded to restart, requested by all members */
+    assert_int_equal(wld_secDmn_reload(pSecDmn2), SWL_RC_CONTINUE);
+    assert_int_equal(wld_secDmn_restart(pSecDmn1), SWL_RC_CONTINUE);
+    assert_int_equal(wld_secDmn_restart(pSecDmn2), SWL_RC_OK);
+    assert_int_equal(s_nGrpReloads, 2);
+    assert_int_equal(wld_secDmnGrp_getRtmActionExecCount(pSecDmnGrp), 4);
+    assert_false(wld_secDmnGrp_isMemberRestarting(pSecDmnGrp, pSecDmn2));
+
+    pProc->status = WLD_DAEMON_STATE_DOWN;
+    wld_secDmn_cleanup(&pSecDmn1);
+    wld_secDmn_cleanup(&pSecDmn2);
+    wld_secDmnGrp_cleanup(&pSecDmnGrp);
+}
+
+static uint32_t s_nGrpAttach = 0;
+static uint32_t s_nGrpDetach = 0;
+static swl_rc_ne s_grpAttachRc = SWL_RC_OK;
+static swl_rc_ne s_grpDetachRc = SWL_RC_OK;
+
+static swl_rc_ne s_grpAddMemberCb(wld_secDmnGrp_t* pSecDmnGrp _UNUSED, void* userData _UNUSED, wld_secDmn_t* pSecDmn _UNUSED) {
+    s_nGrpAttach++;
+    return s_grpAttachRc;
+}
+
+static swl_rc_ne s_grpRemoveMemberCb(wld_secDmnGrp_t* pSecDmnGrp _UNUSED, void* userData _UNUSED, wld_secDmn_t* pSecDmn _UNUSED) {
+    s_nGrpDetach++;
+    return s_grpDetachRc;
+}
+
+static void test_wld_secDmnGrp_warmStandby(void** state _UNUSED) {
+    wld_secDmn_t* pSecDmn1 = NULL;
+    wld_secDmn_t* pSecDmn2 = NULL;
+    wld_secDmnGrp_t* pSecDmnGrp = NULL;
+    wld_secDmnGrp_EvtHandlers_t handlers = {
+        .addMemberCb = s_grpAddMemberCb,
+        .removeMemberCb = s_grpRemoveMemberCb,
+    };
+
+    /* pre-start: idle process is spawned without members, and stopped when standby is disabled */
+    assert_int_equal(wld_secDmnGrp_init(&pSecDmnGrp, "sleep", "30", "standbyGrp"), SWL_RC_OK);
+    wld_process_t* pProc = wld_secDmnGrp_getProc(pSecDmnGrp);
+    assert_int_equal(wld_secDmnGrp_setWarmStandby(pSecDmnGrp, true), SWL_RC_OK);
+    assert_true(wld_secDmnGrp_isWarmStandby(pSecDmnGrp));
+    assert_true(wld_dmn_isEnabled(pProc));
+    assert_true(wld_dmn_isRunning(pProc));
+    assert_int_equal(wld_secDmnGrp_setWarmStandby(pSecDmnGrp, true), SWL_RC_OK);
+    assert_int_equal(wld_secDmnGrp_setWarmStandby(pSecDmnGrp, false), SWL_RC_OK);
+    assert_false(wld_secDmnGrp_isWarmStandby(pSecDmnGrp));
+    assert_false(wld_dmn_isEnabled(pProc));
+    assert_false(wld_dmn_isRunning(pProc));
+    wld_secDmnGrp_cleanup(&pSecDmnGrp);
+
+    assert_int_equal(wld_secDmn_init(&pSecDmn1, "hostapd", NULL, "/tmp/h1.conf", "/tmp/h1"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_init(&pSecDmn2, "hostapd", NULL, "/tmp/h2.conf", "/tmp/h2"), SWL_RC_OK);
+    assert_int_equal(wld_secDmnGrp_init(&pSecDmnGrp, "hostapd", NULL, "standbyGrp"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_addToGrp(pSecDmn1, pSecDmnGrp, "m1"), SWL_RC_OK);
+    assert_int_equal(wld_secDmn_addToGrp(pSecDmn2, pSecDmnGrp, "m2"), SWL_RC_OK);
+
+    /* fake already started group process: pre-start is skipped */
+    pProc = wld_secDmnGrp_getProc(pSecDmnGrp);
+    pProc->status = WLD_DAEMON_STATE_UP;
+    pProc->enabled = true;
+    pProc->handlers.startCb(pProc, pProc->userData);
+    assert_int_equal(wld_secDmnGrp_setWarmStandby(pSecDmnGrp, true), SWL_RC_OK);
+
+    /* no attach handler: member can not be loaded in place, so group restart is requested */
+    assert_int_equal(wld_secDmnGrp_startMember(pSecDmnGrp, pSecDmn1), SWL_RC_OK);
+    assert_false(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn1));
+    assert_false(wld_secDmnGrp_isMemberRestarting(pSecDmnGrp, pSecDmn1));
+    assert_int_equal(wld_secDmnGrp_getRtmActionExecCount(pSecDmnGrp), 1);
+    pProc->handlers.stopCb(pProc, pProc->userData);
+    pProc->status = WLD_DAEMON_STATE_UP;
+    pProc->handlers.startCb(pProc, pProc->userData);
+
+    assert_int_equal(wld_secDmnGrp_setEvtHandlers(pSecDmnGrp, &handlers, NULL), SWL_RC_OK);
+
+    /* members are attached to the running process */
+    assert_int_equal(wld_secDmnGrp_startMember(pSecDmnGrp, pSecDmn1), SWL_RC_DONE);
+    assert_int_equal(wld_secDmnGrp_startMember(pSecDmnGrp, pSecDmn2), SWL_RC_DONE);
+    assert_int_equal(s_nGrpAttach, 2);
+    assert_true(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn1));
+    assert_true(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn2));
+
+    /* already attached member is not loaded twice */
+    assert_int_equal(wld_secDmnGrp_startMember(pSecDmnGrp, pSecDmn1), SWL_RC_DONE);
+    assert_int_equal(s_nGrpAttach, 2);
+
+    /* members are detached in place: process keeps running, even without started members */
+    assert_int_equal(wld_secDmnGrp_stopMember(pSecDmnGrp, pSecDmn1), SWL_RC_CONTINUE);
+    assert_int_equal(s_nGrpDetach, 1);
+    assert_false(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn1));
+    assert_true(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn2));
+    assert_int_equal(wld_secDmnGrp_stopMember(pSecDmnGrp, pSecDmn2), SWL_RC_CONTINUE);
+    assert_int_equal(s_nGrpDetach, 2);
+    assert_false(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn2));
+    assert_true(wld_dmn_isRunning(pProc));
+    assert_true(wld_dmn_isEnabled(pProc));
+    assert_int_equal(wld_secDmnGrp_stopMember(pSecDmnGrp, pSecDmn2), SWL_RC_INVALID_STATE);
+    assert_int_equal(s_nGrpDetach, 2);
+
+    /* attach failure: group restart is requested to load the member */
+    assert_int_equal(wld_secDmnGrp_startMember(pSecDmnGrp, pSecDmn2), SWL_RC_DONE);
+    s_grpAttachRc = SWL_RC_ERROR;
+    assert_int_equal(wld_secDmnGrp_startMember(pSecDmnGrp, pSecDmn1), SWL_RC_CONTINUE);
+    assert_int_equal(s_nGrpAttach, 4);
+    assert_false(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn1));
+    assert_true(wld_secDmnGrp_isMemberRestarting(pSecDmnGrp, pSecDmn1));
+    s_grpAttachRc = SWL_RC_OK;
+
+    /* restarted process loads started members with its start args */
+    pProc->handlers.stopCb(pProc, pProc->userData);
+    assert_false(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn2));
+    assert_null(pProc->handlers.getArgsCb(pProc, pProc->userData));
+    assert_true(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn1));
+    assert_true(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn2));
+    pProc->handlers.startCb(pProc, pProc->userData);
+
+    /* detach failure: member stays stopping, until the group restart unloads it */
+    s_grpDetachRc = SWL_RC_ERROR;
+    assert_int_equal(wld_secDmnGrp_stopMember(pSecDmnGrp, pSecDmn1), SWL_RC_CONTINUE);
+    assert_int_equal(s_nGrpDetach, 3);
+    assert_true(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn1));
+    assert_true(wld_dmn_isEnabled(pProc));
+    pProc->handlers.stopCb(pProc, pProc->userData);
+    assert_false(wld_secDmnGrp_isMemberAttached(pSecDmnGrp, pSecDmn1));
+    assert_int_equal(wld_secDmnGrp_stopMember(pSecDmnGrp, pSecDmn1), SWL_RC_INVALID_STATE);
+    s_grpDetachRc = SWL_RC_OK;
+
+    pProc->status = WLD_DAEMON_STATE_DOWN;
+    wld_secDmn_cleanup(&pSecDmn1);
+    wld_secDmn_cleanup(&pSecDmn2);
+    wld_secDmnGrp_cleanup(&pSecDmnGrp);
+}
+
+static void test_wld_hostapd_cfgFile_patch(void** state _UNUSED) {
+    char* path = "/tmp/test_wld_hostapd_patch.conf";
+    FILE* fp = fopen(path, "w");
+    assert_non_null(fp);
+    fputs("## General configurations\nctrl_interface=/var/run/hostapd\n"
+          "## Interface configurations\ninterface=wlan0\nssid=a\n"
+          "## BSS configurations\nbss=wlan1\nssid=b\n", fp);
+    fclose(fp);
+
+    /* several staged updates are flushed with one write */
+    assert_true(wld_hostapd_cfgFile_stageUpdate(path, "wlan0", "ssid", "longer_ssid"));
+    assert_true(wld_hostapd_cfgFile_stageUpdate(path, "wlan1", "wpa", "2"));
+    assert_true(wld_hostapd_cfgFile_stageUpdate(path, "wlan0", "ignore_broadcast_ssid", "1"));
+    assert_true(wld_hostapd_cfgFile_stageUpdate(path, NULL, "channel", "36"));
+    assert_false(wld_hostapd_cfgFile_stageUpdate(path, "wlan9", "wpa", "2"));
+    assert_false(wld_hostapd_cfgFile_stageUpdate(path, "", "wpa", "2"));
+    assert_true(wld_hostapd_cfgFile_commitUpdates(path));
+    assert_true(wld_hostapd_cfgFile_update(path, "wlan1", "ssid", ""));
+
+    wld_hostapd_config_t* config = NULL;
+    assert_true(wld_hostapd_loadConfig(&config, path));
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan0", "ssid"), "longer_ssid");
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan0", "ignore_broadcast_ssid"), "1");
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan1", "wpa"), "2");
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan1", "ssid"), "");
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, NULL, "channel"), "36");
+    assert_null(wld_hostapd_getConfigParamValStr(config, "wlan0", "channel"));
+
+    /* full rewrite by another writer is detected */
+    assert_true(wld_hostapd_addConfigParam(config, "wlan1", "ssid", "c"));
+    assert_true(wld_hostapd_writeConfig(config, path));
+    wld_hostapd_deleteConfig(config);
+    assert_true(wld_hostapd_cfgFile_update(path, "wlan0", "wpa", "3"));
+    assert_true(wld_hostapd_loadConfig(&config, path));
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan1", "ssid"), "c");
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan0", "wpa"), "3");
+    wld_hostapd_deleteConfig(config);
+
+    wld_cfgDoc_drop(path);
+    unlink(path);
+}
+
+static void test_wld_cfgDoc_blockSection(void** state _UNUSED) {
+    char* path = "/tmp/test_wld_cfgDoc_block.conf";
+    FILE* fp = fopen(path, "w");
+    assert_non_null(fp);
+    fputs("ctrl_interface=/var/run/hostapd\ninterface=wlan0\nssid=a\nblock={\n\tssid=b\n}\nwpa=2\n", fp);
+    fclose(fp);
+
+    /* keys after a block belong to the section enclosing the block */
+    const char* const sectionKeys[] = {"interface", "block"};
+    wld_cfgDoc_t* pDoc = wld_cfgDoc_get(path, sectionKeys, SWL_ARRAY_SIZE(sectionKeys));
+    assert_non_null(pDoc);
+    size_t len = 0;
+    const char* val = wld_cfgDoc_getValue(pDoc, "wlan0", "wpa", &len);
+    assert_non_null(val);
+    assert_int_equal(len, 1);
+    assert_int_equal(val[0], '2');
+    assert_null(wld_cfgDoc_getValue(pDoc, NULL, "wpa", &len));
+    val = wld_cfgDoc_getValue(pDoc, "block", "ssid", &len);
+    assert_non_null(val);
+    assert_int_equal(val[0], 'b');
+
+    /* existing key is patched in place, and not added again to the header */
+    assert_int_equal(wld_cfgDoc_set(pDoc, "wlan0", "wpa", "3"), SWL_RC_OK);
+    assert_int_equal(wld_cfgDoc_commit(pDoc), SWL_RC_OK);
+    char buf[128] = {0};
+    fp = fopen(path, "r");
+    assert_non_null(fp);
+    size_t n = fread(buf, 1, sizeof(buf) - 1, fp);
+    fclose(fp);
+    buf[n] = 0;
+    assert_string_equal(buf, "ctrl_interface=/var/run/hostapd\ninterface=wlan0\nssid=a\nblock={\n\tssid=b\n}\nwpa=3\n");
+
+    wld_cfgDoc_drop(path);
+    unlink(path);
+}
+
+static void test_wld_hostapd_cfgSnapshot(void** state _UNUSED) {
+    char* path = "/tmp/test_wld_hostapd_snapshot.conf";
+    FILE* fp = fopen(path, "w");
+    assert_non_null(fp);
+    fputs("## General configurations\nctrl_interface=/var/run/hostapd\n"
+          "## Interface configurations\ninterface=wlan0\nssid=a\n"
+          "## BSS configurations\nbss=wlan1\nssid=b\nwpa=2\n", fp);
+    fclose(fp);
+
+    wld_hostapd_config_t* config = NULL;
+    assert_true(wld_hostapd_loadConfig(&config, path));
+    wld_hostapd_cfgSnapshot_t* pSnapshot = NULL;
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_FULL);
+    assert_true(wld_hostapd_saveConfigSnapshot(&pSnapshot, config, WLD_HOSTAPD_CFG_CHANGE_FULL, path));
+    assert_int_equal(wld_hostapd_getConfigSnapshotPendingChange(pSnapshot), WLD_HOSTAPD_CFG_CHANGE_FULL);
+    wld_hostapd_setConfigSnapshotPendingChange(pSnapshot, WLD_HOSTAPD_CFG_CHANGE_NONE);
+
+    /* fingerprint does not depend on params order, nor on the way params are set */
+    uint64_t fingerprint = wld_hostapd_getConfigFingerprint(config, "wlan1");
+    swl_mapChar_t* vapMap = wld_hostapd_getConfigMap(config, "wlan1");
+    assert_non_null(vapMap);
+    swl_mapChar_delete(vapMap, "ssid");
+    assert_true(wld_hostapd_addConfigParam(config, "wlan1", "ssid", "b"));
+    assert_int_equal(wld_hostapd_getConfigFingerprint(config, "wlan1"), fingerprint);
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_NONE);
+
+    /* bss change is scoped to its section */
+    assert_true(wld_hostapd_addConfigParam(config, "wlan1", "wpa", "3"));
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_BSS);
+    assert_true(wld_hostapd_isConfigSectionChanged(config, "wlan1"));
+    assert_false(wld_hostapd_isConfigSectionChanged(config, "wlan0"));
+    assert_true(wld_hostapd_saveConfigSnapshot(&pSnapshot, config, WLD_HOSTAPD_CFG_CHANGE_BSS, path));
+    assert_int_equal(wld_hostapd_getConfigSnapshotPendingChange(pSnapshot), WLD_HOSTAPD_CFG_CHANGE_BSS);
+    assert_true(wld_hostapd_isConfigSnapshotBssPending(pSnapshot, "wlan1"));
+    assert_false(wld_hostapd_isConfigSnapshotBssPending(pSnapshot, "wlan0"));
+    assert_true(wld_hostapd_delConfigParam(config, "wlan1", "wpa"));
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_BSS);
+
+    /* general section change, or external file change, implies full change */
+    assert_true(wld_hostapd_addConfigParam(config, "wlan1", "wpa", "3"));
+    assert_true(wld_hostapd_addConfigParam(config, NULL, "country_code", "FR"));
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_FULL);
+    assert_true(wld_hostapd_delConfigParam(config, NULL, "country_code"));
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_NONE);
+
+    /* params patched in place in file are accounted in snapshot: no change seen by next diff */
+    assert_true(wld_hostapd_cfgFile_update(path, "wlan0", "ssid", "c"));
+    assert_true(wld_hostapd_cfgFile_update(path, NULL, "channel", "36"));
+    assert_true(wld_hostapd_updateConfigSnapshotParam(pSnapshot, "wlan0", "ssid", "a", "c"));
+    assert_true(wld_hostapd_updateConfigSnapshotParam(pSnapshot, NULL, "channel", NULL, "36"));
+    assert_false(wld_hostapd_updateConfigSnapshotParam(pSnapshot, "wlan9", "ssid", NULL, "c"));
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_FULL);
+    wld_hostapd_updateConfigSnapshotFileStat(pSnapshot, path);
+    assert_true(wld_hostapd_addConfigParam(config, "wlan0", "ssid", "c"));
+    assert_true(wld_hostapd_addConfigParam(config, NULL, "channel", "36"));
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_NONE);
+    wld_cfgDoc_drop(path);
+    unlink(path);
+    assert_int_equal(wld_hostapd_diffConfigSnapshot(pSnapshot, config, path), WLD_HOSTAPD_CFG_CHANGE_FULL);
+
+    wld_hostapd_deleteConfigSnapshot(&pSnapshot);
+    assert_null(pSnapshot);
+    assert_int_equal(wld_hostapd_getConfigSnapshotPendingChange(pSnapshot), WLD_HOSTAPD_CFG_CHANGE_FULL);
+    wld_hostapd_deleteConfig(config);
+}
+
+static void test_wld_hostapd_cfgLookup(void** state _UNUSED) {
+    char* path = "/tmp/test_wld_hostapd_lookup.conf";
+    FILE* fp = fopen(path, "w");
+    assert_non_null(fp);
+    fputs("ctrl_interface=/var/run/hostapd\n"
+          "interface=wlan0\nbssid=00:11:22:33:44:50\nssid=a\n"
+          "bss=wlan1\nbssid=00:11:22:33:44:51\nssid=b\n"
+          "bss=wlan2\nssid=c\n", fp);
+    fclose(fp);
+
+    wld_hostapd_config_t* config = NULL;
+    assert_true(wld_hostapd_loadConfig(&config, path));
+    unlink(path);
+
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan1", "ssid"), "b");
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan2", "ssid"), "c");
+    assert_null(wld_hostapd_getConfigParamValStr(config, "wlan3", "ssid"));
+    assert_null(wld_hostapd_getConfigMap(config, "wlan3"));
+
+    swl_macBin_t bssid = SWL_MAC_BIN_NEW();
+    swl_typeMacBin_fromChar(&bssid, "00:11:22:33:44:51");
+    assert_string_equal(wld_hostapd_getConfigParamByBssidValStr(config, &bssid, "ssid"), "b");
+    assert_ptr_equal(wld_hostapd_getConfigMapByBssid(config, &bssid), wld_hostapd_getConfigMap(config, "wlan1"));
+    swl_typeMacBin_fromChar(&bssid, "00:11:22:33:44:5f");
+    assert_null(wld_hostapd_getConfigMapByBssid(config, &bssid));
+    assert_string_equal(wld_hostapd_getConfigParamByBssidValStr(config, NULL, "ctrl_interface"), "/var/run/hostapd");
+
+    /* written with one buffered write, then read back */
+    uint32_t nWrites = wld_cfgWriter_getStats()->nWrites;
+    assert_true(wld_hostapd_addConfigParam(config, "wlan2", "wpa_passphrase", "a\\b"));
+    assert_true(wld_hostapd_writeConfig(config, path));
+    assert_int_equal(wld_cfgWriter_getStats()->nWrites, nWrites + 1);
+    wld_hostapd_deleteConfig(config);
+    config = NULL;
+    assert_true(wld_hostapd_loadConfig(&config, path));
+    unlink(path);
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan0", "ssid"), "a");
+    assert_string_equal(wld_hostapd_getConfigParamValStr(config, "wlan1", "ssid"), "b");
+    assert_non_null(wld_hostapd_getConfigParamValStr(config, "wlan2", "wpa_passphrase"));
+
+    wld_hostapd_deleteConfig(config);
+}
+
 static int s_setupSuite(void** state) {
     (void) state;
     return 0;
@@ -276,8 +1205,21 @@ int main(int argc _UNUSED, char* argv[] _UNUSED) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_wld_ap_hostapd_getParamAction),
         cmocka_unit_test(test_wld_ap_hostapd_setParamAction),
+        cmocka_unit_test(test_wld_ap_hostapd_classifyParamsDelta),
+        cmocka_unit_test(test_wld_ap_hostapd_classifyNoSecParamsDelta),
         cmocka_unit_test(test_wld_parse_wpactrl_event),
         cmocka_unit_test(test_wld_fetch_wpactrl_event),
+        cmocka_unit_test(test_wld_wpactrl_reply_tokenizer),
+        cmocka_unit_test(test_wld_wpactrl_evt_shedding),
+        cmocka_unit_test(test_wld_wps_cred_tlv),
+        cmocka_unit_test(test_wld_secDmn_cfgParamSuppIds),
+        cmocka_unit_test(test_wld_secDmn_cfgParamSuppProfile),
+        cmocka_unit_test(test_wld_secDmnGrp_rtmActions),
+        cmocka_unit_test(test_wld_secDmnGrp_warmStandby),
+        cmocka_unit_test(test_wld_hostapd_cfgFile_patch),
+        cmocka_unit_test(test_wld_cfgDoc_blockSection),
+        cmocka_unit_test(test_wld_hostapd_cfgSnapshot),
+        cmocka_unit_test(test_wld_hostapd_cfgLookup),
     };
     int rc = cmocka_run_group_tests(tests, s_setupSuite, s_teardownSuite);
     sahTraceClose();
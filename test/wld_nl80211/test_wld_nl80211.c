@@ -1231,6 +1231,80 @@ static void test_wld_nl80211_request_expires_while_in_callback(void** mockaState
     assert_true(s_stateMockDeInit(&mock));
 }
 
+/*
+ * Reference (previous) implementations of the table driven conversions.
+ */
+static const struct {
+    uint32_t nl80211Bw;
+    uint32_t bw;
+    swl_bandwidth_e swlBw;
+} sRefChannelWidthMap[] = {
+    {NL80211_CHAN_WIDTH_20, 20, SWL_BW_20MHZ},
+    {NL80211_CHAN_WIDTH_40, 40, SWL_BW_40MHZ},
+    {NL80211_CHAN_WIDTH_80, 80, SWL_BW_80MHZ},
+    {NL80211_CHAN_WIDTH_160, 160, SWL_BW_160MHZ},
+    {NL80211_CHAN_WIDTH_320, 320, SWL_BW_320MHZ},
+    {NL80211_CHAN_WIDTH_10, 10, SWL_BW_10MHZ},
+    {NL80211_CHAN_WIDTH_5, 5, SWL_BW_5MHZ},
+    {NL80211_CHAN_WIDTH_2, 2, SWL_BW_2MHZ},
+    {NL80211_CHAN_WIDTH_20_NOHT, 20, SWL_BW_20MHZ},
+    {NL80211_CHAN_WIDTH_80P80, 160, SWL_BW_AUTO},
+};
+
+static swl_bandwidth_e s_refRateBw(uint32_t bwFlags) {
+    if(bwFlags & WLD_NL80211_RATE_BW_F_160) {
+        return SWL_BW_160MHZ;
+    } else if(bwFlags & WLD_NL80211_RATE_BW_F_80) {
+        return SWL_BW_80MHZ;
+    } else if(bwFlags & WLD_NL80211_RATE_BW_F_40) {
+        return SWL_BW_40MHZ;
+    } else if(bwFlags & WLD_NL80211_RATE_BW_F_10) {
+        return SWL_BW_10MHZ;
+    } else if(bwFlags & WLD_NL80211_RATE_BW_F_5) {
+        return SWL_BW_5MHZ;
+    }
+    return SWL_BW_20MHZ;
+}
+
+static swl_guardinterval_e s_refHeGi(uint8_t sgi, swl_guardinterval_e defaultGi) {
+    if(sgi == NL80211_RATE_INFO_HE_GI_0_8) {
+        return SWL_SGI_800;
+    } else if(sgi == NL80211_RATE_INFO_HE_GI_1_6) {
+        return SWL_SGI_1600;
+    } else if(sgi == NL80211_RATE_INFO_HE_GI_3_2) {
+        return SWL_SGI_3200;
+    }
+    return defaultGi;
+}
+
+static void test_wld_nl80211_rateTables(void** mockaState _UNUSED) {
+    /* channel width conversions */
+    for(uint32_t nlBw = 0; nlBw < NL80211_CHAN_WIDTH_320 + 4; nlBw++) {
+        swl_bandwidth_e refSwlBw = SWL_BW_MAX;
+        uint32_t refBw = 0;
+        for(uint32_t i = 0; i < SWL_ARRAY_SIZE(sRefChannelWidthMap); i++) {
+            if(sRefChannelWidthMap[i].nl80211Bw == nlBw) {
+                refSwlBw = sRefChannelWidthMap[i].swlBw;
+                refBw = sRefChannelWidthMap[i].bw;
+                break;
+            }
+        }
+        assert_int_equal(wld_nl80211_bwNlToSwl(nlBw), refSwlBw);
+        assert_int_equal(wld_nl80211_bwNlToVal(nlBw), refBw);
+    }
+
+    /* rate info bandwidth flags */
+    for(uint32_t bwFlags = 0; bwFlags <= WLD_NL80211_RATE_BW_F_ALL; bwFlags++) {
+        assert_int_equal(wld_nl80211_rateBwFlagsToSwl(bwFlags), s_refRateBw(bwFlags));
+    }
+
+    /* HE / EHT guard interval */
+    for(uint32_t sgi = 0; sgi <= UINT8_MAX; sgi++) {
+        assert_int_equal(wld_nl80211_rateHeGiToSwl(sgi, SWL_SGI_AUTO), s_refHeGi(sgi, SWL_SGI_AUTO));
+        assert_int_equal(wld_nl80211_rateHeGiToSwl(sgi, SWL_SGI_800), s_refHeGi(sgi, SWL_SGI_800));
+    }
+}
+
 int main(int argc _UNUSED, char* argv[] _UNUSED) {
     sahTraceOpen(__FILE__, TRACE_TYPE_STDERR);
     if(!sahTraceIsOpen()) {
@@ -1255,6 +1329,7 @@ int main(int argc _UNUSED, char* argv[] _UNUSED) {
         cmocka_unit_test_setup_teardown(test_wld_nl80211_getScanResults, s_test_getScanResults_setup, s_test_getScanResults_teardown),
         cmocka_unit_test(test_wld_nl80211_getChanSurveyInfo),
         cmocka_unit_test(test_wld_nl80211_request_expires_while_in_callback),
+        cmocka_unit_test(test_wld_nl80211_rateTables),
     };
     int rc = cmocka_run_group_tests(tests, setup_suite, teardown_suite);
     sahTraceClose();
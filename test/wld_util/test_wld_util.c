@@ -105,6 +105,18 @@ static void test_convIntArrToString(void** state _UNUSED) {
 }
 
 
+static void test_fnvHash(void** state _UNUSED) {
+    assert_int_equal(wld_util_fnv32Update(WLD_UTIL_FNV32_OFFSET_BASIS, "", 0), WLD_UTIL_FNV32_OFFSET_BASIS);
+    assert_int_equal(wld_util_fnv32Update(WLD_UTIL_FNV32_OFFSET_BASIS, "a", 1), 0xe40c292cU);
+    assert_int_equal(wld_util_fnv32Update(WLD_UTIL_FNV32_OFFSET_BASIS, "foobar", 6), 0xbf9cf968U);
+    /* hash can be updated chunk by chunk */
+    uint32_t hash = wld_util_fnv32Update(WLD_UTIL_FNV32_OFFSET_BASIS, "foo", 3);
+    assert_int_equal(wld_util_fnv32Update(hash, "bar", 3), 0xbf9cf968U);
+
+    assert_true(wld_util_fnv64Update(WLD_UTIL_FNV64_OFFSET_BASIS, "a", 1) == 0xaf63dc4c8601ec8cULL);
+    assert_true(wld_util_fnv64Update(WLD_UTIL_FNV64_OFFSET_BASIS, "foobar", 6) == 0x85944171f73967e8ULL);
+}
+
 static void test_convStrToIntArray(void** state _UNUSED) {
     int buffer1[30];
     int buffer2[5];
@@ -441,6 +453,7 @@ int main(int argc _UNUSED, char* argv[] _UNUSED) {
         cmocka_unit_test(test_isValidAesKey),
         cmocka_unit_test(test_convIntArrToString),
         cmocka_unit_test(test_convStrToIntArray),
+        cmocka_unit_test(test_fnvHash),
     };
     int rc = cmocka_run_group_tests(tests, s_setupSuite, s_teardownSuite);
     sahTraceClose();
@@ -0,0 +1,857 @@
+/****************************************************************************
+**
+** SPDX-License-Identifier: BSD-2-Clause-Patent
+**
+** SPDX-FileCopyrightText: Copyright (c) 2024 SoftAtHome
+**
+** Redistribution and use in source and binary forms, with or
+** without modification, are permitted provided that the following
+** conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+** notice, this list of conditions and the following disclaimer.
+**
+** 2. Redistributions in binary form must reproduce the above
+** copyright notice, this list of conditions and the following
+** disclaimer in the documentation and/or other materials provided
+** with the distribution.
+**
+** Subject to the terms and conditions of this license, each
+** copyright holder and contributor hereby grants to those receiving
+** rights under this license a perpetual, worldwide, non-exclusive,
+** no-charge, royalty-free, irrevocable (except for failure to
+** satisfy the conditions of this license) patent license to make,
+** have made, use, offer to sell, sell, import, and otherwise
+** transfer this software, where such license applies only to those
+** patent claims, already acquired or hereafter acquired, licensable
+** by such copyright holder or contributor that are necessarily
+** infringed by:
+**
+** (a) their Contribution(s) (the licensed copyrights of copyright
+** holders and non-copyrightable additions of contributors, in
+** source or binary form) alone; or
+**
+** (b) combination of their Contribution(s) with the work of
+** authorship to which such Contribution(s) was added by such
+** copyright holder or contributor, if, at the time the Contribution
+** is added, such addition causes such combination to be necessarily
+** infringed. The patent license shall not apply to any other
+** combinations which include the Contribution.
+**
+** Except as expressly stated above, no rights or licenses from any
+** copyright holder or contributor is granted under this license,
+** whether expressly, by implication, estoppel or otherwise.
+**
+** DISCLAIMER
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+** CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+** INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+** DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR
+** CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+** USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+** AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+** LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+** ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+**
+****************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <cmocka.h>
+
+#include <debug/sahtrace.h>
+
+#include "wld.h"
+#include "wld_wpaCtrlInterface.h"
+#include "wld_wpaCtrl_trace.h"
+#include "wld_wpaCtrl_api.h"
+#include "wld_wpaCtrlConnection_priv.h"
+#include "wld_wpaCtrlInterface_priv.h"
+#include "wld_wpaCtrlMngr.h"
+#include "wld_wpaCtrlMngr_priv.h"
+#include "wld_secDmn.h"
+#include "test-toolbox/ttb_amx.h"
+#include "../testHelper/wld_th_wpaCtrlReplay.h"
+
+#define NR_REPLAY_EVTS 2000
+/*
+ * regression gate: mean cpu time to handle one event, on a plain host,
+ * scaled when instrumented by valgrind (default test runner)
+ */
+#define MAX_MEAN_EVT_HANDLING_US 500
+#define VALGRIND_SLOWDOWN_FACTOR 50
+#define TEST_SECRET "S3cr3tPassphrase"
+#define NR_BURST_EVTS 40
+
+static char s_tmpDir[64];
+static uint32_t s_nrEvtsHandled = 0;
+
+typedef struct {
+    char cmd[32];
+    swl_rc_ne rc;
+    char reply[64];
+    bool inSyncCall;
+} cmdDone_t;
+
+static cmdDone_t s_cmdDones[8];
+static uint32_t s_nrCmdDones = 0;
+static bool s_inSyncCall = false;
+static uint32_t s_nrUncorrelatedMsgs = 0;
+static uint32_t s_nrBatchDones = 0;
+static uint32_t s_batchNrCmds = 0;
+static uint32_t s_batchNrFailed = 0;
+
+static void s_procEvtMsg(void* userData _UNUSED, char* ifName _UNUSED, char* msgData _UNUSED) {
+    s_nrEvtsHandled++;
+}
+
+static void s_fmtEvt(char* buf, size_t bufSize, uint32_t id) {
+    snprintf(buf, bufSize, "<3>%s 00:11:22:33:%02x:%02x",
+             (id % 2) ? "AP-STA-DISCONNECTED" : "AP-STA-CONNECTED", (id >> 8) & 0xff, id & 0xff);
+}
+
+static void s_getTmpPath(char* path, size_t pathSize, const char* name) {
+    snprintf(path, pathSize, "%s/%s", s_tmpDir, name);
+}
+
+static void s_recordMsgStr(wld_wpaCtrl_traceDir_e dir, const char* sockName, const char* data) {
+    wld_wpaCtrl_recordMsg(dir, sockName, data, strlen(data));
+}
+
+/*
+ * script of the mock daemon: replies to the commands sent by the plugin, and events to send
+ */
+static void s_writeScriptTrace(const char* path) {
+    assert_int_equal(wld_wpaCtrl_startRecord(path), SWL_RC_OK);
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "GET_CONFIG");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", "bssid=00:11:22:33:44:55\nssid=test\n");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "SET wpa_passphrase " TEST_SECRET);
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", "OK\n");
+    char msg[128];
+    for(uint32_t i = 0; i < NR_REPLAY_EVTS; i++) {
+        s_fmtEvt(msg, sizeof(msg), i);
+        s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_EVT, "wlan0", msg);
+    }
+    wld_wpaCtrl_stopRecord();
+}
+
+/*
+ * capture the traffic of a real wpa_ctrl interface, talking to a mock daemon run from a script
+ */
+static void s_recordLiveTrace(const char* recPath) {
+    char scriptPath[128];
+    s_getTmpPath(scriptPath, sizeof(scriptPath), "script.bin");
+    s_writeScriptTrace(scriptPath);
+    wld_th_wpaCtrlReplay_t replay;
+    assert_true(wld_th_wpaCtrlReplay_init(&replay, scriptPath, s_tmpDir, false));
+    assert_true(wld_th_wpaCtrlReplay_startServer(&replay));
+
+    assert_int_equal(wld_wpaCtrl_startRecord(recPath), SWL_RC_OK);
+    wld_wpaCtrlInterface_t* pIface = NULL;
+    assert_true(wld_wpaCtrlInterface_init(&pIface, "wlan0", s_tmpDir));
+    wld_wpaCtrl_evtHandlers_cb handlers = {.fProcEvtMsg = s_procEvtMsg};
+    wld_wpaCtrlInterface_setEvtHandlers(pIface, NULL, &handlers);
+    wld_wpaCtrlInterface_setEnable(pIface, true);
+    assert_true(wld_wpaCtrlInterface_open(pIface));
+    char ssid[64] = {0};
+    assert_int_equal(wld_wpaCtrl_getSyncCmdParamVal(pIface, "GET_CONFIG", "ssid", ssid, sizeof(ssid)), SWL_RC_OK);
+    assert_string_equal(ssid, "test");
+    char setCmd[] = "SET wpa_passphrase " TEST_SECRET;
+    assert_true(wld_wpaCtrl_sendCmdCheckResponse(pIface, setCmd, "OK"));
+    s_nrEvtsHandled = 0;
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, &pIface, 1, 20000));
+    assert_int_equal(s_nrEvtsHandled, NR_REPLAY_EVTS);
+    wld_wpaCtrl_stopRecord();
+
+    wld_wpaCtrlInterface_cleanup(&pIface);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+    unlink(scriptPath);
+}
+
+static void test_wld_wpaCtrl_traceRedact(void** state _UNUSED) {
+    char buf[256];
+    const char* cmd = "SET wpa_passphrase my secret phrase";
+    assert_int_equal(wld_wpaCtrl_traceRedact(cmd, strlen(cmd), buf, sizeof(buf)), strlen("SET wpa_passphrase <redacted>"));
+    assert_string_equal(buf, "SET wpa_passphrase <redacted>");
+    const char* reply = "ssid=test\nwpa_psk=00112233\nsae_password=abc|id=1\nkey_mgmt=SAE\n";
+    wld_wpaCtrl_traceRedact(reply, strlen(reply), buf, sizeof(buf));
+    assert_string_equal(buf, "ssid=test\nwpa_psk=<redacted>\nsae_password=<redacted>\nkey_mgmt=SAE\n");
+    const char* netCmd = "SET_NETWORK 0 psk \"secret\"";
+    wld_wpaCtrl_traceRedact(netCmd, strlen(netCmd), buf, sizeof(buf));
+    assert_string_equal(buf, "SET_NETWORK 0 psk <redacted>");
+    /* key only matched as a whole word */
+    const char* other = "SET wpa_pairwise CCMP";
+    wld_wpaCtrl_traceRedact(other, strlen(other), buf, sizeof(buf));
+    assert_string_equal(buf, other);
+    /* truncated output */
+    char smallBuf[8];
+    assert_int_equal(wld_wpaCtrl_traceRedact(cmd, strlen(cmd), smallBuf, sizeof(smallBuf)), sizeof(smallBuf) - 1);
+    assert_string_equal(smallBuf, "SET wpa");
+}
+
+static void test_wld_wpaCtrl_recordTrace(void** state _UNUSED) {
+    char recPath[128];
+    s_getTmpPath(recPath, sizeof(recPath), "record.bin");
+    s_recordLiveTrace(recPath);
+
+    wld_wpaCtrl_traceReader_t* pReader = NULL;
+    assert_int_equal(wld_wpaCtrl_traceReader_open(&pReader, recPath), SWL_RC_OK);
+    wld_wpaCtrl_traceRecord_t record;
+    uint32_t nrRecords[WLD_WPACTRL_TRACE_DIR_MAX] = {0};
+    bool cmdSeen[3] = {false, false, false};
+    uint64_t lastTsUs = 0;
+    char msg[128];
+    swl_rc_ne rc;
+    while((rc = wld_wpaCtrl_traceReader_next(pReader, &record)) == SWL_RC_OK) {
+        assert_string_equal(record.sockName, "wlan0");
+        assert_int_equal(strlen(record.data), record.len);
+        assert_true(record.tsUs >= lastTsUs);
+        lastTsUs = record.tsUs;
+        assert_null(strstr(record.data, TEST_SECRET));
+        if(record.dir == WLD_WPACTRL_TRACE_DIR_CMD) {
+            cmdSeen[0] |= swl_str_matches(record.data, "ATTACH");
+            cmdSeen[1] |= swl_str_matches(record.data, "GET_CONFIG");
+            cmdSeen[2] |= swl_str_matches(record.data, "SET wpa_passphrase " WLD_WPACTRL_TRACE_REDACTED);
+        } else if(record.dir == WLD_WPACTRL_TRACE_DIR_EVT) {
+            /* events are captured in the order they are received */
+            s_fmtEvt(msg, sizeof(msg), nrRecords[record.dir]);
+            assert_string_equal(record.data, msg);
+        }
+        nrRecords[record.dir]++;
+    }
+    assert_int_equal(rc, SWL_RC_DONE);
+    wld_wpaCtrl_traceReader_close(&pReader);
+    assert_null(pReader);
+    assert_true(cmdSeen[0] && cmdSeen[1] && cmdSeen[2]);
+    assert_int_equal(nrRecords[WLD_WPACTRL_TRACE_DIR_REPLY], nrRecords[WLD_WPACTRL_TRACE_DIR_CMD]);
+    assert_int_equal(nrRecords[WLD_WPACTRL_TRACE_DIR_EVT], NR_REPLAY_EVTS);
+    unlink(recPath);
+}
+
+static uint64_t s_getMaxMeanEvtHandlingUs() {
+    const char* preload = getenv("LD_PRELOAD");
+    if((preload != NULL) && (strstr(preload, "vgpreload") != NULL)) {
+        return MAX_MEAN_EVT_HANDLING_US * VALGRIND_SLOWDOWN_FACTOR;
+    }
+    return MAX_MEAN_EVT_HANDLING_US;
+}
+
+static void test_wld_wpaCtrl_replayTrace(void** state _UNUSED) {
+    char recPath[128];
+    s_getTmpPath(recPath, sizeof(recPath), "replay.bin");
+    s_recordLiveTrace(recPath);
+
+    wld_th_wpaCtrlReplay_t replay;
+    assert_true(wld_th_wpaCtrlReplay_init(&replay, recPath, s_tmpDir, false));
+    assert_int_equal(replay.stats.nrEvts, NR_REPLAY_EVTS);
+    assert_true(wld_th_wpaCtrlReplay_startServer(&replay));
+
+    wld_wpaCtrlInterface_t* pIface = NULL;
+    assert_true(wld_wpaCtrlInterface_init(&pIface, "wlan0", s_tmpDir));
+    wld_wpaCtrl_evtHandlers_cb handlers = {.fProcEvtMsg = s_procEvtMsg};
+    wld_wpaCtrlInterface_setEvtHandlers(pIface, NULL, &handlers);
+    wld_wpaCtrlInterface_setEnable(pIface, true);
+    assert_true(wld_wpaCtrlInterface_open(pIface));
+    assert_true(wld_wpaCtrlInterface_isReady(pIface));
+
+    /* captured reply is served */
+    char ssid[64] = {0};
+    assert_int_equal(wld_wpaCtrl_getSyncCmdParamVal(pIface, "GET_CONFIG", "ssid", ssid, sizeof(ssid)), SWL_RC_OK);
+    assert_string_equal(ssid, "test");
+    /* kept reply is served from memory */
+    char bssid[32] = {0};
+    assert_int_equal(wld_wpaCtrl_getCachedCmdParamVal(pIface, "GET_CONFIG", "bssid", WLD_WPACTRL_MAX_AGE_UNLIMITED, bssid, sizeof(bssid)), SWL_RC_OK);
+    assert_string_equal(bssid, "00:11:22:33:44:55");
+    /* captured command with redacted secret is still matched */
+    char setCmd[] = "SET wpa_passphrase other" TEST_SECRET;
+    assert_true(wld_wpaCtrl_sendCmdCheckResponse(pIface, setCmd, "OK"));
+
+    s_nrEvtsHandled = 0;
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, &pIface, 1, 20000));
+    assert_int_equal(replay.stats.nrMsgsHandled, NR_REPLAY_EVTS);
+    assert_int_equal(s_nrEvtsHandled, NR_REPLAY_EVTS);
+    assert_true(replay.stats.totalHandlingCpuUs / NR_REPLAY_EVTS <= s_getMaxMeanEvtHandlingUs());
+
+    wld_wpaCtrlInterface_cleanup(&pIface);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+    unlink(recPath);
+}
+
+/*
+ * warm standby flow: interfaces are added/removed over the global ctrl iface of the mock daemon
+ */
+static void test_wld_wpaCtrl_replayGlobalIfaceAddRemove(void** state _UNUSED) {
+    char scriptPath[128];
+    s_getTmpPath(scriptPath, sizeof(scriptPath), "globScript.bin");
+    assert_int_equal(wld_wpaCtrl_startRecord(scriptPath), SWL_RC_OK);
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "global", "PING");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "global", "PONG\n");
+    wld_wpaCtrl_stopRecord();
+
+    wld_th_wpaCtrlReplay_t replay;
+    assert_true(wld_th_wpaCtrlReplay_init(&replay, scriptPath, s_tmpDir, false));
+    assert_int_equal(replay.nrSocks, 1);
+    assert_true(wld_th_wpaCtrlReplay_startServer(&replay));
+
+    char reply[64] = {0};
+    assert_int_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "global", "ADD wlan1 config=/tmp/wlan1_hapd.conf", reply, sizeof(reply)), SWL_RC_OK);
+    assert_true(swl_str_startsWith(reply, "OK"));
+    /* already added */
+    assert_int_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "global", "ADD wlan1 config=/tmp/wlan1_hapd.conf", reply, sizeof(reply)), SWL_RC_OK);
+    assert_true(swl_str_startsWith(reply, "FAIL"));
+
+    /* added interface is served */
+    wld_wpaCtrlInterface_t* pIface = NULL;
+    assert_true(wld_wpaCtrlInterface_init(&pIface, "wlan1", s_tmpDir));
+    wld_wpaCtrlInterface_setEnable(pIface, true);
+    assert_true(wld_wpaCtrlInterface_open(pIface));
+    assert_true(wld_wpaCtrlInterface_isReady(pIface));
+    assert_true(wld_wpaCtrl_sendCmdCheckResponse(pIface, "PING", "PONG"));
+    wld_wpaCtrlInterface_cleanup(&pIface);
+
+    assert_int_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "global", "REMOVE wlan1", reply, sizeof(reply)), SWL_RC_OK);
+    assert_true(swl_str_startsWith(reply, "OK"));
+    char sockPath[128];
+    snprintf(sockPath, sizeof(sockPath), "%s/wlan1", s_tmpDir);
+    assert_int_not_equal(access(sockPath, F_OK), 0);
+    assert_int_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "global", "REMOVE wlan1", reply, sizeof(reply)), SWL_RC_OK);
+    assert_true(swl_str_startsWith(reply, "FAIL"));
+
+    wld_wpaCtrl_flushConnPool(s_tmpDir);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+    unlink(scriptPath);
+}
+
+static void s_cmdDoneCb(void* userData _UNUSED, const char* cmd, swl_rc_ne rc, const char* reply) {
+    assert_true(s_nrCmdDones < SWL_ARRAY_SIZE(s_cmdDones));
+    cmdDone_t* pDone = &s_cmdDones[s_nrCmdDones++];
+    swl_str_copy(pDone->cmd, sizeof(pDone->cmd), cmd);
+    pDone->rc = rc;
+    swl_str_copy(pDone->reply, sizeof(pDone->reply), reply);
+    pDone->inSyncCall = s_inSyncCall;
+}
+
+static void s_readDataCb(void* userData _UNUSED, char* msgData _UNUSED, size_t msgLen _UNUSED) {
+    s_nrUncorrelatedMsgs++;
+}
+
+static void s_checkCmdDone(uint32_t idx, const char* cmd, swl_rc_ne rc, const char* reply) {
+    assert_true(idx < s_nrCmdDones);
+    assert_string_equal(s_cmdDones[idx].cmd, cmd);
+    assert_int_equal(s_cmdDones[idx].rc, rc);
+    assert_string_equal(s_cmdDones[idx].reply, reply);
+}
+
+/*
+ * start a mock daemon answering test commands
+ */
+static void s_startCmdMock(wld_th_wpaCtrlReplay_t* pReplay, const char* slowCmd) {
+    char scriptPath[128];
+    s_getTmpPath(scriptPath, sizeof(scriptPath), "cmdScript.bin");
+    assert_int_equal(wld_wpaCtrl_startRecord(scriptPath), SWL_RC_OK);
+    const char* cmds[] = {"CMD_A", "CMD_B", "CMD_C", "SLOW", "NEXT"};
+    char reply[32];
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(cmds); i++) {
+        s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", cmds[i]);
+        snprintf(reply, sizeof(reply), "REPLY_%s\n", cmds[i]);
+        s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", reply);
+    }
+    wld_wpaCtrl_stopRecord();
+    assert_true(wld_th_wpaCtrlReplay_init(pReplay, scriptPath, s_tmpDir, false));
+    unlink(scriptPath);
+    if(slowCmd != NULL) {
+        /* answered after the reply timeout, and after the time a lost reply was dropped from the queue */
+        wld_th_wpaCtrlReplay_setReplyDelay(pReplay, slowCmd, 2 * DFLT_SYNC_CMD_TMOUT_MS + 500);
+    }
+    assert_true(wld_th_wpaCtrlReplay_startServer(pReplay));
+    s_nrCmdDones = 0;
+    s_nrUncorrelatedMsgs = 0;
+}
+
+/*
+ * start a mock daemon answering test commands, and connect to it
+ */
+static wpaCtrlConnection_t* s_startCmdServer(wld_th_wpaCtrlReplay_t* pReplay, const char* slowCmd) {
+    s_startCmdMock(pReplay, slowCmd);
+    wpaCtrlConnection_t* pConn = NULL;
+    assert_int_equal(wld_wpaCtrlConnection_init(&pConn, 1, s_tmpDir, "wlan0"), SWL_RC_OK);
+    wld_wpaCtrlConnection_evtHandlers_cb handlers = {.fReadDataCb = s_readDataCb};
+    wld_wpaCtrlConnection_setEvtHandlers(pConn, NULL, &handlers);
+    assert_int_equal(wld_wpaCtrlConnection_open(pConn), SWL_RC_OK);
+    return pConn;
+}
+
+static void test_wld_wpaCtrl_connCmdFifo(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    wpaCtrlConnection_t* pConn = s_startCmdServer(&replay, NULL);
+    assert_int_equal(wld_wpaCtrlConnection_setMaxInFlightCmds(pConn, 2), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdAsync(pConn, "CMD_A", 0, s_cmdDoneCb, NULL), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdAsync(pConn, "CMD_B", 0, s_cmdDoneCb, NULL), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdAsync(pConn, "CMD_C", 0, s_cmdDoneCb, NULL), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrlConnection_getNrPendingCmds(pConn), 3);
+    assert_int_equal(pConn->nrInFlightCmds, 2);
+
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, NULL, 0, 5000));
+    /* replies are correlated in sending order */
+    assert_int_equal(s_nrCmdDones, 3);
+    s_checkCmdDone(0, "CMD_A", SWL_RC_OK, "REPLY_CMD_A");
+    s_checkCmdDone(1, "CMD_B", SWL_RC_OK, "REPLY_CMD_B");
+    s_checkCmdDone(2, "CMD_C", SWL_RC_OK, "REPLY_CMD_C");
+    assert_int_equal(wld_wpaCtrlConnection_getNrPendingCmds(pConn), 0);
+    assert_int_equal(s_nrUncorrelatedMsgs, 0);
+
+    wld_wpaCtrlConnection_cleanup(&pConn);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static void test_wld_wpaCtrl_connCmdTimeoutLateReply(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    wpaCtrlConnection_t* pConn = s_startCmdServer(&replay, "SLOW");
+    char cliPath[sizeof(pConn->clientAddr.sun_path)];
+    swl_str_copy(cliPath, sizeof(cliPath), wld_wpaCtrlConnection_getConnCliPath(pConn));
+    assert_int_equal(wld_wpaCtrlConnection_setMaxInFlightCmds(pConn, 1), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdAsync(pConn, "SLOW", 0, s_cmdDoneCb, NULL), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdAsync(pConn, "NEXT", 0, s_cmdDoneCb, NULL), SWL_RC_OK);
+
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, NULL, 0, 10000));
+    /* late reply is not taken for the reply of the following command */
+    assert_int_equal(s_nrCmdDones, 2);
+    s_checkCmdDone(0, "SLOW", SWL_RC_NOT_AVAILABLE, "");
+    s_checkCmdDone(1, "NEXT", SWL_RC_OK, "REPLY_NEXT");
+    assert_int_equal(s_nrUncorrelatedMsgs, 0);
+    assert_int_equal(wld_wpaCtrlConnection_getNrPendingCmds(pConn), 0);
+    /* moved to a new client socket */
+    assert_int_equal(pConn->nrResyncs, 1);
+    assert_string_not_equal(wld_wpaCtrlConnection_getConnCliPath(pConn), cliPath);
+    assert_int_not_equal(access(cliPath, F_OK), 0);
+
+    wld_wpaCtrlConnection_cleanup(&pConn);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static void test_wld_wpaCtrl_connSyncCmdTimeout(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    wpaCtrlConnection_t* pConn = s_startCmdServer(&replay, "SLOW");
+    char reply[64] = {0};
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdSynced(pConn, "SLOW", reply, sizeof(reply)), SWL_RC_NOT_AVAILABLE);
+    /* daemon still busy: wait longer for the reply of the following command */
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdSyncedExt(pConn, "NEXT", reply, sizeof(reply), 3 * DFLT_SYNC_CMD_TMOUT_MS), SWL_RC_OK);
+    assert_string_equal(reply, "REPLY_NEXT");
+
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, NULL, 0, 5000));
+    assert_int_equal(s_nrUncorrelatedMsgs, 0);
+
+    wld_wpaCtrlConnection_cleanup(&pConn);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static void test_wld_wpaCtrl_connSyncCmdDefersAsyncDone(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    wpaCtrlConnection_t* pConn = s_startCmdServer(&replay, NULL);
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdAsync(pConn, "CMD_A", 0, s_cmdDoneCb, NULL), SWL_RC_OK);
+    char reply[64] = {0};
+    s_inSyncCall = true;
+    assert_int_equal(wld_wpaCtrlConnection_sendCmdSynced(pConn, "CMD_B", reply, sizeof(reply)), SWL_RC_OK);
+    s_inSyncCall = false;
+    assert_string_equal(reply, "REPLY_CMD_B");
+    /* reply of the async cmd was received while waiting, but its handler is called from the main loop */
+    assert_int_equal(s_nrCmdDones, 0);
+
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, NULL, 0, 5000));
+    assert_int_equal(s_nrCmdDones, 1);
+    s_checkCmdDone(0, "CMD_A", SWL_RC_OK, "REPLY_CMD_A");
+    assert_false(s_cmdDones[0].inSyncCall);
+
+    wld_wpaCtrlConnection_cleanup(&pConn);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static void s_cmdBatchDoneCb(void* userData _UNUSED, const char* ifName, uint32_t nrCmds, uint32_t nrFailed) {
+    assert_string_equal(ifName, "wlan0");
+    s_nrBatchDones++;
+    s_batchNrCmds = nrCmds;
+    s_batchNrFailed = nrFailed;
+}
+
+static wld_wpaCtrlInterface_t* s_openCmdIface() {
+    wld_wpaCtrlInterface_t* pIface = NULL;
+    assert_true(wld_wpaCtrlInterface_init(&pIface, "wlan0", s_tmpDir));
+    wld_wpaCtrlInterface_setEnable(pIface, true);
+    assert_true(wld_wpaCtrlInterface_open(pIface));
+    assert_true(wld_wpaCtrlInterface_isReady(pIface));
+    s_nrBatchDones = 0;
+    return pIface;
+}
+
+static void test_wld_wpaCtrl_cmdBatch(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    s_startCmdMock(&replay, NULL);
+    wld_wpaCtrlInterface_t* pIface = s_openCmdIface();
+
+    /* without open batch, commands are answered synchronously */
+    assert_false(wld_wpaCtrl_isCmdBatchOpen(pIface));
+    assert_int_equal(wld_wpaCtrl_batchCmdCheckResponse(pIface, "CMD_A", "REPLY_CMD_A"), SWL_RC_OK);
+    assert_int_not_equal(wld_wpaCtrl_batchCmdCheckResponse(pIface, "CMD_A", "OK"), SWL_RC_OK);
+
+    assert_int_equal(wld_wpaCtrl_startCmdBatch(pIface), SWL_RC_OK);
+    assert_true(wld_wpaCtrl_isCmdBatchOpen(pIface));
+    assert_int_equal(wld_wpaCtrl_batchCmdCheckResponse(pIface, "CMD_A", "REPLY_CMD_A"), SWL_RC_OK);
+    /* rejection is only known when the batch completes */
+    assert_int_equal(wld_wpaCtrl_batchCmdCheckResponse(pIface, "CMD_B", "OK"), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrl_endCmdBatch(pIface, s_cmdBatchDoneCb, NULL), SWL_RC_OK);
+    assert_false(wld_wpaCtrl_isCmdBatchOpen(pIface));
+    assert_int_equal(s_nrBatchDones, 0);
+
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, &pIface, 1, 5000));
+    assert_int_equal(s_nrBatchDones, 1);
+    assert_int_equal(s_batchNrCmds, 2);
+    assert_int_equal(s_batchNrFailed, 1);
+
+    wld_wpaCtrlInterface_cleanup(&pIface);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static void test_wld_wpaCtrl_cmdBatchDroppedOnClose(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    s_startCmdMock(&replay, NULL);
+    wld_wpaCtrlInterface_t* pIface = s_openCmdIface();
+
+    assert_int_equal(wld_wpaCtrl_startCmdBatch(pIface), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrl_batchCmdCheckResponse(pIface, "CMD_A", "REPLY_CMD_A"), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrl_batchCmdCheckResponse(pIface, "CMD_C", "REPLY_CMD_C"), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrl_endCmdBatch(pIface, s_cmdBatchDoneCb, NULL), SWL_RC_OK);
+    /* daemon stopped before replies are read: commands are dropped, not rejected */
+    wld_wpaCtrlInterface_close(pIface);
+    assert_int_equal(s_nrBatchDones, 1);
+    assert_int_equal(s_batchNrCmds, 2);
+    assert_int_equal(s_batchNrFailed, 0);
+
+    wld_wpaCtrlInterface_cleanup(&pIface);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+/*
+ * start a mock daemon whose STATUS and GET_CONFIG replies change on each request
+ */
+static void s_startSnapshotMock(wld_th_wpaCtrlReplay_t* pReplay) {
+    char scriptPath[128];
+    s_getTmpPath(scriptPath, sizeof(scriptPath), "snapScript.bin");
+    assert_int_equal(wld_wpaCtrl_startRecord(scriptPath), SWL_RC_OK);
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "GET_CONFIG");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", "bssid=00:11:22:33:44:55\nssid=old\n");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "SET ssid new");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", "OK\n");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "GET_CONFIG");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", "bssid=00:11:22:33:44:55\nssid=new\n");
+    const char* states[] = {"ENABLED", "DISABLED", "DFS", "ENABLED"};
+    char reply[64];
+    for(uint32_t i = 0; i < SWL_ARRAY_SIZE(states); i++) {
+        s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "STATUS");
+        snprintf(reply, sizeof(reply), "state=%s\nnum_sta[0]=%u\n", states[i], i);
+        s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", reply);
+    }
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "DISABLE");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", "OK\n");
+    wld_wpaCtrl_stopRecord();
+    assert_true(wld_th_wpaCtrlReplay_init(pReplay, scriptPath, s_tmpDir, false));
+    unlink(scriptPath);
+    assert_true(wld_th_wpaCtrlReplay_startServer(pReplay));
+}
+
+static void s_checkCachedParam(wld_wpaCtrlInterface_t* pIface, const char* cmd, const char* key, uint32_t maxAgeMs, const char* expVal) {
+    char val[64] = {0};
+    assert_int_equal(wld_wpaCtrl_getCachedCmdParamVal(pIface, cmd, key, maxAgeMs, val, sizeof(val)), SWL_RC_OK);
+    assert_string_equal(val, expVal);
+}
+
+static void test_wld_wpaCtrl_cmdSnapshot(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    s_startSnapshotMock(&replay);
+    wld_wpaCtrlInterface_t* pIface = s_openCmdIface();
+
+    /* kept reply is served until made stale by our own config change */
+    s_checkCachedParam(pIface, "GET_CONFIG", "ssid", WLD_WPACTRL_MAX_AGE_UNLIMITED, "old");
+    /* kept reply is split once, and served from its key=value pairs */
+    assert_non_null(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_GET_CONFIG].pPairs);
+    assert_ptr_equal(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_GET_CONFIG].pPairs->pData, pIface->snapshots[WLD_WPACTRL_SNAPSHOT_GET_CONFIG].reply);
+    s_checkCachedParam(pIface, "GET_CONFIG", "ssid", WLD_WPACTRL_MAX_AGE_UNLIMITED, "old");
+    char setCmd[] = "SET ssid new";
+    assert_true(wld_wpaCtrl_sendCmdCheckResponse(pIface, setCmd, "OK"));
+    assert_false(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_GET_CONFIG].valid);
+    s_checkCachedParam(pIface, "GET_CONFIG", "ssid", WLD_WPACTRL_MAX_AGE_UNLIMITED, "new");
+
+    /* state read: kept while fresh, fetched again after a state changing command */
+    s_checkCachedParam(pIface, "STATUS", "state", 1000, "ENABLED");
+    s_checkCachedParam(pIface, "STATUS", "state", 1000, "ENABLED");
+    char disableCmd[] = "DISABLE";
+    assert_true(wld_wpaCtrl_sendCmdCheckResponse(pIface, disableCmd, "OK"));
+    s_checkCachedParam(pIface, "STATUS", "state", 1000, "DISABLED");
+    /* station events only make the snapshots stale: fetched on next read */
+    wld_wpaCtrlInterface_checkSnapshotEvt(pIface, "<3>AP-STA-CONNECTED 00:11:22:33:44:66");
+    assert_false(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_STATUS].valid);
+    assert_false(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_STATUS].refreshing);
+    s_checkCachedParam(pIface, "STATUS", "num_sta[0]", 1000, "2");
+    /* max age 0 always sends the command */
+    s_checkCachedParam(pIface, "STATUS", "state", 0, "ENABLED");
+
+    /* radio wide events refresh the snapshots in background */
+    wld_wpaCtrlInterface_checkSnapshotEvt(pIface, "<3>AP-CSA-FINISHED freq=5500 dfs=1");
+    assert_false(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_STATUS].valid);
+    assert_true(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_STATUS].refreshing);
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, &pIface, 1, 5000));
+    assert_true(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_STATUS].valid);
+    /* mock daemon is gone: reply is served from memory */
+    s_checkCachedParam(pIface, "STATUS", "state", WLD_WPACTRL_MAX_AGE_UNLIMITED, "ENABLED");
+
+    /* closing the connection drops the kept replies */
+    wld_wpaCtrlInterface_close(pIface);
+    assert_null(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_STATUS].reply);
+    assert_null(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_GET_CONFIG].reply);
+    assert_null(pIface->snapshots[WLD_WPACTRL_SNAPSHOT_GET_CONFIG].pPairs);
+
+    wld_wpaCtrlInterface_cleanup(&pIface);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static uint32_t s_countCliSocks(const char* sockName) {
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), CTRL_IFACE_CLIENT_PREFIX "%s-", sockName);
+    DIR* pDir = opendir(s_tmpDir);
+    assert_non_null(pDir);
+    uint32_t count = 0;
+    struct dirent* pEntry;
+    while((pEntry = readdir(pDir)) != NULL) {
+        count += swl_str_startsWith(pEntry->d_name, prefix);
+    }
+    closedir(pDir);
+    return count;
+}
+
+/*
+ * one-shot queries reuse a pooled connection, renewed when the daemon socket is re-created
+ */
+static void test_wld_wpaCtrl_connPool(void** state _UNUSED) {
+    wld_th_wpaCtrlReplay_t replay;
+    s_startCmdMock(&replay, NULL);
+    char reply[64] = {0};
+    assert_int_equal(wld_wpaCtrl_getConnPoolSize(s_tmpDir), 0);
+    assert_int_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "wlan0", "CMD_A", reply, sizeof(reply)), SWL_RC_OK);
+    assert_string_equal(reply, "REPLY_CMD_A");
+    assert_int_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "wlan0", "CMD_B", reply, sizeof(reply)), SWL_RC_OK);
+    assert_string_equal(reply, "REPLY_CMD_B");
+    assert_int_equal(wld_wpaCtrl_getConnPoolSize(s_tmpDir), 1);
+    assert_int_equal(s_countCliSocks("wlan0"), 1);
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, NULL, 0, 5000));
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+
+    /* daemon restarted: pooled connection to the old socket fails, and is replaced */
+    s_startCmdMock(&replay, NULL);
+    assert_int_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "wlan0", "CMD_C", reply, sizeof(reply)), SWL_RC_OK);
+    assert_string_equal(reply, "REPLY_CMD_C");
+    assert_int_equal(wld_wpaCtrl_getConnPoolSize(s_tmpDir), 1);
+    assert_int_equal(s_countCliSocks("wlan0"), 1);
+
+    /* unused connections are closed */
+    assert_int_equal(wld_wpaCtrl_setConnPoolIdleTmout(100), SWL_RC_OK);
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, NULL, 0, 5000));
+    assert_int_equal(wld_wpaCtrl_getConnPoolSize(s_tmpDir), 0);
+    assert_int_equal(s_countCliSocks("wlan0"), 0);
+
+    /* no more server */
+    assert_int_not_equal(wld_wpaCtrl_queryToSock(s_tmpDir, "wlan0", "CMD_A", reply, sizeof(reply)), SWL_RC_OK);
+    assert_int_equal(wld_wpaCtrl_getConnPoolSize(s_tmpDir), 0);
+
+    assert_int_equal(wld_wpaCtrl_setConnPoolIdleTmout(30000), SWL_RC_OK);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+/*
+ * events bursts are drained within the per wakeup budget, into the connection rx buffer
+ */
+static void test_wld_wpaCtrl_rxBurst(void** state _UNUSED) {
+    char scriptPath[128];
+    s_getTmpPath(scriptPath, sizeof(scriptPath), "burstScript.bin");
+    assert_int_equal(wld_wpaCtrl_startRecord(scriptPath), SWL_RC_OK);
+    char msg[128];
+    for(uint32_t i = 0; i < NR_BURST_EVTS; i++) {
+        s_fmtEvt(msg, sizeof(msg), i);
+        s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_EVT, "wlan0", msg);
+    }
+    wld_wpaCtrl_stopRecord();
+    wld_th_wpaCtrlReplay_t replay;
+    assert_true(wld_th_wpaCtrlReplay_init(&replay, scriptPath, s_tmpDir, false));
+    unlink(scriptPath);
+    assert_true(wld_th_wpaCtrlReplay_startServer(&replay));
+
+    wld_wpaCtrlInterface_t* pIface = NULL;
+    assert_true(wld_wpaCtrlInterface_init(&pIface, "wlan0", s_tmpDir));
+    wld_wpaCtrl_evtHandlers_cb handlers = {.fProcEvtMsg = s_procEvtMsg};
+    wld_wpaCtrlInterface_setEvtHandlers(pIface, NULL, &handlers);
+    wld_wpaCtrlInterface_setEnable(pIface, true);
+    assert_true(wld_wpaCtrlInterface_open(pIface));
+    wpaCtrlConnection_t* pConn = pIface->eventConn;
+    assert_int_equal(wld_wpaCtrlConnection_setRxBurstBudget(pConn, 4), SWL_RC_OK);
+    /* rx buffer is resized on next reception */
+    size_t dfltMaxMsgLen = wld_wpaCtrl_getMaxMsgLen();
+    assert_int_equal(wld_wpaCtrl_setMaxMsgLen(dfltMaxMsgLen + 1024), SWL_RC_OK);
+
+    /* let the mock daemon queue events */
+    usleep(100 * 1000);
+    wld_wpaCtrl_rxStats_t rxStats;
+    assert_true(wld_wpaCtrlInterface_getEvtRxStats(pIface, &rxStats));
+    assert_int_equal(rxStats.nrBudgetExhausted, 0);
+
+    s_nrEvtsHandled = 0;
+    assert_true(wld_th_wpaCtrlReplay_run(&replay, &pIface, 1, 5000));
+    assert_int_equal(s_nrEvtsHandled, NR_BURST_EVTS);
+    assert_true(wld_wpaCtrlInterface_getEvtRxStats(pIface, &rxStats));
+    assert_true(rxStats.nrMsgs >= NR_BURST_EVTS);
+    assert_int_equal(rxStats.maxMsgsPerWakeup, 4);
+    assert_true(rxStats.nrBudgetExhausted > 0);
+    assert_non_null(pConn->rxBuf);
+    assert_int_equal(pConn->rxBufSize, dfltMaxMsgLen + 1024);
+
+    assert_int_equal(wld_wpaCtrl_setMaxMsgLen(dfltMaxMsgLen), SWL_RC_OK);
+    wld_wpaCtrlInterface_cleanup(&pIface);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static void s_readDirWatchEvts(wld_wpaCtrlMngr_t* pMgr) {
+    amxo_connection_t* con = amxo_connection_get(get_wld_plugin_parser(), pMgr->dirWatchFd);
+    assert_non_null(con);
+    con->reader(con->fd, con->priv);
+}
+
+/*
+ * sockets created/removed in the ctrl iface dir are detected with inotify
+ */
+static void test_wld_wpaCtrl_mngrDirWatch(void** state _UNUSED) {
+    char ctrlDir[128];
+    s_getTmpPath(ctrlDir, sizeof(ctrlDir), "hostapd");
+    assert_int_equal(mkdir(ctrlDir, 0755), 0);
+    char scriptPath[128];
+    s_getTmpPath(scriptPath, sizeof(scriptPath), "watchScript.bin");
+    assert_int_equal(wld_wpaCtrl_startRecord(scriptPath), SWL_RC_OK);
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_CMD, "wlan0", "STATUS");
+    s_recordMsgStr(WLD_WPACTRL_TRACE_DIR_REPLY, "wlan0", "state=ENABLED\n");
+    wld_wpaCtrl_stopRecord();
+    wld_th_wpaCtrlReplay_t replay;
+    assert_true(wld_th_wpaCtrlReplay_init(&replay, scriptPath, ctrlDir, false));
+    unlink(scriptPath);
+    assert_true(wld_th_wpaCtrlReplay_startServer(&replay));
+
+    wld_secDmn_t* pSecDmn = NULL;
+    assert_int_equal(wld_secDmn_init(&pSecDmn, "hostapd", NULL, "/tmp/h0.conf", ctrlDir), SWL_RC_OK);
+    wld_wpaCtrlMngr_t* pMgr = pSecDmn->wpaCtrlMngr;
+    wld_wpaCtrlInterface_t* pIface = NULL;
+    assert_true(wld_wpaCtrlInterface_init(&pIface, "wlan0", ctrlDir));
+    assert_true(wld_wpaCtrlMngr_registerInterface(pMgr, pIface));
+    wld_wpaCtrlInterface_setEnable(pIface, true);
+    assert_true(wld_wpaCtrlInterface_open(pIface));
+    /* interface expected, but not yet served */
+    wld_wpaCtrlInterface_t* pIface2 = NULL;
+    assert_true(wld_wpaCtrlInterface_init(&pIface2, "wlan1", ctrlDir));
+    assert_true(wld_wpaCtrlMngr_registerInterface(pMgr, pIface2));
+    wld_wpaCtrlInterface_setEnable(pIface2, true);
+    /* fake running daemon */
+    pSecDmn->dmnProcess->status = WLD_DAEMON_STATE_UP;
+
+    /* connected to the daemon: dir is watched, no polling */
+    assert_true(wld_wpaCtrlMngr_connect(pMgr));
+    assert_true(pMgr->dirWatchFd > 0);
+    assert_false(wld_wpaCtrlMngr_isConnecting(pMgr));
+
+    /* new socket: connection is deferred, the daemon may not serve it yet */
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    assert_true(fd > 0);
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s/wlan1", ctrlDir);
+    assert_int_equal(bind(fd, (struct sockaddr*) &addr, sizeof(addr)), 0);
+    s_readDirWatchEvts(pMgr);
+    assert_true(wld_wpaCtrlMngr_isConnecting(pMgr));
+    assert_false(wld_wpaCtrlInterface_isReady(pIface2));
+    assert_true(wld_wpaCtrlInterface_isReady(pIface));
+    wld_wpaCtrlMngr_stopConnecting(pMgr);
+
+    /* removed socket: connection is closed */
+    close(fd);
+    unlink(addr.sun_path);
+    s_readDirWatchEvts(pMgr);
+    assert_true(wld_wpaCtrlInterface_isReady(pIface));
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s/wlan0", ctrlDir);
+    unlink(addr.sun_path);
+    s_readDirWatchEvts(pMgr);
+    assert_false(wld_wpaCtrlInterface_isReady(pIface));
+
+    /* removed dir: fall back to polling */
+    assert_int_equal(rmdir(ctrlDir), 0);
+    s_readDirWatchEvts(pMgr);
+    assert_int_equal(pMgr->dirWatchFd, 0);
+
+    pSecDmn->dmnProcess->status = WLD_DAEMON_STATE_DOWN;
+    wld_wpaCtrlInterface_cleanup(&pIface);
+    wld_wpaCtrlInterface_cleanup(&pIface2);
+    wld_secDmn_cleanup(&pSecDmn);
+    wld_th_wpaCtrlReplay_cleanup(&replay);
+}
+
+static int s_setupSuite(void** state) {
+    ttb_amx_t* ttbAmx = ttb_amx_init();
+    assert_non_null(ttbAmx);
+    *state = ttbAmx;
+    wld_plugin_init(&ttbAmx->dm, &ttbAmx->parser);
+    swl_str_copy(s_tmpDir, sizeof(s_tmpDir), "/tmp/wld_replay_XXXXXX");
+    assert_non_null(mkdtemp(s_tmpDir));
+    /* plugin client sockets are bound in the temp dir, so that no root access is needed */
+    assert_int_equal(wld_wpaCtrl_setClientDir(s_tmpDir), SWL_RC_OK);
+    return 0;
+}
+
+static int s_teardownSuite(void** state) {
+    rmdir(s_tmpDir);
+    ttb_amx_cleanup(*state);
+    *state = NULL;
+    return 0;
+}
+
+int main(int argc _UNUSED, char* argv[] _UNUSED) {
+    sahTraceOpen(__FILE__, TRACE_TYPE_STDERR);
+    if(!sahTraceIsOpen()) {
+        fprintf(stderr, "FAILED to open SAH TRACE\n");
+    }
+    sahTraceSetLevel(TRACE_LEVEL_WARNING);
+    sahTraceSetTimeFormat(TRACE_TIME_APP_SECONDS);
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_wld_wpaCtrl_traceRedact),
+        cmocka_unit_test(test_wld_wpaCtrl_recordTrace),
+        cmocka_unit_test(test_wld_wpaCtrl_replayTrace),
+        cmocka_unit_test(test_wld_wpaCtrl_replayGlobalIfaceAddRemove),
+        cmocka_unit_test(test_wld_wpaCtrl_connCmdFifo),
+        cmocka_unit_test(test_wld_wpaCtrl_connCmdTimeoutLateReply),
+        cmocka_unit_test(test_wld_wpaCtrl_connSyncCmdTimeout),
+        cmocka_unit_test(test_wld_wpaCtrl_connSyncCmdDefersAsyncDone),
+        cmocka_unit_test(test_wld_wpaCtrl_cmdBatch),
+        cmocka_unit_test(test_wld_wpaCtrl_cmdBatchDroppedOnClose),
+        cmocka_unit_test(test_wld_wpaCtrl_cmdSnapshot),
+        cmocka_unit_test(test_wld_wpaCtrl_connPool),
+        cmocka_unit_test(test_wld_wpaCtrl_rxBurst),
+        cmocka_unit_test(test_wld_wpaCtrl_mngrDirWatch),
+    };
+    int rc = cmocka_run_group_tests(tests, s_setupSuite, s_teardownSuite);
+    sahTraceClose();
+    return rc;
+}